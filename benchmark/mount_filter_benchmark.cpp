@@ -0,0 +1,111 @@
+// Micro-benchmark for mount filtering, which compares the precompiled mount filter against the previous std::regex
+// based implementation, over a synthetic mount table of a container host.
+//
+// Example usage:
+//   ./mount_filter_benchmark [mount_count] [iterations]
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+#include "mount_filter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <regex>
+
+using namespace duckdb;
+
+namespace {
+
+constexpr const char *IGNORE_FILE_SYSTEM_TYPE_REGEX =
+    "^(autofs|binfmt_misc|bpf|cgroup2?|configfs|debugfs|devpts|devtmpfs|fusectl|hugetlbfs|iso9660|mqueue|nsfs|overlay|"
+    "proc|procfs|pstore|rpc_pipefs|securityfs|selinuxfs|squashfs|sysfs|tracefs)$";
+constexpr const char *IGNORE_MOUNT_POINTS_REGEX = "^/(dev|proc|sys|run|snap|var/lib/docker/.+)($|/)";
+
+struct Mount {
+	string fs_type;
+	string mount_point;
+};
+
+// Mount table of a host running many containers: most entries are overlay and per-container virtual mounts.
+vector<Mount> GenerateMounts(idx_t count) {
+	vector<Mount> mounts;
+	mounts.reserve(count);
+	for (idx_t idx = 0; idx < count; idx++) {
+		switch (idx % 8) {
+		case 0:
+			mounts.push_back({"overlay", StringUtil::Format("/var/lib/docker/overlay2/%llu/merged", idx)});
+			break;
+		case 1:
+			mounts.push_back({"proc", StringUtil::Format("/run/containerd/%llu/proc", idx)});
+			break;
+		case 2:
+			mounts.push_back({"tmpfs", StringUtil::Format("/run/user/%llu", idx)});
+			break;
+		case 3:
+			mounts.push_back({"nsfs", StringUtil::Format("/run/netns/cni-%llu", idx)});
+			break;
+		case 4:
+			mounts.push_back({"cgroup2", "/sys/fs/cgroup"});
+			break;
+		case 5:
+			mounts.push_back({"ext4", StringUtil::Format("/data/volume-%llu", idx)});
+			break;
+		case 6:
+			mounts.push_back({"xfs", StringUtil::Format("/mnt/disk%llu", idx)});
+			break;
+		default:
+			mounts.push_back({"squashfs", StringUtil::Format("/snap/core/%llu", idx)});
+			break;
+		}
+	}
+	return mounts;
+}
+
+template <typename Filter>
+double BenchmarkNsPerMount(const vector<Mount> &mounts, idx_t iterations, Filter &&filter, idx_t &kept) {
+	kept = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (idx_t iter = 0; iter < iterations; iter++) {
+		for (const auto &mount : mounts) {
+			if (!filter(mount)) {
+				kept++;
+			}
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+	const double elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return elapsed_ns / static_cast<double>(mounts.size() * iterations);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const idx_t mount_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+	const idx_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+	const auto mounts = GenerateMounts(mount_count);
+
+	const std::regex fs_type_pattern(IGNORE_FILE_SYSTEM_TYPE_REGEX, std::regex_constants::extended);
+	const std::regex mount_point_pattern(IGNORE_MOUNT_POINTS_REGEX, std::regex_constants::extended);
+	idx_t regex_kept = 0;
+	const double regex_ns = BenchmarkNsPerMount(mounts, iterations, [&](const Mount &mount) {
+		return std::regex_match(mount.fs_type, fs_type_pattern) ||
+		       std::regex_match(mount.mount_point, mount_point_pattern);
+	}, regex_kept);
+
+	const auto filter = MountFilter::Default();
+	idx_t filter_kept = 0;
+	const double filter_ns = BenchmarkNsPerMount(mounts, iterations, [&](const Mount &mount) {
+		return filter.IgnoreFileSystemType(mount.fs_type) || filter.IgnoreMountPoint(mount.mount_point);
+	}, filter_kept);
+
+	std::printf("mounts: %llu, iterations: %llu\n", static_cast<unsigned long long>(mount_count),
+	            static_cast<unsigned long long>(iterations));
+	std::printf("std::regex:   %8.1f ns/mount (%llu kept)\n", regex_ns,
+	            static_cast<unsigned long long>(regex_kept / iterations));
+	std::printf("mount filter: %8.1f ns/mount (%llu kept)\n", filter_ns,
+	            static_cast<unsigned long long>(filter_kept / iterations));
+	std::printf("speedup:      %8.1fx\n", regex_ns / filter_ns);
+	return 0;
+}
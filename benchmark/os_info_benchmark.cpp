@@ -0,0 +1,85 @@
+// Micro-benchmark for OS information collection, which compares collecting all fields against collecting only the
+// cheap ones, as sys_os_info does for "SELECT host_name, os_up_since_seconds" through projection pushdown.
+//
+// The cost of process_count, thread_count and the handle count fallback grows with the number of processes, so
+// [extra_processes] idle child processes can be started to simulate a busy host.
+//
+// Example usage:
+//   ./os_info_benchmark [iterations] [extra_processes]
+
+#include "duckdb.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "os_info.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace duckdb;
+
+namespace {
+
+double BenchmarkMicrosPerCall(ClientContext &context, OSInfoFields fields, idx_t iterations) {
+	const auto start = std::chrono::steady_clock::now();
+	for (idx_t iter = 0; iter < iterations; iter++) {
+		const OSInfo info = GetOSInfo(context, fields);
+		if (info.host_name.empty() && info.process_count < 0) {
+			std::printf("unreachable\n");
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(iterations);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const idx_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+	const idx_t extra_processes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+#ifdef __linux__
+	vector<pid_t> children;
+	for (idx_t idx = 0; idx < extra_processes; idx++) {
+		const pid_t pid = fork();
+		if (pid == 0) {
+			pause();
+			_exit(0);
+		}
+		if (pid > 0) {
+			children.emplace_back(pid);
+		}
+	}
+#endif
+
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto &context = *con.context;
+
+	const OSInfo info = GetOSInfo(context, OS_INFO_PROCESS_COUNT);
+	const double all_us = BenchmarkMicrosPerCall(context, OS_INFO_ALL, iterations);
+	const double cheap_us =
+	    BenchmarkMicrosPerCall(context, OS_INFO_HOST_NAME | OS_INFO_OS_UP_SINCE_SECONDS, iterations);
+	const double process_us = BenchmarkMicrosPerCall(context, OS_INFO_PROCESS_COUNT, iterations);
+
+	std::printf("processes: %d, iterations: %llu\n", info.process_count, static_cast<unsigned long long>(iterations));
+	std::printf("all fields:                    %10.1f us/call\n", all_us);
+	std::printf("process_count:                 %10.1f us/call\n", process_us);
+	std::printf("host_name, os_up_since_seconds: %9.1f us/call\n", cheap_us);
+	std::printf("speedup:                       %10.1fx\n", all_us / cheap_us);
+
+#ifdef __linux__
+	for (const auto pid : children) {
+		kill(pid, SIGKILL);
+		waitpid(pid, nullptr, 0);
+	}
+#endif
+	return 0;
+}
@@ -0,0 +1,168 @@
+// Micro-benchmark for the procfs tokenizer, which measures the throughput of splitting text into tokens and parsing the
+// numeric ones, against a byte-by-byte loop with std::from_chars and against std::istringstream, over synthetic
+// /proc/[pid]/stat, /proc/net/tcp and /proc/[pid]/smaps content.
+//
+// Example usage:
+//   ./proc_tokenizer_benchmark [line_count] [repetitions]
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "proc_tokenizer.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace duckdb;
+
+namespace {
+
+// More than the 52 fields of /proc/[pid]/stat.
+constexpr idx_t MAX_TOKENS_PER_LINE = 64;
+
+string GenerateStat(idx_t line_count) {
+	string content;
+	for (idx_t idx = 0; idx < line_count; idx++) {
+		content += StringUtil::Format("%llu (kworker/%llu:1-events) S 2 0 0 0 -1 69238880 0 0 0 0 %llu %llu 0 0 20 0 1 "
+		                              "0 %llu 0 0 18446744073709551615 0 0 0 0 0 0 0 2147483647 0 0 0 0 17 %llu 0 0 0 "
+		                              "0 0 0 0 0 0 0 0 0 0\n",
+		                              1000 + idx, idx % 64, idx * 37, idx * 11, 312 + idx, idx % 64);
+	}
+	return content;
+}
+
+string GenerateNetTcp(idx_t line_count) {
+	string content =
+	    "  sl  local_address rem_address   st tx_queue rx_queue tr tm->when retrnsmt   uid  timeout inode\n";
+	for (idx_t idx = 0; idx < line_count; idx++) {
+		content += StringUtil::Format("%4llu: 0100007F:%04X 00000000:0000 0A 00000000:00000000 00:00000000 00000000  "
+		                              "   0        0 %llu 1 0000000000000000 100 0 0 10 0\n",
+		                              idx, static_cast<uint32_t>(idx % 65536), 17618 + idx);
+	}
+	return content;
+}
+
+string GenerateSmaps(idx_t line_count) {
+	static const char *const FIELDS[] = {"Size:", "Rss:", "Pss:", "Shared_Clean:", "Private_Dirty:", "Swap:"};
+	string content;
+	for (idx_t idx = 0; idx < line_count; idx++) {
+		if (idx % 8 == 0) {
+			content += StringUtil::Format("7f0c%08llx-7f0c%08llx rw-p 00000000 00:00 0%26s[heap]\n", idx * 4096,
+			                              (idx + 8) * 4096, "");
+			continue;
+		}
+		content += StringUtil::Format("%-16s%12llu kB\n", FIELDS[idx % 6], idx * 4);
+	}
+	return content;
+}
+
+bool IsSeparator(char c) {
+	return c == ' ' || c == '\t' || c == '\n';
+}
+
+// Tokenizer of the collectors before the shared one: one byte at a time, numbers parsed with std::from_chars.
+uint64_t SumScalar(std::string_view content) {
+	uint64_t sum = 0;
+	size_t pos = 0;
+	while (true) {
+		while (pos < content.size() && IsSeparator(content[pos])) {
+			pos++;
+		}
+		if (pos >= content.size()) {
+			return sum;
+		}
+		const size_t start = pos;
+		while (pos < content.size() && !IsSeparator(content[pos])) {
+			pos++;
+		}
+		uint64_t value = 0;
+		auto result = std::from_chars(content.data() + start, content.data() + pos, value);
+		if (result.ec == std::errc() && result.ptr == content.data() + pos) {
+			sum += value;
+		}
+	}
+}
+
+uint64_t SumStream(const string &content) {
+	uint64_t sum = 0;
+	std::istringstream stream(content);
+	string token;
+	while (stream >> token) {
+		uint64_t value = 0;
+		auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+		if (result.ec == std::errc() && result.ptr == token.data() + token.size()) {
+			sum += value;
+		}
+	}
+	return sum;
+}
+
+uint64_t SumNextToken(std::string_view content) {
+	uint64_t sum = 0;
+	size_t pos = 0;
+	std::string_view token;
+	while (NextToken(content, pos, token)) {
+		uint64_t value = 0;
+		if (ParseUint64(token, value)) {
+			sum += value;
+		}
+	}
+	return sum;
+}
+
+uint64_t SumSplitTokens(std::string_view content) {
+	uint64_t sum = 0;
+	size_t pos = 0;
+	std::string_view line;
+	std::string_view tokens[MAX_TOKENS_PER_LINE];
+	while (NextLine(content, pos, line)) {
+		const idx_t token_count = SplitTokens(line, tokens, MAX_TOKENS_PER_LINE);
+		for (idx_t idx = 0; idx < token_count; idx++) {
+			uint64_t value = 0;
+			if (ParseUint64(tokens[idx], value)) {
+				sum += value;
+			}
+		}
+	}
+	return sum;
+}
+
+template <typename FUNC>
+double MeasureMBPerSecond(const string &content, idx_t repetitions, uint64_t expected_sum, FUNC func) {
+	const auto start = std::chrono::steady_clock::now();
+	for (idx_t idx = 0; idx < repetitions; idx++) {
+		if (func(content) != expected_sum) {
+			std::fprintf(stderr, "token sums do not match\n");
+			std::exit(1);
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	return static_cast<double>(content.size() * repetitions) / seconds / (1024.0 * 1024.0);
+}
+
+void RunBenchmark(const char *name, const string &content, idx_t repetitions) {
+	const uint64_t expected_sum = SumScalar(content);
+	const double split_tokens = MeasureMBPerSecond(content, repetitions, expected_sum, SumSplitTokens);
+	const double next_token = MeasureMBPerSecond(content, repetitions, expected_sum, SumNextToken);
+	const double scalar = MeasureMBPerSecond(content, repetitions, expected_sum, SumScalar);
+	const double stream = MeasureMBPerSecond(content, repetitions, expected_sum, SumStream);
+	std::printf("%-8s %12.1f %10.1f %10.1f %10.1f\n", name, split_tokens, next_token, scalar, stream);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const idx_t line_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+	const idx_t repetitions = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+
+	std::printf("implementation: %s, lines: %llu\n", GetTokenizerImplementation(),
+	            static_cast<unsigned long long>(line_count));
+	std::printf("%-8s %12s %10s %10s %10s  (MB/s)\n", "input", "SplitTokens", "NextToken", "from_chars", "istream");
+	RunBenchmark("stat", GenerateStat(line_count), repetitions);
+	RunBenchmark("net_tcp", GenerateNetTcp(line_count), repetitions);
+	RunBenchmark("smaps", GenerateSmaps(line_count), repetitions);
+	return 0;
+}
@@ -0,0 +1,187 @@
+// Micro-benchmark for walking /proc, which compares the shared ProcDirectory walker (getdents64 and openat relative to
+// /proc with stack paths) against opendir/readdir with an absolute path formatted for every pid, as ReadProcessStatus
+// and ReadHandleCountFallback did before.
+//
+// The cost of both grows with the number of processes, so [extra_processes] idle child processes are started to
+// simulate a busy host; the default of 10000 needs a pid limit above that.
+//
+// Example usage:
+//   ./proc_walker_benchmark [iterations] [extra_processes]
+
+#include "duckdb.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+#include "proc_walker.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <csignal>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace duckdb;
+
+namespace {
+
+#ifdef __linux__
+struct WalkResult {
+	idx_t processes = 0;
+	idx_t bytes = 0;
+};
+
+// Read /proc/[pid]/stat of all processes with opendir/readdir and an absolute path per pid.
+WalkResult WalkStatReaddir() {
+	WalkResult result;
+	DIR *dirp = opendir("/proc");
+	if (!dirp) {
+		return result;
+	}
+	std::array<char, 512> buf;
+	struct dirent *ent = nullptr;
+	while ((ent = readdir(dirp)) != nullptr) {
+		if (ent->d_name[0] < '0' || ent->d_name[0] > '9') {
+			continue;
+		}
+		result.processes++;
+		const string stat_path = StringUtil::Format("/proc/%s/stat", ent->d_name);
+		FILE *stat_file = fopen(stat_path.c_str(), "r");
+		if (!stat_file) {
+			continue;
+		}
+		if (fgets(buf.data(), buf.size(), stat_file)) {
+			result.bytes += strlen(buf.data());
+		}
+		fclose(stat_file);
+	}
+	closedir(dirp);
+	return result;
+}
+
+// Read /proc/[pid]/stat of all processes with ProcDirectory and openat relative to /proc.
+WalkResult WalkStatProcDirectory() {
+	WalkResult result;
+	ProcDirectory proc_dir("/proc");
+	std::array<char, 512> buf;
+	std::array<char, 32> path;
+	int32_t pid = 0;
+	while (proc_dir.Next(pid)) {
+		result.processes++;
+		snprintf(path.data(), path.size(), "%d/stat", pid);
+		result.bytes += ReadFileAt(proc_dir.GetFd(), path.data(), buf).size();
+	}
+	return result;
+}
+
+// Count open file descriptors of all processes with opendir/readdir.
+WalkResult WalkFdReaddir() {
+	WalkResult result;
+	DIR *dirp = opendir("/proc");
+	if (!dirp) {
+		return result;
+	}
+	struct dirent *ent = nullptr;
+	while ((ent = readdir(dirp)) != nullptr) {
+		if (ent->d_name[0] < '0' || ent->d_name[0] > '9') {
+			continue;
+		}
+		result.processes++;
+		const string fd_path = StringUtil::Format("/proc/%s/fd", ent->d_name);
+		DIR *fd_dirp = opendir(fd_path.c_str());
+		if (!fd_dirp) {
+			continue;
+		}
+		struct dirent *fd_ent = nullptr;
+		while ((fd_ent = readdir(fd_dirp)) != nullptr) {
+			if (fd_ent->d_name[0] >= '0' && fd_ent->d_name[0] <= '9') {
+				result.bytes++;
+			}
+		}
+		closedir(fd_dirp);
+	}
+	closedir(dirp);
+	return result;
+}
+
+// Count open file descriptors of all processes with ProcDirectory.
+WalkResult WalkFdProcDirectory() {
+	WalkResult result;
+	ProcDirectory proc_dir("/proc");
+	std::array<char, 32> path;
+	int32_t pid = 0;
+	while (proc_dir.Next(pid)) {
+		result.processes++;
+		snprintf(path.data(), path.size(), "%d/fd", pid);
+		ProcDirectory fd_dir(proc_dir.GetFd(), path.data());
+		result.bytes += fd_dir.CountRemaining();
+	}
+	return result;
+}
+
+template <typename WALK>
+double BenchmarkMicrosPerWalk(WALK walk, idx_t iterations, WalkResult &result) {
+	const auto start = std::chrono::steady_clock::now();
+	for (idx_t iter = 0; iter < iterations; iter++) {
+		result = walk();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(iterations);
+}
+
+void PrintComparison(const char *name, double readdir_us, double walker_us, const WalkResult &result) {
+	std::printf("%s (%llu processes)\n", name, static_cast<unsigned long long>(result.processes));
+	std::printf("  opendir/readdir: %10.1f us/walk\n", readdir_us);
+	std::printf("  ProcDirectory:   %10.1f us/walk\n", walker_us);
+	std::printf("  speedup:         %10.2fx\n", readdir_us / walker_us);
+}
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const idx_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+	const idx_t extra_processes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+
+#ifdef __linux__
+	vector<pid_t> children;
+	for (idx_t idx = 0; idx < extra_processes; idx++) {
+		const pid_t pid = fork();
+		if (pid == 0) {
+			pause();
+			_exit(0);
+		}
+		if (pid < 0) {
+			std::printf("started %llu of %llu processes\n", static_cast<unsigned long long>(idx),
+			            static_cast<unsigned long long>(extra_processes));
+			break;
+		}
+		children.emplace_back(pid);
+	}
+
+	WalkResult readdir_result;
+	WalkResult walker_result;
+	// Warm up the dentry cache, so both variants see the same state.
+	WalkStatReaddir();
+	const double stat_readdir_us = BenchmarkMicrosPerWalk(WalkStatReaddir, iterations, readdir_result);
+	const double stat_walker_us = BenchmarkMicrosPerWalk(WalkStatProcDirectory, iterations, walker_result);
+	PrintComparison("/proc/[pid]/stat", stat_readdir_us, stat_walker_us, walker_result);
+
+	const double fd_readdir_us = BenchmarkMicrosPerWalk(WalkFdReaddir, iterations, readdir_result);
+	const double fd_walker_us = BenchmarkMicrosPerWalk(WalkFdProcDirectory, iterations, walker_result);
+	PrintComparison("/proc/[pid]/fd", fd_readdir_us, fd_walker_us, walker_result);
+
+	for (const auto pid : children) {
+		kill(pid, SIGKILL);
+		waitpid(pid, nullptr, 0);
+	}
+#else
+	std::printf("/proc is only available on Linux, %llu iterations with %llu processes skipped\n",
+	            static_cast<unsigned long long>(iterations), static_cast<unsigned long long>(extra_processes));
+#endif
+	return 0;
+}
@@ -0,0 +1,118 @@
+// Micro-benchmark for the metric snapshot codec, which measures encode and decode throughput and the compression ratio
+// against raw rows, over synthetic snapshots of a host sampled at 100 milliseconds.
+//
+// Example usage:
+//   ./snapshot_codec_benchmark [snapshot_count] [interface_count]
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+#include "metrics_recorder.hpp"
+#include "snapshot_codec.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace duckdb;
+
+namespace {
+
+constexpr int64_t START_MICROS = 1792324800LL * 1000000;
+constexpr int64_t INTERVAL_MICROS = 100000;
+constexpr idx_t MOUNT_COUNT = 8;
+
+// Snapshots shaped like CollectMetricSamples: busy interfaces change every tick, idle ones and most disk and memory
+// counters rarely do, and sampling jitters by a few microseconds.
+MetricsBatch GenerateSnapshots(idx_t snapshot_count, idx_t interface_count) {
+	vector<string> interfaces;
+	for (idx_t idx = 0; idx < interface_count; idx++) {
+		interfaces.emplace_back(StringUtil::Format("veth%llu", idx));
+	}
+	vector<string> mounts;
+	for (idx_t idx = 0; idx < MOUNT_COUNT; idx++) {
+		mounts.emplace_back(StringUtil::Format("/data/volume-%llu", idx));
+	}
+
+	MetricsBatch batch;
+	for (idx_t tick = 0; tick < snapshot_count; tick++) {
+		const timestamp_t ts {START_MICROS + static_cast<int64_t>(tick) * INTERVAL_MICROS +
+		                      static_cast<int64_t>(tick * 7 % 13)};
+		batch.Append(ts, "memory", "", "total_memory", 64ULL << 30);
+		batch.Append(ts, "memory", "", "used_memory", (20ULL << 30) + (tick % 50) * 4096);
+		batch.Append(ts, "memory", "", "free_memory", (44ULL << 30) - (tick % 50) * 4096);
+		batch.Append(ts, "memory", "", "cached_memory", 8ULL << 30);
+		for (const auto &mount : mounts) {
+			batch.Append(ts, "disk", mount, "total_space", 1ULL << 40);
+			batch.Append(ts, "disk", mount, "used_space", (1ULL << 39) + (tick / 10) * 4096);
+			batch.Append(ts, "disk", mount, "free_space", (1ULL << 39) - (tick / 10) * 4096);
+			batch.Append(ts, "disk", mount, "used_inodes", 100000 + tick / 100);
+			batch.Append(ts, "disk", mount, "free_inodes", 900000 - tick / 100);
+		}
+		for (idx_t idx = 0; idx < interface_count; idx++) {
+			// One in four interfaces carries traffic.
+			const uint64_t busy = idx % 4 == 0 ? tick : tick / 100;
+			batch.Append(ts, "network", interfaces[idx], "tx_bytes", 1000000 + busy * 123456);
+			batch.Append(ts, "network", interfaces[idx], "tx_packets", 1000 + busy * 100);
+			batch.Append(ts, "network", interfaces[idx], "tx_errors", 0);
+			batch.Append(ts, "network", interfaces[idx], "tx_dropped", 0);
+			batch.Append(ts, "network", interfaces[idx], "rx_bytes", 2000000 + busy * 654321);
+			batch.Append(ts, "network", interfaces[idx], "rx_packets", 2000 + busy * 500);
+			batch.Append(ts, "network", interfaces[idx], "rx_errors", 0);
+			batch.Append(ts, "network", interfaces[idx], "rx_dropped", busy / 1000);
+		}
+		batch.Append(ts, "os", "", "process_count", 400 + tick % 3);
+		batch.Append(ts, "os", "", "thread_count", 2000 + tick % 17);
+	}
+	return batch;
+}
+
+// Size of the samples as rows of a fixed width timestamp and value and variable length names.
+idx_t GetRawSize(const MetricsBatch &batch) {
+	idx_t size = 0;
+	for (idx_t row = 0; row < batch.Size(); row++) {
+		size += sizeof(int64_t) + batch.sources[row].size() + batch.entities[row].size() + batch.metrics[row].size() +
+		        sizeof(uint64_t);
+	}
+	return size;
+}
+
+double ElapsedNsPerSample(std::chrono::steady_clock::time_point start, idx_t sample_count) {
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(sample_count);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const idx_t snapshot_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 36000;
+	const idx_t interface_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16;
+	const auto batch = GenerateSnapshots(snapshot_count, interface_count);
+
+	auto start = std::chrono::steady_clock::now();
+	SnapshotEncoder encoder;
+	encoder.Append(batch);
+	const double encode_ns = ElapsedNsPerSample(start, batch.Size());
+
+	start = std::chrono::steady_clock::now();
+	MetricsBatch decoded;
+	SnapshotDecoder decoder(encoder.GetData());
+	while (decoder.Next(decoded)) {
+	}
+	const double decode_ns = ElapsedNsPerSample(start, batch.Size());
+	if (decoded.Size() != batch.Size() || decoded.values.back() != batch.values.back()) {
+		std::fprintf(stderr, "decoded samples do not match\n");
+		return 1;
+	}
+
+	const idx_t raw_size = GetRawSize(batch);
+	const idx_t encoded_size = encoder.GetData().size();
+	std::printf("snapshots: %llu, samples: %llu\n", static_cast<unsigned long long>(snapshot_count),
+	            static_cast<unsigned long long>(batch.Size()));
+	std::printf("encode:      %8.1f ns/sample\n", encode_ns);
+	std::printf("decode:      %8.1f ns/sample\n", decode_ns);
+	std::printf("raw rows:    %8.2f bytes/sample\n", static_cast<double>(raw_size) / batch.Size());
+	std::printf("encoded:     %8.2f bytes/sample\n", static_cast<double>(encoded_size) / batch.Size());
+	std::printf("compression: %8.1fx\n", static_cast<double>(raw_size) / encoded_size);
+	return 0;
+}
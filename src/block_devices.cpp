@@ -0,0 +1,300 @@
+#include "block_devices.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "scope_guard.hpp"
+#include "string_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <climits>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Nesting limit of dm and md devices, which guards against cycles while the device tree changes.
+constexpr idx_t MAX_RESOLVE_DEPTH = 16;
+
+const char *GetDiskClass(const BlockDeviceInfo &disk) {
+	if (disk.rotational) {
+		return "hdd";
+	}
+	return StringUtil::StartsWith(disk.name, "nvme") ? "nvme" : "ssd";
+}
+
+void CollectPhysicalDevices(const vector<BlockDeviceInfo> &devices, const unordered_map<string, idx_t> &device_index,
+                            idx_t idx, idx_t depth, vector<string> &result) {
+	if (depth > MAX_RESOLVE_DEPTH) {
+		return;
+	}
+	const auto &device = devices[idx];
+	auto collect = [&](const string &name) {
+		auto iter = device_index.find(name);
+		if (iter != device_index.end()) {
+			CollectPhysicalDevices(devices, device_index, iter->second, depth + 1, result);
+		}
+	};
+	if (!device.parent.empty()) {
+		collect(device.parent);
+		return;
+	}
+	if (!device.slaves.empty()) {
+		for (const auto &slave : device.slaves) {
+			collect(slave);
+		}
+		return;
+	}
+	// Mirrors and stripes could use several partitions of the same disk.
+	if (device.has_hardware && std::find(result.begin(), result.end(), device.name) == result.end()) {
+		result.emplace_back(device.name);
+	}
+}
+
+#ifdef __linux__
+constexpr const char *SYS_CLASS_BLOCK = "/sys/class/block";
+constexpr const char *SYS_DEVICES = "/sys/devices";
+
+// Read the first line of the attribute at [path] relative to [dir_fd] without surrounding whitespace, i.e. the padding
+// of SCSI model names; empty if it cannot be read.
+string ReadAttribute(int dir_fd, const char *path) {
+	std::array<char, 256> buf;
+	const std::string_view content = ReadFileAt(dir_fd, path, buf);
+	size_t pos = 0;
+	std::string_view line;
+	NextLine(content, pos, line);
+	return string(TrimString(line));
+}
+
+uint64_t ReadUint64Attribute(int dir_fd, const char *path) {
+	uint64_t value = 0;
+	ParseUint64(ReadAttribute(dir_fd, path), value);
+	return value;
+}
+
+bool HasEntry(int dir_fd, const char *path) {
+	return faccessat(dir_fd, path, F_OK, 0) == 0;
+}
+
+vector<string> ListSlaves(int dir_fd) {
+	vector<string> slaves;
+	const int slaves_fd = openat(dir_fd, "slaves", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (slaves_fd == -1) {
+		return slaves;
+	}
+	DIR *dirp = fdopendir(slaves_fd);
+	if (!dirp) {
+		close(slaves_fd);
+		return slaves;
+	}
+	SCOPE_EXIT {
+		closedir(dirp);
+	};
+	struct dirent *ent = nullptr;
+	while ((ent = readdir(dirp)) != nullptr) {
+		if (ent->d_name[0] != '.') {
+			slaves.emplace_back(ent->d_name);
+		}
+	}
+	std::sort(slaves.begin(), slaves.end());
+	return slaves;
+}
+
+// Get the NUMA node of the controller of a disk. Block devices do not report it themselves, so the sysfs device path
+// is walked up until a device does, i.e. the PCI function of an NVMe, SCSI or virtio controller.
+int32_t ReadNumaNode(const string &class_path) {
+	std::array<char, PATH_MAX> resolved;
+	if (!realpath((class_path + "/device").c_str(), resolved.data())) {
+		return -1;
+	}
+	string path = resolved.data();
+	while (path.size() > strlen(SYS_DEVICES) && StringUtil::StartsWith(path, SYS_DEVICES)) {
+		int32_t numa_node = 0;
+		if (ParseInteger(ReadAttribute(AT_FDCWD, (path + "/numa_node").c_str()), numa_node)) {
+			return numa_node;
+		}
+		path.erase(path.find_last_of('/'));
+	}
+	return -1;
+}
+
+// Get the disk of the partition at [class_path], whose sysfs directory is nested in the one of the disk, i.e.
+// /sys/devices/.../block/sda/sda1.
+string ReadPartitionParent(const string &class_path) {
+	std::array<char, PATH_MAX> resolved;
+	if (!realpath(class_path.c_str(), resolved.data())) {
+		return string();
+	}
+	const string path = resolved.data();
+	const size_t name_pos = path.find_last_of('/');
+	if (name_pos == string::npos || name_pos == 0) {
+		return string();
+	}
+	const size_t parent_pos = path.find_last_of('/', name_pos - 1);
+	return path.substr(parent_pos + 1, name_pos - parent_pos - 1);
+}
+
+bool ReadBlockDevice(const string &name, BlockDeviceInfo &info) {
+	const string class_path = StringUtil::Format("%s/%s", SYS_CLASS_BLOCK, name);
+	const int dir_fd = open(class_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (dir_fd == -1) {
+		return false;
+	}
+	SCOPE_EXIT {
+		close(dir_fd);
+	};
+
+	info.name = name;
+	info.device = ReadAttribute(dir_fd, "dev");
+	// Size is in 512 byte sectors, whatever the block size of the device.
+	info.size_bytes = ReadUint64Attribute(dir_fd, "size") * 512;
+	if (info.device.empty() || info.size_bytes == 0) {
+		return false;
+	}
+
+	if (HasEntry(dir_fd, "partition")) {
+		info.type = "partition";
+		info.parent = ReadPartitionParent(class_path);
+		// Queue limits and identity are copied from the disk.
+		return true;
+	}
+	if (HasEntry(dir_fd, "dm")) {
+		info.type = "dm";
+	} else if (HasEntry(dir_fd, "md")) {
+		info.type = "md";
+	} else if (HasEntry(dir_fd, "loop") || StringUtil::StartsWith(name, "loop")) {
+		info.type = "loop";
+	} else {
+		info.type = "disk";
+		info.has_hardware = HasEntry(dir_fd, "device");
+	}
+	info.slaves = ListSlaves(dir_fd);
+
+	info.rotational = ReadUint64Attribute(dir_fd, "queue/rotational") != 0;
+	info.logical_block_size = ReadUint64Attribute(dir_fd, "queue/logical_block_size");
+	info.physical_block_size = ReadUint64Attribute(dir_fd, "queue/physical_block_size");
+	info.nr_requests = ReadUint64Attribute(dir_fd, "queue/nr_requests");
+	info.max_sectors_kb = ReadUint64Attribute(dir_fd, "queue/max_sectors_kb");
+	info.read_ahead_kb = ReadUint64Attribute(dir_fd, "queue/read_ahead_kb");
+	info.scheduler = ParseActiveScheduler(ReadAttribute(dir_fd, "queue/scheduler"));
+
+	if (info.has_hardware) {
+		info.numa_node = ReadNumaNode(class_path);
+		info.model = ReadAttribute(dir_fd, "device/model");
+		// virtio disks report the serial on the block device, NVMe and some SCSI drivers on the device.
+		info.serial = ReadAttribute(dir_fd, "serial");
+		if (info.serial.empty()) {
+			info.serial = ReadAttribute(dir_fd, "device/serial");
+		}
+	}
+	return true;
+}
+
+vector<BlockDeviceInfo> GetBlockDevicesLinux(ClientContext &context) {
+	vector<BlockDeviceInfo> devices;
+	DIR *dirp = opendir(SYS_CLASS_BLOCK);
+	if (!dirp) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open %s: %s", SYS_CLASS_BLOCK, strerror(errno));
+		}
+		return devices;
+	}
+	SCOPE_EXIT {
+		closedir(dirp);
+	};
+	struct dirent *ent = nullptr;
+	while ((ent = readdir(dirp)) != nullptr) {
+		if (ent->d_name[0] == '.') {
+			continue;
+		}
+		BlockDeviceInfo info;
+		if (ReadBlockDevice(ent->d_name, info)) {
+			devices.emplace_back(std::move(info));
+		}
+	}
+	std::sort(devices.begin(), devices.end(),
+	          [](const BlockDeviceInfo &lhs, const BlockDeviceInfo &rhs) { return lhs.name < rhs.name; });
+	ResolveBlockDevices(devices);
+	return devices;
+}
+#endif
+
+} // namespace
+
+string ParseActiveScheduler(std::string_view line) {
+	// Devices without a choice print a single name without brackets, i.e. "none".
+	const size_t open_pos = line.find('[');
+	if (open_pos == std::string_view::npos) {
+		return string(TrimString(line));
+	}
+	const size_t close_pos = line.find(']', open_pos);
+	if (close_pos == std::string_view::npos) {
+		return string();
+	}
+	return string(line.substr(open_pos + 1, close_pos - open_pos - 1));
+}
+
+void ResolveBlockDevices(vector<BlockDeviceInfo> &devices) {
+	unordered_map<string, idx_t> device_index;
+	for (idx_t idx = 0; idx < devices.size(); idx++) {
+		device_index.emplace(devices[idx].name, idx);
+	}
+
+	for (auto &device : devices) {
+		auto iter = device.parent.empty() ? device_index.end() : device_index.find(device.parent);
+		if (iter == device_index.end()) {
+			continue;
+		}
+		const auto &disk = devices[iter->second];
+		device.rotational = disk.rotational;
+		device.logical_block_size = disk.logical_block_size;
+		device.physical_block_size = disk.physical_block_size;
+		device.nr_requests = disk.nr_requests;
+		device.max_sectors_kb = disk.max_sectors_kb;
+		device.read_ahead_kb = disk.read_ahead_kb;
+		device.scheduler = disk.scheduler;
+		device.numa_node = disk.numa_node;
+		device.model = disk.model;
+		device.serial = disk.serial;
+	}
+
+	for (idx_t idx = 0; idx < devices.size(); idx++) {
+		auto &device = devices[idx];
+		device.physical_devices.clear();
+		CollectPhysicalDevices(devices, device_index, idx, 0, device.physical_devices);
+		device.device_class = "virtual";
+		for (const auto &physical : device.physical_devices) {
+			const char *disk_class = GetDiskClass(devices[device_index[physical]]);
+			if (physical == device.physical_devices[0]) {
+				device.device_class = disk_class;
+			} else if (device.device_class != disk_class) {
+				device.device_class = "mixed";
+				break;
+			}
+		}
+	}
+}
+
+vector<BlockDeviceInfo> GetBlockDevices(ClientContext &context) {
+#ifdef __linux__
+	return GetBlockDevicesLinux(context);
+#else
+	throw NotImplementedException("Block device information is not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
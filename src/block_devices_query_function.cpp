@@ -0,0 +1,193 @@
+#include "block_devices_query_function.hpp"
+
+#include "block_devices.hpp"
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+namespace {
+
+Value NullIfEmpty(const string &str) {
+	return str.empty() ? Value(LogicalType::VARCHAR) : Value(str);
+}
+
+Value GetNameListValue(const vector<string> &names) {
+	vector<Value> name_values;
+	name_values.reserve(names.size());
+	for (const auto &name : names) {
+		name_values.emplace_back(Value(name));
+	}
+	return Value::LIST(LogicalType::VARCHAR, std::move(name_values));
+}
+
+struct SysBlockDevicesData : public GlobalTableFunctionState {
+	explicit SysBlockDevicesData(ClientContext &context)
+	    : finished(false), current_index(0), devices(GetBlockDevices(context)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<BlockDeviceInfo> devices;
+};
+
+unique_ptr<FunctionData> SysBlockDevicesBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(18);
+	names.reserve(18);
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("device");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("type");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("parent");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("slaves");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::VARCHAR));
+
+	names.emplace_back("physical_devices");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::VARCHAR));
+
+	names.emplace_back("device_class");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("size_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("rotational");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("logical_block_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("physical_block_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("nr_requests");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("max_sectors_kb");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("read_ahead_kb");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("scheduler");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("numa_node");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("model");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("serial");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysBlockDevicesInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysBlockDevicesData>(context);
+}
+
+void SysBlockDevicesFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysBlockDevicesData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.devices.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &device = data.devices[data.current_index];
+		col_idx = 0;
+
+		// name
+		output.SetValue(col_idx++, output_count, Value(device.name));
+
+		// device
+		output.SetValue(col_idx++, output_count, Value(device.device));
+
+		// type
+		output.SetValue(col_idx++, output_count, Value(device.type));
+
+		// parent, NULL unless a partition
+		output.SetValue(col_idx++, output_count, NullIfEmpty(device.parent));
+
+		// slaves
+		output.SetValue(col_idx++, output_count, GetNameListValue(device.slaves));
+
+		// physical_devices
+		output.SetValue(col_idx++, output_count, GetNameListValue(device.physical_devices));
+
+		// device_class
+		output.SetValue(col_idx++, output_count, Value(device.device_class));
+
+		// size_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.size_bytes));
+
+		// rotational
+		output.SetValue(col_idx++, output_count, Value::BOOLEAN(device.rotational));
+
+		// logical_block_size
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.logical_block_size));
+
+		// physical_block_size
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.physical_block_size));
+
+		// nr_requests
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.nr_requests));
+
+		// max_sectors_kb
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.max_sectors_kb));
+
+		// read_ahead_kb
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(device.read_ahead_kb));
+
+		// scheduler, NULL for devices without one
+		output.SetValue(col_idx++, output_count, NullIfEmpty(device.scheduler));
+
+		// numa_node, NULL if unknown
+		output.SetValue(col_idx++, output_count,
+		                device.numa_node < 0 ? Value(LogicalType::INTEGER) : Value::INTEGER(device.numa_node));
+
+		// model
+		output.SetValue(col_idx++, output_count, NullIfEmpty(device.model));
+
+		// serial
+		output.SetValue(col_idx++, output_count, NullIfEmpty(device.serial));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.devices.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysBlockDevicesFunction(ExtensionLoader &loader) {
+	TableFunction sys_block_devices_func("sys_block_devices", {}, SysBlockDevicesFunc, SysBlockDevicesBind,
+	                                     SysBlockDevicesInit);
+	loader.RegisterFunction(sys_block_devices_func);
+}
+
+} // namespace duckdb
@@ -12,6 +12,8 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "hardware_info_cache.hpp"
+#include "proc_tokenizer.hpp"
 #include "string_utils.hpp"
 
 #ifdef __linux__
@@ -49,16 +51,10 @@ int32_t ReadCPUCacheSize(ClientContext &context, const char *path) {
 
 	string line;
 	if (std::getline(file, line)) {
-		// Extract numeric part only
-		int32_t value = 0;
-		for (size_t idx = 0; idx < line.length(); idx++) {
-			if (isdigit(line[idx])) {
-				value = value * 10 + (line[idx] - '0');
-			} else {
-				break;
-			}
-		}
-		return value;
+		// Extract numeric part only, i.e. 32 for "32K"
+		uint64_t value = 0;
+		ParseUint64Prefix(line, value);
+		return static_cast<int32_t>(value);
 	}
 	return 0;
 }
@@ -285,6 +281,10 @@ CPUInfo GetCPUInfoMacOS(ClientContext &context) {
 } // namespace
 
 CPUInfo GetCPUInfo(ClientContext &context) {
+	return GetHardwareInfoCache(context)->GetCPUInfo(context);
+}
+
+CPUInfo CollectCPUInfo(ClientContext &context) {
 #ifdef __linux__
 	return GetCPUInfoLinux(context);
 #elif __APPLE__
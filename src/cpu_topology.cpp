@@ -0,0 +1,211 @@
+#include "cpu_topology.hpp"
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/string.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "string_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Larger than the max number of CPUs the kernel supports, so garbage cannot allocate huge CPU sets.
+constexpr int32_t MAX_CPU_ID = 65535;
+
+bool ParseCpuId(std::string_view token, int32_t &id) {
+	return ParseInteger(TrimString(token), id) && id >= 0 && id <= MAX_CPU_ID;
+}
+
+#ifdef __linux__
+constexpr const char *SYS_NODE_ONLINE = "/sys/devices/system/node/online";
+
+// Read the list at [path] into [ids]; false if it cannot be read or parsed.
+bool ReadCpuListFile(const char *path, vector<int32_t> &ids) {
+	// Lists of hosts with thousands of CPUs are still short, since consecutive CPUs are printed as ranges.
+	std::array<char, 4096> buf;
+	const std::string_view content = ReadFileAt(AT_FDCWD, path, buf);
+	return !content.empty() && ParseCpuList(content, ids);
+}
+
+// Read a non-negative id of /sys/devices/system/cpu/cpuN/topology at [path] into [id].
+bool ReadTopologyId(const char *path, int32_t &id) {
+	std::array<char, 64> buf;
+	const std::string_view content = ReadFileAt(AT_FDCWD, path, buf);
+	return !content.empty() && ParseInteger(TrimString(content), id) && id >= 0;
+}
+
+// CPU set of at least [cpu_count] CPUs, since cpu_set_t only holds 1024.
+struct DynamicCpuSet {
+	explicit DynamicCpuSet(idx_t cpu_count)
+	    : set(CPU_ALLOC(static_cast<int>(cpu_count))), size(CPU_ALLOC_SIZE(static_cast<int>(cpu_count))) {
+		CPU_ZERO_S(size, set);
+	}
+	~DynamicCpuSet() {
+		CPU_FREE(set);
+	}
+	DynamicCpuSet(const DynamicCpuSet &) = delete;
+	DynamicCpuSet &operator=(const DynamicCpuSet &) = delete;
+
+	cpu_set_t *set;
+	size_t size;
+};
+#endif
+
+} // namespace
+
+bool ParseCpuList(std::string_view text, vector<int32_t> &ids) {
+	ids.clear();
+	text = TrimString(text);
+	size_t pos = 0;
+	while (pos < text.size()) {
+		size_t end = text.find(',', pos);
+		if (end == std::string_view::npos) {
+			end = text.size();
+		}
+		const std::string_view range = text.substr(pos, end - pos);
+		const size_t dash = range.find('-');
+		int32_t first = 0;
+		int32_t last = 0;
+		if (dash == std::string_view::npos) {
+			if (!ParseCpuId(range, first)) {
+				return false;
+			}
+			last = first;
+		} else if (!ParseCpuId(range.substr(0, dash), first) || !ParseCpuId(range.substr(dash + 1), last) ||
+		           last < first) {
+			return false;
+		}
+		for (int32_t id = first; id <= last; id++) {
+			ids.emplace_back(id);
+		}
+		pos = end + 1;
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	return true;
+}
+
+bool GetThreadAffinity(int32_t tid, vector<int32_t> &cpus) {
+	cpus.clear();
+#ifdef __linux__
+	// Grow the set until it holds every possible CPU of the kernel.
+	for (idx_t cpu_count = 1024; cpu_count <= static_cast<idx_t>(MAX_CPU_ID) + 1; cpu_count *= 2) {
+		DynamicCpuSet cpu_set(cpu_count);
+		if (sched_getaffinity(tid, cpu_set.size, cpu_set.set) == 0) {
+			for (idx_t cpu = 0; cpu < cpu_count; cpu++) {
+				if (CPU_ISSET_S(cpu, cpu_set.size, cpu_set.set)) {
+					cpus.emplace_back(static_cast<int32_t>(cpu));
+				}
+			}
+			return true;
+		}
+		if (errno != EINVAL) {
+			break;
+		}
+	}
+	return false;
+#else
+	errno = ENOSYS;
+	return false;
+#endif
+}
+
+vector<int32_t> GetAllowedCpus() {
+	vector<int32_t> cpus;
+	if (GetThreadAffinity(0, cpus)) {
+		return cpus;
+	}
+	const auto cpu_count = static_cast<int32_t>(std::thread::hardware_concurrency());
+	for (int32_t cpu = 0; cpu < MaxValue<int32_t>(cpu_count, 1); cpu++) {
+		cpus.emplace_back(cpu);
+	}
+	return cpus;
+}
+
+vector<NumaNodeInfo> GetNumaNodes() {
+	const vector<int32_t> allowed_cpus = GetAllowedCpus();
+	vector<NumaNodeInfo> nodes;
+#ifdef __linux__
+	vector<int32_t> node_ids;
+	if (ReadCpuListFile(SYS_NODE_ONLINE, node_ids)) {
+		for (const auto node_id : node_ids) {
+			const string path = "/sys/devices/system/node/node" + std::to_string(node_id) + "/cpulist";
+			vector<int32_t> node_cpus;
+			if (!ReadCpuListFile(path.c_str(), node_cpus)) {
+				continue;
+			}
+			NumaNodeInfo node;
+			node.node = node_id;
+			std::set_intersection(node_cpus.begin(), node_cpus.end(), allowed_cpus.begin(), allowed_cpus.end(),
+			                      std::back_inserter(node.cpus));
+			// Memory-only nodes, i.e. CXL memory, and nodes outside of the cpuset are skipped.
+			if (!node.cpus.empty()) {
+				nodes.emplace_back(std::move(node));
+			}
+		}
+	}
+#endif
+	if (nodes.empty()) {
+		NumaNodeInfo node;
+		node.cpus = allowed_cpus;
+		nodes.emplace_back(std::move(node));
+	}
+	return nodes;
+}
+
+vector<CpuTopologyInfo> GetCpuTopology() {
+	vector<CpuTopologyInfo> cpus;
+	for (const auto &node : GetNumaNodes()) {
+		for (const auto cpu_id : node.cpus) {
+			CpuTopologyInfo cpu;
+			cpu.cpu = cpu_id;
+			cpu.node = node.node;
+			cpu.core = cpu_id;
+#ifdef __linux__
+			const string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu_id) + "/topology/";
+			// Architectures without sockets report a package id of -1.
+			if (!ReadTopologyId((dir + "physical_package_id").c_str(), cpu.package)) {
+				cpu.package = 0;
+			}
+			if (!ReadTopologyId((dir + "core_id").c_str(), cpu.core)) {
+				cpu.core = cpu_id;
+			}
+#endif
+			cpus.emplace_back(cpu);
+		}
+	}
+	std::sort(cpus.begin(), cpus.end(),
+	          [](const CpuTopologyInfo &lhs, const CpuTopologyInfo &rhs) { return lhs.cpu < rhs.cpu; });
+	return cpus;
+}
+
+bool SetThreadAffinity(int32_t tid, const vector<int32_t> &cpus) {
+#ifdef __linux__
+	if (cpus.empty()) {
+		errno = EINVAL;
+		return false;
+	}
+	DynamicCpuSet cpu_set(static_cast<idx_t>(*std::max_element(cpus.begin(), cpus.end())) + 1);
+	for (const auto cpu : cpus) {
+		CPU_SET_S(static_cast<size_t>(cpu), cpu_set.size, cpu_set.set);
+	}
+	return sched_setaffinity(tid, cpu_set.size, cpu_set.set) == 0;
+#else
+	errno = ENOSYS;
+	return false;
+#endif
+}
+
+} // namespace duckdb
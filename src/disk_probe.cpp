@@ -0,0 +1,256 @@
+#include "disk_probe.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "scope_guard.hpp"
+#include "time_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Nearest-rank percentile of the sorted [values].
+uint64_t GetPercentile(const vector<uint64_t> &values, idx_t percent) {
+	const idx_t rank = (values.size() * percent + 99) / 100;
+	return values[rank == 0 ? 0 : rank - 1];
+}
+
+#ifdef __linux__
+// Size of the writes filling the file for random reads.
+constexpr uint64_t FILL_CHUNK_SIZE = 1ULL << 20;
+
+// Distinguishes the probe files of concurrent probes of the same process.
+std::atomic<uint64_t> probe_file_counter {0};
+
+// Buffer aligned to the block size, as required by O_DIRECT. It is filled with random bytes, so filesystems which
+// compress or deduplicate data still write every block.
+struct AlignedBuffer {
+	explicit AlignedBuffer(uint64_t size) {
+		if (posix_memalign(&data, DISK_PROBE_BLOCK_SIZE, size) != 0) {
+			throw OutOfMemoryException("Failed to allocate %llu bytes for the disk probe", size);
+		}
+		std::mt19937_64 rng(std::random_device {}());
+		auto *words = static_cast<uint64_t *>(data);
+		for (uint64_t idx = 0; idx < size / sizeof(uint64_t); idx++) {
+			words[idx] = rng();
+		}
+	}
+	~AlignedBuffer() {
+		free(data);
+	}
+	AlignedBuffer(const AlignedBuffer &) = delete;
+	AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+	void *data = nullptr;
+};
+
+// Create the probe file in [path]. It is unlinked right away, so it is removed even if the process dies during the
+// probe, and only takes space while open.
+int OpenProbeFile(ClientContext &context, const string &path, uint64_t size_bytes, bool &direct_io) {
+	const string file_path = StringUtil::Format("%s/.system_stats_disk_probe_%d_%llu", path, getpid(),
+	                                            probe_file_counter.fetch_add(1));
+	const int fd = open(file_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+	if (fd == -1) {
+		throw IOException("Failed to create disk probe file '%s': %s", file_path, strerror(errno));
+	}
+	unlink(file_path.c_str());
+
+	struct statvfs stat;
+	if (fstatvfs(fd, &stat) == 0 && static_cast<uint64_t>(stat.f_bavail) * stat.f_frsize < size_bytes) {
+		close(fd);
+		throw InvalidInputException("Not enough free space under '%s' for a disk probe of %llu bytes", path,
+		                            size_bytes);
+	}
+
+	// Enabled after creating the file, since filesystems without direct I/O, i.e. tmpfs before Linux 6.6, fail open(2)
+	// only after the file was created.
+	direct_io = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_DIRECT) == 0;
+	if (!direct_io) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Direct I/O is not supported under %s, probing through the page cache: %s", path,
+			                 strerror(errno));
+		}
+	}
+	return fd;
+}
+
+void WriteBlocks(int fd, const AlignedBuffer &buffer, uint64_t size, uint64_t offset, const string &path) {
+	const ssize_t written = pwrite(fd, buffer.data, size, NumericCast<off_t>(offset));
+	if (written != static_cast<ssize_t>(size)) {
+		throw IOException("Failed to write disk probe file under '%s': %s", path,
+		                  written == -1 ? strerror(errno) : "short write");
+	}
+}
+
+void SyncFile(int fd, const string &path) {
+	if (fdatasync(fd) != 0) {
+		throw IOException("Failed to sync disk probe file under '%s': %s", path, strerror(errno));
+	}
+}
+
+// Fill the file, so random reads hit allocated blocks, and drop it from the page cache in case direct I/O is not
+// supported. Filling stops after the chunk which passes [deadline_ns]; without direct I/O every chunk is synced right
+// away, so at most one chunk is left to flush then. Return the bytes filled, a multiple of the block size.
+uint64_t FillProbeFile(int fd, uint64_t size_bytes, uint64_t deadline_ns, bool direct_io, const string &path) {
+	AlignedBuffer buffer(FILL_CHUNK_SIZE);
+	uint64_t filled = 0;
+	while (filled < size_bytes) {
+		const uint64_t chunk_size = MinValue(FILL_CHUNK_SIZE, size_bytes - filled);
+		WriteBlocks(fd, buffer, chunk_size, filled, path);
+		if (!direct_io) {
+			SyncFile(fd, path);
+		}
+		filled += chunk_size;
+		if (GetMonotonicTimestampNs() >= deadline_ns) {
+			break;
+		}
+	}
+	SyncFile(fd, path);
+	posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	return filled;
+}
+
+DiskProbeResult RunDiskProbeMode(ClientContext &context, const string &path, DiskProbeMode mode,
+                                 const DiskProbeOptions &options) {
+	DiskProbeResult result;
+	result.path = path;
+	result.mode = mode;
+	result.size_bytes = options.size_bytes / DISK_PROBE_BLOCK_SIZE * DISK_PROBE_BLOCK_SIZE;
+	if (result.size_bytes == 0) {
+		throw InvalidInputException("Size for sys_disk_probe must be at least %llu bytes", DISK_PROBE_BLOCK_SIZE);
+	}
+
+	// The time limit covers filling the file too; random reads are then spread over the part filled in time.
+	const uint64_t deadline_ns = GetMonotonicTimestampNs() + NumericCast<uint64_t>(options.max_duration_micros) * 1000;
+	const int fd = OpenProbeFile(context, path, result.size_bytes, result.direct_io);
+	SCOPE_EXIT {
+		close(fd);
+	};
+	if (mode == DiskProbeMode::RANDREAD) {
+		result.size_bytes = FillProbeFile(fd, result.size_bytes, deadline_ns, result.direct_io, path);
+	}
+	const uint64_t block_count = result.size_bytes / DISK_PROBE_BLOCK_SIZE;
+
+	AlignedBuffer buffer(DISK_PROBE_BLOCK_SIZE);
+	std::mt19937_64 rng(std::random_device {}());
+	vector<uint64_t> latencies_ns;
+	latencies_ns.reserve(options.iterations);
+
+	const uint64_t start_ns = GetMonotonicTimestampNs();
+	for (idx_t iteration = 0; iteration < options.iterations; iteration++) {
+		const uint64_t block = mode == DiskProbeMode::RANDREAD ? rng() % block_count : iteration % block_count;
+		const uint64_t offset = block * DISK_PROBE_BLOCK_SIZE;
+		const uint64_t op_start_ns = GetMonotonicTimestampNs();
+		if (mode == DiskProbeMode::RANDREAD) {
+			const ssize_t bytes_read = pread(fd, buffer.data, DISK_PROBE_BLOCK_SIZE, NumericCast<off_t>(offset));
+			if (bytes_read != static_cast<ssize_t>(DISK_PROBE_BLOCK_SIZE)) {
+				throw IOException("Failed to read disk probe file under '%s': %s", path,
+				                  bytes_read == -1 ? strerror(errno) : "short read");
+			}
+		} else {
+			WriteBlocks(fd, buffer, DISK_PROBE_BLOCK_SIZE, offset, path);
+			if (mode == DiskProbeMode::FSYNC) {
+				SyncFile(fd, path);
+			}
+		}
+		const uint64_t op_end_ns = GetMonotonicTimestampNs();
+		latencies_ns.emplace_back(op_end_ns - op_start_ns);
+		if (op_end_ns >= deadline_ns) {
+			break;
+		}
+	}
+
+	result.elapsed_ns = GetMonotonicTimestampNs() - start_ns;
+	result.iterations = latencies_ns.size();
+	result.latency = SummarizeLatencies(latencies_ns);
+	if (result.elapsed_ns > 0) {
+		result.iops = static_cast<double>(result.iterations) * 1e9 / static_cast<double>(result.elapsed_ns);
+		result.throughput_bytes_per_sec = result.iops * static_cast<double>(DISK_PROBE_BLOCK_SIZE);
+	}
+	return result;
+}
+#endif
+
+} // namespace
+
+vector<DiskProbeMode> ParseDiskProbeModes(const string &mode) {
+	const string lower = StringUtil::Lower(mode);
+	if (lower == "randread") {
+		return {DiskProbeMode::RANDREAD};
+	}
+	if (lower == "seqwrite") {
+		return {DiskProbeMode::SEQWRITE};
+	}
+	if (lower == "fsync") {
+		return {DiskProbeMode::FSYNC};
+	}
+	if (lower == "all") {
+		return {DiskProbeMode::RANDREAD, DiskProbeMode::SEQWRITE, DiskProbeMode::FSYNC};
+	}
+	throw InvalidInputException(
+	    "Unknown mode '%s' for sys_disk_probe, expected 'randread', 'seqwrite', 'fsync' or 'all'", mode);
+}
+
+const char *DiskProbeModeToString(DiskProbeMode mode) {
+	switch (mode) {
+	case DiskProbeMode::RANDREAD:
+		return "randread";
+	case DiskProbeMode::SEQWRITE:
+		return "seqwrite";
+	case DiskProbeMode::FSYNC:
+		return "fsync";
+	}
+	return "unknown";
+}
+
+LatencySummary SummarizeLatencies(vector<uint64_t> &latencies_ns) {
+	LatencySummary summary;
+	if (latencies_ns.empty()) {
+		return summary;
+	}
+	std::sort(latencies_ns.begin(), latencies_ns.end());
+	summary.p50_ns = GetPercentile(latencies_ns, 50);
+	summary.p99_ns = GetPercentile(latencies_ns, 99);
+	summary.max_ns = latencies_ns.back();
+	double total_ns = 0;
+	for (const auto latency_ns : latencies_ns) {
+		total_ns += static_cast<double>(latency_ns);
+	}
+	summary.mean_ns = total_ns / static_cast<double>(latencies_ns.size());
+	return summary;
+}
+
+vector<DiskProbeResult> RunDiskProbe(ClientContext &context, const string &path, const DiskProbeOptions &options) {
+	if (!DBConfig::GetConfig(context).options.enable_external_access) {
+		throw PermissionException("sys_disk_probe is disabled through configuration");
+	}
+#ifdef __linux__
+	vector<DiskProbeResult> results;
+	for (const auto mode : options.modes) {
+		results.emplace_back(RunDiskProbeMode(context, path, mode, options));
+	}
+	return results;
+#else
+	throw NotImplementedException("Disk probes are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,245 @@
+#include "disk_probe_query_function.hpp"
+
+#include "disk_probe.hpp"
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Default probe file size, large enough that random reads are not served by the cache of the device.
+constexpr int64_t DEFAULT_SIZE_BYTES = 64LL << 20;
+constexpr int64_t MAX_SIZE_BYTES = 1LL << 30;
+constexpr int64_t DEFAULT_ITERATIONS = 1000;
+constexpr int64_t MAX_ITERATIONS = 1000000;
+// Default time limit per mode.
+constexpr int64_t DEFAULT_MAX_DURATION_MICROS = 10 * Interval::MICROS_PER_SEC;
+
+Value NanosToMicros(double nanos) {
+	return Value::DOUBLE(nanos / 1000.0);
+}
+
+struct SysDiskProbeBindData : public FunctionData {
+	string path;
+	DiskProbeOptions options;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysDiskProbeBindData>();
+		return path == other.path && options.modes == other.options.modes &&
+		       options.size_bytes == other.options.size_bytes && options.iterations == other.options.iterations &&
+		       options.max_duration_micros == other.options.max_duration_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysDiskProbeBindData>();
+		result->path = path;
+		result->options = options;
+		return std::move(result);
+	}
+};
+
+struct SysDiskProbeData : public GlobalTableFunctionState {
+	SysDiskProbeData(ClientContext &context, const SysDiskProbeBindData &bind_data)
+	    : finished(false), current_index(0), results(RunDiskProbe(context, bind_data.path, bind_data.options)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<DiskProbeResult> results;
+};
+
+int64_t GetPositiveParameter(const Value &value, const char *name, int64_t max_value) {
+	const int64_t result = value.IsNull() ? 0 : value.GetValue<int64_t>();
+	if (result <= 0 || result > max_value) {
+		throw InvalidInputException("%s for sys_disk_probe must be between 1 and %lld, but got '%s'", name, max_value,
+		                            value.ToString());
+	}
+	return result;
+}
+
+unique_ptr<FunctionData> SysDiskProbeBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(14);
+	names.reserve(14);
+
+	auto result = make_uniq<SysDiskProbeBindData>();
+	result->options.modes = {DiskProbeMode::RANDREAD};
+	result->options.size_bytes = DEFAULT_SIZE_BYTES;
+	result->options.iterations = DEFAULT_ITERATIONS;
+	result->options.max_duration_micros = DEFAULT_MAX_DURATION_MICROS;
+
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("Path for sys_disk_probe cannot be NULL");
+	}
+	result->path = input.inputs[0].ToString();
+
+	// Parse mode parameter if provided
+	auto mode_it = input.named_parameters.find("mode");
+	if (mode_it != input.named_parameters.end()) {
+		if (mode_it->second.IsNull()) {
+			throw InvalidInputException("Mode for sys_disk_probe cannot be NULL");
+		}
+		result->options.modes = ParseDiskProbeModes(mode_it->second.ToString());
+	}
+
+	// Parse size parameter if provided
+	auto size_it = input.named_parameters.find("size");
+	if (size_it != input.named_parameters.end()) {
+		result->options.size_bytes =
+		    NumericCast<uint64_t>(GetPositiveParameter(size_it->second, "Size", MAX_SIZE_BYTES));
+	}
+
+	// Parse iterations parameter if provided
+	auto iterations_it = input.named_parameters.find("iterations");
+	if (iterations_it != input.named_parameters.end()) {
+		result->options.iterations =
+		    NumericCast<idx_t>(GetPositiveParameter(iterations_it->second, "Iterations", MAX_ITERATIONS));
+	}
+
+	// Parse max_duration parameter if provided
+	auto duration_it = input.named_parameters.find("max_duration");
+	if (duration_it != input.named_parameters.end()) {
+		if (duration_it->second.IsNull()) {
+			throw InvalidInputException("Max duration for sys_disk_probe cannot be NULL");
+		}
+		result->options.max_duration_micros = Interval::GetMicro(duration_it->second.GetValue<interval_t>());
+		if (result->options.max_duration_micros <= 0) {
+			throw InvalidInputException("Max duration for sys_disk_probe must be positive, but got '%s'",
+			                            duration_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("mode");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("direct_io");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("block_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("size_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("iterations");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("elapsed");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	names.emplace_back("p50_latency_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("p99_latency_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("max_latency_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("mean_latency_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("iops");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("throughput_bytes_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysDiskProbeInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysDiskProbeBindData>();
+	return make_uniq<SysDiskProbeData>(context, bind_data);
+}
+
+void SysDiskProbeFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysDiskProbeData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.results.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &result = data.results[data.current_index];
+		col_idx = 0;
+
+		// path
+		output.SetValue(col_idx++, output_count, Value(result.path));
+
+		// mode
+		output.SetValue(col_idx++, output_count, Value(DiskProbeModeToString(result.mode)));
+
+		// direct_io
+		output.SetValue(col_idx++, output_count, Value::BOOLEAN(result.direct_io));
+
+		// block_size
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(DISK_PROBE_BLOCK_SIZE));
+
+		// size_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(result.size_bytes));
+
+		// iterations
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(result.iterations));
+
+		// elapsed
+		output.SetValue(col_idx++, output_count,
+		                Value::INTERVAL(Interval::FromMicro(NumericCast<int64_t>(result.elapsed_ns / 1000))));
+
+		// p50_latency_us
+		output.SetValue(col_idx++, output_count, NanosToMicros(static_cast<double>(result.latency.p50_ns)));
+
+		// p99_latency_us
+		output.SetValue(col_idx++, output_count, NanosToMicros(static_cast<double>(result.latency.p99_ns)));
+
+		// max_latency_us
+		output.SetValue(col_idx++, output_count, NanosToMicros(static_cast<double>(result.latency.max_ns)));
+
+		// mean_latency_us
+		output.SetValue(col_idx++, output_count, NanosToMicros(result.latency.mean_ns));
+
+		// iops
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(result.iops));
+
+		// throughput_bytes_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(result.throughput_bytes_per_sec));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.results.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysDiskProbeFunction(ExtensionLoader &loader) {
+	TableFunction sys_disk_probe_func("sys_disk_probe", {LogicalType::VARCHAR}, SysDiskProbeFunc, SysDiskProbeBind,
+	                                  SysDiskProbeInit);
+	sys_disk_probe_func.named_parameters["mode"] = LogicalType::VARCHAR;
+	sys_disk_probe_func.named_parameters["size"] = LogicalType::BIGINT;
+	sys_disk_probe_func.named_parameters["iterations"] = LogicalType::BIGINT;
+	sys_disk_probe_func.named_parameters["max_duration"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_disk_probe_func);
+}
+
+} // namespace duckdb
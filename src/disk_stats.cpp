@@ -10,12 +10,14 @@
 #include "duckdb/common/types.hpp"
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "mount_filter.hpp"
+#include "mount_index.hpp"
+#include "mount_info.hpp"
+
 #include <cstring>
-#include <regex>
 
 #ifdef __linux__
 #include <cerrno>
-#include <mntent.h>
 #include <sys/statvfs.h>
 #elif __APPLE__
 #include <cerrno>
@@ -27,90 +29,77 @@ namespace duckdb {
 
 namespace {
 
-// Regex patterns to ignore virtual filesystem types
-constexpr const char *IGNORE_FILE_SYSTEM_TYPE_REGEX =
-    "^(autofs|binfmt_misc|bpf|cgroup2?|configfs|debugfs|devpts|devtmpfs|fusectl|hugetlbfs|iso9660|mqueue|nsfs|overlay|"
-    "proc|procfs|pstore|rpc_pipefs|securityfs|selinuxfs|squashfs|sysfs|tracefs)$";
-constexpr const char *IGNORE_MOUNT_POINTS_REGEX = "^/(dev|proc|sys|run|snap|var/lib/docker/.+)($|/)";
-
-bool IgnoreFileSystemType(const string &fs_type) {
-	static const std::regex pattern(IGNORE_FILE_SYSTEM_TYPE_REGEX, std::regex_constants::extended);
-	try {
-		return std::regex_match(fs_type, pattern);
-	} catch (const std::regex_error &) {
-		return false;
-	}
-}
+#ifdef __linux__
 
-bool IgnoreMountPoint(const string &mount_point) {
-	static const std::regex pattern(IGNORE_MOUNT_POINTS_REGEX, std::regex_constants::extended);
-	try {
-		return std::regex_match(mount_point, pattern);
-	} catch (const std::regex_error &) {
-		return false;
-	}
+// Fill capacity, inode usage and flags from statvfs result.
+void FillDiskUsage(const struct statvfs &buf, DiskInfo &info) {
+	info.total_space = NumericCast<uint64_t>(buf.f_blocks * buf.f_bsize);
+	info.used_space = NumericCast<uint64_t>((buf.f_blocks - buf.f_bfree) * buf.f_bsize);
+	info.free_space = NumericCast<uint64_t>(buf.f_bavail * buf.f_bsize);
+	info.total_inodes = NumericCast<uint64_t>(buf.f_files);
+	info.used_inodes = NumericCast<uint64_t>(buf.f_files - buf.f_ffree);
+	info.free_inodes = NumericCast<uint64_t>(buf.f_favail);
+	info.block_size = NumericCast<uint64_t>(buf.f_bsize);
+	info.read_only = (buf.f_flag & ST_RDONLY) != 0;
+	info.no_exec = (buf.f_flag & ST_NOEXEC) != 0;
 }
 
-#ifdef __linux__
-
 vector<DiskInfo> GetDiskInfoLinux(ClientContext &context) {
 	vector<DiskInfo> disks;
 
-	FILE *fp = setmntent("/etc/mtab", "r");
-	if (!fp) {
-		// Fallback to /proc/mounts if /etc/mtab doesn't exist
-		fp = setmntent("/proc/mounts", "r");
-	}
+	// Parsed, filtered and deduplicated mount table, only rebuilt when mounts change.
+	const MountSnapshot mounts = GetFilteredMounts(context);
 
-	if (!fp) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "Failed to open /etc/mtab and /proc/mounts: %s", strerror(errno));
-		}
-		return disks;
-	}
-
-	struct mntent *ent = nullptr;
 	struct statvfs buf;
-
-	while ((ent = getmntent(fp)) != NULL) {
-		string fs_type = ent->mnt_type;
-		string mount_point = ent->mnt_dir;
-
-		// Skip ignored filesystem types and mount points
-		if (IgnoreFileSystemType(fs_type) || IgnoreMountPoint(mount_point)) {
-			continue;
-		}
-
+	for (const auto &mount : *mounts) {
 		memset(&buf, 0, sizeof(buf));
-		if (statvfs(mount_point.c_str(), &buf) != 0) {
+		if (statvfs(mount.mount_point.c_str(), &buf) != 0) {
 			if (auto db = GetDbInstance(context)) {
-				DUCKDB_LOG_DEBUG(*db, "statvfs() failed for %s: %s", mount_point.c_str(), strerror(errno));
+				DUCKDB_LOG_DEBUG(*db, "statvfs() failed for %s: %s", mount.mount_point.c_str(), strerror(errno));
 			}
 			continue;
 		}
 
-		uint64_t total_space = NumericCast<uint64_t>(buf.f_blocks * buf.f_bsize);
-		if (total_space == 0) {
+		if (buf.f_blocks * buf.f_bsize == 0) {
 			continue;
 		}
 
 		DiskInfo info;
-		info.mount_point = mount_point;
-		info.file_system = ent->mnt_fsname;
-		info.file_system_type = fs_type;
-		info.total_space = total_space;
-		info.used_space = NumericCast<uint64_t>((buf.f_blocks - buf.f_bfree) * buf.f_bsize);
-		info.free_space = NumericCast<uint64_t>(buf.f_bavail * buf.f_bsize);
-
-		disks.emplace_back(info);
+		FillDiskUsage(buf, info);
+		info.mount_point = mount.mount_point;
+		info.file_system = mount.source;
+		info.file_system_type = mount.file_system_type;
+		info.mount_options = mount.mount_options;
+		info.mount_id = mount.mount_id;
+		info.device = StringUtil::Format("%u:%u", mount.major, mount.minor);
+		info.propagation = mount.propagation;
+
+		disks.emplace_back(std::move(info));
 	}
 
-	endmntent(fp);
 	return disks;
 }
 #endif
 
 #ifdef __APPLE__
+// Build mount options from statfs flags, in the same format as on Linux.
+string GetMountOptionsMacOS(uint32_t flags) {
+	string options = (flags & MNT_RDONLY) ? "ro" : "rw";
+	if (flags & MNT_NOSUID) {
+		options += ",nosuid";
+	}
+	if (flags & MNT_NODEV) {
+		options += ",nodev";
+	}
+	if (flags & MNT_NOEXEC) {
+		options += ",noexec";
+	}
+	if (flags & MNT_NOATIME) {
+		options += ",noatime";
+	}
+	return options;
+}
+
 vector<DiskInfo> GetDiskInfoMacOS(ClientContext &context) {
 	vector<DiskInfo> disks;
 
@@ -123,14 +112,15 @@ vector<DiskInfo> GetDiskInfoMacOS(ClientContext &context) {
 		return disks;
 	}
 
+	const MountFilter filter = GetMountFilter(context);
 	for (idx_t idx = 0; idx < count; idx++) {
-		string fs_type = mntbuf[idx].f_fstypename;
-		string mount_point = mntbuf[idx].f_mntonname;
-
 		// Skip ignored filesystem types and mount points
-		if (IgnoreFileSystemType(fs_type) || IgnoreMountPoint(mount_point)) {
+		if (filter.IgnoreFileSystemType(mntbuf[idx].f_fstypename) ||
+		    filter.IgnoreMountPoint(mntbuf[idx].f_mntonname)) {
 			continue;
 		}
+		string fs_type = mntbuf[idx].f_fstypename;
+		string mount_point = mntbuf[idx].f_mntonname;
 
 		struct statvfs buf;
 		if (statvfs(mount_point.c_str(), &buf) != 0) {
@@ -152,6 +142,13 @@ vector<DiskInfo> GetDiskInfoMacOS(ClientContext &context) {
 		info.total_space = total_space;
 		info.used_space = NumericCast<uint64_t>((buf.f_blocks - buf.f_bfree) * buf.f_bsize);
 		info.free_space = NumericCast<uint64_t>(buf.f_bavail * buf.f_bsize);
+		info.total_inodes = NumericCast<uint64_t>(buf.f_files);
+		info.used_inodes = NumericCast<uint64_t>(buf.f_files - buf.f_ffree);
+		info.free_inodes = NumericCast<uint64_t>(buf.f_favail);
+		info.block_size = NumericCast<uint64_t>(buf.f_bsize);
+		info.read_only = (mntbuf[idx].f_flags & MNT_RDONLY) != 0;
+		info.no_exec = (mntbuf[idx].f_flags & MNT_NOEXEC) != 0;
+		info.mount_options = GetMountOptionsMacOS(mntbuf[idx].f_flags);
 
 		disks.emplace_back(info);
 	}
@@ -38,8 +38,8 @@ unique_ptr<FunctionData> SysDiskInfoBind(ClientContext &context, TableFunctionBi
                                          vector<LogicalType> &return_types, vector<string> &names) {
 	D_ASSERT(return_types.empty());
 	D_ASSERT(names.empty());
-	return_types.reserve(6);
-	names.reserve(6);
+	return_types.reserve(16);
+	names.reserve(16);
 
 	auto result = make_uniq<SysDiskInfoBindData>();
 
@@ -67,6 +67,36 @@ unique_ptr<FunctionData> SysDiskInfoBind(ClientContext &context, TableFunctionBi
 	names.emplace_back("free_space");
 	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
 
+	names.emplace_back("total_inodes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("used_inodes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("free_inodes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("block_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("read_only");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("no_exec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("mount_options");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("mount_id");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("device");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("propagation");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
 	return std::move(result);
 }
 
@@ -109,6 +139,36 @@ void SysDiskInfoFunc(ClientContext &context, TableFunctionInput &data_p, DataChu
 		// free_space
 		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(info.free_space, bind_data.unit)));
 
+		// total_inodes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(info.total_inodes));
+
+		// used_inodes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(info.used_inodes));
+
+		// free_inodes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(info.free_inodes));
+
+		// block_size
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(info.block_size));
+
+		// read_only
+		output.SetValue(col_idx++, output_count, Value::BOOLEAN(info.read_only));
+
+		// no_exec
+		output.SetValue(col_idx++, output_count, Value::BOOLEAN(info.no_exec));
+
+		// mount_options
+		output.SetValue(col_idx++, output_count, Value(info.mount_options));
+
+		// mount_id
+		output.SetValue(col_idx++, output_count, Value::INTEGER(info.mount_id));
+
+		// device
+		output.SetValue(col_idx++, output_count, Value(info.device));
+
+		// propagation
+		output.SetValue(col_idx++, output_count, Value(info.propagation));
+
 		data.current_index++;
 		output_count++;
 	}
@@ -0,0 +1,128 @@
+#include "duckdb_resources.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/enum_util.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "proc_tokenizer.hpp"
+#include "scope_guard.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#elif __APPLE__
+#include <mach/mach.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifdef __linux__
+bool GetProcessMemoryUsage(ClientContext &context, ProcessMemoryUsage &usage) {
+	int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open /proc/self/statm: %s", strerror(errno));
+		}
+		return false;
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	char buf[256];
+	ssize_t bytes_read = read(fd, buf, sizeof(buf));
+	if (bytes_read <= 0) {
+		return false;
+	}
+	return ParseStatm(std::string_view {buf, static_cast<size_t>(bytes_read)},
+	                  static_cast<uint64_t>(sysconf(_SC_PAGESIZE)), usage);
+}
+#elif __APPLE__
+bool GetProcessMemoryUsage(ClientContext &context, ProcessMemoryUsage &usage) {
+	mach_task_basic_info_data_t task_info_data;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	kern_return_t ret =
+	    task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&task_info_data), &count);
+	if (ret != KERN_SUCCESS) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "task_info() failed with error code: %d", ret);
+		}
+		return false;
+	}
+	usage.virtual_bytes = task_info_data.virtual_size;
+	usage.rss_bytes = task_info_data.resident_size;
+	// Not reported by mach.
+	usage.shared_bytes = 0;
+	return true;
+}
+#else
+bool GetProcessMemoryUsage(ClientContext &context, ProcessMemoryUsage &usage) {
+	return false;
+}
+#endif
+
+} // namespace
+
+bool ParseStatm(std::string_view content, uint64_t page_size, ProcessMemoryUsage &usage) {
+	// Format: size resident shared text lib data dt, in pages.
+	size_t pos = 0;
+	std::string_view token;
+	uint64_t pages = 0;
+	if (!NextToken(content, pos, token) || !ParseUint64(token, pages)) {
+		return false;
+	}
+	usage.virtual_bytes = pages * page_size;
+	if (!NextToken(content, pos, token) || !ParseUint64(token, pages)) {
+		return false;
+	}
+	usage.rss_bytes = pages * page_size;
+	if (!NextToken(content, pos, token) || !ParseUint64(token, pages)) {
+		return false;
+	}
+	usage.shared_bytes = pages * page_size;
+	return true;
+}
+
+DuckDBResources GetDuckDBResources(ClientContext &context) {
+	auto db = GetDbInstance(context);
+	auto &buffer_manager = BufferManager::GetBufferManager(*db);
+	auto &scheduler = TaskScheduler::GetScheduler(*db);
+
+	DuckDBResources resources;
+
+	// Collect the per-tag breakdown and temporary files first, so buffer manager totals and process memory below are
+	// taken as close together as possible.
+	for (const auto &info : buffer_manager.GetMemoryUsageInfo()) {
+		MemoryTagUsage usage;
+		usage.tag = EnumUtil::ToString(info.tag);
+		usage.memory_bytes = info.size;
+		usage.evicted_bytes = info.evicted_data;
+		resources.memory_by_tag.emplace_back(std::move(usage));
+	}
+	resources.temp_directory = buffer_manager.GetTemporaryDirectory();
+	resources.temp_file_count = buffer_manager.GetTemporaryFiles().size();
+	resources.active_tasks = scheduler.GetNumberOfTasks();
+	resources.scheduler_threads = scheduler.NumberOfThreads();
+
+	resources.buffer_manager_used = buffer_manager.GetUsedMemory();
+	resources.buffer_manager_limit = buffer_manager.GetMaxMemory();
+	resources.temp_storage_used = buffer_manager.GetUsedSwap();
+	auto max_swap = buffer_manager.GetMaxSwap();
+	if (max_swap.IsValid()) {
+		resources.has_temp_storage_limit = true;
+		resources.temp_storage_limit = max_swap.GetIndex();
+	}
+	resources.has_process_memory = GetProcessMemoryUsage(context, resources.process_memory);
+
+	return resources;
+}
+
+} // namespace duckdb
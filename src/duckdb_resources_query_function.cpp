@@ -0,0 +1,176 @@
+#include "duckdb_resources_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb_resources.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// LIST(STRUCT(tag VARCHAR, memory UBIGINT, evicted UBIGINT))
+LogicalType GetMemoryTagStructType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("tag", LogicalType {LogicalTypeId::VARCHAR});
+	children.emplace_back("memory", LogicalType {LogicalTypeId::UBIGINT});
+	children.emplace_back("evicted", LogicalType {LogicalTypeId::UBIGINT});
+	return LogicalType::STRUCT(std::move(children));
+}
+
+LogicalType GetMemoryTagListType() {
+	return LogicalType::LIST(GetMemoryTagStructType());
+}
+
+Value GetMemoryTagListValue(const vector<MemoryTagUsage> &memory_by_tag) {
+	vector<Value> tag_values;
+	tag_values.reserve(memory_by_tag.size());
+	for (const auto &usage : memory_by_tag) {
+		child_list_t<Value> children;
+		children.emplace_back("tag", Value(usage.tag));
+		children.emplace_back("memory", Value::UBIGINT(usage.memory_bytes));
+		children.emplace_back("evicted", Value::UBIGINT(usage.evicted_bytes));
+		tag_values.emplace_back(Value::STRUCT(std::move(children)));
+	}
+	return Value::LIST(GetMemoryTagStructType(), std::move(tag_values));
+}
+
+struct SysDuckDBResourcesData : public GlobalTableFunctionState {
+	SysDuckDBResourcesData() : finished(false) {
+	}
+	bool finished;
+};
+
+unique_ptr<FunctionData> SysDuckDBResourcesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(13);
+	names.reserve(13);
+
+	names.emplace_back("buffer_manager_used");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("buffer_manager_limit");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("memory_by_tag");
+	return_types.emplace_back(GetMemoryTagListType());
+
+	names.emplace_back("temp_directory");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("temp_storage_used");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("temp_storage_limit");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("temp_file_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("active_tasks");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("scheduler_threads");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("process_rss");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("process_virtual");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("process_shared");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("untracked_memory");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysDuckDBResourcesInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysDuckDBResourcesData>();
+}
+
+void SysDuckDBResourcesFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysDuckDBResourcesData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	DuckDBResources resources = GetDuckDBResources(context);
+	const auto &process_memory = resources.process_memory;
+
+	idx_t col_idx = 0;
+
+	// buffer_manager_used
+	output.SetValue(col_idx++, 0, Value::UBIGINT(resources.buffer_manager_used));
+
+	// buffer_manager_limit
+	output.SetValue(col_idx++, 0, Value::UBIGINT(resources.buffer_manager_limit));
+
+	// memory_by_tag
+	output.SetValue(col_idx++, 0, GetMemoryTagListValue(resources.memory_by_tag));
+
+	// temp_directory, NULL if spilling is disabled
+	output.SetValue(col_idx++, 0,
+	                resources.temp_directory.empty() ? Value(LogicalType::VARCHAR) : Value(resources.temp_directory));
+
+	// temp_storage_used
+	output.SetValue(col_idx++, 0, Value::UBIGINT(resources.temp_storage_used));
+
+	// temp_storage_limit, NULL if unlimited
+	output.SetValue(col_idx++, 0,
+	                resources.has_temp_storage_limit ? Value::UBIGINT(resources.temp_storage_limit)
+	                                                 : Value(LogicalType::UBIGINT));
+
+	// temp_file_count
+	output.SetValue(col_idx++, 0, Value::UBIGINT(resources.temp_file_count));
+
+	// active_tasks
+	output.SetValue(col_idx++, 0, Value::UBIGINT(resources.active_tasks));
+
+	// scheduler_threads
+	output.SetValue(col_idx++, 0, Value::INTEGER(resources.scheduler_threads));
+
+	// process_rss, NULL if not available
+	output.SetValue(col_idx++, 0,
+	                resources.has_process_memory ? Value::UBIGINT(process_memory.rss_bytes)
+	                                             : Value(LogicalType::UBIGINT));
+
+	// process_virtual, NULL if not available
+	output.SetValue(col_idx++, 0,
+	                resources.has_process_memory ? Value::UBIGINT(process_memory.virtual_bytes)
+	                                             : Value(LogicalType::UBIGINT));
+
+	// process_shared, NULL if not available
+	output.SetValue(col_idx++, 0,
+	                resources.has_process_memory ? Value::UBIGINT(process_memory.shared_bytes)
+	                                             : Value(LogicalType::UBIGINT));
+
+	// untracked_memory, resident memory not accounted by the buffer manager (i.e. allocator overhead and
+	// fragmentation); negative if buffer manager memory has been swapped out by the OS
+	output.SetValue(col_idx++, 0,
+	                resources.has_process_memory
+	                    ? Value::BIGINT(static_cast<int64_t>(process_memory.rss_bytes) -
+	                                    static_cast<int64_t>(resources.buffer_manager_used))
+	                    : Value(LogicalType::BIGINT));
+
+	output.SetCardinality(1);
+	data.finished = true;
+}
+
+} // namespace
+
+void RegisterSysDuckDBResourcesFunction(ExtensionLoader &loader) {
+	TableFunction sys_duckdb_resources_func("sys_duckdb_resources", {}, SysDuckDBResourcesFunc, SysDuckDBResourcesBind,
+	                                        SysDuckDBResourcesInit);
+	loader.RegisterFunction(sys_duckdb_resources_func);
+}
+
+} // namespace duckdb
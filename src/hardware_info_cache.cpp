@@ -0,0 +1,90 @@
+#include "hardware_info_cache.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifdef __linux__
+constexpr const char *ONLINE_CPUS_PATH = "/sys/devices/system/cpu/online";
+#endif
+
+} // namespace
+
+string ReadOnlineCPUs() {
+#ifdef __linux__
+	// Read with plain syscalls, this is checked on every call and has to be cheap.
+	const int fd = open(ONLINE_CPUS_PATH, O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return "";
+	}
+	char buf[4096];
+	ssize_t bytes_read = 0;
+	do {
+		bytes_read = read(fd, buf, sizeof(buf));
+	} while (bytes_read < 0 && errno == EINTR);
+	close(fd);
+	if (bytes_read <= 0) {
+		return "";
+	}
+	return string {buf, static_cast<size_t>(bytes_read)};
+#else
+	return "";
+#endif
+}
+
+HardwareInfoCacheEntry::HardwareInfoCacheEntry() : cpu_info_valid(false), os_info_valid(false) {
+}
+
+string HardwareInfoCacheEntry::ObjectType() {
+	return "system_stats_hardware_info_cache";
+}
+
+string HardwareInfoCacheEntry::GetObjectType() {
+	return ObjectType();
+}
+
+string HardwareInfoCacheEntry::ReadOnlineCPUs() {
+	return duckdb::ReadOnlineCPUs();
+}
+
+CPUInfo HardwareInfoCacheEntry::CollectCPUInfo(ClientContext &context) {
+	return duckdb::CollectCPUInfo(context);
+}
+
+CPUInfo HardwareInfoCacheEntry::GetCPUInfo(ClientContext &context) {
+	string current_online_cpus = ReadOnlineCPUs();
+	lock_guard<mutex> lock(mu);
+	if (!cpu_info_valid || current_online_cpus != online_cpus) {
+		cpu_info = CollectCPUInfo(context);
+		online_cpus = std::move(current_online_cpus);
+		cpu_info_valid = true;
+	}
+	return cpu_info;
+}
+
+OSInfo HardwareInfoCacheEntry::GetStaticOSInfo(ClientContext &context) {
+	lock_guard<mutex> lock(mu);
+	if (!os_info_valid) {
+		os_info = CollectOSInfo(context, OS_INFO_STATIC_FIELDS);
+		os_info_valid = true;
+	}
+	return os_info;
+}
+
+shared_ptr<HardwareInfoCacheEntry> GetHardwareInfoCache(ClientContext &context) {
+	auto &cache = context.db->GetObjectCache();
+	return cache.GetOrCreate<HardwareInfoCacheEntry>(HardwareInfoCacheEntry::ObjectType());
+}
+
+} // namespace duckdb
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// One block device of /sys/class/block, including partitions and device mapper, md and loop devices.
+struct BlockDeviceInfo {
+	string name;
+	// Device id ("major:minor"), the same as sys_disk_info().device of filesystems stored directly on the device.
+	string device;
+	// "disk", "partition", "dm", "md" or "loop".
+	string type;
+	// Disk of a partition, empty otherwise.
+	string parent;
+	// Devices a dm or md device is built on, i.e. partitions of the mirrored disks; empty otherwise.
+	vector<string> slaves;
+	// Whether the device is backed by hardware, i.e. has a /sys/class/block/[name]/device link; only set for disks.
+	bool has_hardware = false;
+	// Whole hardware disks the device is stored on, resolved through partitions and slaves.
+	vector<string> physical_devices;
+	// "nvme", "ssd" or "hdd" for the physical devices, "mixed" if they differ, or "virtual" if there are none.
+	string device_class;
+	uint64_t size_bytes = 0;
+	// Request queue limits; partitions report those of their disk.
+	bool rotational = false;
+	uint64_t logical_block_size = 0;
+	uint64_t physical_block_size = 0;
+	uint64_t nr_requests = 0;
+	uint64_t max_sectors_kb = 0;
+	uint64_t read_ahead_kb = 0;
+	// Active I/O scheduler, i.e. "mq-deadline" or "none"; empty for devices without a scheduler, i.e. dm and zram.
+	string scheduler;
+	// NUMA node of the controller, -1 if unknown or the host is not NUMA.
+	int32_t numa_node = -1;
+	// Hardware identity, empty if not reported by the driver.
+	string model;
+	string serial;
+};
+
+// Parse the active scheduler from queue/scheduler, i.e. "mq-deadline" for "none [mq-deadline] kyber bfq".
+string ParseActiveScheduler(std::string_view line);
+
+// Fill physical_devices and device_class of [devices], and copy the queue limits and hardware identity of each disk to
+// its partitions.
+void ResolveBlockDevices(vector<BlockDeviceInfo> &devices);
+
+// Get block devices for the current platform; devices of size 0, i.e. unused loop devices, are skipped.
+vector<BlockDeviceInfo> GetBlockDevices(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_block_devices table function
+void RegisterSysBlockDevicesFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -27,7 +27,10 @@ struct CPUInfo {
 	string byte_order;
 };
 
-// Get CPU information for the current platform
+// Get CPU information for the current platform, cached per database instance and only re-collected after CPU hotplug.
 CPUInfo GetCPUInfo(ClientContext &context);
 
+// Collect CPU information for the current platform, bypassing the cache.
+CPUInfo CollectCPUInfo(ClientContext &context);
+
 } // namespace duckdb
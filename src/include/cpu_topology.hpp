@@ -0,0 +1,49 @@
+#pragma once
+
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Online CPUs of one NUMA node which the process may run on.
+struct NumaNodeInfo {
+	int32_t node = 0;
+	// Ascending.
+	vector<int32_t> cpus;
+};
+
+// Position of one online CPU in the topology of the host.
+struct CpuTopologyInfo {
+	int32_t cpu = 0;
+	int32_t node = 0;
+	// Socket of the CPU.
+	int32_t package = 0;
+	// Physical core within the package; hardware threads of one core share it.
+	int32_t core = 0;
+};
+
+// Parse a kernel CPU or node list, i.e. "0-3,8,10-11" of /sys/devices/system/cpu/online, into [ids] in ascending
+// order without duplicates; an empty list is valid. Return false if malformed or an id is out of range.
+bool ParseCpuList(std::string_view text, vector<int32_t> &ids);
+
+// Get the CPUs the thread [tid], or the calling thread if 0, may run on into [cpus] in ascending order; return false
+// and set errno on failure.
+bool GetThreadAffinity(int32_t tid, vector<int32_t> &cpus);
+
+// Get the CPUs the calling thread may run on, i.e. restricted by a cgroup cpuset or taskset; ascending.
+vector<int32_t> GetAllowedCpus();
+
+// Get the NUMA nodes with at least one CPU the calling thread may run on. Hosts without NUMA, and platforms other
+// than Linux, report a single node 0.
+vector<NumaNodeInfo> GetNumaNodes();
+
+// Get the node, package and core of every CPU the calling thread may run on, ordered by CPU id. Hosts without
+// topology information in sysfs report one package with one core per CPU.
+vector<CpuTopologyInfo> GetCpuTopology();
+
+// Restrict the thread [tid], or the calling thread if 0, to [cpus]; return false and set errno on failure.
+bool SetThreadAffinity(int32_t tid, const vector<int32_t> &cpus);
+
+} // namespace duckdb
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+enum class DiskProbeMode : uint8_t {
+	// Random reads of one block each from a file filled beforehand.
+	RANDREAD,
+	// Sequential writes of one block each, wrapping around at the file size.
+	SEQWRITE,
+	// Sequential writes of one block each followed by fdatasync(2), like appending to a write-ahead log.
+	FSYNC,
+};
+
+// Every mode reads or writes 4 KiB per operation, the page size and the physical block size of most devices.
+constexpr uint64_t DISK_PROBE_BLOCK_SIZE = 4096;
+
+struct DiskProbeOptions {
+	vector<DiskProbeMode> modes;
+	// Size of the probe file, rounded down to whole blocks.
+	uint64_t size_bytes = 0;
+	// Operations per mode.
+	idx_t iterations = 0;
+	// Max time per mode including filling the file, so a degraded disk cannot stall the query; fewer operations are
+	// done when exceeded, and random reads cover only the part of the file filled in time.
+	int64_t max_duration_micros = 0;
+};
+
+// Latency distribution of the operations of one mode, in nanoseconds.
+struct LatencySummary {
+	uint64_t p50_ns = 0;
+	uint64_t p99_ns = 0;
+	uint64_t max_ns = 0;
+	double mean_ns = 0;
+};
+
+struct DiskProbeResult {
+	string path;
+	DiskProbeMode mode = DiskProbeMode::RANDREAD;
+	// Whether the page cache was bypassed with O_DIRECT, which not all filesystems support.
+	bool direct_io = false;
+	// Bytes the operations were spread over, less than requested for random reads if filling hit the time limit.
+	uint64_t size_bytes = 0;
+	// Operations done, less than requested if the time limit was hit.
+	idx_t iterations = 0;
+	uint64_t elapsed_ns = 0;
+	LatencySummary latency;
+	double iops = 0;
+	double throughput_bytes_per_sec = 0;
+};
+
+// Parse a mode name, "all" selects every mode; throws InvalidInputException for unknown names.
+vector<DiskProbeMode> ParseDiskProbeModes(const string &mode);
+
+const char *DiskProbeModeToString(DiskProbeMode mode);
+
+// Summarize the latencies of [latencies_ns], which are sorted in place; nearest-rank percentiles.
+LatencySummary SummarizeLatencies(vector<uint64_t> &latencies_ns);
+
+// Run the probes of [options] against an unlinked temporary file in the directory [path] for the current platform.
+vector<DiskProbeResult> RunDiskProbe(ClientContext &context, const string &path, const DiskProbeOptions &options);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_disk_probe table function
+void RegisterSysDiskProbeFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -16,6 +16,20 @@ struct DiskInfo {
 	uint64_t total_space = 0;
 	uint64_t used_space = 0;
 	uint64_t free_space = 0;
+	uint64_t total_inodes = 0;
+	uint64_t used_inodes = 0;
+	// Inodes available to unprivileged users.
+	uint64_t free_inodes = 0;
+	uint64_t block_size = 0;
+	bool read_only = false;
+	bool no_exec = false;
+	// Per-mount options, i.e. "rw,nosuid,noatime".
+	string mount_options;
+	// Mount ID and device id ("major:minor") from /proc/self/mountinfo, unavailable on macOS.
+	int32_t mount_id = 0;
+	string device;
+	// Mount propagation, i.e. "shared:1 master:2", unavailable on macOS.
+	string propagation;
 };
 
 // Get disk information for the current platform
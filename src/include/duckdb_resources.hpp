@@ -0,0 +1,54 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Memory usage of one buffer manager memory tag, i.e. "HASH_TABLE".
+struct MemoryTagUsage {
+	string tag;
+	uint64_t memory_bytes = 0;
+	// Bytes of this tag evicted to temporary storage.
+	uint64_t evicted_bytes = 0;
+};
+
+// Process memory usage from /proc/self/statm, in bytes.
+struct ProcessMemoryUsage {
+	uint64_t virtual_bytes = 0;
+	uint64_t rss_bytes = 0;
+	// Resident pages backed by a file or shared memory.
+	uint64_t shared_bytes = 0;
+};
+
+struct DuckDBResources {
+	uint64_t buffer_manager_used = 0;
+	uint64_t buffer_manager_limit = 0;
+	// Bytes written to temporary storage; [has_temp_storage_limit] is false if unlimited.
+	uint64_t temp_storage_used = 0;
+	bool has_temp_storage_limit = false;
+	uint64_t temp_storage_limit = 0;
+	string temp_directory;
+	uint64_t temp_file_count = 0;
+	vector<MemoryTagUsage> memory_by_tag;
+	// Tasks queued in the task scheduler.
+	uint64_t active_tasks = 0;
+	int32_t scheduler_threads = 0;
+	// Process memory, only valid when [has_process_memory] is true.
+	bool has_process_memory = false;
+	ProcessMemoryUsage process_memory;
+};
+
+// Parse the content of /proc/[pid]/statm, which is in pages of [page_size] bytes.
+bool ParseStatm(std::string_view content, uint64_t page_size, ProcessMemoryUsage &usage);
+
+// Get DuckDB resource usage along with process memory usage, collected back to back so they can be compared.
+DuckDBResources GetDuckDBResources(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_duckdb_resources table function
+void RegisterSysDuckDBResourcesFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "cpu_stats.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "os_info.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// OSInfo fields which never change while the process runs.
+constexpr OSInfoFields OS_INFO_STATIC_FIELDS = OS_INFO_NAME | OS_INFO_VERSION | OS_INFO_ARCHITECTURE;
+
+// ObjectCacheEntry that keeps hardware and OS facts which are immutable while the process runs, i.e. the CPU model,
+// cache sizes and the OS name from /etc/os-release, so they are not re-parsed on every call.
+// CPU information is re-collected when /sys/devices/system/cpu/online changes, since CPU hotplug changes the
+// processor counts; OS facts are collected once.
+class HardwareInfoCacheEntry : public ObjectCacheEntry {
+public:
+	HardwareInfoCacheEntry();
+
+	static string ObjectType();
+
+	string GetObjectType() override;
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise /proc/cpuinfo has to be parsed again.
+		return optional_idx {};
+	}
+
+	CPUInfo GetCPUInfo(ClientContext &context);
+
+	// Get the OS_INFO_STATIC_FIELDS of OSInfo.
+	OSInfo GetStaticOSInfo(ClientContext &context);
+
+protected:
+	// Read the list of online CPUs, which is compared on every call. Virtual, so tests can simulate CPU hotplug.
+	virtual string ReadOnlineCPUs();
+	// Collect CPU information when the cached one is missing or stale. Virtual, so tests can count the rebuilds.
+	virtual CPUInfo CollectCPUInfo(ClientContext &context);
+
+private:
+	mutex mu;
+	bool cpu_info_valid;
+	// Content of /sys/devices/system/cpu/online when [cpu_info] was collected, i.e. "0-191".
+	string online_cpus;
+	CPUInfo cpu_info;
+	bool os_info_valid;
+	OSInfo os_info;
+};
+
+// Read the list of online CPUs, i.e. "0-3,5"; empty if not available (i.e. on macOS, which has no CPU hotplug).
+string ReadOnlineCPUs();
+
+// Get the hardware info cache of the database instance.
+shared_ptr<HardwareInfoCacheEntry> GetHardwareInfoCache(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+enum class InterruptType : uint8_t {
+	// Hardware and architecture specific interrupts of /proc/interrupts.
+	HARDIRQ,
+	// Software interrupts of /proc/softirqs.
+	SOFTIRQ,
+};
+
+// One line of /proc/interrupts or /proc/softirqs.
+struct InterruptSource {
+	// IRQ number or name, i.e. "24", "LOC" or "NET_RX".
+	string irq;
+	// Text after the counts with runs of spaces collapsed, i.e. "IO-APIC 4-edge ttyS0"; empty for softirqs.
+	string description;
+	// Position of the counts in InterruptTable::counts.
+	idx_t count_offset = 0;
+	idx_t count_size = 0;
+	// One count per CPU column, or a single system-wide total (i.e. "ERR" and "MIS" on x86).
+	bool per_cpu = true;
+	// CPUs the interrupt is routed to and the registered handlers; only read for numbered interrupts, when requested.
+	string smp_affinity;
+	string device;
+};
+
+// Content of /proc/interrupts or /proc/softirqs. Counts of all lines are stored in one flat array, so the very wide
+// per-CPU layout of many-core hosts costs no allocation per line.
+struct InterruptTable {
+	InterruptType type = InterruptType::HARDIRQ;
+	// CPU ids of the count columns; offline CPUs have no column.
+	vector<int32_t> cpus;
+	vector<InterruptSource> sources;
+	vector<uint64_t> counts;
+	// Interrupts per second of each count, only valid where [has_rate] is set; empty without sampling interval.
+	vector<double> rates;
+	vector<bool> has_rate;
+};
+
+// Hardware and software interrupts of all CPUs.
+struct InterruptStats {
+	InterruptTable hardirqs;
+	InterruptTable softirqs;
+};
+
+// Parse the content of /proc/interrupts or /proc/softirqs into [table]; return false if the header is malformed.
+bool ParseInterruptTable(std::string_view content, InterruptTable &table);
+
+// Compute the rates of the counts of [after] since [before], taken [interval_ns] apart. Interrupts and CPUs are
+// matched by name and id, so interrupts registered or CPUs brought online in between have no rates.
+void ComputeInterruptRates(const InterruptTable &before, InterruptTable &after, uint64_t interval_ns);
+
+// Get interrupt counts for the current platform. If [interval_micros] is positive, counts are sampled twice and
+// rates are computed. CPU affinity and handler names are only read if [read_details] is set.
+InterruptStats GetInterruptStats(ClientContext &context, int64_t interval_micros, bool read_details);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_interrupts table function
+void RegisterSysInterruptsFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Kernels of the STREAM benchmark, with a, b and c the arrays and s a scalar.
+enum class StreamKernel : uint8_t {
+	// c = a
+	COPY,
+	// b = s * c
+	SCALE,
+	// c = a + b
+	ADD,
+	// a = b + s * c
+	TRIAD,
+};
+
+constexpr double STREAM_SCALAR = 3.0;
+
+// Arrays of the STREAM kernels, aligned to 64 bytes.
+struct StreamArrays {
+	double *a = nullptr;
+	double *b = nullptr;
+	double *c = nullptr;
+	idx_t count = 0;
+};
+
+// Bandwidth of the STREAM kernels in bytes per second, and latency of dependent loads in nanoseconds, of one node
+// against the memory of one node.
+struct MemoryBandwidth {
+	double copy_bytes_per_sec = 0;
+	double scale_bytes_per_sec = 0;
+	double add_bytes_per_sec = 0;
+	double triad_bytes_per_sec = 0;
+	double latency_ns = 0;
+};
+
+struct MemoryBenchmarkOptions {
+	// NUMA node to benchmark, or -1 for every node.
+	int32_t node = -1;
+	// Threads per node running the STREAM kernels, or 0 for one per CPU of the node.
+	idx_t threads = 0;
+	// Bytes per STREAM array; the pointer chase uses a buffer of the same size.
+	uint64_t array_bytes = 0;
+	// Time limit of the whole benchmark, checked between repetitions of a kernel.
+	int64_t max_duration_micros = 0;
+};
+
+struct MemoryBenchmarkResult {
+	int32_t node = 0;
+	idx_t cpu_count = 0;
+	idx_t threads = 0;
+	uint64_t array_bytes = 0;
+	// Against memory of [node].
+	MemoryBandwidth local;
+	// Node whose memory [remote] was measured against, -1 on hosts with a single node.
+	int32_t remote_node = -1;
+	MemoryBandwidth remote;
+	uint64_t elapsed_ns = 0;
+};
+
+// Run [kernel] over the elements [begin, end) of [arrays]; [begin] has to be a multiple of 8, so the vector stores are
+// aligned.
+void RunStreamKernel(StreamKernel kernel, const StreamArrays &arrays, idx_t begin, idx_t end);
+
+// Bytes read and written per element by [kernel], as counted by STREAM.
+idx_t GetStreamBytesPerElement(StreamKernel kernel);
+
+// Get the implementation of the STREAM kernels selected for the host, i.e. "avx", "sse2" or "scalar".
+const char *GetStreamImplementation();
+
+// Link the [line_count] cache lines at [buffer] into a single cycle in random order; the first word of each line
+// points to the next one, so following the links is a chain of dependent loads the prefetcher cannot predict.
+void BuildPointerChase(void *buffer, idx_t line_count, uint64_t seed);
+
+// Follow [steps] links of a pointer chase starting at [start]; return the line reached.
+const void *ChasePointers(const void *start, idx_t steps);
+
+// Benchmark memory bandwidth and latency with threads pinned to each NUMA node, against the memory of the node and of
+// another node, for the current platform.
+vector<MemoryBenchmarkResult> RunMemoryBenchmark(ClientContext &context, const MemoryBenchmarkOptions &options);
+
+} // namespace duckdb
@@ -17,7 +17,10 @@ struct MemoryInfo {
 	uint64_t cached_memory = 0;
 };
 
-// Get memory information for the current platform
+// Get memory information for the current platform, from the shared metrics snapshot if enabled and fresh.
 MemoryInfo GetMemoryInfo(ClientContext &context);
 
+// Collect memory information for the current platform, bypassing the shared metrics snapshot.
+MemoryInfo CollectMemoryInfo(ClientContext &context);
+
 } // namespace duckdb
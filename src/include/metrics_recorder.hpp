@@ -0,0 +1,97 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Samples in long format, stored column by column.
+// Source and metric names are string literals, so only the entity (i.e. mount point or interface) is copied.
+struct MetricsBatch {
+	vector<timestamp_t> timestamps;
+	vector<std::string_view> sources;
+	// Empty for host-wide metrics.
+	vector<string> entities;
+	vector<std::string_view> metrics;
+	vector<uint64_t> values;
+
+	void Append(timestamp_t ts, std::string_view source, std::string_view entity, std::string_view metric,
+	            uint64_t value);
+	idx_t Size() const {
+		return timestamps.size();
+	}
+	void Clear();
+};
+
+// File format of recordings.
+enum class RecordingFormat : uint8_t {
+	// Parquet with ts, source, entity, metric and value columns.
+	PARQUET,
+	// Delta encoded stream of SnapshotEncoder, decoded with sys_snapshot_decode().
+	SNAPSHOT,
+};
+
+struct RecorderConfig {
+	// Directory the recording files are written to.
+	string path;
+	RecordingFormat format = RecordingFormat::PARQUET;
+	int64_t interval_micros = 0;
+	int64_t rotate_micros = 0;
+};
+
+struct RecorderStatus {
+	bool running = false;
+	RecorderConfig config;
+	// Samples buffered in memory, not yet written to a file.
+	uint64_t buffered_rows = 0;
+	uint64_t files_written = 0;
+	uint64_t rows_written = 0;
+	// Last failure of collecting or writing samples, empty if none.
+	string last_error;
+};
+
+// Time range covered by a recording file, in microseconds since epoch.
+struct RecordingFile {
+	string path;
+	RecordingFormat format = RecordingFormat::PARQUET;
+	int64_t start_micros = 0;
+	int64_t end_micros = 0;
+};
+
+// Collect samples of all collectors at [ts] into [batch].
+void CollectMetricSamples(ClientContext &context, timestamp_t ts, MetricsBatch &batch);
+
+// Parse recording format from string (case-insensitive), i.e. "parquet" or "snapshot".
+// Throws InvalidInputException if the format is unknown.
+RecordingFormat ParseRecordingFormat(const string &format_str);
+
+// Get the file name of a recording covering [start_micros, end_micros], i.e.
+// "sys_metrics_20261018T120000Z_20261018T125959Z.parquet". Times are rounded to seconds (start down, end up).
+string GetRecordingFileName(int64_t start_micros, int64_t end_micros, RecordingFormat format);
+
+// Parse the time range and format from a recording file name; return false if [file_name] is not a recording.
+bool ParseRecordingFileName(std::string_view file_name, int64_t &start_micros, int64_t &end_micros,
+                            RecordingFormat &format);
+
+// Start recording samples in the background for the database of [context].
+// Throws InvalidInputException if a recorder is already running.
+void StartRecorder(ClientContext &context, const RecorderConfig &config);
+
+// Stop the recorder and flush buffered samples; return the final status.
+RecorderStatus StopRecorder(ClientContext &context);
+
+// Get the status of the recorder.
+RecorderStatus GetRecorderStatus(ClientContext &context);
+
+// List recording files under [path] overlapping [start_micros, end_micros), sorted by start time.
+vector<RecordingFile> ListRecordingFiles(ClientContext &context, const string &path, int64_t start_micros,
+                                         int64_t end_micros);
+
+} // namespace duckdb
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_recorder_start, sys_recorder_stop and sys_recorder_status table functions
+void RegisterSysRecorderFunctions(ExtensionLoader &loader);
+
+// Register sys_recorded table function
+void RegisterSysRecordedFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
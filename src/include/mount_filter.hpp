@@ -0,0 +1,121 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+class DatabaseInstance;
+
+// Default filesystem types to ignore, which are virtual filesystems.
+extern const char *const DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES;
+// Default mount points to ignore.
+extern const char *const DEFAULT_EXCLUDE_MOUNT_POINTS;
+
+// Collision-free hash set over a fixed set of strings, built once and probed with a single hash and compare.
+class PerfectHashSet {
+public:
+	PerfectHashSet() = default;
+	explicit PerfectHashSet(const vector<string> &keys);
+
+	bool Contains(std::string_view key) const;
+	bool Empty() const {
+		return size == 0;
+	}
+
+private:
+	uint64_t Hash(std::string_view key) const;
+
+	// Seed picked at construction so that all keys land in distinct slots.
+	uint64_t seed = 0;
+	// Bitmask of the slot count, which is a power of two.
+	uint64_t mask = 0;
+	idx_t size = 0;
+	vector<string> slots;
+	vector<bool> occupied;
+};
+
+// Matches a path against a set of path prefixes at path component boundary, i.e.
+// - "/dev" matches "/dev" and "/dev/shm", but not "/devices";
+// - "/var/lib/docker/" (with trailing slash) matches everything under the directory, but not the directory itself.
+class PathPrefixTrie {
+public:
+	PathPrefixTrie();
+	explicit PathPrefixTrie(const vector<string> &prefixes);
+
+	bool Matches(std::string_view path) const;
+	bool Empty() const {
+		return nodes.size() == 1;
+	}
+
+private:
+	struct Node {
+		// Sorted by character; fanout of path prefixes is small so linear scan is cheap.
+		vector<std::pair<char, uint32_t>> children;
+		// Whether a prefix without trailing slash ends at this node.
+		bool terminal = false;
+		// Whether a prefix with trailing slash ends at this node.
+		bool terminal_dir = false;
+	};
+
+	void Insert(std::string_view prefix);
+
+	vector<Node> nodes;
+};
+
+// Raw include/exclude lists of the mount filter, as configured by settings.
+struct MountFilterConfig {
+	string include_fs_types;
+	string exclude_fs_types;
+	string include_mount_points;
+	string exclude_mount_points;
+
+	bool operator==(const MountFilterConfig &other) const {
+		return include_fs_types == other.include_fs_types && exclude_fs_types == other.exclude_fs_types &&
+		       include_mount_points == other.include_mount_points &&
+		       exclude_mount_points == other.exclude_mount_points;
+	}
+	bool operator!=(const MountFilterConfig &other) const {
+		return !(*this == other);
+	}
+};
+
+// Precompiled filter deciding which mounts are reported by sys_disk_info.
+// A mount is kept if it matches the include list (when not empty), and doesn't match the exclude list.
+class MountFilter {
+public:
+	MountFilter(const vector<string> &include_fs_types, const vector<string> &exclude_fs_types,
+	            const vector<string> &include_mount_points, const vector<string> &exclude_mount_points);
+	explicit MountFilter(const MountFilterConfig &config);
+
+	// Get the filter with default exclude lists.
+	static MountFilter Default();
+
+	bool IgnoreFileSystemType(std::string_view fs_type) const;
+	bool IgnoreMountPoint(std::string_view mount_point) const;
+
+private:
+	PerfectHashSet include_fs_types;
+	PerfectHashSet exclude_fs_types;
+	PathPrefixTrie include_mount_points;
+	PathPrefixTrie exclude_mount_points;
+};
+
+// Util function to parse a comma separated filter list, i.e. "ext4, xfs".
+vector<string> ParseFilterList(const string &list);
+
+// Register settings to configure the mount filter.
+void RegisterMountFilterOptions(DatabaseInstance &db);
+
+// Get the mount filter config from current settings.
+MountFilterConfig GetMountFilterConfig(ClientContext &context);
+
+// Get the mount filter configured by current settings.
+MountFilter GetMountFilter(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "mount_filter.hpp"
+#include "mount_info.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+class DatabaseInstance;
+
+// Mount table shared by all callers until it is rebuilt.
+using MountSnapshot = shared_ptr<const vector<MountInfoEntry>>;
+
+// ObjectCacheEntry that keeps the parsed, filtered and deduplicated mount table.
+// The kernel signals mount table changes via POLLPRI on an open /proc/self/mountinfo, so the table is only re-read
+// and rebuilt when a change is signalled (or the filter settings change); otherwise the cached index is returned.
+class MountIndexCacheEntry : public ObjectCacheEntry {
+public:
+	// [path] is the mountinfo file to read, which tests replace with a regular file.
+	explicit MountIndexCacheEntry(string path = "/proc/self/mountinfo");
+	~MountIndexCacheEntry() override;
+
+	static string ObjectType();
+
+	string GetObjectType() override;
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise the mount table has to be re-read.
+		return optional_idx {};
+	}
+
+	// Get mounts selected by [config]; the same snapshot is returned until the mount table or [config] changes. [db]
+	// is only used for logging and may be null.
+	MountSnapshot GetMounts(optional_ptr<DatabaseInstance> db, const MountFilterConfig &config);
+
+protected:
+	// Poll [fd_p] for a mount table change into [changed]; return false if polling failed. Virtual, so tests can
+	// simulate changes, which regular files never signal.
+	virtual bool PollMountTable(int fd_p, bool &changed);
+
+private:
+	// Whether mount table has changed since last check; must be called with [mu] held.
+	bool MountTableChanged(optional_ptr<DatabaseInstance> db);
+	// Re-read and rebuild the mount index; must be called with [mu] held.
+	void Rebuild(optional_ptr<DatabaseInstance> db, const MountFilterConfig &config);
+
+	const string path;
+	mutex mu;
+	// Opened [path], which is polled for changes and read from; -1 if not opened.
+	int fd;
+	bool initialized;
+	MountFilterConfig cached_config;
+	MountSnapshot mounts;
+};
+
+// Get mounts selected by current settings, from the index cached for the database instance.
+MountSnapshot GetFilteredMounts(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// One line of /proc/self/mountinfo, see proc(5).
+// Example: 36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw,errors=continue
+struct MountInfoEntry {
+	int32_t mount_id = 0;
+	int32_t parent_id = 0;
+	uint32_t major = 0;
+	uint32_t minor = 0;
+	// Root of the mount within the filesystem, which is not "/" for bind mounts of a subdirectory.
+	string root;
+	string mount_point;
+	// Per-mount options, i.e. "rw,noatime".
+	string mount_options;
+	// Space separated optional fields, i.e. "shared:1 master:2".
+	string propagation;
+	string file_system_type;
+	string source;
+	// Per-superblock options.
+	string super_options;
+};
+
+// Unescape octal sequences used by the kernel for whitespace and backslash in paths, i.e. "\040" for space.
+string UnescapeMountPath(std::string_view path);
+
+// Parse one line of /proc/self/mountinfo; return false if the line is malformed.
+bool ParseMountInfoLine(std::string_view line, MountInfoEntry &entry);
+
+// Keep only one entry per device, so bind mounts of the same filesystem are not reported (and counted) multiple
+// times. The mount of the filesystem root is preferred, then the one with the shortest mount point.
+// Relative order of kept entries is preserved.
+void DeduplicateBindMounts(vector<MountInfoEntry> &entries);
+
+} // namespace duckdb
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// One kernel network stack counter, i.e. TcpExt.ListenOverflows from /proc/net/netstat.
+struct ProtocolCounter {
+	// Source file name, i.e. "snmp", "netstat" and "sockstat".
+	string source;
+	// Protocol section, i.e. "Tcp", "TcpExt" and "UDP".
+	string protocol;
+	string name;
+	// Some counters are signed (i.e. Tcp.MaxConn is -1 for dynamic).
+	int64_t value = 0;
+};
+
+// Per-CPU packet processing statistics from /proc/net/softnet_stat.
+struct SoftnetStat {
+	int32_t cpu = 0;
+	uint64_t processed = 0;
+	// Packets dropped because the backlog queue was full.
+	uint64_t dropped = 0;
+	// Times net_rx_action ran out of budget or time with work remaining.
+	uint64_t time_squeeze = 0;
+	uint64_t received_rps = 0;
+	uint64_t flow_limit_count = 0;
+	uint64_t backlog_len = 0;
+};
+
+// Parse the header/value line pairs used by /proc/net/snmp and /proc/net/netstat in a single pass, ie.
+//   Tcp: RtoAlgorithm RtoMin ...
+//   Tcp: 1 200 ...
+void ParseHeaderValueLines(std::string_view content, const string &source, vector<ProtocolCounter> &counters);
+
+// Parse the key/value lines used by /proc/net/sockstat, ie.
+//   TCP: inuse 5 orphan 0 tw 0 alloc 7 mem 1
+void ParseKeyValueLines(std::string_view content, const string &source, vector<ProtocolCounter> &counters);
+
+// Parse /proc/net/softnet_stat, one line per online CPU in hex.
+vector<SoftnetStat> ParseSoftnetStat(std::string_view content);
+
+// Get kernel network protocol counters for the current platform.
+vector<ProtocolCounter> GetNetProtocolStats(ClientContext &context);
+
+// Get per-CPU softnet statistics for the current platform.
+vector<SoftnetStat> GetSoftnetStats(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_net_protocol_stats table function
+void RegisterSysNetProtocolStatsFunction(ExtensionLoader &loader);
+
+// Register sys_softnet_stats table function
+void RegisterSysSoftnetStatsFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Traffic counters of one network interface. Unlike NetworkInfo, interfaces without addresses, i.e. bond and bridge
+// members, are included.
+struct InterfaceCounters {
+	string interface_name;
+	// Index of the interface, which changes when it is deleted and re-created under the same name; 0 if unknown.
+	int32_t ifindex = 0;
+	uint64_t tx_bytes = 0;
+	uint64_t tx_packets = 0;
+	uint64_t tx_errors = 0;
+	uint64_t tx_dropped = 0;
+	uint64_t rx_bytes = 0;
+	uint64_t rx_packets = 0;
+	uint64_t rx_errors = 0;
+	uint64_t rx_dropped = 0;
+	uint64_t speed_mbps = 0;
+};
+
+// Network counters of all interfaces, taken at one point in time.
+struct NetworkSnapshot {
+	// Monotonic timestamp in nanoseconds, not affected by wall clock adjustments.
+	uint64_t timestamp_ns = 0;
+	vector<InterfaceCounters> interfaces;
+};
+
+struct NetworkRate {
+	string interface_name;
+	// Actual elapsed time between the two snapshots.
+	double interval_seconds = 0;
+	double tx_bytes_per_sec = 0;
+	double tx_packets_per_sec = 0;
+	double tx_errors_per_sec = 0;
+	double tx_dropped_per_sec = 0;
+	double rx_bytes_per_sec = 0;
+	double rx_packets_per_sec = 0;
+	double rx_errors_per_sec = 0;
+	double rx_dropped_per_sec = 0;
+	uint64_t speed_mbps = 0;
+	// Link utilization in percent, only valid when [has_utilization] is true (link speed is known).
+	bool has_utilization = false;
+	double tx_utilization = 0;
+	double rx_utilization = 0;
+};
+
+// Get the increment of a cumulative counter between two reads.
+// A decreasing counter is either a 32-bit wraparound, or a counter reset (i.e. interface re-created).
+uint64_t GetCounterDelta(uint64_t before, uint64_t after);
+
+// Parse the counters of every interface of /proc/net/dev into [interfaces]; malformed lines are skipped. The ifindex
+// and link speed are not part of the file and left at 0.
+void ParseProcNetDev(std::string_view content, vector<InterfaceCounters> &interfaces);
+
+// Take a network snapshot for the current platform, with a monotonic timestamp. Counters are always read from the
+// kernel, never from the shared metrics snapshot.
+NetworkSnapshot TakeNetworkSnapshot(ClientContext &context);
+
+// Compute per-interface rates between two snapshots.
+// Interfaces which only show up in one of the snapshots (added or removed in between) are skipped. Interfaces whose
+// ifindex changed were re-created in between, so their counters are counted from zero.
+vector<NetworkRate> ComputeNetworkRates(const NetworkSnapshot &before, const NetworkSnapshot &after);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_network_rates table function
+void RegisterSysNetworkRatesFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
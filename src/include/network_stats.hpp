@@ -9,9 +9,26 @@ namespace duckdb {
 // Forward declaration.
 class ClientContext;
 
+// Address families which could be collected for a network interface.
+enum class AddressFamily {
+	ALL, // Default
+	IPV4,
+	IPV6,
+};
+
+struct NetworkAddress {
+	// "ipv4" or "ipv6"
+	string family;
+	string address;
+	int32_t prefix_len = 0;
+};
+
+// One entry per network interface, all addresses assigned to the interface are grouped together.
 struct NetworkInfo {
 	string interface_name;
+	// First IPv4 address of the interface, empty if none.
 	string ipv4_address;
+	vector<NetworkAddress> addresses;
 	uint64_t tx_bytes = 0;
 	uint64_t tx_packets = 0;
 	uint64_t tx_errors = 0;
@@ -23,7 +40,15 @@ struct NetworkInfo {
 	uint64_t speed_mbps = 0;
 };
 
-// Get network information for the current platform
-vector<NetworkInfo> GetNetworkInfo(ClientContext &context);
+// Util function to parse address family string
+AddressFamily ParseAddressFamily(const string &family_str);
+
+// Get network information for the current platform.
+// Only addresses of the given [family] are collected, interfaces without any matching address are skipped.
+// Comes from the shared metrics snapshot if enabled and fresh.
+vector<NetworkInfo> GetNetworkInfo(ClientContext &context, AddressFamily family = AddressFamily::ALL);
+
+// Collect network information for the current platform, bypassing the shared metrics snapshot.
+vector<NetworkInfo> CollectNetworkInfo(ClientContext &context, AddressFamily family);
 
 } // namespace duckdb
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+
+#include <initializer_list>
+#include <string_view>
+#include <utility>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Text exposition formats for metrics.
+enum class MetricsFormat {
+	OPENMETRICS, // Default
+	// Prometheus text format 0.0.4, i.e. for the node_exporter textfile collector.
+	PROMETHEUS,
+};
+
+enum class MetricType {
+	GAUGE,
+	COUNTER,
+	// Constant 1 with descriptive labels.
+	INFO,
+};
+
+using MetricLabel = std::pair<std::string_view, std::string_view>;
+
+// Serializes metrics into a text exposition buffer.
+// Samples are appended straight from integers and strings, without going through DuckDB Values.
+class MetricsWriter {
+public:
+	MetricsWriter(MetricsFormat format, idx_t reserve_size);
+
+	// Start a metric family; [name] is the family name without "_total" or "_info" suffix, and [unit] could be empty.
+	void AddFamily(std::string_view name, MetricType type, std::string_view unit, std::string_view help);
+
+	// Add one sample to the current family.
+	void AddSample(std::initializer_list<MetricLabel> labels, uint64_t value);
+
+	// Terminate the exposition and return the text.
+	string Finish();
+
+private:
+	void AppendEscapedLabelValue(std::string_view value);
+
+	MetricsFormat format;
+	string buffer;
+	// Sample name of the current family, including the type suffix.
+	string sample_name;
+};
+
+// Util function to parse metrics format string
+MetricsFormat ParseMetricsFormat(const string &format_str);
+
+// Collect CPU, memory, disk, network and OS metrics for the current platform, and serialize them in [format].
+string GetMetricsText(ClientContext &context, MetricsFormat format);
+
+// Write the metrics to [path] atomically via a temporary file and rename, so readers never see a partial file.
+// Return the number of bytes written.
+idx_t WriteMetricsFile(ClientContext &context, const string &path, MetricsFormat format);
+
+} // namespace duckdb
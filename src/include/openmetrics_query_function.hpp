@@ -0,0 +1,14 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_metrics_openmetrics scalar function
+void RegisterSysMetricsOpenMetricsFunction(ExtensionLoader &loader);
+
+// Register sys_write_metrics table function
+void RegisterSysWriteMetricsFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
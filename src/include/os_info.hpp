@@ -18,7 +18,42 @@ struct OSInfo {
 	uint64_t os_up_since_seconds = 0;
 };
 
+// Bit set of OSInfo fields to collect. Fields differ widely in cost: host_name is a syscall, while process_count and
+// thread_count walk all of /proc, so callers only pay for the fields they use.
+using OSInfoFields = uint32_t;
+constexpr OSInfoFields OS_INFO_NAME = 1U << 0;
+constexpr OSInfoFields OS_INFO_VERSION = 1U << 1;
+constexpr OSInfoFields OS_INFO_HOST_NAME = 1U << 2;
+constexpr OSInfoFields OS_INFO_HANDLE_COUNT = 1U << 3;
+constexpr OSInfoFields OS_INFO_PROCESS_COUNT = 1U << 4;
+constexpr OSInfoFields OS_INFO_THREAD_COUNT = 1U << 5;
+constexpr OSInfoFields OS_INFO_ARCHITECTURE = 1U << 6;
+constexpr OSInfoFields OS_INFO_OS_UP_SINCE_SECONDS = 1U << 7;
+constexpr OSInfoFields OS_INFO_ALL = (1U << 8) - 1;
+
+// Process counts by state, from a walk of /proc.
+struct ProcessStatus {
+	int32_t active_processes = 0;
+	int32_t running_processes = 0;
+	int32_t sleeping_processes = 0;
+	int32_t stopped_processes = 0;
+	int32_t zombie_processes = 0;
+	int32_t total_threads = 0;
+};
+
+// Read process status from /proc; all counts are 0 on platforms without procfs.
+ProcessStatus ReadProcessStatus();
+
 // Get OS information for the current platform
 OSInfo GetOSInfo(ClientContext &context);
 
+// Get the requested [fields] of OS information for the current platform; other fields keep their default value.
+// Fields which never change while the process runs (name, version and architecture) are cached per database instance,
+// handle, process and thread counts come from the shared metrics snapshot if enabled and fresh.
+OSInfo GetOSInfo(ClientContext &context, OSInfoFields fields);
+
+// Collect the requested [fields] of OS information for the current platform, bypassing the cache and the shared
+// metrics snapshot.
+OSInfo CollectOSInfo(ClientContext &context, OSInfoFields fields);
+
 } // namespace duckdb
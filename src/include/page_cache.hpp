@@ -0,0 +1,57 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+enum class PageCacheMethod : uint8_t {
+	// cachestat(2), Linux 6.5 and later; reports dirty, writeback and evicted pages as well.
+	CACHESTAT,
+	// mmap(2) and mincore(2), only reports resident pages.
+	MINCORE,
+};
+
+// Page cache state of one file, in pages of the system page size.
+struct FilePageCache {
+	string path;
+	// "database", "wal" or "temp" for files of the attached databases, "file" for files matching a pattern.
+	string file_type;
+	// Name of the attached database, empty for temporary files and files matching a pattern.
+	string database;
+	uint64_t size_bytes = 0;
+	uint64_t total_pages = 0;
+	uint64_t cached_pages = 0;
+	uint64_t cached_bytes = 0;
+	PageCacheMethod method = PageCacheMethod::CACHESTAT;
+	// Only valid when [method] is CACHESTAT.
+	uint64_t dirty_pages = 0;
+	uint64_t writeback_pages = 0;
+	// Pages evicted from the cache, and those evicted recently enough to count as refaults if read again.
+	uint64_t evicted_pages = 0;
+	uint64_t recently_evicted_pages = 0;
+};
+
+// Read the page cache state of the open file [fd] with cachestat(2); return false if the kernel does not support it.
+bool ReadPageCacheCachestat(int fd, FilePageCache &cache);
+
+// Read the resident pages of the open file [fd] of [size_bytes] with mincore(2). The file is mapped one chunk at a
+// time, so the residency vector stays small for huge files; return false if it cannot be mapped.
+bool ReadPageCacheMincore(int fd, uint64_t size_bytes, FilePageCache &cache);
+
+// Read the page cache state of the regular file at [cache.path], with cachestat(2) if supported and mincore(2)
+// otherwise; return false if it cannot be opened or is not a regular file.
+bool ReadFilePageCache(FilePageCache &cache);
+
+// Get the page cache state of the files matching [pattern] for the current platform.
+vector<FilePageCache> GetPageCacheForPattern(ClientContext &context, const string &pattern);
+
+// Get the page cache state of the database and WAL files of all attached databases, and of the temporary files of the
+// database instance.
+vector<FilePageCache> GetPageCacheForDatabase(ClientContext &context);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_page_cache table function
+void RegisterSysPageCacheFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
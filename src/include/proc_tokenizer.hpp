@@ -0,0 +1,75 @@
+#pragma once
+
+#include "duckdb/common/types.hpp"
+
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace duckdb {
+
+// Tokenizer for procfs and sysfs text shared by all collectors.
+//
+// Tokens are separated by runs of ' ', '\t' and '\n'. Separators are located 64 bytes at a time as a bit mask, built
+// with AVX2 or SSE2 compares on x86-64 (selected at runtime) and one byte at a time on other platforms. Integers are
+// parsed 8 digits at a time with SWAR (SIMD within a register) arithmetic.
+
+// Get the next line from [text] starting at [pos], and advance [pos] past the line break.
+bool NextLine(std::string_view text, size_t &pos, std::string_view &line);
+
+// Get the next whitespace separated token from [text] starting at [pos], and advance [pos] past the token.
+bool NextToken(std::string_view text, size_t &pos, std::string_view &token);
+
+// Split [text] into whitespace separated tokens, storing up to [max_tokens] of them in [tokens]; return the number
+// stored. Faster than repeated NextToken() calls for lines of many short fields, i.e. /proc/[pid]/stat.
+idx_t SplitTokens(std::string_view text, std::string_view *tokens, idx_t max_tokens);
+
+// Get the position of the first separator in [text] at or after [pos], or the size of [text] if there is none.
+size_t FindSeparator(std::string_view text, size_t pos);
+
+// Get the position of the first non-separator in [text] at or after [pos], or the size of [text] if there is none.
+size_t SkipSeparators(std::string_view text, size_t pos);
+
+// Parse the leading decimal digits of [text] into [value], i.e. 32 for "32K"; return the number of digits consumed,
+// or 0 if [text] does not start with a digit or the number overflows.
+size_t ParseUint64Prefix(std::string_view text, uint64_t &value);
+
+// Parse [token] as a decimal unsigned integer; return false unless the whole token is a number within range.
+bool ParseUint64(std::string_view token, uint64_t &value);
+
+// Parse [token] as a decimal signed integer with an optional leading '-'.
+bool ParseInt64(std::string_view token, int64_t &value);
+
+// Parse [token] as a decimal integer, which must fit into the integral type T.
+template <typename T>
+bool ParseInteger(std::string_view token, T &value) {
+	static_assert(std::is_integral<T>::value, "ParseInteger requires an integral type");
+	if constexpr (std::is_signed<T>::value) {
+		int64_t parsed = 0;
+		if (!ParseInt64(token, parsed) || parsed < std::numeric_limits<T>::min() ||
+		    parsed > std::numeric_limits<T>::max()) {
+			return false;
+		}
+		value = static_cast<T>(parsed);
+	} else {
+		uint64_t parsed = 0;
+		if (!ParseUint64(token, parsed) || parsed > std::numeric_limits<T>::max()) {
+			return false;
+		}
+		value = static_cast<T>(parsed);
+	}
+	return true;
+}
+
+// Parse [token] as a hexadecimal unsigned integer without "0x" prefix.
+bool ParseHexUint64(std::string_view token, uint64_t &value);
+
+// Split a /proc/[pid]/stat line into the command name and the fields after it, i.e.
+//   1234 (my (weird) name) S 1 1234 ...
+// The name is wrapped in parentheses but could contain ')' and spaces itself, so it ends at the last ')'.
+bool SplitProcStat(std::string_view line, std::string_view &comm, std::string_view &fields);
+
+// Get the name of the separator search implementation selected for this CPU, i.e. "avx2", "sse2" or "scalar".
+const char *GetTokenizerImplementation();
+
+} // namespace duckdb
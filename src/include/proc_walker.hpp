@@ -0,0 +1,67 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Walker of procfs directories shared by all collectors, i.e. the pids in /proc or the tids in /proc/[pid]/task.
+//
+// Entries are read with getdents64 into a 32 KiB buffer which lives with the walker, so there is no opendir()
+// allocation and no per-entry libc overhead of readdir(), and files of an entry are opened relative to the directory
+// with openat(), i.e. "1234/stat" relative to /proc, formatted into a stack buffer. The kernel then does not resolve
+// "/proc" again for every file, and no path string is allocated.
+class ProcDirectory {
+public:
+	// Open the directory at [path].
+	explicit ProcDirectory(const char *path);
+	// Open the directory at [path] relative to the directory [dir_fd].
+	ProcDirectory(int dir_fd, const char *path);
+	~ProcDirectory();
+
+	ProcDirectory(const ProcDirectory &) = delete;
+	ProcDirectory &operator=(const ProcDirectory &) = delete;
+
+	bool IsOpen() const {
+		return fd != -1;
+	}
+	int GetFd() const {
+		return fd;
+	}
+
+	// Get the next entry whose name is a number, i.e. a pid, tid or file descriptor; return false after the last one.
+	bool Next(int32_t &id);
+	// Count the remaining entries whose name is a number.
+	idx_t CountRemaining();
+
+private:
+	static constexpr size_t BUFFER_SIZE = 32 * 1024;
+
+	int fd;
+	// Range of [buffer] holding entries not returned yet.
+	size_t pos;
+	size_t end;
+	alignas(8) std::array<char, BUFFER_SIZE> buffer;
+};
+
+// Read up to [size] bytes of the file at [path] relative to the directory [dir_fd] into [buf]; return an empty view
+// if it cannot be read, i.e. the process has exited.
+std::string_view ReadFileAt(int dir_fd, const char *path, char *buf, size_t size);
+
+template <size_t N>
+std::string_view ReadFileAt(int dir_fd, const char *path, std::array<char, N> &buf) {
+	return ReadFileAt(dir_fd, path, buf.data(), buf.size());
+}
+
+// Read the whole content of the file at [path] into [content], i.e. /proc/interrupts, which is several hundred KiB on
+// many-core hosts. procfs files report a size of 0, so the content grows with every read. Return false, after logging
+// the error to the database of [context], if it cannot be read.
+bool ReadProcFile(ClientContext &context, const char *path, string &content);
+
+} // namespace duckdb
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+enum class ProcEventType : uint8_t {
+	// Acknowledgement of a subscription request, with an error code.
+	ACK,
+	// A process or thread was created.
+	FORK,
+	EXEC,
+	// A process or thread exited.
+	EXIT,
+	// Events not tracked, i.e. uid or comm changes.
+	OTHER,
+};
+
+// One event of the netlink proc connector.
+struct ProcEvent {
+	ProcEventType type = ProcEventType::OTHER;
+	// Monotonic timestamp in nanoseconds.
+	uint64_t timestamp_ns = 0;
+	// Thread id and process id of the created, exec'ed or exited task.
+	int32_t pid = 0;
+	int32_t tgid = 0;
+	// Process id of the parent, for forks and exits.
+	int32_t parent_tgid = 0;
+	// Wait status of exits, i.e. the exit code shifted by 8 bits, or the terminating signal.
+	uint32_t exit_code = 0;
+	// Error code of acknowledgements.
+	uint32_t error = 0;
+};
+
+// Live process counts, kept up to date from fork and exit events.
+struct ProcessEventCounts {
+	int64_t process_count = 0;
+	int64_t thread_count = 0;
+	// Processes and threads created, exec() calls and processes exited since the listener started.
+	uint64_t forks = 0;
+	uint64_t clones = 0;
+	uint64_t execs = 0;
+	uint64_t exits = 0;
+	// Times the socket buffer overflowed and events were lost; counts are re-read from /proc after each.
+	uint64_t overruns = 0;
+};
+
+// Threads found by the walk of /proc which seeds the counts. Events queued while the walk ran could describe threads
+// it already counted, or threads which exited before it got to them, so they are reconciled against it.
+struct ProcessEventSeed {
+	// Thread ids found by the walk.
+	unordered_set<int32_t> tids;
+	// Threads created before the walk finished which it did not find.
+	unordered_set<int32_t> forked;
+	// Monotonic time the walk finished, in nanoseconds; later events describe changes the walk did not see.
+	uint64_t end_ns = 0;
+};
+
+struct ProcessExit {
+	timestamp_t exit_time;
+	int32_t pid = 0;
+	int32_t ppid = 0;
+	uint32_t exit_code = 0;
+	// Read from /proc/[pid]/stat right after the exit, only valid when [has_usage] is true; the parent could have
+	// reaped the process already.
+	bool has_usage = false;
+	string name;
+	double utime_seconds = 0;
+	double stime_seconds = 0;
+	uint64_t minor_faults = 0;
+	uint64_t major_faults = 0;
+};
+
+// Ring buffer of the latest process exits.
+class ProcessExitLog {
+public:
+	explicit ProcessExitLog(idx_t capacity);
+
+	void Append(ProcessExit exit);
+	// Get the entries, oldest first.
+	vector<ProcessExit> GetEntries() const;
+	// Number of entries overwritten because the log was full.
+	uint64_t GetDropped() const {
+		return dropped;
+	}
+
+private:
+	idx_t capacity;
+	// Position of the oldest entry once the buffer is full.
+	idx_t next;
+	uint64_t dropped;
+	vector<ProcessExit> entries;
+};
+
+struct ProcessEventsStatus {
+	bool running = false;
+	ProcessEventCounts counts;
+	idx_t exit_log_size = 0;
+	uint64_t exits_dropped = 0;
+	// Reason the listener could not start or stopped, i.e. missing CAP_NET_ADMIN; empty if none.
+	string last_error;
+};
+
+// Parse the proc connector events of one netlink datagram into [events]; return false if it is malformed.
+bool ParseProcConnectorMessage(const char *buf, size_t size, vector<ProcEvent> &events);
+
+// Update [counts] for [event]. Only threads whose thread id equals the process id start or end a process. Unless
+// [live], only the totals of forks, clones, execs and exits are updated, not the process and thread counts.
+void ApplyProcEvent(const ProcEvent &event, ProcessEventCounts &counts, bool live = true);
+
+// Return whether [event] changes the process and thread counts seeded from [seed]: forks of threads the walk found
+// and exits of threads it never counted are skipped. Once events are well past the walk, [seed] is cleared.
+bool ReconcileSeededEvent(const ProcEvent &event, ProcessEventSeed &seed);
+
+// Start listening to process events in the background for the database of [context], keeping the latest
+// [exit_log_size] exits. If the proc connector is not available, the listener does not run and the error is reported
+// in the returned status.
+ProcessEventsStatus StartProcessEvents(ClientContext &context, idx_t exit_log_size);
+
+// Stop the listener; counts and the exit log are kept until the next start.
+ProcessEventsStatus StopProcessEvents(ClientContext &context);
+
+ProcessEventsStatus GetProcessEventsStatus(ClientContext &context);
+
+// Get the logged process exits, oldest first.
+vector<ProcessExit> GetProcessExits(ClientContext &context);
+
+// Get the live process and thread counts; return false unless the listener is running.
+bool GetProcessEventCounts(ClientContext &context, int64_t &process_count, int64_t &thread_count);
+
+} // namespace duckdb
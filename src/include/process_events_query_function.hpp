@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_process_events_start, sys_process_events_stop, sys_process_events and sys_process_exits table functions
+void RegisterSysProcessEventsFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// One memory mapping from /proc/[pid]/smaps, or the whole process from /proc/[pid]/smaps_rollup.
+// All sizes are in bytes.
+struct MemoryMapping {
+	uint64_t start_address = 0;
+	uint64_t end_address = 0;
+	string permissions;
+	uint64_t offset = 0;
+	// Device in "major:minor" format.
+	string device;
+	uint64_t inode = 0;
+	// Backing file or pseudo path (i.e. "[heap]"), empty for anonymous mappings.
+	string pathname;
+
+	uint64_t size = 0;
+	uint64_t rss = 0;
+	uint64_t pss = 0;
+	uint64_t pss_anon = 0;
+	uint64_t pss_file = 0;
+	uint64_t pss_shmem = 0;
+	uint64_t shared_clean = 0;
+	uint64_t shared_dirty = 0;
+	uint64_t private_clean = 0;
+	uint64_t private_dirty = 0;
+	uint64_t referenced = 0;
+	uint64_t anonymous = 0;
+	uint64_t anon_huge_pages = 0;
+	uint64_t shmem_pmd_mapped = 0;
+	uint64_t file_pmd_mapped = 0;
+	// Shared_Hugetlb and Private_Hugetlb combined.
+	uint64_t hugetlb = 0;
+	uint64_t swap = 0;
+	uint64_t swap_pss = 0;
+	uint64_t locked = 0;
+
+	// Add the sizes of [other] to this mapping, and extend the address range to cover both.
+	void Accumulate(const MemoryMapping &other);
+};
+
+// Incremental parser for /proc/[pid]/smaps and /proc/[pid]/smaps_rollup.
+// Content is fed in arbitrary chunks, and only the current line and mapping are buffered, so memory usage does not
+// depend on the size of the file.
+class SmapsParser {
+public:
+	// Parse the next chunk; mappings completed by this chunk are appended to [mappings].
+	void Feed(std::string_view chunk, vector<MemoryMapping> &mappings);
+
+	// Parse the remaining content at end of file, and append the last mapping if any.
+	void Finish(vector<MemoryMapping> &mappings);
+
+private:
+	void ParseLine(std::string_view line, vector<MemoryMapping> &mappings);
+
+	// Incomplete line left over from the previous chunk.
+	string partial_line;
+	MemoryMapping current;
+	bool has_current = false;
+};
+
+// Streaming reader of the memory mappings of one process.
+class ProcessMemoryReader {
+public:
+	// [pid] 0 refers to the current process. If [detail] is false, only the process-wide summary is read.
+	ProcessMemoryReader(ClientContext &context, int32_t pid, bool detail);
+	~ProcessMemoryReader();
+
+	ProcessMemoryReader(const ProcessMemoryReader &) = delete;
+	ProcessMemoryReader &operator=(const ProcessMemoryReader &) = delete;
+
+	// Append up to [max_count] mappings to [mappings]; return false once all mappings have been returned.
+	bool Read(vector<MemoryMapping> &mappings, idx_t max_count);
+
+private:
+	// Read and parse the next chunk into [pending]; return false at end of file.
+	bool ReadChunk();
+
+	int fd = -1;
+	// Whether all mappings have to be summed up into one, when smaps_rollup is not available.
+	bool aggregate = false;
+	bool eof = false;
+	SmapsParser parser;
+	vector<MemoryMapping> pending;
+	idx_t pending_offset = 0;
+};
+
+} // namespace duckdb
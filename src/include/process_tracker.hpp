@@ -0,0 +1,145 @@
+#pragma once
+
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Identity of a process. Pids are reused, so the same pid with another start time is another process.
+struct ProcessKey {
+	int32_t pid = 0;
+	// Start time in clock ticks since boot.
+	uint64_t start_time_ticks = 0;
+
+	bool operator==(const ProcessKey &other) const {
+		return pid == other.pid && start_time_ticks == other.start_time_ticks;
+	}
+};
+
+struct ProcessKeyHash {
+	size_t operator()(const ProcessKey &key) const {
+		return CombineHash(Hash(key.pid), Hash(key.start_time_ticks));
+	}
+};
+
+// Fields of /proc/[pid]/stat, the only file read for known processes on every sample.
+struct ProcessStat {
+	string name;
+	char state = '\0';
+	int32_t ppid = 0;
+	uint64_t minor_faults = 0;
+	uint64_t major_faults = 0;
+	uint64_t utime_ticks = 0;
+	uint64_t stime_ticks = 0;
+	uint64_t num_threads = 0;
+	uint64_t start_time_ticks = 0;
+	uint64_t rss_pages = 0;
+};
+
+struct TrackedProcess {
+	int32_t pid = 0;
+	ProcessStat stat;
+	// CPU usage in percent of one CPU since the previous sample, only valid when [has_rates] is true.
+	bool has_rates = false;
+	double cpu_pct = 0;
+	// Sample the process was last seen in.
+	uint64_t last_sample = 0;
+	// Fields which do not change while the process runs, read once when the process is first reported. exec() keeps
+	// pid and start time but replaces the command, so they are read again when the name changes.
+	bool details_loaded = false;
+	bool has_uid = false;
+	uint32_t uid = 0;
+	string cmdline;
+	string exe;
+};
+
+// Processes seen in consecutive samples of /proc, keyed by pid and start time.
+class ProcessTracker {
+public:
+	explicit ProcessTracker(double ticks_per_second);
+
+	// Start a sample taken at monotonic [timestamp_ns].
+	void BeginSample(uint64_t timestamp_ns);
+	// Record the stat of [pid] in the current sample; CPU usage is computed if the process was in the previous one.
+	TrackedProcess &Update(int32_t pid, ProcessStat stat);
+	// Forget processes not seen in the current sample, which have exited.
+	void EndSample();
+
+	// Get the [n] processes using the most CPU, ranked by CPU percentage then CPU time, from a bounded heap.
+	vector<TrackedProcess *> SelectTop(idx_t n);
+
+	idx_t Size() const {
+		return processes.size();
+	}
+
+private:
+	double ticks_per_second;
+	uint64_t sample_count;
+	uint64_t sample_ns;
+	uint64_t previous_sample_ns;
+	unordered_map<ProcessKey, TrackedProcess, ProcessKeyHash> processes;
+};
+
+struct ProcessUsage {
+	int32_t pid = 0;
+	int32_t ppid = 0;
+	string name;
+	string state;
+	// Effective user id, only valid when [has_uid] is true.
+	bool has_uid = false;
+	uint32_t uid = 0;
+	// Empty for kernel threads, or if not readable (i.e. exe of processes of other users).
+	string cmdline;
+	string exe;
+	uint64_t num_threads = 0;
+	uint64_t rss_bytes = 0;
+	double cpu_seconds = 0;
+	bool has_rates = false;
+	double cpu_pct = 0;
+};
+
+// Parse the content of /proc/[pid]/stat; the name could contain spaces and parentheses.
+bool ParseProcessStat(std::string_view content, ProcessStat &stat);
+
+// ObjectCacheEntry keeping the process tracker of a database instance between queries, so processes are not
+// rediscovered and their details not re-read on every call.
+class ProcessTrackerCacheEntry : public ObjectCacheEntry {
+public:
+	ProcessTrackerCacheEntry();
+
+	static string ObjectType();
+
+	string GetObjectType() override;
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise CPU usage since the previous call is lost.
+		return optional_idx {};
+	}
+
+	// Take a sample of all processes.
+	void Sample(ClientContext &context);
+	// Take a sample of all processes, and get the [n] using the most CPU since the previous sample.
+	vector<ProcessUsage> SampleTop(ClientContext &context, idx_t n);
+
+private:
+	mutex mu;
+	ProcessTracker tracker;
+};
+
+// Get the [n] processes using the most CPU for the current platform. Processes are tracked between calls, so without
+// [interval_micros] CPU percentage covers the time since the previous call (NULL on the first one); with a positive
+// [interval_micros], processes are sampled twice that far apart.
+vector<ProcessUsage> GetTopProcesses(ClientContext &context, idx_t n, int64_t interval_micros);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_process_top table function
+void RegisterSysProcessTopFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
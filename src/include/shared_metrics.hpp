@@ -0,0 +1,96 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+#include "memory_stats.hpp"
+#include "network_stats.hpp"
+#include "os_info.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+class DatabaseInstance;
+
+// Path of the POSIX shared memory segment of the effective user, i.e. "/dev/shm/duckdb_system_stats_v1_1000". The
+// layout version is part of it, so processes of different versions never map a segment of another layout, and so is
+// the user id, so processes only trust metrics published by their own user.
+string GetSharedMetricsSegmentPath();
+
+// Host metrics collected by one publishing process, and read by all DuckDB processes of the host.
+struct SharedMetricsSnapshot {
+	// CLOCK_MONOTONIC time the metrics were collected at, 0 if nothing was published yet.
+	uint64_t publish_time_ns = 0;
+	uint64_t interval_ns = 0;
+	int32_t publisher_pid = 0;
+	MemoryInfo memory;
+	int32_t handle_count = 0;
+	int32_t process_count = 0;
+	int32_t thread_count = 0;
+	// False if some interface or address did not fit into the segment, readers then collect network info themselves.
+	bool has_networks = false;
+	// Interfaces with addresses of all families.
+	vector<NetworkInfo> networks;
+};
+
+// Fixed layout of the shared memory segment, defined in shared_metrics.cpp.
+struct SharedMetricsSegment;
+
+// Size of the shared memory segment in bytes.
+idx_t GetSharedMetricsSegmentSize();
+
+// Prepare the zeroed or previously published [segment] for publishing. Must only be called by the publisher.
+void InitializeSharedMetricsSegment(SharedMetricsSegment &segment);
+
+// Write [snapshot] into [segment] under its seqlock. Must only be called by the publisher.
+void WriteSharedMetrics(SharedMetricsSegment &segment, const SharedMetricsSnapshot &snapshot);
+
+// Read a consistent copy of [segment] into [snapshot], including networks only if [with_networks]. Return false if the
+// segment was never initialized, or the publisher kept writing while it was read.
+bool ReadSharedMetrics(const SharedMetricsSegment &segment, bool with_networks, SharedMetricsSnapshot &snapshot);
+
+// Return whether [snapshot] is recent enough at CLOCK_MONOTONIC time [now_ns] to be used instead of collecting.
+// Snapshots older than three publish intervals (at least one second) mean the publisher stopped or hangs.
+bool IsSharedMetricsFresh(const SharedMetricsSnapshot &snapshot, uint64_t now_ns);
+
+// Keep the addresses of [networks] belonging to [family], skipping interfaces without any, as GetNetworkInfo does.
+vector<NetworkInfo> FilterNetworkInfo(const vector<NetworkInfo> &networks, AddressFamily family);
+
+// Readers: if the system_stats_shared_metrics setting is enabled and a fresh snapshot is published, fill the
+// requested metrics from it and return true; otherwise return false, and the caller collects them itself.
+bool ReadSharedMemoryInfo(ClientContext &context, MemoryInfo &info);
+bool ReadSharedNetworkInfo(ClientContext &context, AddressFamily family, vector<NetworkInfo> &networks);
+// Fills handle_count, process_count and thread_count.
+bool ReadSharedOSCounts(ClientContext &context, OSInfo &info);
+
+struct SharedMetricsStatus {
+	// Whether this database instance runs a publisher thread, either publishing or on standby.
+	bool running = false;
+	// Whether this database instance holds the segment lock and publishes; others stand by to take over.
+	bool publishing = false;
+	int64_t interval_micros = 0;
+	uint64_t publish_count = 0;
+	// Last snapshot found in the segment, from the view of a reader; publish_time_ns is 0 if there is none.
+	SharedMetricsSnapshot snapshot;
+	int64_t snapshot_age_micros = 0;
+	// Whether readers with the setting enabled use the snapshot instead of collecting.
+	bool snapshot_fresh = false;
+	// Last failure of acquiring the segment or collecting metrics, empty if none.
+	string last_error;
+};
+
+// Start publishing host metrics every [interval_micros] for the database of [context]. Only one process of the host
+// publishes at a time; the others stand by and take over within one interval once it stops or exits.
+// Throws InvalidInputException if a publisher is already running.
+SharedMetricsStatus StartSharedMetrics(ClientContext &context, int64_t interval_micros);
+
+// Stop publishing, or standing by; readers fall back to collecting once the last snapshot turns stale.
+SharedMetricsStatus StopSharedMetrics(ClientContext &context);
+
+SharedMetricsStatus GetSharedMetricsStatus(ClientContext &context);
+
+// Register the setting which enables reading shared metrics.
+void RegisterSharedMetricsOptions(DatabaseInstance &db);
+
+} // namespace duckdb
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_shared_metrics_start, sys_shared_metrics_stop and sys_shared_metrics_status table functions
+void RegisterSysSharedMetricsFunctions(ExtensionLoader &loader);
+
+} // namespace duckdb
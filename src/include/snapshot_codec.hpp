@@ -0,0 +1,103 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "metrics_recorder.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Compact binary encoding of consecutive metric snapshots, for sampled history at sub-second resolution.
+//
+// Layout, all integers are LEB128 varints:
+//   header:   magic "SYSSNAP" and version byte
+//   snapshot: zigzag(delta of delta of timestamp)
+//             count of new strings, then (length, bytes) for each
+//             count of new series, then (source id, entity id, metric id) for each
+//             count of samples, then 1 if the series are the same as in the previous snapshot, otherwise 0 followed
+//             by the series id of each sample
+//             zigzag(value - previous value of the series) for each sample
+//
+// Source, entity and metric names are written once per stream, and unchanged counters cost a single byte.
+class SnapshotEncoder {
+public:
+	SnapshotEncoder();
+
+	// Append the samples of [batch] as one snapshot per distinct timestamp; samples of a snapshot must be contiguous.
+	void Append(const MetricsBatch &batch);
+
+	const string &GetData() const {
+		return data;
+	}
+	idx_t SampleCount() const {
+		return sample_count;
+	}
+	// Timestamps of the first and last snapshot, in microseconds since epoch; only valid if SampleCount() > 0.
+	int64_t FirstTimestamp() const {
+		return first_timestamp;
+	}
+	int64_t LastTimestamp() const {
+		return last_timestamp;
+	}
+
+	// Drop the encoded data and all dictionaries, so the next snapshot starts a new self-contained stream.
+	void Reset();
+
+private:
+	void AppendSnapshot(const MetricsBatch &batch, idx_t begin, idx_t end);
+	uint32_t GetStringId(std::string_view str, vector<uint32_t> &new_strings);
+
+	string data;
+	idx_t sample_count = 0;
+	int64_t first_timestamp = 0;
+	int64_t last_timestamp = 0;
+	int64_t last_delta = 0;
+
+	unordered_map<string, uint32_t> string_ids;
+	// Strings in id order, to write the new ones of a snapshot.
+	vector<string> strings;
+	// Series key is the source, entity and metric string ids as raw bytes.
+	unordered_map<string, uint32_t> series_ids;
+	// Series keys in id order.
+	vector<string> series_keys;
+	vector<uint64_t> last_values;
+	vector<uint32_t> last_layout;
+	// Series id of each sample of the current snapshot, reused across snapshots.
+	vector<uint32_t> layout;
+};
+
+// Decodes a stream written by SnapshotEncoder, one snapshot at a time.
+// Source and metric names in the decoded batch point into [data], which must outlive the decoded batches.
+class SnapshotDecoder {
+public:
+	// Throws InvalidInputException if [data] is not a snapshot stream.
+	explicit SnapshotDecoder(std::string_view data);
+
+	// Append the samples of the next snapshot to [batch]; return false at the end of the stream.
+	// Throws InvalidInputException if the stream is truncated or corrupted.
+	bool Next(MetricsBatch &batch);
+
+private:
+	uint64_t ReadVarint();
+	uint32_t ReadId(idx_t limit);
+
+	std::string_view data;
+	idx_t pos = 0;
+	int64_t last_timestamp = 0;
+	int64_t last_delta = 0;
+
+	vector<std::string_view> strings;
+	struct Series {
+		uint32_t source;
+		uint32_t entity;
+		uint32_t metric;
+	};
+	vector<Series> series;
+	vector<uint64_t> last_values;
+	vector<uint32_t> layout;
+};
+
+} // namespace duckdb
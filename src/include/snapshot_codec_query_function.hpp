@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_snapshot_decode table function
+void RegisterSysSnapshotDecodeFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
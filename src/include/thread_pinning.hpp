@@ -0,0 +1,60 @@
+#pragma once
+
+#include "cpu_topology.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+enum class ThreadPinPolicy : uint8_t {
+	// Every worker may run on every allowed CPU, which undoes an earlier pinning.
+	NONE,
+	// One CPU per worker, filling the hardware threads of a core, the cores of a package and the packages of a node
+	// in turn, so workers share caches and stay on as few sockets as possible.
+	COMPACT,
+	// One CPU per worker, spread round-robin across the packages of every node; the second hardware thread of a core
+	// is only used once every core has a worker.
+	SCATTER,
+	// Every worker may run on all CPUs of one node, with workers spread across nodes in proportion to their CPUs, so
+	// memory a worker allocates stays local to it.
+	NUMA_LOCAL,
+	// Every worker may run on the allowed CPUs which receive no device interrupts.
+	AVOID_IRQ_CPUS,
+};
+
+// Parse a policy name; throws InvalidInputException for unknown names.
+ThreadPinPolicy ParseThreadPinPolicy(const string &policy);
+
+const char *ThreadPinPolicyToString(ThreadPinPolicy policy);
+
+// Compute the CPUs of each of [worker_count] workers under [policy], given the allowed CPUs [cpus] and the ascending
+// CPUs [irq_cpus] device interrupts are routed to. Every CPU list is ascending; if [irq_cpus] covers every allowed
+// CPU, AVOID_IRQ_CPUS falls back to all of them.
+vector<vector<int32_t>> AssignWorkerCpus(ThreadPinPolicy policy, const vector<CpuTopologyInfo> &cpus,
+                                         const vector<int32_t> &irq_cpus, idx_t worker_count);
+
+// Affinity of one task scheduler worker before and after pinning.
+struct PinnedThreadInfo {
+	int32_t tid = 0;
+	vector<int32_t> previous_cpus;
+	vector<int32_t> cpus;
+	// Node and package shared by all of [cpus], or -1 if they span several.
+	int32_t node = -1;
+	int32_t package = -1;
+	// Empty if the affinity was set.
+	string error;
+};
+
+// Get the ascending CPUs which device interrupts that fired since boot are routed to, for the current platform.
+vector<int32_t> GetInterruptCpus(ClientContext &context);
+
+// Set the affinity of the task scheduler workers of the database under [policy], for the current platform. Workers
+// are found by scheduling one task per worker; workers busy with tasks of other queries for longer than a second are
+// not pinned. Workers started later, i.e. by raising the threads setting, are not pinned either.
+vector<PinnedThreadInfo> PinWorkerThreads(ClientContext &context, ThreadPinPolicy policy);
+
+} // namespace duckdb
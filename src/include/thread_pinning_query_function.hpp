@@ -0,0 +1,11 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/function/table_function.hpp"
+
+namespace duckdb {
+
+// Register sys_pin_threads table function
+void RegisterSysPinThreadsFunction(ExtensionLoader &loader);
+
+} // namespace duckdb
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <string_view>
+
+namespace duckdb {
+
+// Forward declaration.
+class ClientContext;
+
+// Fields of /proc/[pid]/task/[tid]/stat used for thread statistics.
+struct TaskStat {
+	string name;
+	char state = '\0';
+	uint64_t utime_ticks = 0;
+	uint64_t stime_ticks = 0;
+	// CPU the thread last ran on.
+	int32_t processor = -1;
+};
+
+// Fields of /proc/[pid]/task/[tid]/schedstat, all in nanoseconds.
+struct SchedStat {
+	uint64_t run_time_ns = 0;
+	// Time spent waiting on a run queue.
+	uint64_t wait_time_ns = 0;
+	uint64_t timeslices = 0;
+};
+
+struct ThreadInfo {
+	int32_t tid = 0;
+	string name;
+	string state;
+	int32_t cpu = -1;
+	double utime_seconds = 0;
+	double stime_seconds = 0;
+	uint64_t voluntary_ctxt_switches = 0;
+	uint64_t nonvoluntary_ctxt_switches = 0;
+	uint64_t run_time_ns = 0;
+	uint64_t wait_time_ns = 0;
+	uint64_t timeslices = 0;
+	// CPU and run-queue wait percentage over the sampling interval, only valid when [has_rates] is true.
+	bool has_rates = false;
+	double cpu_pct = 0;
+	double wait_pct = 0;
+};
+
+// Parse the content of /proc/[pid]/task/[tid]/stat; the thread name could contain spaces and parentheses.
+bool ParseTaskStat(std::string_view content, TaskStat &stat);
+
+// Parse the content of /proc/[pid]/task/[tid]/schedstat.
+bool ParseSchedStat(std::string_view content, SchedStat &stat);
+
+// Parse voluntary and nonvoluntary context switches from the content of /proc/[pid]/task/[tid]/status.
+void ParseContextSwitches(std::string_view content, uint64_t &voluntary, uint64_t &nonvoluntary);
+
+// Compute per-thread CPU and wait percentage between two samples taken [interval_ns] apart.
+// Threads which exited in between are not reported, threads created in between have no rates.
+void ComputeThreadRates(const vector<ThreadInfo> &before, vector<ThreadInfo> &after, uint64_t interval_ns);
+
+// Get thread information of process [pid] for the current platform; [pid] 0 refers to the current process.
+// If [interval_micros] is positive, threads are sampled twice and CPU / wait percentage are computed.
+vector<ThreadInfo> GetThreadInfo(ClientContext &context, int32_t pid, int64_t interval_micros);
+
+} // namespace duckdb
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace duckdb {
+
+// Nanoseconds of the steady clock, for the elapsed time between samples; unrelated to wall-clock time.
+uint64_t GetMonotonicTimestampNs();
+
+} // namespace duckdb
@@ -0,0 +1,245 @@
+#include "interrupt_stats.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "network_rates.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "time_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Interrupts printed as a single system-wide total instead of one count per CPU.
+constexpr std::string_view SYSTEM_WIDE_IRQS[] = {"ERR", "MIS", "Err"};
+
+bool IsSystemWideIrq(std::string_view irq) {
+	return std::find(std::begin(SYSTEM_WIDE_IRQS), std::end(SYSTEM_WIDE_IRQS), irq) != std::end(SYSTEM_WIDE_IRQS);
+}
+
+// Parse the header line, i.e. "CPU0 CPU1 CPU3"; offline CPUs are skipped, so ids could have gaps.
+bool ParseCpuHeader(std::string_view line, vector<int32_t> &cpus) {
+	constexpr std::string_view CPU_PREFIX = "CPU";
+	size_t pos = 0;
+	std::string_view token;
+	while (NextToken(line, pos, token)) {
+		int32_t cpu = 0;
+		if (token.substr(0, CPU_PREFIX.size()) != CPU_PREFIX || !ParseInteger(token.substr(CPU_PREFIX.size()), cpu)) {
+			return false;
+		}
+		cpus.push_back(cpu);
+	}
+	return !cpus.empty();
+}
+
+// Append the tokens of [text] to [result], separated by single spaces.
+void AppendCollapsed(std::string_view text, string &result) {
+	size_t pos = 0;
+	std::string_view token;
+	while (NextToken(text, pos, token)) {
+		if (!result.empty()) {
+			result += ' ';
+		}
+		result.append(token.data(), token.size());
+	}
+}
+
+#ifdef __linux__
+// Read the first line of a small sysfs or procfs file, or empty if it cannot be read.
+string ReadFirstLine(const char *path) {
+	std::array<char, 4096> buf;
+	size_t pos = 0;
+	std::string_view line;
+	NextLine(ReadFileAt(AT_FDCWD, path, buf), pos, line);
+	return string(line);
+}
+
+void SampleInterruptTable(ClientContext &context, const char *path, InterruptTable &table) {
+	string content;
+	if (!ReadProcFile(context, path, content)) {
+		return;
+	}
+	if (!ParseInterruptTable(content, table)) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to parse %s", path);
+		}
+	}
+}
+
+void SampleInterrupts(ClientContext &context, InterruptStats &stats) {
+	stats.hardirqs.type = InterruptType::HARDIRQ;
+	SampleInterruptTable(context, "/proc/interrupts", stats.hardirqs);
+	stats.softirqs.type = InterruptType::SOFTIRQ;
+	SampleInterruptTable(context, "/proc/softirqs", stats.softirqs);
+}
+
+// Read CPU affinity and handler names of numbered interrupts; named ones (i.e. "LOC") have neither.
+void ReadInterruptDetails(InterruptTable &table) {
+	std::array<char, 64> path;
+	for (auto &source : table.sources) {
+		uint32_t irq = 0;
+		if (!ParseInteger(source.irq, irq)) {
+			continue;
+		}
+		snprintf(path.data(), path.size(), "/proc/irq/%u/smp_affinity_list", irq);
+		source.smp_affinity = ReadFirstLine(path.data());
+		snprintf(path.data(), path.size(), "/sys/kernel/irq/%u/actions", irq);
+		source.device = ReadFirstLine(path.data());
+	}
+}
+#endif
+
+} // namespace
+
+bool ParseInterruptTable(std::string_view content, InterruptTable &table) {
+	table.cpus.clear();
+	table.sources.clear();
+	table.counts.clear();
+	table.rates.clear();
+	table.has_rate.clear();
+
+	size_t pos = 0;
+	std::string_view line;
+	if (!NextLine(content, pos, line) || !ParseCpuHeader(line, table.cpus)) {
+		return false;
+	}
+	const idx_t cpu_count = table.cpus.size();
+	const auto line_count = static_cast<idx_t>(std::count(content.begin() + pos, content.end(), '\n'));
+	table.sources.reserve(line_count);
+	table.counts.reserve(line_count * cpu_count);
+
+	// Counts of one line, plus the first token after them where the description starts.
+	vector<std::string_view> tokens(cpu_count + 1);
+	while (NextLine(content, pos, line)) {
+		const size_t colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			continue;
+		}
+		size_t label_pos = 0;
+		std::string_view label;
+		if (!NextToken(line.substr(0, colon), label_pos, label)) {
+			continue;
+		}
+
+		const auto rest = line.substr(colon + 1);
+		const idx_t token_count = SplitTokens(rest, tokens.data(), cpu_count + 1);
+		const idx_t count_offset = table.counts.size();
+		idx_t count_size = 0;
+		for (; count_size < token_count && count_size < cpu_count; count_size++) {
+			uint64_t value = 0;
+			if (!ParseUint64(tokens[count_size], value)) {
+				break;
+			}
+			table.counts.push_back(value);
+		}
+		// Either one count per CPU, or a single total.
+		if (count_size != cpu_count && count_size != 1) {
+			table.counts.resize(count_offset);
+			continue;
+		}
+
+		table.sources.emplace_back();
+		auto &source = table.sources.back();
+		source.irq = string(label);
+		source.count_offset = count_offset;
+		source.count_size = count_size;
+		source.per_cpu = count_size == cpu_count && !IsSystemWideIrq(label);
+		if (count_size < token_count) {
+			const auto description_pos = static_cast<size_t>(tokens[count_size].data() - rest.data());
+			AppendCollapsed(rest.substr(description_pos), source.description);
+		}
+	}
+	return true;
+}
+
+void ComputeInterruptRates(const InterruptTable &before, InterruptTable &after, uint64_t interval_ns) {
+	after.rates.assign(after.counts.size(), 0);
+	after.has_rate.assign(after.counts.size(), false);
+	if (interval_ns == 0) {
+		return;
+	}
+	const double interval_seconds = static_cast<double>(interval_ns) / 1e9;
+
+	// Column in [before] of each CPU column in [after].
+	unordered_map<int32_t, idx_t> before_columns;
+	for (idx_t col = 0; col < before.cpus.size(); col++) {
+		before_columns.emplace(before.cpus[col], col);
+	}
+	vector<idx_t> column_map(after.cpus.size(), DConstants::INVALID_INDEX);
+	for (idx_t col = 0; col < after.cpus.size(); col++) {
+		auto iter = before_columns.find(after.cpus[col]);
+		if (iter != before_columns.end()) {
+			column_map[col] = iter->second;
+		}
+	}
+
+	unordered_map<std::string_view, const InterruptSource *> before_sources;
+	before_sources.reserve(before.sources.size());
+	for (const auto &source : before.sources) {
+		before_sources.emplace(source.irq, &source);
+	}
+
+	auto set_rate = [&](idx_t after_idx, idx_t before_idx) {
+		after.rates[after_idx] = GetCounterDelta(before.counts[before_idx], after.counts[after_idx]) / interval_seconds;
+		after.has_rate[after_idx] = true;
+	};
+	for (const auto &cur : after.sources) {
+		auto iter = before_sources.find(cur.irq);
+		if (iter == before_sources.end() || iter->second->per_cpu != cur.per_cpu) {
+			continue;
+		}
+		const auto &prev = *iter->second;
+		if (!cur.per_cpu) {
+			set_rate(cur.count_offset, prev.count_offset);
+			continue;
+		}
+		for (idx_t col = 0; col < cur.count_size; col++) {
+			if (column_map[col] != DConstants::INVALID_INDEX) {
+				set_rate(cur.count_offset + col, prev.count_offset + column_map[col]);
+			}
+		}
+	}
+}
+
+InterruptStats GetInterruptStats(ClientContext &context, int64_t interval_micros, bool read_details) {
+#ifdef __linux__
+	InterruptStats stats;
+	if (interval_micros <= 0) {
+		SampleInterrupts(context, stats);
+	} else {
+		InterruptStats before;
+		const uint64_t before_ns = GetMonotonicTimestampNs();
+		SampleInterrupts(context, before);
+		std::this_thread::sleep_for(std::chrono::microseconds(interval_micros));
+		const uint64_t after_ns = GetMonotonicTimestampNs();
+		SampleInterrupts(context, stats);
+		ComputeInterruptRates(before.hardirqs, stats.hardirqs, after_ns - before_ns);
+		ComputeInterruptRates(before.softirqs, stats.softirqs, after_ns - before_ns);
+	}
+	if (read_details) {
+		ReadInterruptDetails(stats.hardirqs);
+	}
+	return stats;
+#elif __APPLE__
+	// procfs is not available on macOS.
+	return {};
+#else
+	throw NotImplementedException("Interrupt statistics are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
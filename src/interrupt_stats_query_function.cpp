@@ -0,0 +1,204 @@
+#include "interrupt_stats_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "interrupt_stats.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// The query sleeps for the whole interval and cannot be interrupted meanwhile.
+constexpr int64_t MAX_INTERVAL_MICROS = 60 * Interval::MICROS_PER_SEC;
+
+// Columns read from /proc/irq and /sys/kernel/irq, one file per interrupt.
+constexpr column_t SMP_AFFINITY_COLUMN = 5;
+constexpr column_t DEVICE_COLUMN = 6;
+
+bool NeedsDetails(const vector<column_t> &column_ids) {
+	for (const auto column_id : column_ids) {
+		if (column_id == SMP_AFFINITY_COLUMN || column_id == DEVICE_COLUMN) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Value NullIfEmpty(const string &str) {
+	return str.empty() ? Value(LogicalType::VARCHAR) : Value(str);
+}
+
+struct SysInterruptsBindData : public FunctionData {
+	// No sampling interval by default, so rates are NULL.
+	int64_t interval_micros = 0;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysInterruptsBindData>();
+		return interval_micros == other.interval_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysInterruptsBindData>();
+		result->interval_micros = interval_micros;
+		return std::move(result);
+	}
+};
+
+struct SysInterruptsData : public GlobalTableFunctionState {
+	SysInterruptsData(ClientContext &context, int64_t interval_micros, vector<column_t> column_ids_p)
+	    : finished(false), table_index(0), source_index(0), cpu_index(0), column_ids(std::move(column_ids_p)),
+	      stats(GetInterruptStats(context, interval_micros, NeedsDetails(column_ids))) {
+	}
+	bool finished;
+	// Position of the next row: hardirqs then softirqs, one row per interrupt and CPU.
+	idx_t table_index;
+	idx_t source_index;
+	idx_t cpu_index;
+	vector<column_t> column_ids;
+	InterruptStats stats;
+
+	const InterruptTable *GetTable(idx_t index) const {
+		return index == 0 ? &stats.hardirqs : index == 1 ? &stats.softirqs : nullptr;
+	}
+};
+
+unique_ptr<FunctionData> SysInterruptsBind(ClientContext &context, TableFunctionBindInput &input,
+                                           vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(8);
+	names.reserve(8);
+
+	auto result = make_uniq<SysInterruptsBindData>();
+
+	// Parse interval parameter if provided
+	auto interval_it = input.named_parameters.find("interval");
+	if (interval_it != input.named_parameters.end()) {
+		result->interval_micros = Interval::GetMicro(interval_it->second.GetValue<interval_t>());
+		if (result->interval_micros <= 0 || result->interval_micros > MAX_INTERVAL_MICROS) {
+			throw InvalidInputException(
+			    "Sampling interval for sys_interrupts must be positive and at most 60 seconds, but got '%s'",
+			    interval_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("type");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("irq");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("cpu");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("rate_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("smp_affinity");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("device");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("description");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysInterruptsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysInterruptsBindData>();
+	return make_uniq<SysInterruptsData>(context, bind_data.interval_micros, input.column_ids);
+}
+
+void SysInterruptsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysInterruptsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+
+	// Output rows in batches
+	const InterruptTable *table = data.GetTable(data.table_index);
+	while (table != nullptr && output_count < STANDARD_VECTOR_SIZE) {
+		if (data.source_index >= table->sources.size()) {
+			table = data.GetTable(++data.table_index);
+			data.source_index = 0;
+			data.cpu_index = 0;
+			continue;
+		}
+		const auto &source = table->sources[data.source_index];
+		const idx_t count_index = source.count_offset + data.cpu_index;
+
+		for (idx_t col_idx = 0; col_idx < data.column_ids.size(); col_idx++) {
+			switch (data.column_ids[col_idx]) {
+			case 0: // type
+				output.SetValue(col_idx, output_count,
+				                Value(table->type == InterruptType::HARDIRQ ? "hardirq" : "softirq"));
+				break;
+			case 1: // irq
+				output.SetValue(col_idx, output_count, Value(source.irq));
+				break;
+			case 2: // cpu, NULL for system-wide totals
+				output.SetValue(col_idx, output_count,
+				                source.per_cpu ? Value::INTEGER(table->cpus[data.cpu_index])
+				                               : Value(LogicalType::INTEGER));
+				break;
+			case 3: // count
+				output.SetValue(col_idx, output_count, Value::UBIGINT(table->counts[count_index]));
+				break;
+			case 4: // rate_per_sec, NULL without sampling interval
+				output.SetValue(col_idx, output_count,
+				                !table->has_rate.empty() && table->has_rate[count_index]
+				                    ? Value::DOUBLE(table->rates[count_index])
+				                    : Value(LogicalType::DOUBLE));
+				break;
+			case SMP_AFFINITY_COLUMN: // smp_affinity
+				output.SetValue(col_idx, output_count, NullIfEmpty(source.smp_affinity));
+				break;
+			case DEVICE_COLUMN: // device
+				output.SetValue(col_idx, output_count, NullIfEmpty(source.device));
+				break;
+			case 7: // description
+				output.SetValue(col_idx, output_count, NullIfEmpty(source.description));
+				break;
+			default: // virtual columns, i.e. the row id requested for count(*)
+				output.SetValue(col_idx, output_count, Value(output.data[col_idx].GetType()));
+				break;
+			}
+		}
+
+		output_count++;
+		if (!source.per_cpu || ++data.cpu_index >= source.count_size) {
+			data.source_index++;
+			data.cpu_index = 0;
+		}
+	}
+
+	if (table == nullptr) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysInterruptsFunction(ExtensionLoader &loader) {
+	TableFunction sys_interrupts_func("sys_interrupts", {}, SysInterruptsFunc, SysInterruptsBind, SysInterruptsInit);
+	sys_interrupts_func.named_parameters["interval"] = LogicalType::INTERVAL;
+	sys_interrupts_func.projection_pushdown = true;
+	loader.RegisterFunction(sys_interrupts_func);
+}
+
+} // namespace duckdb
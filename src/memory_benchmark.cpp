@@ -0,0 +1,518 @@
+#include "memory_benchmark.hpp"
+
+#include "cpu_topology.hpp"
+#include "database_instance_cache.hpp"
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "time_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SYSTEM_STATS_STREAM_X86_64 1
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Doubles per cache line; worker slices start at cache line boundaries, so vector stores are aligned.
+constexpr idx_t DOUBLES_PER_LINE = 8;
+constexpr idx_t CACHE_LINE_SIZE = 64;
+// Repetitions per kernel; like STREAM, the best one is reported.
+constexpr idx_t MAX_REPETITIONS = 10;
+// Arrays are whole pages, so every array is aligned for vector stores.
+constexpr uint64_t ARRAY_ALIGNMENT = 4096;
+// Links followed between checks of the time limit.
+constexpr idx_t CHASE_BATCH_STEPS = 1 << 16;
+
+void CopyScalar(double *c, const double *a, idx_t begin, idx_t end) {
+	for (idx_t idx = begin; idx < end; idx++) {
+		c[idx] = a[idx];
+	}
+}
+
+void ScaleScalar(double *b, const double *c, idx_t begin, idx_t end) {
+	for (idx_t idx = begin; idx < end; idx++) {
+		b[idx] = STREAM_SCALAR * c[idx];
+	}
+}
+
+void AddScalar(double *c, const double *a, const double *b, idx_t begin, idx_t end) {
+	for (idx_t idx = begin; idx < end; idx++) {
+		c[idx] = a[idx] + b[idx];
+	}
+}
+
+void TriadScalar(double *a, const double *b, const double *c, idx_t begin, idx_t end) {
+	for (idx_t idx = begin; idx < end; idx++) {
+		a[idx] = b[idx] + STREAM_SCALAR * c[idx];
+	}
+}
+
+#ifdef SYSTEM_STATS_STREAM_X86_64
+// Non-temporal stores bypass the caches, so the destination is not read first and the measured bandwidth is the one
+// of memory rather than of the write-allocate traffic. SSE2 is part of x86-64, so it needs no runtime check.
+void CopySSE2(double *c, const double *a, idx_t begin, idx_t end) {
+	idx_t idx = begin;
+	for (; idx + 2 <= end; idx += 2) {
+		_mm_stream_pd(c + idx, _mm_load_pd(a + idx));
+	}
+	CopyScalar(c, a, idx, end);
+	_mm_sfence();
+}
+
+void ScaleSSE2(double *b, const double *c, idx_t begin, idx_t end) {
+	const __m128d scalar = _mm_set1_pd(STREAM_SCALAR);
+	idx_t idx = begin;
+	for (; idx + 2 <= end; idx += 2) {
+		_mm_stream_pd(b + idx, _mm_mul_pd(scalar, _mm_load_pd(c + idx)));
+	}
+	ScaleScalar(b, c, idx, end);
+	_mm_sfence();
+}
+
+void AddSSE2(double *c, const double *a, const double *b, idx_t begin, idx_t end) {
+	idx_t idx = begin;
+	for (; idx + 2 <= end; idx += 2) {
+		_mm_stream_pd(c + idx, _mm_add_pd(_mm_load_pd(a + idx), _mm_load_pd(b + idx)));
+	}
+	AddScalar(c, a, b, idx, end);
+	_mm_sfence();
+}
+
+void TriadSSE2(double *a, const double *b, const double *c, idx_t begin, idx_t end) {
+	const __m128d scalar = _mm_set1_pd(STREAM_SCALAR);
+	idx_t idx = begin;
+	for (; idx + 2 <= end; idx += 2) {
+		_mm_stream_pd(a + idx, _mm_add_pd(_mm_load_pd(b + idx), _mm_mul_pd(scalar, _mm_load_pd(c + idx))));
+	}
+	TriadScalar(a, b, c, idx, end);
+	_mm_sfence();
+}
+
+__attribute__((target("avx"))) void CopyAVX(double *c, const double *a, idx_t begin, idx_t end) {
+	idx_t idx = begin;
+	for (; idx + 4 <= end; idx += 4) {
+		_mm256_stream_pd(c + idx, _mm256_load_pd(a + idx));
+	}
+	CopyScalar(c, a, idx, end);
+	_mm_sfence();
+}
+
+__attribute__((target("avx"))) void ScaleAVX(double *b, const double *c, idx_t begin, idx_t end) {
+	const __m256d scalar = _mm256_set1_pd(STREAM_SCALAR);
+	idx_t idx = begin;
+	for (; idx + 4 <= end; idx += 4) {
+		_mm256_stream_pd(b + idx, _mm256_mul_pd(scalar, _mm256_load_pd(c + idx)));
+	}
+	ScaleScalar(b, c, idx, end);
+	_mm_sfence();
+}
+
+__attribute__((target("avx"))) void AddAVX(double *c, const double *a, const double *b, idx_t begin, idx_t end) {
+	idx_t idx = begin;
+	for (; idx + 4 <= end; idx += 4) {
+		_mm256_stream_pd(c + idx, _mm256_add_pd(_mm256_load_pd(a + idx), _mm256_load_pd(b + idx)));
+	}
+	AddScalar(c, a, b, idx, end);
+	_mm_sfence();
+}
+
+__attribute__((target("avx"))) void TriadAVX(double *a, const double *b, const double *c, idx_t begin, idx_t end) {
+	const __m256d scalar = _mm256_set1_pd(STREAM_SCALAR);
+	idx_t idx = begin;
+	for (; idx + 4 <= end; idx += 4) {
+		_mm256_stream_pd(a + idx,
+		                 _mm256_add_pd(_mm256_load_pd(b + idx), _mm256_mul_pd(scalar, _mm256_load_pd(c + idx))));
+	}
+	TriadScalar(a, b, c, idx, end);
+	_mm_sfence();
+}
+#endif
+
+struct StreamImplementation {
+	void (*copy)(double *c, const double *a, idx_t begin, idx_t end);
+	void (*scale)(double *b, const double *c, idx_t begin, idx_t end);
+	void (*add)(double *c, const double *a, const double *b, idx_t begin, idx_t end);
+	void (*triad)(double *a, const double *b, const double *c, idx_t begin, idx_t end);
+	const char *name;
+};
+
+StreamImplementation SelectImplementation() {
+#ifdef SYSTEM_STATS_STREAM_X86_64
+	if (__builtin_cpu_supports("avx")) {
+		return {CopyAVX, ScaleAVX, AddAVX, TriadAVX, "avx"};
+	}
+	return {CopySSE2, ScaleSSE2, AddSSE2, TriadSSE2, "sse2"};
+#else
+	return {CopyScalar, ScaleScalar, AddScalar, TriadScalar, "scalar"};
+#endif
+}
+
+const StreamImplementation &GetImplementation() {
+	static const StreamImplementation implementation = SelectImplementation();
+	return implementation;
+}
+
+#ifdef __linux__
+// From linux/mempolicy.h, which is not installed everywhere.
+constexpr int MPOL_PREFERRED_MODE = 1;
+// Nodes the node mask of mbind(2) holds.
+constexpr int32_t MAX_NODE_ID = 1023;
+
+constexpr StreamKernel STREAM_KERNELS[] = {StreamKernel::COPY, StreamKernel::SCALE, StreamKernel::ADD,
+                                           StreamKernel::TRIAD};
+// Measurements per pair of nodes, the STREAM kernels and the pointer chase.
+constexpr idx_t MEASUREMENTS_PER_PAIR = 5;
+
+// Anonymous memory placed on one NUMA node: the STREAM arrays followed by the pointer chase buffer.
+class NodeMemory {
+public:
+	NodeMemory(ClientContext &context, int32_t node, bool bind, uint64_t array_bytes) : size(4 * array_bytes) {
+		data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (data == MAP_FAILED) {
+			throw OutOfMemoryException("Failed to allocate %llu bytes for the memory benchmark: %s", size,
+			                           strerror(errno));
+		}
+		// Fewer TLB misses, so the pointer chase measures memory rather than page walks where huge pages are enabled.
+		madvise(data, size, MADV_HUGEPAGE);
+		// Preferred rather than bound, so a full node falls back to others instead of failing. Pages are touched
+		// first by a thread of the node as well, which places them on it if mbind(2) is blocked, i.e. by seccomp.
+		if (bind && node <= MAX_NODE_ID) {
+			unsigned long node_mask[(MAX_NODE_ID + 1) / (8 * sizeof(unsigned long))] = {};
+			node_mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+			if (syscall(SYS_mbind, data, size, MPOL_PREFERRED_MODE, node_mask, MAX_NODE_ID + 2, 0) != 0) {
+				if (auto db = GetDbInstance(context)) {
+					DUCKDB_LOG_DEBUG(*db, "Failed to bind memory benchmark buffers to node %d: %s", node,
+					                 strerror(errno));
+				}
+			}
+		}
+		auto *arrays_data = static_cast<double *>(data);
+		const idx_t count = array_bytes / sizeof(double);
+		arrays.a = arrays_data;
+		arrays.b = arrays_data + count;
+		arrays.c = arrays_data + 2 * count;
+		arrays.count = count;
+		chase = static_cast<char *>(data) + 3 * array_bytes;
+		chase_lines = array_bytes / CACHE_LINE_SIZE;
+	}
+	~NodeMemory() {
+		munmap(data, size);
+	}
+	NodeMemory(const NodeMemory &) = delete;
+	NodeMemory &operator=(const NodeMemory &) = delete;
+
+	StreamArrays arrays;
+	void *chase;
+	idx_t chase_lines;
+
+private:
+	void *data;
+	uint64_t size;
+};
+
+// Fill the arrays and link the pointer chase from a thread pinned to [cpus], so first touch places the pages there.
+void InitializeNodeMemory(NodeMemory &memory, const vector<int32_t> &cpus) {
+	std::thread init_thread([&]() {
+		SetThreadAffinity(0, cpus);
+		std::fill_n(memory.arrays.a, memory.arrays.count, 1.0);
+		std::fill_n(memory.arrays.b, memory.arrays.count, 2.0);
+		std::fill_n(memory.arrays.c, memory.arrays.count, 0.0);
+		BuildPointerChase(memory.chase, memory.chase_lines, std::random_device {}());
+	});
+	init_thread.join();
+}
+
+// Threads pinned to the CPUs of one node, which run a STREAM kernel on their slice of the arrays on request.
+class StreamWorkers {
+public:
+	StreamWorkers(const vector<int32_t> &cpus, idx_t thread_count) {
+		threads.reserve(thread_count);
+		try {
+			for (idx_t idx = 0; idx < thread_count; idx++) {
+				threads.emplace_back([this, idx, thread_count, cpu = cpus[idx % cpus.size()]]() {
+					SetThreadAffinity(0, {cpu});
+					Work(idx, thread_count);
+				});
+			}
+		} catch (...) {
+			// Threads started so far have to be joined before they are destroyed.
+			StopThreads();
+			throw;
+		}
+	}
+	~StreamWorkers() {
+		StopThreads();
+	}
+	StreamWorkers(const StreamWorkers &) = delete;
+	StreamWorkers &operator=(const StreamWorkers &) = delete;
+
+	// Run [kernel_p] over [arrays_p] on all workers; return the time until the last one finished.
+	uint64_t Run(StreamKernel kernel_p, const StreamArrays &arrays_p) {
+		const uint64_t start_ns = GetMonotonicTimestampNs();
+		{
+			lock_guard<mutex> lock(mu);
+			kernel = kernel_p;
+			arrays = arrays_p;
+			pending = threads.size();
+			generation++;
+		}
+		start_cv.notify_all();
+		std::unique_lock<mutex> lock(mu);
+		done_cv.wait(lock, [this]() { return pending == 0; });
+		return GetMonotonicTimestampNs() - start_ns;
+	}
+
+private:
+	void StopThreads() {
+		{
+			lock_guard<mutex> lock(mu);
+			stop = true;
+		}
+		start_cv.notify_all();
+		for (auto &thread : threads) {
+			thread.join();
+		}
+		threads.clear();
+	}
+
+	void Work(idx_t index, idx_t thread_count) {
+		uint64_t seen_generation = 0;
+		while (true) {
+			StreamKernel current_kernel;
+			StreamArrays current_arrays;
+			{
+				std::unique_lock<mutex> lock(mu);
+				start_cv.wait(lock, [&]() { return stop || generation != seen_generation; });
+				if (stop) {
+					return;
+				}
+				seen_generation = generation;
+				current_kernel = kernel;
+				current_arrays = arrays;
+			}
+			// Slices of whole cache lines; the last worker takes the remainder.
+			const idx_t lines = current_arrays.count / DOUBLES_PER_LINE;
+			const idx_t begin = lines * index / thread_count * DOUBLES_PER_LINE;
+			const bool is_last = index + 1 == thread_count;
+			const idx_t end = is_last ? current_arrays.count : lines * (index + 1) / thread_count * DOUBLES_PER_LINE;
+			RunStreamKernel(current_kernel, current_arrays, begin, end);
+			{
+				lock_guard<mutex> lock(mu);
+				pending--;
+			}
+			done_cv.notify_one();
+		}
+	}
+
+	mutex mu;
+	std::condition_variable start_cv;
+	std::condition_variable done_cv;
+	bool stop = false;
+	uint64_t generation = 0;
+	idx_t pending = 0;
+	StreamKernel kernel = StreamKernel::COPY;
+	StreamArrays arrays;
+	vector<std::thread> threads;
+};
+
+// Split the time left until [deadline_ns] evenly between the [measurements_left].
+uint64_t GetMeasurementBudget(uint64_t deadline_ns, idx_t measurements_left) {
+	const uint64_t now_ns = GetMonotonicTimestampNs();
+	return now_ns >= deadline_ns ? 0 : (deadline_ns - now_ns) / MaxValue<idx_t>(measurements_left, 1);
+}
+
+// Best bandwidth of up to [MAX_REPETITIONS] runs of [kernel] within [budget_ns]; at least one run is done.
+double MeasureKernel(StreamWorkers &workers, StreamKernel kernel, const StreamArrays &arrays, uint64_t budget_ns) {
+	const double bytes = static_cast<double>(GetStreamBytesPerElement(kernel) * arrays.count);
+	uint64_t best_ns = 0;
+	uint64_t total_ns = 0;
+	for (idx_t repetition = 0; repetition < MAX_REPETITIONS; repetition++) {
+		const uint64_t elapsed_ns = MaxValue<uint64_t>(workers.Run(kernel, arrays), 1);
+		best_ns = best_ns == 0 ? elapsed_ns : MinValue(best_ns, elapsed_ns);
+		total_ns += elapsed_ns;
+		if (total_ns >= budget_ns) {
+			break;
+		}
+	}
+	return bytes * 1e9 / static_cast<double>(best_ns);
+}
+
+// Mean latency of the pointer chase of [memory] from a thread pinned to [cpu], within [budget_ns].
+double MeasureLatency(const NodeMemory &memory, int32_t cpu, uint64_t budget_ns) {
+	double latency_ns = 0;
+	std::thread chase_thread([&]() {
+		SetThreadAffinity(0, {cpu});
+		// Warm up the TLB and the caches of the page tables.
+		const void *line = ChasePointers(memory.chase, CHASE_BATCH_STEPS);
+		idx_t steps = 0;
+		const uint64_t start_ns = GetMonotonicTimestampNs();
+		uint64_t elapsed_ns = 0;
+		do {
+			line = ChasePointers(line, CHASE_BATCH_STEPS);
+			steps += CHASE_BATCH_STEPS;
+			elapsed_ns = GetMonotonicTimestampNs() - start_ns;
+		} while (elapsed_ns < budget_ns);
+		// The line reached is used, so the chase cannot be optimized away.
+		latency_ns = line ? static_cast<double>(elapsed_ns) / static_cast<double>(steps) : 0;
+	});
+	chase_thread.join();
+	return latency_ns;
+}
+
+MemoryBandwidth MeasureNodePair(ClientContext &context, StreamWorkers &workers, const NumaNodeInfo &cpu_node,
+                                const NumaNodeInfo &memory_node, bool bind, uint64_t array_bytes,
+                                uint64_t deadline_ns, idx_t measurements_left) {
+	NodeMemory memory(context, memory_node.node, bind, array_bytes);
+	InitializeNodeMemory(memory, memory_node.cpus);
+
+	MemoryBandwidth bandwidth;
+	double *results[] = {&bandwidth.copy_bytes_per_sec, &bandwidth.scale_bytes_per_sec, &bandwidth.add_bytes_per_sec,
+	                     &bandwidth.triad_bytes_per_sec};
+	for (idx_t idx = 0; idx < 4; idx++) {
+		*results[idx] = MeasureKernel(workers, STREAM_KERNELS[idx], memory.arrays,
+		                              GetMeasurementBudget(deadline_ns, measurements_left--));
+	}
+	bandwidth.latency_ns =
+	    MeasureLatency(memory, cpu_node.cpus[0], GetMeasurementBudget(deadline_ns, measurements_left--));
+	return bandwidth;
+}
+
+vector<MemoryBenchmarkResult> RunMemoryBenchmarkLinux(ClientContext &context, const MemoryBenchmarkOptions &options) {
+	const vector<NumaNodeInfo> nodes = GetNumaNodes();
+	vector<idx_t> node_indexes;
+	for (idx_t idx = 0; idx < nodes.size(); idx++) {
+		if (options.node < 0 || nodes[idx].node == options.node) {
+			node_indexes.emplace_back(idx);
+		}
+	}
+	if (node_indexes.empty()) {
+		throw InvalidInputException("NUMA node %d has no CPUs available to sys_memory_benchmark", options.node);
+	}
+
+	const uint64_t array_bytes = MaxValue<uint64_t>(options.array_bytes / ARRAY_ALIGNMENT, 1) * ARRAY_ALIGNMENT;
+	const bool has_remote = nodes.size() > 1;
+	idx_t measurements_left = node_indexes.size() * MEASUREMENTS_PER_PAIR * (has_remote ? 2 : 1);
+	const uint64_t deadline_ns =
+	    GetMonotonicTimestampNs() + NumericCast<uint64_t>(options.max_duration_micros) * 1000;
+
+	vector<MemoryBenchmarkResult> results;
+	for (const auto node_idx : node_indexes) {
+		const auto &node = nodes[node_idx];
+		const uint64_t start_ns = GetMonotonicTimestampNs();
+		MemoryBenchmarkResult result;
+		result.node = node.node;
+		result.cpu_count = node.cpus.size();
+		result.threads = options.threads == 0 ? node.cpus.size() : options.threads;
+		result.array_bytes = array_bytes;
+
+		StreamWorkers workers(node.cpus, result.threads);
+		result.local = MeasureNodePair(context, workers, node, node, has_remote, array_bytes, deadline_ns,
+		                               measurements_left);
+		measurements_left -= MEASUREMENTS_PER_PAIR;
+		if (has_remote) {
+			// The next node, which is the other socket of two socket hosts.
+			const auto &remote_node = nodes[(node_idx + 1) % nodes.size()];
+			result.remote_node = remote_node.node;
+			result.remote = MeasureNodePair(context, workers, node, remote_node, true, array_bytes,
+			                                deadline_ns, measurements_left);
+			measurements_left -= MEASUREMENTS_PER_PAIR;
+		}
+		result.elapsed_ns = GetMonotonicTimestampNs() - start_ns;
+		results.emplace_back(std::move(result));
+	}
+	return results;
+}
+#endif
+
+} // namespace
+
+void RunStreamKernel(StreamKernel kernel, const StreamArrays &arrays, idx_t begin, idx_t end) {
+	D_ASSERT(begin % DOUBLES_PER_LINE == 0);
+	const auto &implementation = GetImplementation();
+	switch (kernel) {
+	case StreamKernel::COPY:
+		implementation.copy(arrays.c, arrays.a, begin, end);
+		break;
+	case StreamKernel::SCALE:
+		implementation.scale(arrays.b, arrays.c, begin, end);
+		break;
+	case StreamKernel::ADD:
+		implementation.add(arrays.c, arrays.a, arrays.b, begin, end);
+		break;
+	case StreamKernel::TRIAD:
+		implementation.triad(arrays.a, arrays.b, arrays.c, begin, end);
+		break;
+	}
+}
+
+idx_t GetStreamBytesPerElement(StreamKernel kernel) {
+	switch (kernel) {
+	case StreamKernel::COPY:
+	case StreamKernel::SCALE:
+		return 2 * sizeof(double);
+	case StreamKernel::ADD:
+	case StreamKernel::TRIAD:
+		return 3 * sizeof(double);
+	}
+	return 0;
+}
+
+const char *GetStreamImplementation() {
+	return GetImplementation().name;
+}
+
+void BuildPointerChase(void *buffer, idx_t line_count, uint64_t seed) {
+	if (line_count == 0) {
+		return;
+	}
+	// Sattolo's algorithm, whose permutations are a single cycle, so the chase visits every line.
+	vector<uint32_t> order(line_count);
+	for (idx_t idx = 0; idx < line_count; idx++) {
+		order[idx] = NumericCast<uint32_t>(idx);
+	}
+	std::mt19937_64 rng(seed);
+	for (idx_t idx = line_count - 1; idx > 0; idx--) {
+		std::swap(order[idx], order[rng() % idx]);
+	}
+	auto *lines = static_cast<char *>(buffer);
+	for (idx_t idx = 0; idx < line_count; idx++) {
+		void *next = lines + order[idx] * CACHE_LINE_SIZE;
+		memcpy(lines + idx * CACHE_LINE_SIZE, &next, sizeof(next));
+	}
+}
+
+const void *ChasePointers(const void *start, idx_t steps) {
+	const void *line = start;
+	for (idx_t step = 0; step < steps; step++) {
+		line = *static_cast<const void *const *>(line);
+	}
+	return line;
+}
+
+vector<MemoryBenchmarkResult> RunMemoryBenchmark(ClientContext &context, const MemoryBenchmarkOptions &options) {
+#ifdef __linux__
+	return RunMemoryBenchmarkLinux(context, options);
+#else
+	throw NotImplementedException("Memory benchmarks are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,231 @@
+#include "memory_benchmark_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "memory_benchmark.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Default bytes per STREAM array, several times the last level cache of most CPUs.
+constexpr int64_t DEFAULT_ARRAY_BYTES = 64LL << 20;
+constexpr int64_t MIN_ARRAY_BYTES = 1LL << 20;
+constexpr int64_t MAX_ARRAY_BYTES = 1LL << 30;
+constexpr int64_t MAX_THREADS = 4096;
+// Default time limit of the whole benchmark.
+constexpr int64_t DEFAULT_MAX_DURATION_MICROS = 10 * Interval::MICROS_PER_SEC;
+
+Value BytesPerSecToGBps(double bytes_per_sec) {
+	return Value::DOUBLE(bytes_per_sec / 1e9);
+}
+
+struct SysMemoryBenchmarkBindData : public FunctionData {
+	MemoryBenchmarkOptions options;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysMemoryBenchmarkBindData>();
+		return options.node == other.options.node && options.threads == other.options.threads &&
+		       options.array_bytes == other.options.array_bytes &&
+		       options.max_duration_micros == other.options.max_duration_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysMemoryBenchmarkBindData>();
+		result->options = options;
+		return std::move(result);
+	}
+};
+
+struct SysMemoryBenchmarkData : public GlobalTableFunctionState {
+	SysMemoryBenchmarkData(ClientContext &context, const SysMemoryBenchmarkBindData &bind_data)
+	    : finished(false), current_index(0), results(RunMemoryBenchmark(context, bind_data.options)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<MemoryBenchmarkResult> results;
+};
+
+void AddBandwidthColumns(const string &prefix, vector<LogicalType> &return_types, vector<string> &names) {
+	for (const char *kernel : {"copy", "scale", "add", "triad"}) {
+		names.emplace_back(prefix + kernel + "_gbps");
+		return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	}
+	names.emplace_back(prefix + "latency_ns");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+}
+
+void SetBandwidthValues(DataChunk &output, idx_t &col_idx, idx_t row, const MemoryBandwidth &bandwidth, bool valid) {
+	for (const double bytes_per_sec : {bandwidth.copy_bytes_per_sec, bandwidth.scale_bytes_per_sec,
+	                                   bandwidth.add_bytes_per_sec, bandwidth.triad_bytes_per_sec}) {
+		output.SetValue(col_idx++, row, valid ? BytesPerSecToGBps(bytes_per_sec) : Value(LogicalType::DOUBLE));
+	}
+	output.SetValue(col_idx++, row, valid ? Value::DOUBLE(bandwidth.latency_ns) : Value(LogicalType::DOUBLE));
+}
+
+unique_ptr<FunctionData> SysMemoryBenchmarkBind(ClientContext &context, TableFunctionBindInput &input,
+                                                vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(17);
+	names.reserve(17);
+
+	auto result = make_uniq<SysMemoryBenchmarkBindData>();
+	result->options.array_bytes = DEFAULT_ARRAY_BYTES;
+	result->options.max_duration_micros = DEFAULT_MAX_DURATION_MICROS;
+
+	// Parse node parameter if provided, NULL benchmarks every node
+	auto node_it = input.named_parameters.find("node");
+	if (node_it != input.named_parameters.end() && !node_it->second.IsNull()) {
+		result->options.node = node_it->second.GetValue<int32_t>();
+		if (result->options.node < 0) {
+			throw InvalidInputException("Node for sys_memory_benchmark must not be negative, but got '%s'",
+			                            node_it->second.ToString());
+		}
+	}
+
+	// Parse threads parameter if provided, NULL uses one thread per CPU of the node
+	auto threads_it = input.named_parameters.find("threads");
+	if (threads_it != input.named_parameters.end() && !threads_it->second.IsNull()) {
+		const int64_t threads = threads_it->second.GetValue<int64_t>();
+		if (threads <= 0 || threads > MAX_THREADS) {
+			throw InvalidInputException("Threads for sys_memory_benchmark must be between 1 and %lld, but got '%s'",
+			                            MAX_THREADS, threads_it->second.ToString());
+		}
+		result->options.threads = NumericCast<idx_t>(threads);
+	}
+
+	// Parse size parameter if provided
+	auto size_it = input.named_parameters.find("size");
+	if (size_it != input.named_parameters.end()) {
+		const int64_t size = size_it->second.IsNull() ? 0 : size_it->second.GetValue<int64_t>();
+		if (size < MIN_ARRAY_BYTES || size > MAX_ARRAY_BYTES) {
+			throw InvalidInputException(
+			    "Size for sys_memory_benchmark must be between %lld and %lld bytes, but got '%s'", MIN_ARRAY_BYTES,
+			    MAX_ARRAY_BYTES, size_it->second.ToString());
+		}
+		result->options.array_bytes = NumericCast<uint64_t>(size);
+	}
+
+	// Parse max_duration parameter if provided
+	auto duration_it = input.named_parameters.find("max_duration");
+	if (duration_it != input.named_parameters.end()) {
+		if (duration_it->second.IsNull()) {
+			throw InvalidInputException("Max duration for sys_memory_benchmark cannot be NULL");
+		}
+		result->options.max_duration_micros = Interval::GetMicro(duration_it->second.GetValue<interval_t>());
+		if (result->options.max_duration_micros <= 0) {
+			throw InvalidInputException("Max duration for sys_memory_benchmark must be positive, but got '%s'",
+			                            duration_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("node");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("cpu_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("threads");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("implementation");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("array_size_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	AddBandwidthColumns("local_", return_types, names);
+
+	names.emplace_back("remote_node");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	AddBandwidthColumns("remote_", return_types, names);
+
+	names.emplace_back("elapsed");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysMemoryBenchmarkInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysMemoryBenchmarkBindData>();
+	return make_uniq<SysMemoryBenchmarkData>(context, bind_data);
+}
+
+void SysMemoryBenchmarkFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysMemoryBenchmarkData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.results.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &result = data.results[data.current_index];
+		col_idx = 0;
+		// Cross-node columns are NULL on hosts with a single node.
+		const bool has_remote = result.remote_node >= 0;
+
+		// node
+		output.SetValue(col_idx++, output_count, Value::INTEGER(result.node));
+
+		// cpu_count
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(result.cpu_count));
+
+		// threads
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(result.threads));
+
+		// implementation
+		output.SetValue(col_idx++, output_count, Value(GetStreamImplementation()));
+
+		// array_size_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(result.array_bytes));
+
+		// local_copy_gbps, local_scale_gbps, local_add_gbps, local_triad_gbps, local_latency_ns
+		SetBandwidthValues(output, col_idx, output_count, result.local, true);
+
+		// remote_node
+		output.SetValue(col_idx++, output_count,
+		                has_remote ? Value::INTEGER(result.remote_node) : Value(LogicalType::INTEGER));
+
+		// remote_copy_gbps, remote_scale_gbps, remote_add_gbps, remote_triad_gbps, remote_latency_ns
+		SetBandwidthValues(output, col_idx, output_count, result.remote, has_remote);
+
+		// elapsed
+		output.SetValue(col_idx++, output_count,
+		                Value::INTERVAL(Interval::FromMicro(NumericCast<int64_t>(result.elapsed_ns / 1000))));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.results.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysMemoryBenchmarkFunction(ExtensionLoader &loader) {
+	TableFunction sys_memory_benchmark_func("sys_memory_benchmark", {}, SysMemoryBenchmarkFunc, SysMemoryBenchmarkBind,
+	                                        SysMemoryBenchmarkInit);
+	sys_memory_benchmark_func.named_parameters["node"] = LogicalType::INTEGER;
+	sys_memory_benchmark_func.named_parameters["threads"] = LogicalType::INTEGER;
+	sys_memory_benchmark_func.named_parameters["size"] = LogicalType::BIGINT;
+	sys_memory_benchmark_func.named_parameters["max_duration"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_memory_benchmark_func);
+}
+
+} // namespace duckdb
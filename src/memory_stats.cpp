@@ -7,6 +7,8 @@
 #include "duckdb/common/numeric_utils.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
+#include "shared_metrics.hpp"
 
 #ifdef __linux__
 #elif __APPLE__
@@ -24,12 +26,11 @@ namespace {
 #ifdef __linux__
 // Convert memory value from /proc/meminfo (in kB) to bytes
 uint64_t ParseBytesValue(const string &line) {
-	std::istringstream iss(line);
-	string key;
-	uint64_t value;
-	string unit;
-
-	if (iss >> key >> value >> unit) {
+	size_t pos = 0;
+	std::string_view key;
+	std::string_view token;
+	uint64_t value = 0;
+	if (NextToken(line, pos, key) && NextToken(line, pos, token) && ParseUint64(token, value)) {
 		// Convert from kB to bytes
 		return value * 1024;
 	}
@@ -141,6 +142,14 @@ MemoryInfo GetMemoryInfoMacOS(ClientContext &context) {
 } // namespace
 
 MemoryInfo GetMemoryInfo(ClientContext &context) {
+	MemoryInfo info;
+	if (ReadSharedMemoryInfo(context, info)) {
+		return info;
+	}
+	return CollectMemoryInfo(context);
+}
+
+MemoryInfo CollectMemoryInfo(ClientContext &context) {
 #ifdef __linux__
 	return GetMemoryInfoLinux(context);
 #elif __APPLE__
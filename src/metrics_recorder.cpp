@@ -0,0 +1,531 @@
+#include "metrics_recorder.hpp"
+
+#include "database_instance_cache.hpp"
+#include "disk_stats.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/appender.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "duckdb_resources.hpp"
+#include "memory_stats.hpp"
+#include "network_stats.hpp"
+#include "os_info.hpp"
+#include "scope_guard.hpp"
+#include "snapshot_codec.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+namespace duckdb {
+
+namespace {
+
+constexpr const char *RECORDING_FILE_PREFIX = "sys_metrics_";
+constexpr const char *PARQUET_FILE_SUFFIX = ".parquet";
+constexpr const char *SNAPSHOT_FILE_SUFFIX = ".snap";
+// Length of a UTC timestamp in recording file names, i.e. "20261018T120000Z".
+constexpr size_t FILE_TIMESTAMP_LENGTH = 16;
+// Temporary table the buffered samples are appended to before they are copied to Parquet.
+constexpr const char *BATCH_TABLE_NAME = "__sys_recorder_batch";
+// Flush before the rotation window ends once this many samples are buffered, to bound memory usage.
+constexpr idx_t MAX_BUFFERED_ROWS = 1000000;
+// Default Parquet row group size, so a 1 hour file at 1 second resolution has a handful of row groups.
+constexpr idx_t ROW_GROUP_SIZE = 122880;
+constexpr int64_t MICROS_PER_SECOND = 1000000;
+
+int64_t GetCurrentEpochMicros() {
+	auto now = std::chrono::system_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+// Format [epoch_seconds] as "20261018T120000Z".
+string FormatFileTimestamp(int64_t epoch_seconds) {
+	time_t seconds = static_cast<time_t>(epoch_seconds);
+	struct tm utc;
+	gmtime_r(&seconds, &utc);
+	char buf[FILE_TIMESTAMP_LENGTH + 1];
+	strftime(buf, sizeof(buf), "%Y%m%dT%H%M%SZ", &utc);
+	return string {buf};
+}
+
+bool ParseFileTimestamp(std::string_view text, int64_t &epoch_micros) {
+	if (text.size() != FILE_TIMESTAMP_LENGTH || text[8] != 'T' || text[15] != 'Z') {
+		return false;
+	}
+	struct tm utc = {};
+	const string buf {text};
+	if (sscanf(buf.c_str(), "%4d%2d%2dT%2d%2d%2dZ", &utc.tm_year, &utc.tm_mon, &utc.tm_mday, &utc.tm_hour,
+	           &utc.tm_min, &utc.tm_sec) != 6) {
+		return false;
+	}
+	utc.tm_year -= 1900;
+	utc.tm_mon -= 1;
+	epoch_micros = static_cast<int64_t>(timegm(&utc)) * MICROS_PER_SECOND;
+	return true;
+}
+
+// Recorder state shared between the cache entry and the background thread, so the thread never touches the entry,
+// which could be destroyed together with the database while the thread is still running.
+struct RecorderState {
+	RecorderConfig config;
+	weak_ptr<DatabaseInstance> db_weak;
+
+	// Only accessed by the background thread while it is running, and by the stopping thread after join.
+	// Samples of the current tick, which are kept until the flush for Parquet, or encoded right away for snapshots.
+	MetricsBatch batch;
+	SnapshotEncoder encoder;
+	// End of the rotation window of the buffered samples, in microseconds since epoch.
+	int64_t window_end_micros = 0;
+
+	// Protects the fields below.
+	mutex mu;
+	std::condition_variable cv;
+	bool stop = false;
+	uint64_t buffered_rows = 0;
+	uint64_t files_written = 0;
+	uint64_t rows_written = 0;
+	string last_error;
+};
+
+void SetLastError(RecorderState &state, const string &error) {
+	lock_guard<mutex> lock(state.mu);
+	state.last_error = error;
+}
+
+string_t ToStringT(std::string_view str) {
+	return string_t {str.data(), static_cast<uint32_t>(str.size())};
+}
+
+void ThrowOnError(QueryResult &result) {
+	if (result.HasError()) {
+		throw IOException(result.GetError());
+	}
+}
+
+bool HasSuffix(std::string_view str, std::string_view suffix) {
+	return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+const char *GetRecordingFileSuffix(RecordingFormat format) {
+	return format == RecordingFormat::SNAPSHOT ? SNAPSHOT_FILE_SUFFIX : PARQUET_FILE_SUFFIX;
+}
+
+idx_t GetBufferedRows(const RecorderState &state) {
+	return state.config.format == RecordingFormat::SNAPSHOT ? state.encoder.SampleCount() : state.batch.Size();
+}
+
+// Get the path of a new recording file covering [start_micros, end_micros].
+string GetNewRecordingPath(FileSystem &fs, const RecorderConfig &config, int64_t start_micros, int64_t end_micros) {
+	const string file_name = GetRecordingFileName(start_micros, end_micros, config.format);
+	string path = fs.JoinPath(config.path, file_name);
+	// A restarted recorder could produce a file for the same seconds.
+	const char *suffix = GetRecordingFileSuffix(config.format);
+	for (idx_t idx = 1; fs.FileExists(path); idx++) {
+		const string stem = file_name.substr(0, file_name.size() - strlen(suffix));
+		path = fs.JoinPath(config.path, StringUtil::Format("%s_%llu%s", stem, idx, suffix));
+	}
+	return path;
+}
+
+void WriteParquetFile(Connection &con, const MetricsBatch &batch, const string &temp_path) {
+	ThrowOnError(*con.Query(StringUtil::Format(
+	    "CREATE OR REPLACE TEMPORARY TABLE %s (ts TIMESTAMP, source VARCHAR, entity VARCHAR, metric VARCHAR, value "
+	    "UBIGINT)",
+	    BATCH_TABLE_NAME)));
+	{
+		Appender appender(con, "temp", "main", BATCH_TABLE_NAME);
+		for (idx_t row = 0; row < batch.Size(); row++) {
+			appender.BeginRow();
+			appender.Append<timestamp_t>(batch.timestamps[row]);
+			appender.Append<string_t>(ToStringT(batch.sources[row]));
+			if (batch.entities[row].empty()) {
+				appender.Append<Value>(Value(LogicalType::VARCHAR));
+			} else {
+				appender.Append<string_t>(ToStringT(batch.entities[row]));
+			}
+			appender.Append<string_t>(ToStringT(batch.metrics[row]));
+			appender.Append<uint64_t>(batch.values[row]);
+			appender.EndRow();
+		}
+		appender.Close();
+	}
+	ThrowOnError(*con.Query(StringUtil::Format("COPY %s TO %s (FORMAT parquet, COMPRESSION zstd, ROW_GROUP_SIZE %llu)",
+	                                           BATCH_TABLE_NAME, KeywordHelper::WriteQuoted(temp_path, '\''),
+	                                           ROW_GROUP_SIZE)));
+	ThrowOnError(*con.Query(StringUtil::Format("DROP TABLE temp.main.%s", BATCH_TABLE_NAME)));
+}
+
+void WriteSnapshotFile(const SnapshotEncoder &encoder, const string &temp_path) {
+	const string &data = encoder.GetData();
+	std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		throw IOException("Failed to open recording file '%s': %s", temp_path, strerror(errno));
+	}
+	file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	file.close();
+	if (file.fail()) {
+		throw IOException("Failed to write recording file '%s': %s", temp_path, strerror(errno));
+	}
+}
+
+// Write the buffered samples to a new recording file and clear the buffer.
+void FlushBatch(Connection &con, RecorderState &state) {
+	const idx_t row_count = GetBufferedRows(state);
+	if (row_count == 0) {
+		return;
+	}
+	// Samples are dropped even if the write fails, so a broken destination cannot grow the buffer without bounds.
+	SCOPE_EXIT {
+		state.batch.Clear();
+		state.encoder.Reset();
+		lock_guard<mutex> lock(state.mu);
+		state.buffered_rows = 0;
+	};
+
+	auto &fs = FileSystem::GetFileSystem(*con.context);
+	const bool is_snapshot = state.config.format == RecordingFormat::SNAPSHOT;
+	const int64_t start_micros = is_snapshot ? state.encoder.FirstTimestamp() : state.batch.timestamps.front().value;
+	const int64_t end_micros = is_snapshot ? state.encoder.LastTimestamp() : state.batch.timestamps.back().value;
+	const string path = GetNewRecordingPath(fs, state.config, start_micros, end_micros);
+	// Readers only pick up "*.parquet" and "*.snap", so a partially written file is never read.
+	const string temp_path = path + ".tmp";
+	if (is_snapshot) {
+		WriteSnapshotFile(state.encoder, temp_path);
+	} else {
+		WriteParquetFile(con, state.batch, temp_path);
+	}
+	fs.MoveFile(temp_path, path);
+
+	lock_guard<mutex> lock(state.mu);
+	state.files_written++;
+	state.rows_written += row_count;
+}
+
+// Take one sample, after flushing the buffer if the rotation window is over.
+void RecordTick(Connection &con, RecorderState &state) {
+	const int64_t now_micros = GetCurrentEpochMicros();
+	const idx_t buffered_rows = GetBufferedRows(state);
+	if (buffered_rows > 0 && (now_micros >= state.window_end_micros || buffered_rows >= MAX_BUFFERED_ROWS)) {
+		FlushBatch(con, state);
+	}
+	if (GetBufferedRows(state) == 0) {
+		// Windows are aligned to the rotation interval, i.e. hourly files start at full hours.
+		state.window_end_micros = (now_micros / state.config.rotate_micros + 1) * state.config.rotate_micros;
+	}
+	CollectMetricSamples(*con.context, timestamp_t {now_micros}, state.batch);
+	if (state.config.format == RecordingFormat::SNAPSHOT) {
+		state.encoder.Append(state.batch);
+		state.batch.Clear();
+	}
+
+	lock_guard<mutex> lock(state.mu);
+	state.buffered_rows = GetBufferedRows(state);
+}
+
+void RunRecorder(shared_ptr<RecorderState> state) {
+	const auto interval = std::chrono::microseconds(state->config.interval_micros);
+	auto next_tick = std::chrono::steady_clock::now();
+	while (true) {
+		{
+			// The database is only referenced during a tick, so the recorder never keeps it alive.
+			auto db = state->db_weak.lock();
+			if (!db) {
+				return;
+			}
+			try {
+				Connection con(*db);
+				RecordTick(con, *state);
+			} catch (std::exception &ex) {
+				SetLastError(*state, ErrorData(ex).Message());
+			}
+		}
+
+		// Skip ticks missed because of a slow collection or flush, instead of sampling in a burst.
+		next_tick += interval;
+		const auto now = std::chrono::steady_clock::now();
+		if (next_tick < now) {
+			next_tick = now;
+		}
+		std::unique_lock<mutex> lock(state->mu);
+		if (state->cv.wait_until(lock, next_tick, [&]() { return state->stop; })) {
+			return;
+		}
+	}
+}
+
+// ObjectCacheEntry that owns the recorder of one database instance.
+class RecorderCacheEntry : public ObjectCacheEntry {
+public:
+	~RecorderCacheEntry() override {
+		// Buffered samples are dropped, the database cannot be queried while being destroyed.
+		StopThread();
+	}
+
+	static string ObjectType() {
+		return "system_stats_recorder_cache";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise a running recorder is lost.
+		return optional_idx {};
+	}
+
+	void Start(ClientContext &context, const RecorderConfig &config) {
+		lock_guard<mutex> lock(mu);
+		if (state) {
+			throw InvalidInputException("sys_recorder is already running and writing to '%s', call "
+			                            "sys_recorder_stop() first",
+			                            state->config.path);
+		}
+		state = make_shared_ptr<RecorderState>();
+		state->config = config;
+		state->db_weak = GetDbInstance(context);
+		thread = std::thread(RunRecorder, state);
+	}
+
+	RecorderStatus Stop(ClientContext &context) {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return RecorderStatus {};
+		}
+		StopThread();
+		auto stopped_state = std::move(state);
+		try {
+			Connection con(*GetDbInstance(context));
+			FlushBatch(con, *stopped_state);
+		} catch (std::exception &ex) {
+			SetLastError(*stopped_state, ErrorData(ex).Message());
+		}
+		auto status = GetStatus(*stopped_state);
+		status.running = false;
+		return status;
+	}
+
+	RecorderStatus GetStatus() {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return RecorderStatus {};
+		}
+		return GetStatus(*state);
+	}
+
+private:
+	static RecorderStatus GetStatus(RecorderState &recorder_state) {
+		lock_guard<mutex> lock(recorder_state.mu);
+		RecorderStatus status;
+		status.running = !recorder_state.stop;
+		status.config = recorder_state.config;
+		status.buffered_rows = recorder_state.buffered_rows;
+		status.files_written = recorder_state.files_written;
+		status.rows_written = recorder_state.rows_written;
+		status.last_error = recorder_state.last_error;
+		return status;
+	}
+
+	// Signal the background thread to stop and wait for it.
+	void StopThread() {
+		if (state) {
+			lock_guard<mutex> lock(state->mu);
+			state->stop = true;
+		}
+		if (state) {
+			state->cv.notify_all();
+		}
+		if (!thread.joinable()) {
+			return;
+		}
+		// The last reference to the database could be released by the recorder thread itself, in which case the
+		// entry is destroyed on that thread; it exits on its own as soon as it sees [stop].
+		if (thread.get_id() == std::this_thread::get_id()) {
+			thread.detach();
+		} else {
+			thread.join();
+		}
+	}
+
+	mutex mu;
+	shared_ptr<RecorderState> state;
+	std::thread thread;
+};
+
+shared_ptr<RecorderCacheEntry> GetRecorderEntry(ClientContext &context) {
+	auto &cache = GetDbInstance(context)->GetObjectCache();
+	return cache.GetOrCreate<RecorderCacheEntry>(RecorderCacheEntry::ObjectType());
+}
+
+} // namespace
+
+void MetricsBatch::Append(timestamp_t ts, std::string_view source, std::string_view entity, std::string_view metric,
+                          uint64_t value) {
+	timestamps.emplace_back(ts);
+	sources.emplace_back(source);
+	entities.emplace_back(entity);
+	metrics.emplace_back(metric);
+	values.emplace_back(value);
+}
+
+void MetricsBatch::Clear() {
+	timestamps.clear();
+	sources.clear();
+	entities.clear();
+	metrics.clear();
+	values.clear();
+}
+
+void CollectMetricSamples(ClientContext &context, timestamp_t ts, MetricsBatch &batch) {
+	const MemoryInfo memory = GetMemoryInfo(context);
+	batch.Append(ts, "memory", "", "total_memory", memory.total_memory);
+	batch.Append(ts, "memory", "", "used_memory", memory.used_memory);
+	batch.Append(ts, "memory", "", "free_memory", memory.free_memory);
+	batch.Append(ts, "memory", "", "cached_memory", memory.cached_memory);
+	batch.Append(ts, "memory", "", "total_swap", memory.total_swap);
+	batch.Append(ts, "memory", "", "used_swap", memory.used_swap);
+	batch.Append(ts, "memory", "", "free_swap", memory.free_swap);
+
+	for (const auto &disk : GetDiskInfo(context)) {
+		batch.Append(ts, "disk", disk.mount_point, "total_space", disk.total_space);
+		batch.Append(ts, "disk", disk.mount_point, "used_space", disk.used_space);
+		batch.Append(ts, "disk", disk.mount_point, "free_space", disk.free_space);
+		batch.Append(ts, "disk", disk.mount_point, "used_inodes", disk.used_inodes);
+		batch.Append(ts, "disk", disk.mount_point, "free_inodes", disk.free_inodes);
+	}
+
+	for (const auto &network : GetNetworkInfo(context)) {
+		batch.Append(ts, "network", network.interface_name, "tx_bytes", network.tx_bytes);
+		batch.Append(ts, "network", network.interface_name, "tx_packets", network.tx_packets);
+		batch.Append(ts, "network", network.interface_name, "tx_errors", network.tx_errors);
+		batch.Append(ts, "network", network.interface_name, "tx_dropped", network.tx_dropped);
+		batch.Append(ts, "network", network.interface_name, "rx_bytes", network.rx_bytes);
+		batch.Append(ts, "network", network.interface_name, "rx_packets", network.rx_packets);
+		batch.Append(ts, "network", network.interface_name, "rx_errors", network.rx_errors);
+		batch.Append(ts, "network", network.interface_name, "rx_dropped", network.rx_dropped);
+	}
+
+	const OSInfo os = GetOSInfo(context, OS_INFO_HANDLE_COUNT | OS_INFO_PROCESS_COUNT | OS_INFO_THREAD_COUNT);
+	batch.Append(ts, "os", "", "handle_count", static_cast<uint64_t>(os.handle_count));
+	batch.Append(ts, "os", "", "process_count", static_cast<uint64_t>(os.process_count));
+	batch.Append(ts, "os", "", "thread_count", static_cast<uint64_t>(os.thread_count));
+
+	const DuckDBResources resources = GetDuckDBResources(context);
+	batch.Append(ts, "duckdb", "", "buffer_manager_used", resources.buffer_manager_used);
+	batch.Append(ts, "duckdb", "", "temp_storage_used", resources.temp_storage_used);
+	batch.Append(ts, "duckdb", "", "active_tasks", resources.active_tasks);
+	if (resources.has_process_memory) {
+		batch.Append(ts, "duckdb", "", "process_rss", resources.process_memory.rss_bytes);
+	}
+}
+
+RecordingFormat ParseRecordingFormat(const string &format_str) {
+	string lower_format = StringUtil::Lower(format_str);
+	if (lower_format == "parquet") {
+		return RecordingFormat::PARQUET;
+	}
+	if (lower_format == "snapshot") {
+		return RecordingFormat::SNAPSHOT;
+	}
+	throw InvalidInputException("Invalid recording format '%s'. Supported formats: parquet, snapshot", format_str);
+}
+
+string GetRecordingFileName(int64_t start_micros, int64_t end_micros, RecordingFormat format) {
+	const int64_t start_seconds = start_micros / MICROS_PER_SECOND;
+	const int64_t end_seconds = (end_micros + MICROS_PER_SECOND - 1) / MICROS_PER_SECOND;
+	return StringUtil::Format("%s%s_%s%s", RECORDING_FILE_PREFIX, FormatFileTimestamp(start_seconds),
+	                          FormatFileTimestamp(end_seconds), GetRecordingFileSuffix(format));
+}
+
+bool ParseRecordingFileName(std::string_view file_name, int64_t &start_micros, int64_t &end_micros,
+                            RecordingFormat &format) {
+	// sys_metrics_<start>_<end>[_<n>].parquet or .snap
+	const std::string_view prefix {RECORDING_FILE_PREFIX};
+	if (file_name.size() < prefix.size() || file_name.substr(0, prefix.size()) != prefix) {
+		return false;
+	}
+	std::string_view suffix;
+	if (HasSuffix(file_name, PARQUET_FILE_SUFFIX)) {
+		format = RecordingFormat::PARQUET;
+		suffix = PARQUET_FILE_SUFFIX;
+	} else if (HasSuffix(file_name, SNAPSHOT_FILE_SUFFIX)) {
+		format = RecordingFormat::SNAPSHOT;
+		suffix = SNAPSHOT_FILE_SUFFIX;
+	} else {
+		return false;
+	}
+	if (file_name.size() < prefix.size() + suffix.size()) {
+		return false;
+	}
+	std::string_view range = file_name.substr(prefix.size(), file_name.size() - prefix.size() - suffix.size());
+	if (range.size() < 2 * FILE_TIMESTAMP_LENGTH + 1 || range[FILE_TIMESTAMP_LENGTH] != '_') {
+		return false;
+	}
+	return ParseFileTimestamp(range.substr(0, FILE_TIMESTAMP_LENGTH), start_micros) &&
+	       ParseFileTimestamp(range.substr(FILE_TIMESTAMP_LENGTH + 1, FILE_TIMESTAMP_LENGTH), end_micros);
+}
+
+void StartRecorder(ClientContext &context, const RecorderConfig &config) {
+	if (!DBConfig::GetConfig(context).options.enable_external_access) {
+		throw PermissionException("sys_recorder_start is disabled through configuration");
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.DirectoryExists(config.path)) {
+		fs.CreateDirectory(config.path);
+	}
+	GetRecorderEntry(context)->Start(context, config);
+}
+
+RecorderStatus StopRecorder(ClientContext &context) {
+	return GetRecorderEntry(context)->Stop(context);
+}
+
+RecorderStatus GetRecorderStatus(ClientContext &context) {
+	return GetRecorderEntry(context)->GetStatus();
+}
+
+vector<RecordingFile> ListRecordingFiles(ClientContext &context, const string &path, int64_t start_micros,
+                                         int64_t end_micros) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	const string pattern = fs.JoinPath(path, StringUtil::Format("%s*", RECORDING_FILE_PREFIX));
+
+	vector<RecordingFile> files;
+	for (const auto &file_info : fs.Glob(pattern)) {
+		RecordingFile file;
+		file.path = file_info.path;
+		const size_t name_pos = file.path.find_last_of("/\\");
+		const std::string_view file_name =
+		    name_pos == string::npos ? std::string_view {file.path} : std::string_view {file.path}.substr(name_pos + 1);
+		if (!ParseRecordingFileName(file_name, file.start_micros, file.end_micros, file.format)) {
+			continue;
+		}
+		// File end is the last sample rounded up to full seconds, so the range is inclusive.
+		if (file.end_micros < start_micros || file.start_micros >= end_micros) {
+			continue;
+		}
+		files.emplace_back(std::move(file));
+	}
+	std::sort(files.begin(), files.end(), [](const RecordingFile &lhs, const RecordingFile &rhs) {
+		return lhs.start_micros < rhs.start_micros;
+	});
+	return files;
+}
+
+} // namespace duckdb
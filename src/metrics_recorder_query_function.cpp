@@ -0,0 +1,297 @@
+#include "metrics_recorder_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/statement/select_statement.hpp"
+#include "duckdb/parser/tableref/subqueryref.hpp"
+#include "metrics_recorder.hpp"
+
+#include <limits>
+
+namespace duckdb {
+
+namespace {
+
+// Default rotation interval of recording files.
+constexpr int64_t DEFAULT_ROTATE_MICROS = 3600 * Interval::MICROS_PER_SEC;
+// Min sampling interval, collecting all metrics takes a few milliseconds.
+constexpr int64_t MIN_INTERVAL_MICROS = 100 * Interval::MICROS_PER_MSEC;
+
+void AddRecorderStatusColumns(vector<LogicalType> &return_types, vector<string> &names) {
+	return_types.reserve(9);
+	names.reserve(9);
+
+	names.emplace_back("running");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("format");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("interval");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	names.emplace_back("rotate");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	names.emplace_back("buffered_rows");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("files_written");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("rows_written");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("last_error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+}
+
+void SetRecorderStatusRow(DataChunk &output, const RecorderStatus &status) {
+	idx_t col_idx = 0;
+	// Configuration is NULL when no recorder has been started.
+	const bool has_config = !status.config.path.empty();
+
+	// running
+	output.SetValue(col_idx++, 0, Value::BOOLEAN(status.running));
+
+	// path
+	output.SetValue(col_idx++, 0, has_config ? Value(status.config.path) : Value(LogicalType::VARCHAR));
+
+	// format
+	const char *format = status.config.format == RecordingFormat::SNAPSHOT ? "snapshot" : "parquet";
+	output.SetValue(col_idx++, 0, has_config ? Value(format) : Value(LogicalType::VARCHAR));
+
+	// interval
+	output.SetValue(col_idx++, 0,
+	                has_config ? Value::INTERVAL(Interval::FromMicro(status.config.interval_micros))
+	                           : Value(LogicalType::INTERVAL));
+
+	// rotate
+	output.SetValue(col_idx++, 0,
+	                has_config ? Value::INTERVAL(Interval::FromMicro(status.config.rotate_micros))
+	                           : Value(LogicalType::INTERVAL));
+
+	// buffered_rows
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.buffered_rows));
+
+	// files_written
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.files_written));
+
+	// rows_written
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.rows_written));
+
+	// last_error, NULL if none
+	output.SetValue(col_idx++, 0, status.last_error.empty() ? Value(LogicalType::VARCHAR) : Value(status.last_error));
+
+	output.SetCardinality(1);
+}
+
+struct SysRecorderStartBindData : public FunctionData {
+	RecorderConfig config;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysRecorderStartBindData>();
+		return config.path == other.config.path && config.format == other.config.format &&
+		       config.interval_micros == other.config.interval_micros &&
+		       config.rotate_micros == other.config.rotate_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysRecorderStartBindData>();
+		result->config = config;
+		return std::move(result);
+	}
+};
+
+struct SysRecorderData : public GlobalTableFunctionState {
+	SysRecorderData() : finished(false) {
+	}
+	bool finished;
+};
+
+unique_ptr<FunctionData> SysRecorderStartBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+
+	auto result = make_uniq<SysRecorderStartBindData>();
+	if (input.inputs[0].IsNull() || input.inputs[1].IsNull()) {
+		throw InvalidInputException("Path and interval for sys_recorder_start cannot be NULL");
+	}
+	result->config.path = input.inputs[0].ToString();
+	result->config.interval_micros = Interval::GetMicro(input.inputs[1].GetValue<interval_t>());
+	if (result->config.interval_micros < MIN_INTERVAL_MICROS) {
+		throw InvalidInputException("Sampling interval for sys_recorder_start must be at least 100 milliseconds, but "
+		                            "got '%s'",
+		                            input.inputs[1].ToString());
+	}
+
+	// Parse rotate parameter if provided
+	result->config.rotate_micros = DEFAULT_ROTATE_MICROS;
+	auto rotate_it = input.named_parameters.find("rotate");
+	if (rotate_it != input.named_parameters.end()) {
+		result->config.rotate_micros = Interval::GetMicro(rotate_it->second.GetValue<interval_t>());
+		if (result->config.rotate_micros < Interval::MICROS_PER_SEC ||
+		    result->config.rotate_micros < result->config.interval_micros) {
+			throw InvalidInputException("Rotation interval for sys_recorder_start must be at least 1 second and the "
+			                            "sampling interval, but got '%s'",
+			                            rotate_it->second.ToString());
+		}
+	}
+
+	// Parse format parameter if provided
+	auto format_it = input.named_parameters.find("format");
+	if (format_it != input.named_parameters.end()) {
+		result->config.format = ParseRecordingFormat(format_it->second.ToString());
+	}
+
+	AddRecorderStatusColumns(return_types, names);
+	return std::move(result);
+}
+
+unique_ptr<FunctionData> SysRecorderStatusBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	AddRecorderStatusColumns(return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysRecorderInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysRecorderData>();
+}
+
+void SysRecorderStartFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysRecorderData>();
+	auto &bind_data = data_p.bind_data->Cast<SysRecorderStartBindData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	StartRecorder(context, bind_data.config);
+	SetRecorderStatusRow(output, GetRecorderStatus(context));
+	data.finished = true;
+}
+
+void SysRecorderStopFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysRecorderData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetRecorderStatusRow(output, StopRecorder(context));
+	data.finished = true;
+}
+
+void SysRecorderStatusFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysRecorderData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetRecorderStatusRow(output, GetRecorderStatus(context));
+	data.finished = true;
+}
+
+// Replace sys_recorded(path) with a scan of the recording files overlapping the requested time range; Parquet files are
+// read with read_parquet and snapshot files with sys_snapshot_decode.
+unique_ptr<TableRef> SysRecordedBindReplace(ClientContext &context, TableFunctionBindInput &input) {
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("Path for sys_recorded cannot be NULL");
+	}
+	const string path = input.inputs[0].ToString();
+
+	// Parse start and end parameters if provided
+	int64_t start_micros = std::numeric_limits<int64_t>::min();
+	int64_t end_micros = std::numeric_limits<int64_t>::max();
+	vector<string> conditions;
+	auto start_it = input.named_parameters.find("start");
+	if (start_it != input.named_parameters.end() && !start_it->second.IsNull()) {
+		start_micros = Timestamp::GetEpochMicroSeconds(start_it->second.GetValue<timestamp_t>());
+		conditions.emplace_back("ts >= " + start_it->second.ToSQLString());
+	}
+	auto end_it = input.named_parameters.find("end");
+	if (end_it != input.named_parameters.end() && !end_it->second.IsNull()) {
+		end_micros = Timestamp::GetEpochMicroSeconds(end_it->second.GetValue<timestamp_t>());
+		conditions.emplace_back("ts < " + end_it->second.ToSQLString());
+	}
+
+	// Files are pruned by the time range in their names, Parquet row groups by the min/max statistics of ts.
+	const auto files = ListRecordingFiles(context, path, start_micros, end_micros);
+	string parquet_files;
+	string snapshot_files;
+	for (const auto &file : files) {
+		string &file_list = file.format == RecordingFormat::SNAPSHOT ? snapshot_files : parquet_files;
+		if (!file_list.empty()) {
+			file_list += ", ";
+		}
+		file_list += KeywordHelper::WriteQuoted(file.path, '\'');
+	}
+	vector<string> scans;
+	if (!parquet_files.empty()) {
+		scans.emplace_back("SELECT ts, source, entity, metric, value FROM read_parquet([" + parquet_files + "])");
+	}
+	if (!snapshot_files.empty()) {
+		scans.emplace_back("SELECT ts, source, entity, metric, value FROM read_blob([" + snapshot_files +
+		                   "]) AS recording, sys_snapshot_decode(recording.content)");
+	}
+
+	string sql;
+	if (scans.empty()) {
+		sql = "SELECT NULL::TIMESTAMP AS ts, NULL::VARCHAR AS source, NULL::VARCHAR AS entity, NULL::VARCHAR AS "
+		      "metric, NULL::UBIGINT AS value LIMIT 0";
+	} else {
+		sql = "SELECT * FROM (" + StringUtil::Join(scans, " UNION ALL ") + ")";
+		for (idx_t idx = 0; idx < conditions.size(); idx++) {
+			sql += idx == 0 ? " WHERE " : " AND ";
+			sql += conditions[idx];
+		}
+	}
+
+	Parser parser;
+	parser.ParseQuery(sql);
+	auto select = unique_ptr_cast<SQLStatement, SelectStatement>(std::move(parser.statements[0]));
+	return make_uniq<SubqueryRef>(std::move(select));
+}
+
+} // namespace
+
+void RegisterSysRecorderFunctions(ExtensionLoader &loader) {
+	TableFunction sys_recorder_start_func("sys_recorder_start", {LogicalType::VARCHAR, LogicalType::INTERVAL},
+	                                      SysRecorderStartFunc, SysRecorderStartBind, SysRecorderInit);
+	sys_recorder_start_func.named_parameters["rotate"] = LogicalType::INTERVAL;
+	sys_recorder_start_func.named_parameters["format"] = LogicalType::VARCHAR;
+	loader.RegisterFunction(sys_recorder_start_func);
+
+	TableFunction sys_recorder_stop_func("sys_recorder_stop", {}, SysRecorderStopFunc, SysRecorderStatusBind,
+	                                     SysRecorderInit);
+	loader.RegisterFunction(sys_recorder_stop_func);
+
+	TableFunction sys_recorder_status_func("sys_recorder_status", {}, SysRecorderStatusFunc, SysRecorderStatusBind,
+	                                       SysRecorderInit);
+	loader.RegisterFunction(sys_recorder_status_func);
+}
+
+void RegisterSysRecordedFunction(ExtensionLoader &loader) {
+	TableFunction sys_recorded_func("sys_recorded", {LogicalType::VARCHAR}, nullptr, nullptr);
+	sys_recorded_func.bind_replace = SysRecordedBindReplace;
+	sys_recorded_func.named_parameters["start"] = LogicalType::TIMESTAMP;
+	sys_recorded_func.named_parameters["end"] = LogicalType::TIMESTAMP;
+	loader.RegisterFunction(sys_recorded_func);
+}
+
+} // namespace duckdb
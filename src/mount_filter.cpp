@@ -0,0 +1,248 @@
+#include "mount_filter.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
+#include "string_utils.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+const char *const DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES =
+    "autofs,binfmt_misc,bpf,cgroup,cgroup2,configfs,debugfs,devpts,devtmpfs,fusectl,hugetlbfs,iso9660,mqueue,nsfs,"
+    "overlay,proc,procfs,pstore,rpc_pipefs,securityfs,selinuxfs,squashfs,sysfs,tracefs";
+const char *const DEFAULT_EXCLUDE_MOUNT_POINTS = "/dev,/proc,/sys,/run,/snap,/var/lib/docker/";
+
+namespace {
+
+constexpr const char *INCLUDE_FILE_SYSTEM_TYPES_OPTION = "system_stats_include_file_system_types";
+constexpr const char *EXCLUDE_FILE_SYSTEM_TYPES_OPTION = "system_stats_exclude_file_system_types";
+constexpr const char *INCLUDE_MOUNT_POINTS_OPTION = "system_stats_include_mount_points";
+constexpr const char *EXCLUDE_MOUNT_POINTS_OPTION = "system_stats_exclude_mount_points";
+
+// Max number of seeds to try for a table size, before doubling the table.
+constexpr uint64_t MAX_SEED_ATTEMPTS = 256;
+
+// Read a filter list setting, falling back to [default_value] if unset.
+string GetFilterListSetting(ClientContext &context, const char *option, const char *default_value) {
+	Value value;
+	if (!context.TryGetCurrentSetting(option, value) || value.IsNull()) {
+		return default_value;
+	}
+	return value.ToString();
+}
+
+} // namespace
+
+PerfectHashSet::PerfectHashSet(const vector<string> &keys) {
+	vector<string> unique_keys = keys;
+	std::sort(unique_keys.begin(), unique_keys.end());
+	unique_keys.erase(std::unique(unique_keys.begin(), unique_keys.end()), unique_keys.end());
+	size = unique_keys.size();
+	if (size == 0) {
+		return;
+	}
+
+	// Keep load factor at most 50%, which makes a collision-free seed easy to find.
+	uint64_t slot_count = 1;
+	while (slot_count < 2 * size) {
+		slot_count <<= 1;
+	}
+
+	while (true) {
+		mask = slot_count - 1;
+		for (seed = 0; seed < MAX_SEED_ATTEMPTS; seed++) {
+			occupied.assign(slot_count, false);
+			bool collision = false;
+			for (const auto &key : unique_keys) {
+				const uint64_t slot = Hash(key) & mask;
+				if (occupied[slot]) {
+					collision = true;
+					break;
+				}
+				occupied[slot] = true;
+			}
+			if (collision) {
+				continue;
+			}
+
+			slots.assign(slot_count, string {});
+			for (auto &key : unique_keys) {
+				slots[Hash(key) & mask] = std::move(key);
+			}
+			return;
+		}
+		slot_count <<= 1;
+	}
+}
+
+uint64_t PerfectHashSet::Hash(std::string_view key) const {
+	// FNV-1a, with the seed folded into the offset basis.
+	uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+	for (char c : key) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ULL;
+	}
+	return hash ^ (hash >> 32);
+}
+
+bool PerfectHashSet::Contains(std::string_view key) const {
+	if (size == 0) {
+		return false;
+	}
+	const uint64_t slot = Hash(key) & mask;
+	return occupied[slot] && slots[slot] == key;
+}
+
+PathPrefixTrie::PathPrefixTrie() : nodes(1) {
+}
+
+PathPrefixTrie::PathPrefixTrie(const vector<string> &prefixes) : nodes(1) {
+	for (const auto &prefix : prefixes) {
+		Insert(prefix);
+	}
+}
+
+void PathPrefixTrie::Insert(std::string_view prefix) {
+	if (prefix.empty()) {
+		return;
+	}
+	// A trailing slash (except for root) means only paths strictly under the directory match.
+	bool dir_only = false;
+	if (prefix.size() > 1 && prefix.back() == '/') {
+		dir_only = true;
+		prefix.remove_suffix(1);
+	}
+
+	uint32_t node_idx = 0;
+	for (char c : prefix) {
+		auto &children = nodes[node_idx].children;
+		auto iter = std::lower_bound(children.begin(), children.end(), c,
+		                             [](const std::pair<char, uint32_t> &child, char ch) { return child.first < ch; });
+		if (iter != children.end() && iter->first == c) {
+			node_idx = iter->second;
+			continue;
+		}
+		const auto child_idx = static_cast<uint32_t>(nodes.size());
+		children.insert(iter, std::make_pair(c, child_idx));
+		// Insertion might reallocate [nodes], so [children] is not accessed afterwards.
+		nodes.emplace_back();
+		node_idx = child_idx;
+	}
+
+	if (dir_only) {
+		nodes[node_idx].terminal_dir = true;
+	} else {
+		nodes[node_idx].terminal = true;
+	}
+}
+
+bool PathPrefixTrie::Matches(std::string_view path) const {
+	uint32_t node_idx = 0;
+	for (size_t idx = 0;; idx++) {
+		const auto &node = nodes[node_idx];
+		const bool at_boundary = idx == path.size() || path[idx] == '/';
+		if (node.terminal && at_boundary) {
+			return true;
+		}
+		if (node.terminal_dir && idx + 1 < path.size() && path[idx] == '/') {
+			return true;
+		}
+		if (idx == path.size()) {
+			return false;
+		}
+
+		bool found = false;
+		for (const auto &child : node.children) {
+			if (child.first == path[idx]) {
+				node_idx = child.second;
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			return false;
+		}
+	}
+}
+
+MountFilter::MountFilter(const vector<string> &include_fs_types_p, const vector<string> &exclude_fs_types_p,
+                         const vector<string> &include_mount_points_p, const vector<string> &exclude_mount_points_p)
+    : include_fs_types(include_fs_types_p), exclude_fs_types(exclude_fs_types_p),
+      include_mount_points(include_mount_points_p), exclude_mount_points(exclude_mount_points_p) {
+}
+
+MountFilter::MountFilter(const MountFilterConfig &config)
+    : MountFilter(ParseFilterList(config.include_fs_types), ParseFilterList(config.exclude_fs_types),
+                  ParseFilterList(config.include_mount_points), ParseFilterList(config.exclude_mount_points)) {
+}
+
+MountFilter MountFilter::Default() {
+	return MountFilter({}, ParseFilterList(DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES), {},
+	                   ParseFilterList(DEFAULT_EXCLUDE_MOUNT_POINTS));
+}
+
+bool MountFilter::IgnoreFileSystemType(std::string_view fs_type) const {
+	if (!include_fs_types.Empty() && !include_fs_types.Contains(fs_type)) {
+		return true;
+	}
+	return exclude_fs_types.Contains(fs_type);
+}
+
+bool MountFilter::IgnoreMountPoint(std::string_view mount_point) const {
+	if (!include_mount_points.Empty() && !include_mount_points.Matches(mount_point)) {
+		return true;
+	}
+	return exclude_mount_points.Matches(mount_point);
+}
+
+vector<string> ParseFilterList(const string &list) {
+	vector<string> result;
+	for (const auto &item : StringUtil::Split(list, ',')) {
+		auto trimmed = TrimString(item);
+		if (!trimmed.empty()) {
+			result.emplace_back(trimmed);
+		}
+	}
+	return result;
+}
+
+void RegisterMountFilterOptions(DatabaseInstance &db) {
+	auto &config = DBConfig::GetConfig(db);
+	config.AddExtensionOption(INCLUDE_FILE_SYSTEM_TYPES_OPTION,
+	                          "Comma separated filesystem types reported by sys_disk_info, empty to report all",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption(EXCLUDE_FILE_SYSTEM_TYPES_OPTION,
+	                          "Comma separated filesystem types not reported by sys_disk_info", LogicalType::VARCHAR,
+	                          Value(DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES));
+	config.AddExtensionOption(INCLUDE_MOUNT_POINTS_OPTION,
+	                          "Comma separated mount point prefixes reported by sys_disk_info, empty to report all",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption(
+	    EXCLUDE_MOUNT_POINTS_OPTION,
+	    "Comma separated mount point prefixes not reported by sys_disk_info, a trailing slash only excludes entries "
+	    "under the directory",
+	    LogicalType::VARCHAR, Value(DEFAULT_EXCLUDE_MOUNT_POINTS));
+}
+
+MountFilterConfig GetMountFilterConfig(ClientContext &context) {
+	MountFilterConfig config;
+	config.include_fs_types = GetFilterListSetting(context, INCLUDE_FILE_SYSTEM_TYPES_OPTION, "");
+	config.exclude_fs_types =
+	    GetFilterListSetting(context, EXCLUDE_FILE_SYSTEM_TYPES_OPTION, DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES);
+	config.include_mount_points = GetFilterListSetting(context, INCLUDE_MOUNT_POINTS_OPTION, "");
+	config.exclude_mount_points =
+	    GetFilterListSetting(context, EXCLUDE_MOUNT_POINTS_OPTION, DEFAULT_EXCLUDE_MOUNT_POINTS);
+	return config;
+}
+
+MountFilter GetMountFilter(ClientContext &context) {
+	return MountFilter(GetMountFilterConfig(context));
+}
+
+} // namespace duckdb
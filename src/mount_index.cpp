@@ -0,0 +1,170 @@
+#include "mount_index.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "proc_tokenizer.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifdef __linux__
+// Read the whole content of [fd] from the beginning.
+bool ReadAll(int fd, string &content) {
+	content.clear();
+	if (lseek(fd, 0, SEEK_SET) != 0) {
+		return false;
+	}
+	char buf[64 * 1024];
+	while (true) {
+		ssize_t bytes_read = read(fd, buf, sizeof(buf));
+		if (bytes_read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		if (bytes_read == 0) {
+			return true;
+		}
+		content.append(buf, static_cast<size_t>(bytes_read));
+	}
+}
+#endif
+
+} // namespace
+
+MountIndexCacheEntry::MountIndexCacheEntry(string path_p)
+    : path(std::move(path_p)), fd(-1), initialized(false), mounts(make_shared_ptr<const vector<MountInfoEntry>>()) {
+}
+
+MountIndexCacheEntry::~MountIndexCacheEntry() {
+#ifdef __linux__
+	if (fd != -1) {
+		close(fd);
+	}
+#endif
+}
+
+string MountIndexCacheEntry::ObjectType() {
+	return "system_stats_mount_index_cache";
+}
+
+string MountIndexCacheEntry::GetObjectType() {
+	return ObjectType();
+}
+
+bool MountIndexCacheEntry::PollMountTable(int fd_p, bool &changed) {
+#ifdef __linux__
+	struct pollfd pfd;
+	pfd.fd = fd_p;
+	pfd.events = POLLPRI;
+	pfd.revents = 0;
+	int ret = poll(&pfd, 1, /*timeout=*/0);
+	if (ret < 0) {
+		return false;
+	}
+	changed = ret > 0 && (pfd.revents & (POLLPRI | POLLERR)) != 0;
+	return true;
+#else
+	changed = true;
+	return true;
+#endif
+}
+
+bool MountIndexCacheEntry::MountTableChanged(optional_ptr<DatabaseInstance> db) {
+	bool changed = false;
+	if (!PollMountTable(fd, changed)) {
+		if (db) {
+			DUCKDB_LOG_DEBUG(*db, "poll() failed for %s: %s", path.c_str(), strerror(errno));
+		}
+		// Cannot tell, rebuild conservatively.
+		return true;
+	}
+	return changed;
+}
+
+void MountIndexCacheEntry::Rebuild(optional_ptr<DatabaseInstance> db, const MountFilterConfig &config) {
+#ifdef __linux__
+	mounts = make_shared_ptr<const vector<MountInfoEntry>>();
+	initialized = false;
+
+	string content;
+	if (!ReadAll(fd, content)) {
+		if (db) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to read %s: %s", path.c_str(), strerror(errno));
+		}
+		return;
+	}
+
+	const MountFilter filter(config);
+	vector<MountInfoEntry> new_mounts;
+	MountInfoEntry entry;
+	std::string_view content_sv {content};
+	size_t pos = 0;
+	std::string_view line;
+	while (NextLine(content_sv, pos, line)) {
+		if (!ParseMountInfoLine(line, entry)) {
+			continue;
+		}
+		// Skip ignored filesystem types and mount points
+		if (filter.IgnoreFileSystemType(entry.file_system_type) || filter.IgnoreMountPoint(entry.mount_point)) {
+			continue;
+		}
+		new_mounts.emplace_back(std::move(entry));
+	}
+
+	// Bind mounts share the device with their source, only report each filesystem once.
+	DeduplicateBindMounts(new_mounts);
+	// Callers still holding the previous snapshot keep it; it is freed once the last of them is done.
+	mounts = make_shared_ptr<const vector<MountInfoEntry>>(std::move(new_mounts));
+
+	cached_config = config;
+	initialized = true;
+#endif
+}
+
+MountSnapshot MountIndexCacheEntry::GetMounts(optional_ptr<DatabaseInstance> db, const MountFilterConfig &config) {
+#ifdef __linux__
+	lock_guard<mutex> lock(mu);
+	if (fd == -1) {
+		fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd == -1) {
+			if (db) {
+				DUCKDB_LOG_DEBUG(*db, "Failed to open %s: %s", path.c_str(), strerror(errno));
+			}
+			return make_shared_ptr<const vector<MountInfoEntry>>();
+		}
+	}
+
+	// Always poll, so a pending change event is consumed even if the index is rebuilt for other reasons.
+	const bool mount_table_changed = MountTableChanged(db);
+	if (!initialized || mount_table_changed || config != cached_config) {
+		Rebuild(db, config);
+	}
+	return mounts;
+#else
+	return make_shared_ptr<const vector<MountInfoEntry>>();
+#endif
+}
+
+MountSnapshot GetFilteredMounts(ClientContext &context) {
+	auto &cache = context.db->GetObjectCache();
+	auto entry = cache.GetOrCreate<MountIndexCacheEntry>(MountIndexCacheEntry::ObjectType());
+	return entry->GetMounts(GetDbInstance(context).get(), GetMountFilterConfig(context));
+}
+
+} // namespace duckdb
@@ -0,0 +1,144 @@
+#include "mount_info.hpp"
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "proc_tokenizer.hpp"
+
+namespace duckdb {
+
+namespace {
+
+bool IsOctalDigit(char c) {
+	return c >= '0' && c <= '7';
+}
+
+// Whether [candidate] should represent its device instead of [current].
+bool IsPreferredMount(const MountInfoEntry &candidate, const MountInfoEntry &current) {
+	const bool candidate_is_root = candidate.root == "/";
+	const bool current_is_root = current.root == "/";
+	if (candidate_is_root != current_is_root) {
+		return candidate_is_root;
+	}
+	return candidate.mount_point.size() < current.mount_point.size();
+}
+
+} // namespace
+
+string UnescapeMountPath(std::string_view path) {
+	string result;
+	result.reserve(path.size());
+	for (size_t idx = 0; idx < path.size(); idx++) {
+		if (path[idx] == '\\' && idx + 3 < path.size() && IsOctalDigit(path[idx + 1]) &&
+		    IsOctalDigit(path[idx + 2]) && IsOctalDigit(path[idx + 3])) {
+			result += static_cast<char>(((path[idx + 1] - '0') << 6) | ((path[idx + 2] - '0') << 3) |
+			                            (path[idx + 3] - '0'));
+			idx += 3;
+			continue;
+		}
+		result += path[idx];
+	}
+	return result;
+}
+
+bool ParseMountInfoLine(std::string_view line, MountInfoEntry &entry) {
+	size_t pos = 0;
+	std::string_view field;
+
+	// (1) mount ID
+	if (!NextToken(line, pos, field) || !ParseInteger(field, entry.mount_id)) {
+		return false;
+	}
+	// (2) parent ID
+	if (!NextToken(line, pos, field) || !ParseInteger(field, entry.parent_id)) {
+		return false;
+	}
+	// (3) major:minor
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	size_t colon_pos = field.find(':');
+	if (colon_pos == std::string_view::npos || !ParseInteger(field.substr(0, colon_pos), entry.major) ||
+	    !ParseInteger(field.substr(colon_pos + 1), entry.minor)) {
+		return false;
+	}
+	// (4) root
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	entry.root = UnescapeMountPath(field);
+	// (5) mount point
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	entry.mount_point = UnescapeMountPath(field);
+	// (6) mount options
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	entry.mount_options = string {field};
+	// (7) optional fields, terminated by a single hyphen
+	entry.propagation.clear();
+	while (true) {
+		if (!NextToken(line, pos, field)) {
+			return false;
+		}
+		if (field == "-") {
+			break;
+		}
+		if (!entry.propagation.empty()) {
+			entry.propagation += ' ';
+		}
+		entry.propagation.append(field.data(), field.size());
+	}
+	// (9) filesystem type
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	entry.file_system_type = string {field};
+	// (10) mount source
+	if (!NextToken(line, pos, field)) {
+		return false;
+	}
+	entry.source = UnescapeMountPath(field);
+	// (11) super options, could be missing on old kernels
+	entry.super_options.clear();
+	if (NextToken(line, pos, field)) {
+		entry.super_options = string {field};
+	}
+	return true;
+}
+
+void DeduplicateBindMounts(vector<MountInfoEntry> &entries) {
+	// Maps device id to the index of its representing entry.
+	unordered_map<uint64_t, idx_t> device_to_index;
+	vector<bool> keep(entries.size(), false);
+	for (idx_t idx = 0; idx < entries.size(); idx++) {
+		const uint64_t device = (static_cast<uint64_t>(entries[idx].major) << 32) | entries[idx].minor;
+		auto iter = device_to_index.find(device);
+		if (iter == device_to_index.end()) {
+			device_to_index.emplace(device, idx);
+			keep[idx] = true;
+			continue;
+		}
+		if (IsPreferredMount(entries[idx], entries[iter->second])) {
+			keep[iter->second] = false;
+			keep[idx] = true;
+			iter->second = idx;
+		}
+	}
+
+	idx_t kept_count = 0;
+	for (idx_t idx = 0; idx < entries.size(); idx++) {
+		if (!keep[idx]) {
+			continue;
+		}
+		if (kept_count != idx) {
+			entries[kept_count] = std::move(entries[idx]);
+		}
+		kept_count++;
+	}
+	entries.resize(kept_count);
+}
+
+} // namespace duckdb
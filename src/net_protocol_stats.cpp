@@ -0,0 +1,185 @@
+#include "net_protocol_stats.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Split "Tcp: ..." into protocol name "Tcp" and the remaining fields.
+bool SplitProtocol(std::string_view line, std::string_view &protocol, std::string_view &fields) {
+	size_t colon_pos = line.find(':');
+	if (colon_pos == std::string_view::npos) {
+		return false;
+	}
+	protocol = line.substr(0, colon_pos);
+	fields = line.substr(colon_pos + 1);
+	return true;
+}
+
+} // namespace
+
+void ParseHeaderValueLines(std::string_view content, const string &source, vector<ProtocolCounter> &counters) {
+	size_t pos = 0;
+	std::string_view line;
+	// Header line waiting for its value line; a line is a header unless it follows a header of the same protocol.
+	bool has_header = false;
+	std::string_view header_protocol, header_fields;
+	while (NextLine(content, pos, line)) {
+		std::string_view protocol, fields;
+		if (!SplitProtocol(line, protocol, fields)) {
+			has_header = false;
+			continue;
+		}
+		if (!has_header || protocol != header_protocol) {
+			has_header = true;
+			header_protocol = protocol;
+			header_fields = fields;
+			continue;
+		}
+		has_header = false;
+
+		size_t header_pos = 0;
+		size_t value_pos = 0;
+		std::string_view name, value_token;
+		while (NextToken(header_fields, header_pos, name) && NextToken(fields, value_pos, value_token)) {
+			ProtocolCounter counter;
+			if (!ParseInt64(value_token, counter.value)) {
+				continue;
+			}
+			counter.source = source;
+			counter.protocol = string {protocol};
+			counter.name = string {name};
+			counters.emplace_back(std::move(counter));
+		}
+	}
+}
+
+void ParseKeyValueLines(std::string_view content, const string &source, vector<ProtocolCounter> &counters) {
+	size_t pos = 0;
+	std::string_view line;
+	while (NextLine(content, pos, line)) {
+		std::string_view protocol, fields;
+		if (!SplitProtocol(line, protocol, fields)) {
+			continue;
+		}
+
+		size_t field_pos = 0;
+		std::string_view name, value_token;
+		while (NextToken(fields, field_pos, name) && NextToken(fields, field_pos, value_token)) {
+			ProtocolCounter counter;
+			if (!ParseInt64(value_token, counter.value)) {
+				continue;
+			}
+			counter.source = source;
+			counter.protocol = string {protocol};
+			counter.name = string {name};
+			counters.emplace_back(std::move(counter));
+		}
+	}
+}
+
+vector<SoftnetStat> ParseSoftnetStat(std::string_view content) {
+	// Field index in each line, see softnet_seq_show() in net/core/net-procfs.c.
+	static constexpr size_t PROCESSED_IDX = 0;
+	static constexpr size_t DROPPED_IDX = 1;
+	static constexpr size_t TIME_SQUEEZE_IDX = 2;
+	static constexpr size_t RECEIVED_RPS_IDX = 9;
+	static constexpr size_t FLOW_LIMIT_COUNT_IDX = 10;
+	static constexpr size_t BACKLOG_LEN_IDX = 11;
+	static constexpr size_t CPU_IDX = 12;
+
+	vector<SoftnetStat> stats;
+	size_t pos = 0;
+	std::string_view line;
+	int32_t line_idx = 0;
+	while (NextLine(content, pos, line)) {
+		if (line.empty()) {
+			continue;
+		}
+
+		SoftnetStat stat;
+		// Older kernels don't report CPU index, in which case lines are ordered by CPU.
+		stat.cpu = line_idx++;
+
+		size_t field_pos = 0;
+		size_t field_idx = 0;
+		std::string_view token;
+		while (NextToken(line, field_pos, token)) {
+			uint64_t value = 0;
+			if (!ParseHexUint64(token, value)) {
+				field_idx++;
+				continue;
+			}
+			switch (field_idx) {
+			case PROCESSED_IDX:
+				stat.processed = value;
+				break;
+			case DROPPED_IDX:
+				stat.dropped = value;
+				break;
+			case TIME_SQUEEZE_IDX:
+				stat.time_squeeze = value;
+				break;
+			case RECEIVED_RPS_IDX:
+				stat.received_rps = value;
+				break;
+			case FLOW_LIMIT_COUNT_IDX:
+				stat.flow_limit_count = value;
+				break;
+			case BACKLOG_LEN_IDX:
+				stat.backlog_len = value;
+				break;
+			case CPU_IDX:
+				stat.cpu = static_cast<int32_t>(value);
+				break;
+			}
+			field_idx++;
+		}
+		stats.emplace_back(stat);
+	}
+	return stats;
+}
+
+vector<ProtocolCounter> GetNetProtocolStats(ClientContext &context) {
+#ifdef __linux__
+	vector<ProtocolCounter> counters;
+	string content;
+	if (ReadProcFile(context, "/proc/net/snmp", content)) {
+		ParseHeaderValueLines(content, "snmp", counters);
+	}
+	if (ReadProcFile(context, "/proc/net/netstat", content)) {
+		ParseHeaderValueLines(content, "netstat", counters);
+	}
+	if (ReadProcFile(context, "/proc/net/sockstat", content)) {
+		ParseKeyValueLines(content, "sockstat", counters);
+	}
+	return counters;
+#elif __APPLE__
+	// procfs is not available on macOS.
+	return {};
+#else
+	throw NotImplementedException("Network protocol statistics are not supported on this platform");
+#endif
+}
+
+vector<SoftnetStat> GetSoftnetStats(ClientContext &context) {
+#ifdef __linux__
+	string content;
+	if (!ReadProcFile(context, "/proc/net/softnet_stat", content)) {
+		return {};
+	}
+	return ParseSoftnetStat(content);
+#elif __APPLE__
+	// procfs is not available on macOS.
+	return {};
+#else
+	throw NotImplementedException("Softnet statistics are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,192 @@
+#include "net_protocol_stats_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "net_protocol_stats.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct SysNetProtocolStatsData : public GlobalTableFunctionState {
+	explicit SysNetProtocolStatsData(ClientContext &context) : finished(false), current_index(0) {
+		counters = GetNetProtocolStats(context);
+	}
+	bool finished;
+	size_t current_index;
+	vector<ProtocolCounter> counters;
+};
+
+unique_ptr<FunctionData> SysNetProtocolStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(4);
+	names.reserve(4);
+
+	names.emplace_back("source");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("protocol");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("value");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysNetProtocolStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysNetProtocolStatsData>(context);
+}
+
+void SysNetProtocolStatsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysNetProtocolStatsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.counters.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &counter = data.counters[data.current_index];
+		col_idx = 0;
+
+		// source
+		output.SetValue(col_idx++, output_count, Value(counter.source));
+
+		// protocol
+		output.SetValue(col_idx++, output_count, Value(counter.protocol));
+
+		// name
+		output.SetValue(col_idx++, output_count, Value(counter.name));
+
+		// value
+		output.SetValue(col_idx++, output_count, Value::BIGINT(counter.value));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.counters.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+struct SysSoftnetStatsData : public GlobalTableFunctionState {
+	explicit SysSoftnetStatsData(ClientContext &context) : finished(false), current_index(0) {
+		stats = GetSoftnetStats(context);
+	}
+	bool finished;
+	size_t current_index;
+	vector<SoftnetStat> stats;
+};
+
+unique_ptr<FunctionData> SysSoftnetStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(7);
+	names.reserve(7);
+
+	names.emplace_back("cpu");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("processed");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("dropped");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("time_squeeze");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("received_rps");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("flow_limit_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("backlog_len");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysSoftnetStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysSoftnetStatsData>(context);
+}
+
+void SysSoftnetStatsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysSoftnetStatsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.stats.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &stat = data.stats[data.current_index];
+		col_idx = 0;
+
+		// cpu
+		output.SetValue(col_idx++, output_count, Value::INTEGER(stat.cpu));
+
+		// processed
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.processed));
+
+		// dropped
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.dropped));
+
+		// time_squeeze
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.time_squeeze));
+
+		// received_rps
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.received_rps));
+
+		// flow_limit_count
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.flow_limit_count));
+
+		// backlog_len
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(stat.backlog_len));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.stats.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysNetProtocolStatsFunction(ExtensionLoader &loader) {
+	TableFunction sys_net_protocol_stats_func("sys_net_protocol_stats", {}, SysNetProtocolStatsFunc,
+	                                          SysNetProtocolStatsBind, SysNetProtocolStatsInit);
+	loader.RegisterFunction(sys_net_protocol_stats_func);
+}
+
+void RegisterSysSoftnetStatsFunction(ExtensionLoader &loader) {
+	TableFunction sys_softnet_stats_func("sys_softnet_stats", {}, SysSoftnetStatsFunc, SysSoftnetStatsBind,
+	                                     SysSoftnetStatsInit);
+	loader.RegisterFunction(sys_softnet_stats_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,209 @@
+#include "network_rates.hpp"
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "network_stats.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "string_utils.hpp"
+#include "time_utils.hpp"
+
+#include <limits>
+
+#ifdef __linux__
+#include <fcntl.h>
+#elif __APPLE__
+#include <net/if.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Link speed reported by the kernel for a down or virtual interface is meaningless (i.e. -1 read as unsigned).
+bool IsValidLinkSpeed(uint64_t speed_mbps) {
+	return speed_mbps > 0 && speed_mbps < std::numeric_limits<uint32_t>::max();
+}
+
+// Fields of each interface line of /proc/net/dev: 8 receive counters followed by 8 transmit counters.
+constexpr idx_t PROC_NET_DEV_FIELDS = 16;
+
+#ifdef __linux__
+// Read a decimal value of /sys/class/net/[interface]/[name]; false for down or virtual links without a speed.
+template <class T>
+bool ReadSysNetValue(const string &interface, const char *name, T &value) {
+	const string path = "/sys/class/net/" + interface + "/" + name;
+	std::array<char, 64> buf;
+	const std::string_view content = ReadFileAt(AT_FDCWD, path.c_str(), buf);
+	return !content.empty() && ParseInteger(TrimString(content), value);
+}
+
+vector<InterfaceCounters> CollectInterfaceCountersLinux(ClientContext &context) {
+	vector<InterfaceCounters> interfaces;
+	string content;
+	if (!ReadProcFile(context, "/proc/net/dev", content)) {
+		return interfaces;
+	}
+	ParseProcNetDev(content, interfaces);
+	for (auto &info : interfaces) {
+		if (!ReadSysNetValue(info.interface_name, "ifindex", info.ifindex)) {
+			info.ifindex = 0;
+		}
+		if (!ReadSysNetValue(info.interface_name, "speed", info.speed_mbps)) {
+			info.speed_mbps = 0;
+		}
+	}
+	return interfaces;
+}
+#endif
+
+vector<InterfaceCounters> CollectInterfaceCounters(ClientContext &context) {
+#ifdef __linux__
+	return CollectInterfaceCountersLinux(context);
+#elif __APPLE__
+	// The interface list of macOS only has interfaces with addresses.
+	vector<InterfaceCounters> interfaces;
+	for (const auto &network : CollectNetworkInfo(context, AddressFamily::ALL)) {
+		InterfaceCounters info;
+		info.interface_name = network.interface_name;
+		info.ifindex = static_cast<int32_t>(if_nametoindex(network.interface_name.c_str()));
+		info.tx_bytes = network.tx_bytes;
+		info.tx_packets = network.tx_packets;
+		info.tx_errors = network.tx_errors;
+		info.tx_dropped = network.tx_dropped;
+		info.rx_bytes = network.rx_bytes;
+		info.rx_packets = network.rx_packets;
+		info.rx_errors = network.rx_errors;
+		info.rx_dropped = network.rx_dropped;
+		info.speed_mbps = network.speed_mbps;
+		interfaces.emplace_back(std::move(info));
+	}
+	return interfaces;
+#else
+	throw NotImplementedException("Network statistics are not supported on this platform");
+#endif
+}
+
+} // namespace
+
+void ParseProcNetDev(std::string_view content, vector<InterfaceCounters> &interfaces) {
+	interfaces.clear();
+	size_t pos = 0;
+	std::string_view line;
+	std::array<std::string_view, PROC_NET_DEV_FIELDS> tokens;
+	std::array<uint64_t, PROC_NET_DEV_FIELDS> values;
+	while (NextLine(content, pos, line)) {
+		// Large counters follow the colon without a space, i.e. "eth0:123456", so split at the colon; the two header
+		// lines have none.
+		const size_t colon = line.find(':');
+		if (colon == std::string_view::npos) {
+			continue;
+		}
+		const std::string_view name = TrimString(line.substr(0, colon));
+		if (name.empty() ||
+		    SplitTokens(line.substr(colon + 1), tokens.data(), PROC_NET_DEV_FIELDS) != PROC_NET_DEV_FIELDS) {
+			continue;
+		}
+		bool valid = true;
+		for (idx_t idx = 0; idx < PROC_NET_DEV_FIELDS && valid; idx++) {
+			valid = ParseUint64(tokens[idx], values[idx]);
+		}
+		if (!valid) {
+			continue;
+		}
+		InterfaceCounters info;
+		info.interface_name = string(name);
+		info.rx_bytes = values[0];
+		info.rx_packets = values[1];
+		info.rx_errors = values[2];
+		info.rx_dropped = values[3];
+		info.tx_bytes = values[8];
+		info.tx_packets = values[9];
+		info.tx_errors = values[10];
+		info.tx_dropped = values[11];
+		interfaces.emplace_back(std::move(info));
+	}
+}
+
+uint64_t GetCounterDelta(uint64_t before, uint64_t after) {
+	if (after >= before) {
+		return after - before;
+	}
+	// 32-bit counter wrapped around.
+	constexpr uint64_t UINT32_RANGE = static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()) + 1;
+	if (before < UINT32_RANGE) {
+		return UINT32_RANGE - before + after;
+	}
+	// 64-bit counters don't wrap in practice, so the counter has been reset; count from zero.
+	return after;
+}
+
+NetworkSnapshot TakeNetworkSnapshot(ClientContext &context) {
+	NetworkSnapshot snapshot;
+	// Take the middle of the collection as timestamp, so collection cost is split evenly between the two sides.
+	// The shared metrics snapshot is only refreshed once per publish period, so samples taken from it within one
+	// period would be identical; rates need the counters of the kernel at the time of the local timestamp.
+	const uint64_t start_ns = GetMonotonicTimestampNs();
+	snapshot.interfaces = CollectInterfaceCounters(context);
+	const uint64_t end_ns = GetMonotonicTimestampNs();
+	snapshot.timestamp_ns = start_ns + (end_ns - start_ns) / 2;
+	return snapshot;
+}
+
+vector<NetworkRate> ComputeNetworkRates(const NetworkSnapshot &before, const NetworkSnapshot &after) {
+	vector<NetworkRate> rates;
+	if (after.timestamp_ns <= before.timestamp_ns) {
+		return rates;
+	}
+	const double interval_seconds = static_cast<double>(after.timestamp_ns - before.timestamp_ns) / 1e9;
+
+	unordered_map<string, const InterfaceCounters *> before_by_name;
+	before_by_name.reserve(before.interfaces.size());
+	for (const auto &info : before.interfaces) {
+		before_by_name.emplace(info.interface_name, &info);
+	}
+
+	rates.reserve(after.interfaces.size());
+	for (const auto &cur : after.interfaces) {
+		auto iter = before_by_name.find(cur.interface_name);
+		if (iter == before_by_name.end()) {
+			continue;
+		}
+		const auto &prev = *iter->second;
+		// A re-created interface starts from zero, which must not be taken for a 32-bit wraparound.
+		const bool recreated = prev.ifindex != cur.ifindex;
+		auto get_delta = [&](uint64_t before_count, uint64_t after_count) {
+			return recreated ? after_count : GetCounterDelta(before_count, after_count);
+		};
+
+		NetworkRate rate;
+		rate.interface_name = cur.interface_name;
+		rate.interval_seconds = interval_seconds;
+		rate.tx_bytes_per_sec = get_delta(prev.tx_bytes, cur.tx_bytes) / interval_seconds;
+		rate.tx_packets_per_sec = get_delta(prev.tx_packets, cur.tx_packets) / interval_seconds;
+		rate.tx_errors_per_sec = get_delta(prev.tx_errors, cur.tx_errors) / interval_seconds;
+		rate.tx_dropped_per_sec = get_delta(prev.tx_dropped, cur.tx_dropped) / interval_seconds;
+		rate.rx_bytes_per_sec = get_delta(prev.rx_bytes, cur.rx_bytes) / interval_seconds;
+		rate.rx_packets_per_sec = get_delta(prev.rx_packets, cur.rx_packets) / interval_seconds;
+		rate.rx_errors_per_sec = get_delta(prev.rx_errors, cur.rx_errors) / interval_seconds;
+		rate.rx_dropped_per_sec = get_delta(prev.rx_dropped, cur.rx_dropped) / interval_seconds;
+		rate.speed_mbps = cur.speed_mbps;
+
+		// Links are full duplex, so utilization is computed per direction.
+		if (IsValidLinkSpeed(cur.speed_mbps)) {
+			const double link_bytes_per_sec = static_cast<double>(cur.speed_mbps) * 1000 * 1000 / 8;
+			rate.has_utilization = true;
+			rate.tx_utilization = rate.tx_bytes_per_sec / link_bytes_per_sec * 100;
+			rate.rx_utilization = rate.rx_bytes_per_sec / link_bytes_per_sec * 100;
+		}
+
+		rates.emplace_back(std::move(rate));
+	}
+
+	return rates;
+}
+
+} // namespace duckdb
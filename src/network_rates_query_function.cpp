@@ -0,0 +1,194 @@
+#include "network_rates_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "network_rates.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace duckdb {
+
+namespace {
+
+// Default sampling interval between the two snapshots.
+constexpr int64_t DEFAULT_INTERVAL_MICROS = Interval::MICROS_PER_SEC;
+// The query sleeps for the whole interval and cannot be interrupted meanwhile.
+constexpr int64_t MAX_INTERVAL_MICROS = 60 * Interval::MICROS_PER_SEC;
+
+struct SysNetworkRatesBindData : public FunctionData {
+	int64_t interval_micros = DEFAULT_INTERVAL_MICROS;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysNetworkRatesBindData>();
+		return interval_micros == other.interval_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysNetworkRatesBindData>();
+		result->interval_micros = interval_micros;
+		return std::move(result);
+	}
+};
+
+struct SysNetworkRatesData : public GlobalTableFunctionState {
+	SysNetworkRatesData(ClientContext &context, int64_t interval_micros) : finished(false), current_index(0) {
+		auto before = TakeNetworkSnapshot(context);
+		std::this_thread::sleep_for(std::chrono::microseconds(interval_micros));
+		auto after = TakeNetworkSnapshot(context);
+		rates = ComputeNetworkRates(before, after);
+	}
+	bool finished;
+	size_t current_index;
+	vector<NetworkRate> rates;
+};
+
+unique_ptr<FunctionData> SysNetworkRatesBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(14);
+	names.reserve(14);
+
+	auto result = make_uniq<SysNetworkRatesBindData>();
+
+	// Parse interval parameter if provided
+	auto interval_it = input.named_parameters.find("interval");
+	if (interval_it != input.named_parameters.end()) {
+		result->interval_micros = Interval::GetMicro(interval_it->second.GetValue<interval_t>());
+		if (result->interval_micros <= 0 || result->interval_micros > MAX_INTERVAL_MICROS) {
+			throw InvalidInputException(
+			    "Sampling interval for sys_network_rates must be positive and at most 60 seconds, but got '%s'",
+			    interval_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("interface_name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("interval_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("tx_bytes_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("tx_packets_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("tx_errors_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("tx_dropped_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("rx_bytes_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("rx_packets_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("rx_errors_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("rx_dropped_per_sec");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("link_speed_mbps");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("tx_utilization_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("rx_utilization_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysNetworkRatesInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysNetworkRatesBindData>();
+	return make_uniq<SysNetworkRatesData>(context, bind_data.interval_micros);
+}
+
+void SysNetworkRatesFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysNetworkRatesData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.rates.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &rate = data.rates[data.current_index];
+		col_idx = 0;
+
+		// interface_name
+		output.SetValue(col_idx++, output_count, Value(rate.interface_name));
+
+		// interval_seconds
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.interval_seconds));
+
+		// tx_bytes_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.tx_bytes_per_sec));
+
+		// tx_packets_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.tx_packets_per_sec));
+
+		// tx_errors_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.tx_errors_per_sec));
+
+		// tx_dropped_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.tx_dropped_per_sec));
+
+		// rx_bytes_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.rx_bytes_per_sec));
+
+		// rx_packets_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.rx_packets_per_sec));
+
+		// rx_errors_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.rx_errors_per_sec));
+
+		// rx_dropped_per_sec
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(rate.rx_dropped_per_sec));
+
+		// link_speed_mbps
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(rate.speed_mbps));
+
+		// tx_utilization_pct, NULL if link speed is unknown
+		output.SetValue(col_idx++, output_count,
+		                rate.has_utilization ? Value::DOUBLE(rate.tx_utilization) : Value(LogicalType::DOUBLE));
+
+		// rx_utilization_pct, NULL if link speed is unknown
+		output.SetValue(col_idx++, output_count,
+		                rate.has_utilization ? Value::DOUBLE(rate.rx_utilization) : Value(LogicalType::DOUBLE));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.rates.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysNetworkRatesFunction(ExtensionLoader &loader) {
+	TableFunction sys_network_rates_func("sys_network_rates", {}, SysNetworkRatesFunc, SysNetworkRatesBind,
+	                                     SysNetworkRatesInit);
+	sys_network_rates_func.named_parameters["interval"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_network_rates_func);
+}
+
+} // namespace duckdb
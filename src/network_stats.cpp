@@ -7,14 +7,18 @@
 #include "duckdb/common/numeric_utils.hpp"
 #include "duckdb/common/string.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector.hpp"
 #include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
 #include "scope_guard.hpp"
+#include "shared_metrics.hpp"
 
 #ifdef __linux__
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <netdb.h>
+#include <netinet/in.h>
 #include <sys/socket.h>
 #elif __APPLE__
 #include <arpa/inet.h>
@@ -37,6 +41,71 @@ namespace duckdb {
 
 namespace {
 
+#if defined(__linux__) || defined(__APPLE__)
+// Count the leading one bits of a netmask, which is the prefix length of the address.
+int32_t GetPrefixLength(const uint8_t *mask, size_t len) {
+	int32_t prefix_len = 0;
+	for (size_t idx = 0; idx < len; idx++) {
+		uint8_t byte = mask[idx];
+		while (byte & 0x80) {
+			prefix_len++;
+			byte = static_cast<uint8_t>(byte << 1);
+		}
+		if (mask[idx] != 0xFF) {
+			break;
+		}
+	}
+	return prefix_len;
+}
+
+// Parse the address of [ifa] into [address].
+// Return false if it's not an IP address, or it doesn't belong to the requested [family].
+bool ParseNetworkAddress(ClientContext &context, const struct ifaddrs *ifa, AddressFamily family,
+                         NetworkAddress &address) {
+	if (ifa->ifa_addr == NULL) {
+		return false;
+	}
+
+	socklen_t addr_len = 0;
+	const sa_family_t sa_family = ifa->ifa_addr->sa_family;
+	if (sa_family == AF_INET && family != AddressFamily::IPV6) {
+		address.family = "ipv4";
+		addr_len = sizeof(struct sockaddr_in);
+		if (ifa->ifa_netmask != NULL) {
+			auto *mask = reinterpret_cast<const struct sockaddr_in *>(ifa->ifa_netmask);
+			address.prefix_len = GetPrefixLength(reinterpret_cast<const uint8_t *>(&mask->sin_addr), 4);
+		}
+	} else if (sa_family == AF_INET6 && family != AddressFamily::IPV4) {
+		address.family = "ipv6";
+		addr_len = sizeof(struct sockaddr_in6);
+		if (ifa->ifa_netmask != NULL) {
+			auto *mask = reinterpret_cast<const struct sockaddr_in6 *>(ifa->ifa_netmask);
+			address.prefix_len = GetPrefixLength(reinterpret_cast<const uint8_t *>(&mask->sin6_addr), 16);
+		}
+	} else {
+		return false;
+	}
+
+	std::array<char, NI_MAXHOST> host;
+	int ret = getnameinfo(ifa->ifa_addr, addr_len, host.data(), NI_MAXHOST, NULL, 0, NI_NUMERICHOST);
+	if (ret != 0) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "getnameinfo() failed for interface %s: %s", ifa->ifa_name, gai_strerror(ret));
+		}
+		return false;
+	}
+	address.address = host.data();
+	return true;
+}
+
+void AddNetworkAddress(NetworkInfo &info, NetworkAddress address) {
+	if (info.ipv4_address.empty() && address.family == "ipv4") {
+		info.ipv4_address = address.address;
+	}
+	info.addresses.emplace_back(std::move(address));
+}
+#endif
+
 #ifdef __linux__
 // Read a value from a file in /sys/class/net
 uint64_t ReadSysNetValue(ClientContext &context, const string &interface, const string &stat_name) {
@@ -48,8 +117,11 @@ uint64_t ReadSysNetValue(ClientContext &context, const string &interface, const
 		}
 		return 0;
 	}
+	string line;
 	uint64_t value = 0;
-	file >> value;
+	if (std::getline(file, line)) {
+		ParseUint64Prefix(line, value);
+	}
 	return value;
 }
 
@@ -63,12 +135,15 @@ uint64_t ReadSpeedMbps(ClientContext &context, const string &interface) {
 		}
 		return 0;
 	}
+	string line;
 	uint64_t speed = 0;
-	file >> speed;
+	if (std::getline(file, line)) {
+		ParseUint64Prefix(line, speed);
+	}
 	return speed;
 }
 
-vector<NetworkInfo> GetNetworkInfoLinux(ClientContext &context) {
+vector<NetworkInfo> GetNetworkInfoLinux(ClientContext &context, AddressFamily family) {
 	vector<NetworkInfo> networks;
 	struct ifaddrs *ifaddr;
 	struct ifaddrs *ifa;
@@ -84,34 +159,27 @@ vector<NetworkInfo> GetNetworkInfoLinux(ClientContext &context) {
 		freeifaddrs(ifaddr);
 	};
 
+	// Maps interface name to its index in [networks], so aliased addresses are grouped into one entry.
+	unordered_map<string, idx_t> interface_index;
+
 	// Iterate through all network interfaces
 	for (ifa = ifaddr; ifa != NULL; ifa = ifa->ifa_next) {
-		if (ifa->ifa_addr == NULL) {
-			continue;
-		}
-
-		// Only process IPv4 addresses
-		if (ifa->ifa_addr->sa_family != AF_INET) {
+		NetworkAddress address;
+		if (!ParseNetworkAddress(context, ifa, family, address)) {
 			continue;
 		}
 
-		NetworkInfo info;
-		info.interface_name = ifa->ifa_name;
-
-		// Get IPv4 address
-		std::array<char, NI_MAXHOST> host;
-		int ret =
-		    getnameinfo(ifa->ifa_addr, sizeof(struct sockaddr_in), host.data(), NI_MAXHOST, NULL, 0, NI_NUMERICHOST);
-		if (ret != 0) {
-			if (auto db = GetDbInstance(context)) {
-				DUCKDB_LOG_DEBUG(*db, "getnameinfo() failed for interface %s: %s", info.interface_name.c_str(),
-				                 gai_strerror(ret));
-			}
-		} else {
-			info.ipv4_address = host.data();
+		auto iter = interface_index.find(ifa->ifa_name);
+		if (iter == interface_index.end()) {
+			iter = interface_index.emplace(ifa->ifa_name, networks.size()).first;
+			networks.emplace_back();
+			networks.back().interface_name = ifa->ifa_name;
 		}
+		AddNetworkAddress(networks[iter->second], std::move(address));
+	}
 
-		// Read statistics from /sys/class/net
+	// Read statistics from /sys/class/net, once per interface
+	for (auto &info : networks) {
 		info.speed_mbps = ReadSpeedMbps(context, info.interface_name);
 		info.rx_bytes = ReadSysNetValue(context, info.interface_name, "rx_bytes");
 		info.tx_bytes = ReadSysNetValue(context, info.interface_name, "tx_bytes");
@@ -121,8 +189,6 @@ vector<NetworkInfo> GetNetworkInfoLinux(ClientContext &context) {
 		info.tx_errors = ReadSysNetValue(context, info.interface_name, "tx_errors");
 		info.rx_dropped = ReadSysNetValue(context, info.interface_name, "rx_dropped");
 		info.tx_dropped = ReadSysNetValue(context, info.interface_name, "tx_dropped");
-
-		networks.emplace_back(info);
 	}
 
 	return networks;
@@ -130,7 +196,7 @@ vector<NetworkInfo> GetNetworkInfoLinux(ClientContext &context) {
 #endif
 
 #ifdef __APPLE__
-vector<NetworkInfo> GetNetworkInfoMacOS(ClientContext &context) {
+vector<NetworkInfo> GetNetworkInfoMacOS(ClientContext &context, AddressFamily family) {
 	vector<NetworkInfo> networks;
 
 	// Get network interface list using sysctl
@@ -193,49 +259,35 @@ vector<NetworkInfo> GetNetworkInfoMacOS(ClientContext &context) {
 
 		string interface_name(sdl->sdl_data, sdl->sdl_nlen);
 
-		// Find matching IPv4 address from getifaddrs
+		// Collect all matching addresses from getifaddrs
+		NetworkInfo info;
+		info.interface_name = interface_name;
 		for (struct ifaddrs *ifa = ifaddr; ifa != NULL; ifa = ifa->ifa_next) {
-			if (ifa->ifa_addr == NULL) {
-				continue;
-			}
-
 			if (strcmp(ifa->ifa_name, interface_name.c_str()) != 0) {
 				continue;
 			}
-			if (ifa->ifa_addr->sa_family != AF_INET) {
+			NetworkAddress address;
+			if (!ParseNetworkAddress(context, ifa, family, address)) {
 				continue;
 			}
-
-			NetworkInfo info;
-			info.interface_name = interface_name;
-
-			// Get IPv4 address
-			std::array<char, NI_MAXHOST> host;
-			int ret = getnameinfo(ifa->ifa_addr, sizeof(struct sockaddr_in), host.data(), NI_MAXHOST, NULL, 0,
-			                      NI_NUMERICHOST);
-			if (ret != 0) {
-				if (auto db = GetDbInstance(context)) {
-					DUCKDB_LOG_DEBUG(*db, "getnameinfo() failed for interface %s: %s", info.interface_name.c_str(),
-					                 gai_strerror(ret));
-				}
-			} else {
-				info.ipv4_address = host.data();
-			}
-
-			// Get statistics from if_msghdr2
-			info.tx_bytes = NumericCast<uint64_t>(if2m->ifm_data.ifi_obytes);
-			info.tx_packets = NumericCast<uint64_t>(if2m->ifm_data.ifi_opackets);
-			info.tx_errors = NumericCast<uint64_t>(if2m->ifm_data.ifi_oerrors);
-			info.tx_dropped = 0; // Not available on macOS
-			info.speed_mbps = 0; // Not available on macOS
-			info.rx_bytes = NumericCast<uint64_t>(if2m->ifm_data.ifi_ibytes);
-			info.rx_packets = NumericCast<uint64_t>(if2m->ifm_data.ifi_ipackets);
-			info.rx_errors = NumericCast<uint64_t>(if2m->ifm_data.ifi_ierrors);
-			info.rx_dropped = NumericCast<uint64_t>(if2m->ifm_data.ifi_iqdrops);
-
-			networks.emplace_back(info);
-			break;
+			AddNetworkAddress(info, std::move(address));
 		}
+		if (info.addresses.empty()) {
+			continue;
+		}
+
+		// Get statistics from if_msghdr2
+		info.tx_bytes = NumericCast<uint64_t>(if2m->ifm_data.ifi_obytes);
+		info.tx_packets = NumericCast<uint64_t>(if2m->ifm_data.ifi_opackets);
+		info.tx_errors = NumericCast<uint64_t>(if2m->ifm_data.ifi_oerrors);
+		info.tx_dropped = 0; // Not available on macOS
+		info.speed_mbps = 0; // Not available on macOS
+		info.rx_bytes = NumericCast<uint64_t>(if2m->ifm_data.ifi_ibytes);
+		info.rx_packets = NumericCast<uint64_t>(if2m->ifm_data.ifi_ipackets);
+		info.rx_errors = NumericCast<uint64_t>(if2m->ifm_data.ifi_ierrors);
+		info.rx_dropped = NumericCast<uint64_t>(if2m->ifm_data.ifi_iqdrops);
+
+		networks.emplace_back(std::move(info));
 	}
 
 	return networks;
@@ -244,11 +296,33 @@ vector<NetworkInfo> GetNetworkInfoMacOS(ClientContext &context) {
 
 } // namespace
 
-vector<NetworkInfo> GetNetworkInfo(ClientContext &context) {
+AddressFamily ParseAddressFamily(const string &family_str) {
+	string lower_family = StringUtil::Lower(family_str);
+	if (lower_family == "all") {
+		return AddressFamily::ALL;
+	}
+	if (lower_family == "ipv4") {
+		return AddressFamily::IPV4;
+	}
+	if (lower_family == "ipv6") {
+		return AddressFamily::IPV6;
+	}
+	throw InvalidInputException("Invalid address family '%s'. Supported families: all, ipv4, ipv6", family_str);
+}
+
+vector<NetworkInfo> GetNetworkInfo(ClientContext &context, AddressFamily family) {
+	vector<NetworkInfo> networks;
+	if (ReadSharedNetworkInfo(context, family, networks)) {
+		return networks;
+	}
+	return CollectNetworkInfo(context, family);
+}
+
+vector<NetworkInfo> CollectNetworkInfo(ClientContext &context, AddressFamily family) {
 #ifdef __linux__
-	return GetNetworkInfoLinux(context);
+	return GetNetworkInfoLinux(context, family);
 #elif __APPLE__
-	return GetNetworkInfoMacOS(context);
+	return GetNetworkInfoMacOS(context, family);
 #else
 	throw NotImplementedException("Network statistics are not supported on this platform");
 #endif
@@ -11,9 +11,50 @@ namespace duckdb {
 
 namespace {
 
+// LIST(STRUCT(family VARCHAR, address VARCHAR, prefixlen INTEGER))
+LogicalType GetAddressStructType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("family", LogicalType {LogicalTypeId::VARCHAR});
+	children.emplace_back("address", LogicalType {LogicalTypeId::VARCHAR});
+	children.emplace_back("prefixlen", LogicalType {LogicalTypeId::INTEGER});
+	return LogicalType::STRUCT(std::move(children));
+}
+
+LogicalType GetAddressListType() {
+	return LogicalType::LIST(GetAddressStructType());
+}
+
+Value GetAddressListValue(const vector<NetworkAddress> &addresses) {
+	vector<Value> address_values;
+	address_values.reserve(addresses.size());
+	for (const auto &address : addresses) {
+		child_list_t<Value> children;
+		children.emplace_back("family", Value(address.family));
+		children.emplace_back("address", Value(address.address));
+		children.emplace_back("prefixlen", Value::INTEGER(address.prefix_len));
+		address_values.emplace_back(Value::STRUCT(std::move(children)));
+	}
+	return Value::LIST(GetAddressStructType(), std::move(address_values));
+}
+
+struct SysNetworkInfoBindData : public FunctionData {
+	AddressFamily family = AddressFamily::ALL;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysNetworkInfoBindData>();
+		return family == other.family;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysNetworkInfoBindData>();
+		result->family = family;
+		return std::move(result);
+	}
+};
+
 struct SysNetworkInfoData : public GlobalTableFunctionState {
-	explicit SysNetworkInfoData(ClientContext &context) : finished(false), current_index(0) {
-		networks = GetNetworkInfo(context);
+	SysNetworkInfoData(ClientContext &context, AddressFamily family) : finished(false), current_index(0) {
+		networks = GetNetworkInfo(context, family);
 	}
 	bool finished;
 	size_t current_index;
@@ -24,8 +65,16 @@ unique_ptr<FunctionData> SysNetworkInfoBind(ClientContext &context, TableFunctio
                                             vector<LogicalType> &return_types, vector<string> &names) {
 	D_ASSERT(return_types.empty());
 	D_ASSERT(names.empty());
-	return_types.reserve(11);
-	names.reserve(11);
+	return_types.reserve(12);
+	names.reserve(12);
+
+	auto result = make_uniq<SysNetworkInfoBindData>();
+
+	// Parse address family parameter if provided, so unrequested addresses are never collected
+	auto family_it = input.named_parameters.find("family");
+	if (family_it != input.named_parameters.end()) {
+		result->family = ParseAddressFamily(family_it->second.ToString());
+	}
 
 	names.emplace_back("interface_name");
 	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
@@ -60,11 +109,15 @@ unique_ptr<FunctionData> SysNetworkInfoBind(ClientContext &context, TableFunctio
 	names.emplace_back("link_speed_mbps");
 	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
 
-	return nullptr;
+	names.emplace_back("addresses");
+	return_types.emplace_back(GetAddressListType());
+
+	return std::move(result);
 }
 
 unique_ptr<GlobalTableFunctionState> SysNetworkInfoInit(ClientContext &context, TableFunctionInitInput &input) {
-	return make_uniq<SysNetworkInfoData>(context);
+	auto &bind_data = input.bind_data->Cast<SysNetworkInfoBindData>();
+	return make_uniq<SysNetworkInfoData>(context, bind_data.family);
 }
 
 void SysNetworkInfoFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
@@ -115,6 +168,9 @@ void SysNetworkInfoFunc(ClientContext &context, TableFunctionInput &data_p, Data
 		// link_speed_mbps
 		output.SetValue(col_idx++, output_count, Value::UBIGINT(info.speed_mbps));
 
+		// addresses
+		output.SetValue(col_idx++, output_count, GetAddressListValue(info.addresses));
+
 		data.current_index++;
 		output_count++;
 	}
@@ -132,6 +188,7 @@ void SysNetworkInfoFunc(ClientContext &context, TableFunctionInput &data_p, Data
 void RegisterSysNetworkInfoFunction(ExtensionLoader &loader) {
 	TableFunction sys_network_info_func("sys_network_info", {}, SysNetworkInfoFunc, SysNetworkInfoBind,
 	                                    SysNetworkInfoInit);
+	sys_network_info_func.named_parameters["family"] = LogicalType::VARCHAR;
 	loader.RegisterFunction(sys_network_info_func);
 }
 
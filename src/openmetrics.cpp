@@ -0,0 +1,295 @@
+#include "openmetrics.hpp"
+
+#include "cpu_stats.hpp"
+#include "disk_stats.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+#include "memory_stats.hpp"
+#include "network_stats.hpp"
+#include "os_info.hpp"
+
+#include <charconv>
+
+namespace duckdb {
+
+namespace {
+
+// Buffer size reserved for the host-wide metrics, and for the metrics of each disk and network interface.
+constexpr idx_t BASE_RESERVE_SIZE = 4096;
+constexpr idx_t DISK_RESERVE_SIZE = 1024;
+constexpr idx_t NETWORK_RESERVE_SIZE = 1024;
+
+// Bytes per second of 1 megabit per second.
+constexpr uint64_t BYTES_PER_MEGABIT = 125000;
+
+std::string_view GetTypeName(MetricType type, MetricsFormat format) {
+	switch (type) {
+	case MetricType::COUNTER:
+		return "counter";
+	case MetricType::INFO:
+		// Prometheus text format has no info type, it is exposed as a gauge with "_info" suffix by convention.
+		return format == MetricsFormat::OPENMETRICS ? "info" : "gauge";
+	default:
+		return "gauge";
+	}
+}
+
+std::string_view GetSampleSuffix(MetricType type) {
+	switch (type) {
+	case MetricType::COUNTER:
+		return "_total";
+	case MetricType::INFO:
+		return "_info";
+	default:
+		return "";
+	}
+}
+
+void AddCPUMetrics(MetricsWriter &writer, const CPUInfo &cpu) {
+	writer.AddFamily("duckdb_sys_cpu", MetricType::INFO, "", "CPU model information.");
+	writer.AddSample(
+	    {{"model_name", cpu.model_name}, {"architecture", cpu.architecture}, {"byte_order", cpu.byte_order}}, 1);
+
+	writer.AddFamily("duckdb_sys_cpu_logical", MetricType::GAUGE, "", "Number of logical CPUs.");
+	writer.AddSample({}, static_cast<uint64_t>(cpu.logical_cpus));
+
+	writer.AddFamily("duckdb_sys_cpu_physical", MetricType::GAUGE, "", "Number of physical CPU cores.");
+	writer.AddSample({}, static_cast<uint64_t>(cpu.physical_cpus));
+
+	writer.AddFamily("duckdb_sys_cpu_cache_bytes", MetricType::GAUGE, "bytes", "CPU cache size per level.");
+	writer.AddSample({{"level", "l1d"}}, static_cast<uint64_t>(cpu.l1d_cache_kb) * 1024);
+	writer.AddSample({{"level", "l1i"}}, static_cast<uint64_t>(cpu.l1i_cache_kb) * 1024);
+	writer.AddSample({{"level", "l2"}}, static_cast<uint64_t>(cpu.l2_cache_kb) * 1024);
+	writer.AddSample({{"level", "l3"}}, static_cast<uint64_t>(cpu.l3_cache_kb) * 1024);
+}
+
+void AddMemoryMetrics(MetricsWriter &writer, const MemoryInfo &memory) {
+	writer.AddFamily("duckdb_sys_memory_total_bytes", MetricType::GAUGE, "bytes", "Total physical memory.");
+	writer.AddSample({}, memory.total_memory);
+
+	writer.AddFamily("duckdb_sys_memory_used_bytes", MetricType::GAUGE, "bytes", "Used physical memory.");
+	writer.AddSample({}, memory.used_memory);
+
+	writer.AddFamily("duckdb_sys_memory_free_bytes", MetricType::GAUGE, "bytes", "Free physical memory.");
+	writer.AddSample({}, memory.free_memory);
+
+	writer.AddFamily("duckdb_sys_memory_cached_bytes", MetricType::GAUGE, "bytes", "Cached memory.");
+	writer.AddSample({}, memory.cached_memory);
+
+	writer.AddFamily("duckdb_sys_swap_total_bytes", MetricType::GAUGE, "bytes", "Total swap space.");
+	writer.AddSample({}, memory.total_swap);
+
+	writer.AddFamily("duckdb_sys_swap_used_bytes", MetricType::GAUGE, "bytes", "Used swap space.");
+	writer.AddSample({}, memory.used_swap);
+
+	writer.AddFamily("duckdb_sys_swap_free_bytes", MetricType::GAUGE, "bytes", "Free swap space.");
+	writer.AddSample({}, memory.free_swap);
+}
+
+void AddDiskMetrics(MetricsWriter &writer, const vector<DiskInfo> &disks) {
+	// Samples of a family have to be contiguous, so iterate over all disks once per family.
+	auto add_family = [&](std::string_view name, std::string_view unit, std::string_view help,
+	                      uint64_t DiskInfo::*member) {
+		writer.AddFamily(name, MetricType::GAUGE, unit, help);
+		for (const auto &disk : disks) {
+			writer.AddSample(
+			    {{"mountpoint", disk.mount_point}, {"device", disk.file_system}, {"fstype", disk.file_system_type}},
+			    disk.*member);
+		}
+	};
+	add_family("duckdb_sys_filesystem_size_bytes", "bytes", "Filesystem size.", &DiskInfo::total_space);
+	add_family("duckdb_sys_filesystem_used_bytes", "bytes", "Filesystem space used.", &DiskInfo::used_space);
+	add_family("duckdb_sys_filesystem_free_bytes", "bytes", "Filesystem space available to unprivileged users.",
+	           &DiskInfo::free_space);
+	add_family("duckdb_sys_filesystem_files", "", "Filesystem total inodes.", &DiskInfo::total_inodes);
+	add_family("duckdb_sys_filesystem_files_used", "", "Filesystem inodes used.", &DiskInfo::used_inodes);
+	add_family("duckdb_sys_filesystem_files_free", "", "Filesystem inodes available to unprivileged users.",
+	           &DiskInfo::free_inodes);
+
+	writer.AddFamily("duckdb_sys_filesystem_readonly", MetricType::GAUGE, "", "Whether the filesystem is read-only.");
+	for (const auto &disk : disks) {
+		writer.AddSample(
+		    {{"mountpoint", disk.mount_point}, {"device", disk.file_system}, {"fstype", disk.file_system_type}},
+		    disk.read_only ? 1 : 0);
+	}
+}
+
+void AddNetworkMetrics(MetricsWriter &writer, const vector<NetworkInfo> &networks) {
+	auto add_counter = [&](std::string_view name, std::string_view unit, std::string_view help,
+	                       uint64_t NetworkInfo::*member) {
+		writer.AddFamily(name, MetricType::COUNTER, unit, help);
+		for (const auto &network : networks) {
+			writer.AddSample({{"interface", network.interface_name}}, network.*member);
+		}
+	};
+	add_counter("duckdb_sys_network_transmit_bytes", "bytes", "Bytes transmitted.", &NetworkInfo::tx_bytes);
+	add_counter("duckdb_sys_network_transmit_packets", "", "Packets transmitted.", &NetworkInfo::tx_packets);
+	add_counter("duckdb_sys_network_transmit_errors", "", "Transmission errors.", &NetworkInfo::tx_errors);
+	add_counter("duckdb_sys_network_transmit_dropped", "", "Packets dropped during transmission.",
+	            &NetworkInfo::tx_dropped);
+	add_counter("duckdb_sys_network_receive_bytes", "bytes", "Bytes received.", &NetworkInfo::rx_bytes);
+	add_counter("duckdb_sys_network_receive_packets", "", "Packets received.", &NetworkInfo::rx_packets);
+	add_counter("duckdb_sys_network_receive_errors", "", "Receive errors.", &NetworkInfo::rx_errors);
+	add_counter("duckdb_sys_network_receive_dropped", "", "Packets dropped during receive.", &NetworkInfo::rx_dropped);
+
+	writer.AddFamily("duckdb_sys_network_speed_bytes", MetricType::GAUGE, "bytes",
+	                 "Link speed in bytes per second, 0 if not available.");
+	for (const auto &network : networks) {
+		writer.AddSample({{"interface", network.interface_name}}, network.speed_mbps * BYTES_PER_MEGABIT);
+	}
+}
+
+void AddOSMetrics(MetricsWriter &writer, const OSInfo &os) {
+	writer.AddFamily("duckdb_sys_os", MetricType::INFO, "", "Operating system information.");
+	writer.AddSample({{"name", os.name},
+	                  {"version", os.version},
+	                  {"architecture", os.architecture},
+	                  {"host_name", os.host_name}},
+	                 1);
+
+	writer.AddFamily("duckdb_sys_os_processes", MetricType::GAUGE, "", "Number of processes.");
+	writer.AddSample({}, static_cast<uint64_t>(os.process_count));
+
+	writer.AddFamily("duckdb_sys_os_threads", MetricType::GAUGE, "", "Number of threads.");
+	writer.AddSample({}, static_cast<uint64_t>(os.thread_count));
+
+	writer.AddFamily("duckdb_sys_os_open_handles", MetricType::GAUGE, "", "Number of open file handles.");
+	writer.AddSample({}, static_cast<uint64_t>(os.handle_count));
+
+	writer.AddFamily("duckdb_sys_os_uptime_seconds", MetricType::GAUGE, "seconds", "System uptime.");
+	writer.AddSample({}, os.os_up_since_seconds);
+}
+
+} // namespace
+
+MetricsWriter::MetricsWriter(MetricsFormat format, idx_t reserve_size) : format(format) {
+	buffer.reserve(reserve_size);
+}
+
+void MetricsWriter::AddFamily(std::string_view name, MetricType type, std::string_view unit, std::string_view help) {
+	sample_name.assign(name.data(), name.size());
+	const auto suffix = GetSampleSuffix(type);
+	sample_name.append(suffix.data(), suffix.size());
+
+	// OpenMetrics describes the family, while Prometheus text format describes the sample name.
+	const std::string_view described_name =
+	    format == MetricsFormat::OPENMETRICS ? name : std::string_view {sample_name};
+	const auto type_name = GetTypeName(type, format);
+
+	buffer += "# TYPE ";
+	buffer.append(described_name.data(), described_name.size());
+	buffer += ' ';
+	buffer.append(type_name.data(), type_name.size());
+	buffer += '\n';
+	if (format == MetricsFormat::OPENMETRICS && !unit.empty()) {
+		buffer += "# UNIT ";
+		buffer.append(described_name.data(), described_name.size());
+		buffer += ' ';
+		buffer.append(unit.data(), unit.size());
+		buffer += '\n';
+	}
+	buffer += "# HELP ";
+	buffer.append(described_name.data(), described_name.size());
+	buffer += ' ';
+	buffer.append(help.data(), help.size());
+	buffer += '\n';
+}
+
+void MetricsWriter::AddSample(std::initializer_list<MetricLabel> labels, uint64_t value) {
+	buffer += sample_name;
+	if (labels.size() > 0) {
+		buffer += '{';
+		bool first = true;
+		for (const auto &label : labels) {
+			if (!first) {
+				buffer += ',';
+			}
+			first = false;
+			buffer.append(label.first.data(), label.first.size());
+			buffer += "=\"";
+			AppendEscapedLabelValue(label.second);
+			buffer += '"';
+		}
+		buffer += '}';
+	}
+	buffer += ' ';
+	char digits[24];
+	auto result = std::to_chars(digits, digits + sizeof(digits), value);
+	buffer.append(digits, result.ptr - digits);
+	buffer += '\n';
+}
+
+string MetricsWriter::Finish() {
+	if (format == MetricsFormat::OPENMETRICS) {
+		buffer += "# EOF\n";
+	}
+	return std::move(buffer);
+}
+
+void MetricsWriter::AppendEscapedLabelValue(std::string_view value) {
+	for (char c : value) {
+		switch (c) {
+		case '\\':
+			buffer += "\\\\";
+			break;
+		case '"':
+			buffer += "\\\"";
+			break;
+		case '\n':
+			buffer += "\\n";
+			break;
+		default:
+			buffer += c;
+		}
+	}
+}
+
+MetricsFormat ParseMetricsFormat(const string &format_str) {
+	string lower_format = StringUtil::Lower(format_str);
+	if (lower_format == "openmetrics") {
+		return MetricsFormat::OPENMETRICS;
+	}
+	if (lower_format == "prometheus") {
+		return MetricsFormat::PROMETHEUS;
+	}
+	throw InvalidInputException("Invalid metrics format '%s'. Supported formats: openmetrics, prometheus", format_str);
+}
+
+string GetMetricsText(ClientContext &context, MetricsFormat format) {
+	const CPUInfo cpu = GetCPUInfo(context);
+	const MemoryInfo memory = GetMemoryInfo(context);
+	const vector<DiskInfo> disks = GetDiskInfo(context);
+	const vector<NetworkInfo> networks = GetNetworkInfo(context);
+	const OSInfo os = GetOSInfo(context);
+
+	MetricsWriter writer(format,
+	                     BASE_RESERVE_SIZE + disks.size() * DISK_RESERVE_SIZE + networks.size() * NETWORK_RESERVE_SIZE);
+	AddCPUMetrics(writer, cpu);
+	AddMemoryMetrics(writer, memory);
+	AddDiskMetrics(writer, disks);
+	AddNetworkMetrics(writer, networks);
+	AddOSMetrics(writer, os);
+	return writer.Finish();
+}
+
+idx_t WriteMetricsFile(ClientContext &context, const string &path, MetricsFormat format) {
+	const string text = GetMetricsText(context, format);
+	auto &fs = FileSystem::GetFileSystem(context);
+	// Scrapers only pick up files with a known extension (i.e. "*.prom"), so the temporary file is never read.
+	const string temp_path = path + ".tmp";
+	try {
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(const_cast<char *>(text.data()), text.size());
+		handle->Close();
+		fs.MoveFile(temp_path, path);
+	} catch (...) {
+		fs.TryRemoveFile(temp_path);
+		throw;
+	}
+	return text.size();
+}
+
+} // namespace duckdb
@@ -0,0 +1,120 @@
+#include "openmetrics_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/config.hpp"
+#include "openmetrics.hpp"
+
+namespace duckdb {
+
+namespace {
+
+void SysMetricsOpenMetricsFunc(DataChunk &args, ExpressionState &state, Vector &result) {
+	const string text = GetMetricsText(state.GetContext(), MetricsFormat::OPENMETRICS);
+	result.SetVectorType(VectorType::CONSTANT_VECTOR);
+	ConstantVector::GetData<string_t>(result)[0] = StringVector::AddString(result, text);
+}
+
+struct SysWriteMetricsBindData : public FunctionData {
+	string path;
+	MetricsFormat format = MetricsFormat::OPENMETRICS;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysWriteMetricsBindData>();
+		return path == other.path && format == other.format;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysWriteMetricsBindData>();
+		result->path = path;
+		result->format = format;
+		return std::move(result);
+	}
+};
+
+struct SysWriteMetricsData : public GlobalTableFunctionState {
+	SysWriteMetricsData() : finished(false) {
+	}
+	bool finished;
+};
+
+unique_ptr<FunctionData> SysWriteMetricsBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(2);
+	names.reserve(2);
+
+	if (!DBConfig::GetConfig(context).options.enable_external_access) {
+		throw PermissionException("sys_write_metrics is disabled through configuration");
+	}
+
+	auto result = make_uniq<SysWriteMetricsBindData>();
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("Path for sys_write_metrics cannot be NULL");
+	}
+	result->path = input.inputs[0].ToString();
+
+	// Parse format parameter if provided
+	auto format_it = input.named_parameters.find("format");
+	if (format_it != input.named_parameters.end()) {
+		result->format = ParseMetricsFormat(format_it->second.ToString());
+	}
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("bytes_written");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysWriteMetricsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysWriteMetricsData>();
+}
+
+void SysWriteMetricsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysWriteMetricsData>();
+	auto &bind_data = data_p.bind_data->Cast<SysWriteMetricsBindData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	const idx_t bytes_written = WriteMetricsFile(context, bind_data.path, bind_data.format);
+
+	idx_t col_idx = 0;
+
+	// path
+	output.SetValue(col_idx++, 0, Value(bind_data.path));
+
+	// bytes_written
+	output.SetValue(col_idx++, 0, Value::UBIGINT(bytes_written));
+
+	output.SetCardinality(1);
+	data.finished = true;
+}
+
+} // namespace
+
+void RegisterSysMetricsOpenMetricsFunction(ExtensionLoader &loader) {
+	ScalarFunction sys_metrics_openmetrics_func("sys_metrics_openmetrics", {}, LogicalType::VARCHAR,
+	                                            SysMetricsOpenMetricsFunc);
+	// Metrics change between calls, so the result must not be constant folded or cached.
+	sys_metrics_openmetrics_func.stability = FunctionStability::VOLATILE;
+	loader.RegisterFunction(sys_metrics_openmetrics_func);
+}
+
+void RegisterSysWriteMetricsFunction(ExtensionLoader &loader) {
+	TableFunction sys_write_metrics_func("sys_write_metrics", {LogicalType::VARCHAR}, SysWriteMetricsFunc,
+	                                     SysWriteMetricsBind, SysWriteMetricsInit);
+	sys_write_metrics_func.named_parameters["format"] = LogicalType::VARCHAR;
+	loader.RegisterFunction(sys_write_metrics_func);
+}
+
+} // namespace duckdb
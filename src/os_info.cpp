@@ -9,16 +9,19 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "hardware_info_cache.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "process_events.hpp"
 #include "scope_guard.hpp"
+#include "shared_metrics.hpp"
 #include "string_utils.hpp"
 
 #ifdef __linux__
 #include <cerrno>
-#include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <dirent.h>
 #include <sys/sysinfo.h>
 #include <sys/utsname.h>
 #include <unistd.h>
@@ -41,15 +44,6 @@ namespace {
 
 #ifdef __linux__
 
-struct ProcessStatus {
-	int32_t active_processes = 0;
-	int32_t running_processes = 0;
-	int32_t sleeping_processes = 0;
-	int32_t stopped_processes = 0;
-	int32_t zombie_processes = 0;
-	int32_t total_threads = 0;
-};
-
 // Read OS name from /etc/os-release; return empty string if not found.
 string ReadOSName(ClientContext &context) {
 	// Key-value pair example: PRETTY_NAME="Debian GNU/Linux 13 (trixie)"
@@ -87,9 +81,12 @@ int32_t ReadHandleCount(ClientContext &context) {
 		return 0;
 	}
 
-	int allocated = 0;
-	file >> allocated;
-	if (file.fail()) {
+	// Format: allocated unused maximum
+	string line;
+	int32_t allocated = 0;
+	size_t pos = 0;
+	std::string_view token;
+	if (!std::getline(file, line) || !NextToken(line, pos, token) || !ParseInteger(token, allocated)) {
 		return 0;
 	}
 	return allocated;
@@ -98,206 +95,95 @@ int32_t ReadHandleCount(ClientContext &context) {
 // Fallback: Count file descriptors from /proc/*/fd directories
 // This is used when /proc/sys/fs/file-nr is not available (e.g., older kernels or restricted environments)
 int32_t ReadHandleCountFallback() {
-	DIR *dirp = opendir("/proc");
-	if (!dirp) {
-		return 0;
-	}
-
-	SCOPE_EXIT {
-		closedir(dirp);
-	};
-
+	ProcDirectory proc_dir("/proc");
 	int32_t handle_count = 0;
-	struct dirent *ent = nullptr;
-	while ((ent = readdir(dirp)) != nullptr) {
-		if (ent->d_name[0] == '\0' || !std::isdigit(static_cast<unsigned char>(ent->d_name[0]))) {
-			continue;
-		}
-
+	int32_t pid = 0;
+	std::array<char, 32> path;
+	while (proc_dir.Next(pid)) {
 		// Count file descriptors in /proc/pid/fd
-		string fd_path = StringUtil::Format("/proc/%s/fd", ent->d_name);
-		DIR *fd_dirp = opendir(fd_path.c_str());
-		if (!fd_dirp) {
-			continue;
-		}
-		SCOPE_EXIT {
-			closedir(fd_dirp);
-		};
-
-		struct dirent *fd_ent = nullptr;
-		while ((fd_ent = readdir(fd_dirp)) != nullptr) {
-			if (fd_ent->d_name[0] != '\0' && std::isdigit(static_cast<unsigned char>(fd_ent->d_name[0]))) {
-				handle_count++;
-			}
-		}
+		snprintf(path.data(), path.size(), "%d/fd", pid);
+		ProcDirectory fd_dir(proc_dir.GetFd(), path.data());
+		handle_count += NumericCast<int32_t>(fd_dir.CountRemaining());
 	}
-
 	return handle_count;
 }
 
-// Read process status from /proc directory
-ProcessStatus ReadProcessStatus() {
-	ProcessStatus status;
-
-	DIR *dirp = opendir("/proc");
-	if (!dirp) {
-		return status;
-	}
-	SCOPE_EXIT {
-		closedir(dirp);
-	};
-
-	struct dirent *ent = nullptr;
-	while ((ent = readdir(dirp)) != nullptr) {
-		// Skip non-numeric entries, only PID directories start with digits.
-		if (!std::isdigit(static_cast<unsigned char>(ent->d_name[0]))) {
-			continue;
-		}
-		status.active_processes++;
-		string stat_path = StringUtil::Format("/proc/%s/stat", ent->d_name);
-		FILE *stat_file = fopen(stat_path.c_str(), "r");
-		if (!stat_file) {
-			continue;
-		}
-		SCOPE_EXIT {
-			fclose(stat_file);
-		};
-
-		std::array<char, 512> line_buf {};
-		if (!fgets(line_buf.data(), line_buf.size(), stat_file)) {
-			continue;
-		}
-
-		// `line` is our parsing cursor into the stat line; we advance it as we consume fields.
-		// Example: [pid] [comm] [state] [ppid] ...
-		// Skip the PID field by finding the first space
-		char *line = line_buf.data();
-
-		// Skip PID (first field) - find first space
-		while (*line != '\0' && *line != ' ' && *line != '\t') {
-			line++;
-		}
-		if (*line == '\0') {
-			continue; // malformed line
-		}
-
-		// Skip whitespace before '(' of comm field
-		while (*line == ' ' || *line == '\t') {
-			line++;
-		}
-		if (*line != '(') {
-			continue;
-		}
-		line++; // skip '('
-
-		// Find the closing ')' of comm (process name field)
-		char *comm_end = strrchr(line, ')');
-		if (!comm_end) {
-			continue; // malformed /proc entry
-		}
-
-		// Extract comm if needed, move cursor past ')'.
-		line = comm_end + 1;
-
-		// Skip whitespace after comm
-		while (*line == ' ' || *line == '\t') {
-			line++;
-		}
-		if (*line == '\0') {
-			continue;
-		}
-
-		// Parse fields after comm
-		char state = '\0';
-		int ppid = 0, pgrp = 0, session = 0, tty_nr = 0, tpgid = 0;
-		unsigned long flags = 0, minflt = 0, cminflt = 0, majflt = 0, cmajflt = 0;
-		unsigned long utime = 0, stime = 0, cutime = 0, cstime = 0, threads = 0;
-		long priority = 0, nice = 0;
-
-		int scanned = sscanf(line,
-		                     "%c %d %d %d %d %d %lu %lu %lu %lu %lu "
-		                     "%lu %lu %lu %lu %ld %ld %lu",
-		                     &state, &ppid, &pgrp, &session, &tty_nr, &tpgid, &flags, &minflt, &cminflt, &majflt,
-		                     &cmajflt, &utime, &stime, &cutime, &cstime, &priority, &nice, &threads);
-		if (scanned < 18) {
-			continue; // incomplete record
-		}
-
-		// Count processes by state
-		switch (state) {
-		case 'R':
-			status.running_processes++;
-			break;
-		case 'S':
-		case 'D':
-			status.sleeping_processes++;
-			break;
-		case 'T':
-			status.stopped_processes++;
-			break;
-		case 'Z':
-			status.zombie_processes++;
-			break;
-		}
-
-		status.total_threads += threads;
-	}
-
-	return status;
-}
-
-OSInfo GetOSInfoLinux(ClientContext &context) {
+OSInfo GetOSInfoLinux(ClientContext &context, OSInfoFields fields) {
 	OSInfo info;
 
 	struct utsname uts;
-	if (uname(&uts) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "uname() failed: %s", strerror(errno));
+	bool has_uts = false;
+	if (fields & (OS_INFO_NAME | OS_INFO_VERSION | OS_INFO_ARCHITECTURE)) {
+		if (uname(&uts) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "uname() failed: %s", strerror(errno));
+			}
+		} else {
+			has_uts = true;
+			if (fields & OS_INFO_VERSION) {
+				info.version = StringUtil::Format("%s %s", uts.sysname, uts.release);
+			}
+			if (fields & OS_INFO_ARCHITECTURE) {
+				info.architecture = uts.machine;
+			}
 		}
-	} else {
-		info.version = StringUtil::Format("%s %s", uts.sysname, uts.release);
-		info.architecture = uts.machine;
 	}
 
 	// Get hostname
-	std::array<char, 256> hostname_buf {};
-	if (gethostname(hostname_buf.data(), hostname_buf.size()) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "gethostname() failed: %s", strerror(errno));
+	if (fields & OS_INFO_HOST_NAME) {
+		std::array<char, 256> hostname_buf {};
+		if (gethostname(hostname_buf.data(), hostname_buf.size()) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "gethostname() failed: %s", strerror(errno));
+			}
+		} else {
+			info.host_name = hostname_buf.data();
 		}
-	} else {
-		info.host_name = hostname_buf.data();
 	}
 
 	// Read OS name from /etc/os-release
-	info.name = ReadOSName(context);
-	if (info.name.empty()) {
-		// Fallback to sysname from uname
-		if (uname(&uts) == 0) {
+	if (fields & OS_INFO_NAME) {
+		info.name = ReadOSName(context);
+		if (info.name.empty() && has_uts) {
+			// Fallback to sysname from uname
 			info.name = uts.sysname;
 		}
 	}
 
 	// Read handle count
-	info.handle_count = ReadHandleCount(context);
-	if (info.handle_count == 0) {
-		// Fallback: count file descriptors from /proc/*/fd if /proc/sys/fs/file-nr is unavailable
-		info.handle_count = ReadHandleCountFallback();
+	if (fields & OS_INFO_HANDLE_COUNT) {
+		info.handle_count = ReadHandleCount(context);
+		if (info.handle_count == 0) {
+			// Fallback: count file descriptors from /proc/*/fd if /proc/sys/fs/file-nr is unavailable
+			info.handle_count = ReadHandleCountFallback();
+		}
 	}
 
-	// Read process status
-	ProcessStatus proc_status = ReadProcessStatus();
-	info.process_count = proc_status.active_processes;
-	info.thread_count = proc_status.total_threads;
+	// Process and thread counts are kept up to date by the process event listener if it runs, otherwise both counts
+	// come from the same walk of /proc
+	if (fields & (OS_INFO_PROCESS_COUNT | OS_INFO_THREAD_COUNT)) {
+		int64_t process_count = 0;
+		int64_t thread_count = 0;
+		if (GetProcessEventCounts(context, process_count, thread_count)) {
+			info.process_count = NumericCast<int32_t>(process_count);
+			info.thread_count = NumericCast<int32_t>(thread_count);
+		} else {
+			ProcessStatus proc_status = ReadProcessStatus();
+			info.process_count = proc_status.active_processes;
+			info.thread_count = proc_status.total_threads;
+		}
+	}
 
 	// Get uptime
-	struct sysinfo s_info;
-	if (sysinfo(&s_info) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "sysinfo() failed: %s", strerror(errno));
+	if (fields & OS_INFO_OS_UP_SINCE_SECONDS) {
+		struct sysinfo s_info;
+		if (sysinfo(&s_info) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "sysinfo() failed: %s", strerror(errno));
+			}
+		} else {
+			info.os_up_since_seconds = NumericCast<uint64_t>(s_info.uptime);
 		}
-	} else {
-		info.os_up_since_seconds = NumericCast<uint64_t>(s_info.uptime);
 	}
 
 	return info;
@@ -394,55 +280,73 @@ int32_t GetHandleCountMacOS(ClientContext &context) {
 	return total_handles;
 }
 
-OSInfo GetOSInfoMacOS(ClientContext &context) {
+OSInfo GetOSInfoMacOS(ClientContext &context, OSInfoFields fields) {
 	OSInfo info;
 
-	struct utsname uts;
-	if (uname(&uts) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "uname() failed: %s", strerror(errno));
+	if (fields & (OS_INFO_NAME | OS_INFO_VERSION | OS_INFO_ARCHITECTURE)) {
+		struct utsname uts;
+		if (uname(&uts) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "uname() failed: %s", strerror(errno));
+			}
+		} else {
+			if (fields & OS_INFO_NAME) {
+				info.name = uts.sysname;
+			}
+			if (fields & OS_INFO_VERSION) {
+				info.version = uts.version;
+			}
+			if (fields & OS_INFO_ARCHITECTURE) {
+				info.architecture = uts.machine;
+			}
 		}
-	} else {
-		info.name = uts.sysname;
-		info.version = uts.version;
-		info.architecture = uts.machine;
 	}
 
 	// Get hostname
-	std::array<char, 256> hostname_buf;
-	if (gethostname(hostname_buf.data(), hostname_buf.size()) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "gethostname() failed: %s", strerror(errno));
+	if (fields & OS_INFO_HOST_NAME) {
+		std::array<char, 256> hostname_buf;
+		if (gethostname(hostname_buf.data(), hostname_buf.size()) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "gethostname() failed: %s", strerror(errno));
+			}
+		} else {
+			info.host_name = hostname_buf.data();
 		}
-	} else {
-		info.host_name = hostname_buf.data();
 	}
 
 	// Get process count using sysctl
-	std::array<int, 4> mib = {CTL_KERN, KERN_PROC, KERN_PROC_ALL, 0};
-	size_t len = 0;
-	if (sysctl(mib.data(), mib.size(), nullptr, &len, nullptr, 0) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "sysctl() failed to get process count: %s", strerror(errno));
+	if (fields & OS_INFO_PROCESS_COUNT) {
+		std::array<int, 4> mib = {CTL_KERN, KERN_PROC, KERN_PROC_ALL, 0};
+		size_t len = 0;
+		if (sysctl(mib.data(), mib.size(), nullptr, &len, nullptr, 0) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "sysctl() failed to get process count: %s", strerror(errno));
+			}
+		} else if (len > 0) {
+			info.process_count = NumericCast<int32_t>(len / sizeof(struct kinfo_proc));
 		}
-	} else if (len > 0) {
-		info.process_count = NumericCast<int32_t>(len / sizeof(struct kinfo_proc));
 	}
 
 	// Get thread count by summing threads from all processes
-	info.thread_count = GetThreadCountMacOS(context);
+	if (fields & OS_INFO_THREAD_COUNT) {
+		info.thread_count = GetThreadCountMacOS(context);
+	}
 
 	// Get handle count by summing file descriptors from all processes
-	info.handle_count = GetHandleCountMacOS(context);
+	if (fields & OS_INFO_HANDLE_COUNT) {
+		info.handle_count = GetHandleCountMacOS(context);
+	}
 
 	// Get uptime using clock_gettime
-	struct timespec uptime;
-	if (clock_gettime(CLOCK_MONOTONIC_RAW, &uptime) != 0) {
-		if (auto db = GetDbInstance(context)) {
-			DUCKDB_LOG_DEBUG(*db, "clock_gettime() failed: %s", strerror(errno));
+	if (fields & OS_INFO_OS_UP_SINCE_SECONDS) {
+		struct timespec uptime;
+		if (clock_gettime(CLOCK_MONOTONIC_RAW, &uptime) != 0) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "clock_gettime() failed: %s", strerror(errno));
+			}
+		} else {
+			info.os_up_since_seconds = NumericCast<uint64_t>(uptime.tv_sec);
 		}
-	} else {
-		info.os_up_since_seconds = NumericCast<uint64_t>(uptime.tv_sec);
 	}
 
 	return info;
@@ -451,11 +355,98 @@ OSInfo GetOSInfoMacOS(ClientContext &context) {
 
 } // namespace
 
+ProcessStatus ReadProcessStatus() {
+#ifdef __linux__
+	ProcessStatus status;
+	ProcDirectory proc_dir("/proc");
+	int32_t pid = 0;
+	std::array<char, 32> path;
+	std::array<char, 512> buf;
+	while (proc_dir.Next(pid)) {
+		status.active_processes++;
+		snprintf(path.data(), path.size(), "%d/stat", pid);
+		const std::string_view line = ReadFileAt(proc_dir.GetFd(), path.data(), buf);
+
+		// Fields after comm, 0-indexed from state (field 3 in proc(5)).
+		static constexpr size_t STATE_IDX = 0;
+		static constexpr size_t NUM_THREADS_IDX = 17;
+
+		std::string_view comm;
+		std::string_view fields;
+		if (!SplitProcStat(line, comm, fields)) {
+			continue; // exited process or malformed /proc entry
+		}
+		std::array<std::string_view, NUM_THREADS_IDX + 1> tokens;
+		uint64_t threads = 0;
+		if (SplitTokens(fields, tokens.data(), tokens.size()) != tokens.size() ||
+		    !ParseUint64(tokens[NUM_THREADS_IDX], threads)) {
+			continue; // incomplete record
+		}
+		const char state = tokens[STATE_IDX][0];
+
+		// Count processes by state
+		switch (state) {
+		case 'R':
+			status.running_processes++;
+			break;
+		case 'S':
+		case 'D':
+			status.sleeping_processes++;
+			break;
+		case 'T':
+			status.stopped_processes++;
+			break;
+		case 'Z':
+			status.zombie_processes++;
+			break;
+		}
+
+		status.total_threads += threads;
+	}
+
+	return status;
+#else
+	return {};
+#endif
+}
+
 OSInfo GetOSInfo(ClientContext &context) {
+	return GetOSInfo(context, OS_INFO_ALL);
+}
+
+OSInfo GetOSInfo(ClientContext &context, OSInfoFields fields) {
+	// Counts which walk /proc are taken from the shared metrics snapshot if enabled and fresh.
+	static constexpr OSInfoFields SHARED_FIELDS = OS_INFO_HANDLE_COUNT | OS_INFO_PROCESS_COUNT | OS_INFO_THREAD_COUNT;
+	OSInfo shared_info;
+	if ((fields & SHARED_FIELDS) && ReadSharedOSCounts(context, shared_info)) {
+		OSInfo info = GetOSInfo(context, fields & ~SHARED_FIELDS);
+		info.handle_count = (fields & OS_INFO_HANDLE_COUNT) ? shared_info.handle_count : 0;
+		info.process_count = (fields & OS_INFO_PROCESS_COUNT) ? shared_info.process_count : 0;
+		info.thread_count = (fields & OS_INFO_THREAD_COUNT) ? shared_info.thread_count : 0;
+		return info;
+	}
+	if ((fields & OS_INFO_STATIC_FIELDS) == 0) {
+		return CollectOSInfo(context, fields);
+	}
+	OSInfo info = CollectOSInfo(context, fields & ~OS_INFO_STATIC_FIELDS);
+	const OSInfo static_info = GetHardwareInfoCache(context)->GetStaticOSInfo(context);
+	if (fields & OS_INFO_NAME) {
+		info.name = static_info.name;
+	}
+	if (fields & OS_INFO_VERSION) {
+		info.version = static_info.version;
+	}
+	if (fields & OS_INFO_ARCHITECTURE) {
+		info.architecture = static_info.architecture;
+	}
+	return info;
+}
+
+OSInfo CollectOSInfo(ClientContext &context, OSInfoFields fields) {
 #ifdef __linux__
-	return GetOSInfoLinux(context);
+	return GetOSInfoLinux(context, fields);
 #elif __APPLE__
-	return GetOSInfoMacOS(context);
+	return GetOSInfoMacOS(context, fields);
 #else
 	throw NotImplementedException("OS information is not supported on this platform");
 #endif
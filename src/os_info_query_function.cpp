@@ -2,6 +2,7 @@
 
 #include "duckdb/common/assert.hpp"
 #include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
 #include "duckdb/common/vector_size.hpp"
 #include "duckdb/function/table_function.hpp"
 #include "os_info.hpp"
@@ -10,11 +11,27 @@ namespace duckdb {
 
 namespace {
 
+// OSInfo field of each column, in bind order.
+constexpr OSInfoFields COLUMN_FIELDS[] = {
+    OS_INFO_NAME,          OS_INFO_VERSION,       OS_INFO_HOST_NAME,    OS_INFO_HANDLE_COUNT,
+    OS_INFO_PROCESS_COUNT, OS_INFO_THREAD_COUNT, OS_INFO_ARCHITECTURE, OS_INFO_OS_UP_SINCE_SECONDS,
+};
+constexpr idx_t COLUMN_COUNT = sizeof(COLUMN_FIELDS) / sizeof(COLUMN_FIELDS[0]);
+
 struct SysOSInfoData : public GlobalTableFunctionState {
-	explicit SysOSInfoData(ClientContext &context) : finished(false) {
-		os_info = GetOSInfo(context);
+	SysOSInfoData(ClientContext &context, vector<column_t> column_ids_p)
+	    : finished(false), column_ids(std::move(column_ids_p)) {
+		// Only collect the projected columns, i.e. "SELECT host_name" does not walk /proc.
+		OSInfoFields fields = 0;
+		for (const auto column_id : column_ids) {
+			if (column_id < COLUMN_COUNT) {
+				fields |= COLUMN_FIELDS[column_id];
+			}
+		}
+		os_info = GetOSInfo(context, fields);
 	}
 	bool finished;
+	vector<column_t> column_ids;
 	OSInfo os_info;
 };
 
@@ -22,8 +39,8 @@ unique_ptr<FunctionData> SysOSInfoBind(ClientContext &context, TableFunctionBind
                                        vector<LogicalType> &return_types, vector<string> &names) {
 	D_ASSERT(return_types.empty());
 	D_ASSERT(names.empty());
-	return_types.reserve(8);
-	names.reserve(8);
+	return_types.reserve(COLUMN_COUNT);
+	names.reserve(COLUMN_COUNT);
 
 	names.emplace_back("name");
 	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
@@ -53,7 +70,7 @@ unique_ptr<FunctionData> SysOSInfoBind(ClientContext &context, TableFunctionBind
 }
 
 unique_ptr<GlobalTableFunctionState> SysOSInfoInit(ClientContext &context, TableFunctionInitInput &input) {
-	return make_uniq<SysOSInfoData>(context);
+	return make_uniq<SysOSInfoData>(context, input.column_ids);
 }
 
 void SysOSInfoFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
@@ -64,31 +81,37 @@ void SysOSInfoFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk
 	}
 
 	const auto &info = data.os_info;
-	idx_t col_idx = 0;
-
-	// name
-	output.SetValue(col_idx++, 0, Value(info.name));
-
-	// version
-	output.SetValue(col_idx++, 0, Value(info.version));
-
-	// host_name
-	output.SetValue(col_idx++, 0, Value(info.host_name));
-
-	// handle_count
-	output.SetValue(col_idx++, 0, Value::INTEGER(info.handle_count));
-
-	// process_count
-	output.SetValue(col_idx++, 0, Value::INTEGER(info.process_count));
-
-	// thread_count
-	output.SetValue(col_idx++, 0, Value::INTEGER(info.thread_count));
-
-	// architecture
-	output.SetValue(col_idx++, 0, Value(info.architecture));
-
-	// os_up_since_seconds
-	output.SetValue(col_idx++, 0, Value::UBIGINT(info.os_up_since_seconds));
+	for (idx_t col_idx = 0; col_idx < data.column_ids.size(); col_idx++) {
+		switch (data.column_ids[col_idx]) {
+		case 0: // name
+			output.SetValue(col_idx, 0, Value(info.name));
+			break;
+		case 1: // version
+			output.SetValue(col_idx, 0, Value(info.version));
+			break;
+		case 2: // host_name
+			output.SetValue(col_idx, 0, Value(info.host_name));
+			break;
+		case 3: // handle_count
+			output.SetValue(col_idx, 0, Value::INTEGER(info.handle_count));
+			break;
+		case 4: // process_count
+			output.SetValue(col_idx, 0, Value::INTEGER(info.process_count));
+			break;
+		case 5: // thread_count
+			output.SetValue(col_idx, 0, Value::INTEGER(info.thread_count));
+			break;
+		case 6: // architecture
+			output.SetValue(col_idx, 0, Value(info.architecture));
+			break;
+		case 7: // os_up_since_seconds
+			output.SetValue(col_idx, 0, Value::UBIGINT(info.os_up_since_seconds));
+			break;
+		default: // virtual columns, i.e. the row id requested for count(*)
+			output.SetValue(col_idx, 0, Value(output.data[col_idx].GetType()));
+			break;
+		}
+	}
 
 	output.SetCardinality(1);
 	data.finished = true;
@@ -98,6 +121,7 @@ void SysOSInfoFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk
 
 void RegisterSysOSInfoFunction(ExtensionLoader &loader) {
 	TableFunction sys_os_info_func("sys_os_info", {}, SysOSInfoFunc, SysOSInfoBind, SysOSInfoInit);
+	sys_os_info_func.projection_pushdown = true;
 	loader.RegisterFunction(sys_os_info_func);
 }
 
@@ -0,0 +1,219 @@
+#include "page_cache.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+#include "scope_guard.hpp"
+
+#include <atomic>
+#include <cerrno>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#if defined(__linux__) || defined(__APPLE__)
+// Bytes mapped at a time for mincore(2), which needs one byte of residency vector per page.
+constexpr uint64_t MINCORE_CHUNK_BYTES = 256ULL * 1024 * 1024;
+
+#ifdef __APPLE__
+using MincoreVecType = char;
+#else
+using MincoreVecType = unsigned char;
+#endif
+
+uint64_t GetPageSize() {
+	static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	return page_size;
+}
+#endif
+
+#ifdef __linux__
+// System call number of cachestat(2), the same on all architectures; older kernel headers do not define it.
+#ifdef SYS_cachestat
+constexpr long CACHESTAT_SYSCALL = SYS_cachestat;
+#else
+constexpr long CACHESTAT_SYSCALL = 451;
+#endif
+
+// Arguments of cachestat(2) from <linux/mman.h>, which older kernel headers do not define.
+struct CachestatRange {
+	uint64_t off;
+	// 0 covers the file up to its end.
+	uint64_t len;
+};
+
+struct Cachestat {
+	uint64_t nr_cache;
+	uint64_t nr_dirty;
+	uint64_t nr_writeback;
+	uint64_t nr_evicted;
+	uint64_t nr_recently_evicted;
+};
+
+// Set once the kernel reported that cachestat(2) does not exist, so it is not tried for every file.
+std::atomic<bool> cachestat_unsupported {false};
+#endif
+
+void AddFile(const string &path, const char *file_type, const string &database, vector<FilePageCache> &result) {
+	FilePageCache cache;
+	cache.path = path;
+	cache.file_type = file_type;
+	cache.database = database;
+	if (ReadFilePageCache(cache)) {
+		result.emplace_back(std::move(cache));
+	}
+}
+
+} // namespace
+
+bool ReadPageCacheCachestat(int fd, FilePageCache &cache) {
+#ifdef __linux__
+	if (cachestat_unsupported.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	CachestatRange range {0, 0};
+	Cachestat stat {};
+	if (syscall(CACHESTAT_SYSCALL, fd, &range, &stat, 0) != 0) {
+		// EOPNOTSUPP for hugetlbfs files, which mincore(2) handles.
+		if (errno == ENOSYS) {
+			cachestat_unsupported.store(true, std::memory_order_relaxed);
+		}
+		return false;
+	}
+	cache.method = PageCacheMethod::CACHESTAT;
+	cache.cached_pages = stat.nr_cache;
+	cache.dirty_pages = stat.nr_dirty;
+	cache.writeback_pages = stat.nr_writeback;
+	cache.evicted_pages = stat.nr_evicted;
+	cache.recently_evicted_pages = stat.nr_recently_evicted;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool ReadPageCacheMincore(int fd, uint64_t size_bytes, FilePageCache &cache) {
+#if defined(__linux__) || defined(__APPLE__)
+	const uint64_t page_size = GetPageSize();
+	vector<MincoreVecType> residency;
+	uint64_t cached_pages = 0;
+	for (uint64_t offset = 0; offset < size_bytes; offset += MINCORE_CHUNK_BYTES) {
+		const uint64_t length = MinValue<uint64_t>(MINCORE_CHUNK_BYTES, size_bytes - offset);
+		// Mapping does not fault pages in, only touching them would.
+		void *addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset));
+		if (addr == MAP_FAILED) {
+			return false;
+		}
+		SCOPE_EXIT {
+			munmap(addr, length);
+		};
+		residency.resize((length + page_size - 1) / page_size);
+		if (mincore(addr, length, residency.data()) != 0) {
+			return false;
+		}
+		for (const auto page : residency) {
+			cached_pages += page & 1;
+		}
+	}
+	cache.method = PageCacheMethod::MINCORE;
+	cache.cached_pages = cached_pages;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool ReadFilePageCache(FilePageCache &cache) {
+#if defined(__linux__) || defined(__APPLE__)
+	// Without O_NONBLOCK, opening a FIFO matched by a pattern blocks until a writer shows up; it is then skipped below.
+	const int fd = open(cache.path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+	if (fd == -1) {
+		return false;
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+		return false;
+	}
+	const uint64_t page_size = GetPageSize();
+	cache.size_bytes = static_cast<uint64_t>(file_stat.st_size);
+	cache.total_pages = (cache.size_bytes + page_size - 1) / page_size;
+	if (!ReadPageCacheCachestat(fd, cache) && !ReadPageCacheMincore(fd, cache.size_bytes, cache)) {
+		return false;
+	}
+	cache.cached_bytes = cache.cached_pages * page_size;
+	return true;
+#else
+	return false;
+#endif
+}
+
+vector<FilePageCache> GetPageCacheForPattern(ClientContext &context, const string &pattern) {
+#if defined(__linux__) || defined(__APPLE__)
+	auto &fs = FileSystem::GetFileSystem(context);
+	vector<FilePageCache> result;
+	for (const auto &file_info : fs.Glob(pattern)) {
+		const idx_t count = result.size();
+		AddFile(file_info.path, "file", string(), result);
+		if (result.size() == count) {
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "Skipping %s, which is not a readable regular file", file_info.path.c_str());
+			}
+		}
+	}
+	return result;
+#else
+	throw NotImplementedException("Page cache statistics are not supported on this platform");
+#endif
+}
+
+vector<FilePageCache> GetPageCacheForDatabase(ClientContext &context) {
+#if defined(__linux__) || defined(__APPLE__)
+	auto db = GetDbInstance(context);
+	vector<FilePageCache> result;
+	for (const auto &attached : DatabaseManager::Get(*db).GetDatabases(context)) {
+		// Databases attached through other storage extensions, i.e. SQLite, have no storage manager.
+		if (attached->IsSystem() || attached->IsTemporary() || !attached->GetCatalog().IsDuckCatalog()) {
+			continue;
+		}
+		auto &storage = attached->GetStorageManager();
+		if (storage.InMemory()) {
+			continue;
+		}
+		const string &db_path = storage.GetDBPath();
+		AddFile(db_path, "database", attached->GetName(), result);
+		// The WAL only exists while it holds changes not checkpointed yet.
+		AddFile(db_path + ".wal", "wal", attached->GetName(), result);
+	}
+	for (const auto &temp_file : BufferManager::GetBufferManager(*db).GetTemporaryFiles()) {
+		AddFile(temp_file.path, "temp", string(), result);
+	}
+	return result;
+#else
+	throw NotImplementedException("Page cache statistics are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
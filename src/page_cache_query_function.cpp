@@ -0,0 +1,196 @@
+#include "page_cache_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "page_cache.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct SysPageCacheBindData : public FunctionData {
+	// Files of the attached databases are reported when no pattern is given.
+	bool has_pattern = false;
+	string pattern;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysPageCacheBindData>();
+		return has_pattern == other.has_pattern && pattern == other.pattern;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysPageCacheBindData>();
+		result->has_pattern = has_pattern;
+		result->pattern = pattern;
+		return std::move(result);
+	}
+};
+
+struct SysPageCacheData : public GlobalTableFunctionState {
+	SysPageCacheData(ClientContext &context, const SysPageCacheBindData &bind_data)
+	    : finished(false), current_index(0),
+	      files(bind_data.has_pattern ? GetPageCacheForPattern(context, bind_data.pattern)
+	                                  : GetPageCacheForDatabase(context)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<FilePageCache> files;
+};
+
+unique_ptr<FunctionData> SysPageCacheBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(13);
+	names.reserve(13);
+
+	auto result = make_uniq<SysPageCacheBindData>();
+
+	// Parse path_or_glob parameter if provided
+	if (!input.inputs.empty()) {
+		if (input.inputs[0].IsNull()) {
+			throw InvalidInputException("Path for sys_page_cache cannot be NULL");
+		}
+		result->has_pattern = true;
+		result->pattern = input.inputs[0].ToString();
+	}
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("file_type");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("database");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("size_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("total_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("cached_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("cached_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("cached_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("dirty_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("writeback_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("evicted_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("recently_evicted_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("method");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysPageCacheInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysPageCacheBindData>();
+	return make_uniq<SysPageCacheData>(context, bind_data);
+}
+
+void SysPageCacheFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysPageCacheData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.files.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &file = data.files[data.current_index];
+		col_idx = 0;
+		// Dirty, writeback and evicted pages are only reported by cachestat(2).
+		const bool has_states = file.method == PageCacheMethod::CACHESTAT;
+
+		// path
+		output.SetValue(col_idx++, output_count, Value(file.path));
+
+		// file_type
+		output.SetValue(col_idx++, output_count, Value(file.file_type));
+
+		// database, NULL for temporary files and files matching a pattern
+		output.SetValue(col_idx++, output_count,
+		                file.database.empty() ? Value(LogicalType::VARCHAR) : Value(file.database));
+
+		// size_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(file.size_bytes));
+
+		// total_pages
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(file.total_pages));
+
+		// cached_pages
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(file.cached_pages));
+
+		// cached_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(file.cached_bytes));
+
+		// cached_pct, NULL for empty files
+		output.SetValue(col_idx++, output_count,
+		                file.total_pages == 0
+		                    ? Value(LogicalType::DOUBLE)
+		                    : Value::DOUBLE(static_cast<double>(file.cached_pages) * 100.0 /
+		                                    static_cast<double>(file.total_pages)));
+
+		// dirty_pages
+		output.SetValue(col_idx++, output_count,
+		                has_states ? Value::UBIGINT(file.dirty_pages) : Value(LogicalType::UBIGINT));
+
+		// writeback_pages
+		output.SetValue(col_idx++, output_count,
+		                has_states ? Value::UBIGINT(file.writeback_pages) : Value(LogicalType::UBIGINT));
+
+		// evicted_pages
+		output.SetValue(col_idx++, output_count,
+		                has_states ? Value::UBIGINT(file.evicted_pages) : Value(LogicalType::UBIGINT));
+
+		// recently_evicted_pages
+		output.SetValue(col_idx++, output_count,
+		                has_states ? Value::UBIGINT(file.recently_evicted_pages) : Value(LogicalType::UBIGINT));
+
+		// method
+		output.SetValue(col_idx++, output_count, Value(has_states ? "cachestat" : "mincore"));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.files.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysPageCacheFunction(ExtensionLoader &loader) {
+	TableFunctionSet sys_page_cache_set("sys_page_cache");
+	sys_page_cache_set.AddFunction(
+	    TableFunction("sys_page_cache", {}, SysPageCacheFunc, SysPageCacheBind, SysPageCacheInit));
+	sys_page_cache_set.AddFunction(
+	    TableFunction("sys_page_cache", {LogicalType::VARCHAR}, SysPageCacheFunc, SysPageCacheBind, SysPageCacheInit));
+	loader.RegisterFunction(sys_page_cache_set);
+}
+
+} // namespace duckdb
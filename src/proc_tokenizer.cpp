@@ -0,0 +1,339 @@
+#include "proc_tokenizer.hpp"
+
+#include <charconv>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SYSTEM_STATS_TOKENIZER_X86_64 1
+#include <immintrin.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Bytes searched per separator mask.
+constexpr size_t BLOCK_SIZE = 64;
+// Bytes checked one at a time before switching to the vector search; most tokens are shorter, and for them a vector
+// search costs more than it saves.
+constexpr size_t SCALAR_PROBE_LENGTH = 8;
+// Numbers with fewer digits cannot overflow uint64_t.
+constexpr size_t MAX_SAFE_DIGITS = 19;
+
+constexpr uint64_t POWERS_OF_TEN[] = {1,      10,      100,      1000,      10000,
+                                      100000, 1000000, 10000000, 100000000};
+
+bool IsSeparator(char c) {
+	return c == ' ' || c == '\t' || c == '\n';
+}
+
+size_t CountTrailingZeros(uint64_t value) {
+#ifdef __GNUC__
+	return static_cast<size_t>(__builtin_ctzll(value));
+#else
+	size_t count = 0;
+	while ((value & 1) == 0) {
+		value >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Bit i of the result is set if byte i of the [BLOCK_SIZE] bytes at [data] is a separator.
+uint64_t SeparatorMaskScalar(const char *data) {
+	uint64_t mask = 0;
+	for (size_t idx = 0; idx < BLOCK_SIZE; idx++) {
+		mask |= static_cast<uint64_t>(IsSeparator(data[idx])) << idx;
+	}
+	return mask;
+}
+
+#ifdef SYSTEM_STATS_TOKENIZER_X86_64
+// SSE2 is part of x86-64, so it needs no runtime check.
+uint64_t SeparatorMaskSSE2(const char *data) {
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i newline = _mm_set1_epi8('\n');
+	uint64_t mask = 0;
+	for (size_t offset = 0; offset < BLOCK_SIZE; offset += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset));
+		const __m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+		                                     _mm_cmpeq_epi8(chunk, newline));
+		mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(matches))) << offset;
+	}
+	return mask;
+}
+
+__attribute__((target("avx2"))) uint64_t SeparatorMaskAVX2(const char *data) {
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i newline = _mm256_set1_epi8('\n');
+	uint64_t mask = 0;
+	for (size_t offset = 0; offset < BLOCK_SIZE; offset += 32) {
+		const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + offset));
+		const __m256i matches =
+		    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+		                    _mm256_cmpeq_epi8(chunk, newline));
+		mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(matches))) << offset;
+	}
+	return mask;
+}
+#endif
+
+struct TokenizerKernel {
+	uint64_t (*separator_mask)(const char *data);
+	const char *name;
+};
+
+TokenizerKernel SelectKernel() {
+#ifdef SYSTEM_STATS_TOKENIZER_X86_64
+	if (__builtin_cpu_supports("avx2")) {
+		return {SeparatorMaskAVX2, "avx2"};
+	}
+	return {SeparatorMaskSSE2, "sse2"};
+#else
+	return {SeparatorMaskScalar, "scalar"};
+#endif
+}
+
+const TokenizerKernel &GetKernel() {
+	static const TokenizerKernel kernel = SelectKernel();
+	return kernel;
+}
+
+// Get the separator mask of the block of [text] at [pos]; bytes past the end count as separators.
+uint64_t GetSeparatorMask(std::string_view text, size_t pos) {
+	const auto separator_mask = GetKernel().separator_mask;
+	if (pos + BLOCK_SIZE <= text.size()) {
+		return separator_mask(text.data() + pos);
+	}
+	char padded[BLOCK_SIZE];
+	memset(padded, ' ', BLOCK_SIZE);
+	memcpy(padded, text.data() + pos, text.size() - pos);
+	return separator_mask(padded);
+}
+
+// Search for the first byte at or after [pos] which is ([SEPARATOR] = true) or is not a separator.
+template <bool SEPARATOR>
+size_t FindFirst(std::string_view text, size_t pos) {
+	const size_t probe_end = pos + SCALAR_PROBE_LENGTH < text.size() ? pos + SCALAR_PROBE_LENGTH : text.size();
+	for (; pos < probe_end; pos++) {
+		if (IsSeparator(text[pos]) == SEPARATOR) {
+			return pos;
+		}
+	}
+	for (; pos < text.size(); pos += BLOCK_SIZE) {
+		const uint64_t separators = GetSeparatorMask(text, pos);
+		const uint64_t matches = SEPARATOR ? separators : ~separators;
+		if (matches != 0) {
+			const size_t match_pos = pos + CountTrailingZeros(matches);
+			return match_pos < text.size() ? match_pos : text.size();
+		}
+	}
+	return text.size();
+}
+
+// Load 8 bytes of [data] so the first character is the least significant byte regardless of host byte order.
+uint64_t LoadChunk(const char *data) {
+	uint64_t chunk;
+	memcpy(&chunk, data, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	chunk = __builtin_bswap64(chunk);
+#endif
+	return chunk;
+}
+
+// Count the leading ASCII digits in [chunk]; a byte is a digit if its high nibble is 3 both before and after adding 6.
+// Carries of the addition only propagate towards later bytes, which cannot affect the first non-digit.
+size_t CountLeadingDigits(uint64_t chunk) {
+	constexpr uint64_t HIGH_NIBBLES = 0xF0F0F0F0F0F0F0F0ULL;
+	constexpr uint64_t DIGIT_HIGH_NIBBLES = 0x3030303030303030ULL;
+	const uint64_t non_digits = ((chunk & HIGH_NIBBLES) ^ DIGIT_HIGH_NIBBLES) |
+	                            (((chunk + 0x0606060606060606ULL) & HIGH_NIBBLES) ^ DIGIT_HIGH_NIBBLES);
+	if (non_digits == 0) {
+		return 8;
+	}
+	return CountTrailingZeros(non_digits) / 8;
+}
+
+// Convert the first [digit_count] (1 to 8) ASCII digits of [chunk] into their value.
+uint64_t ConvertDigits(uint64_t chunk, size_t digit_count) {
+	// Keep the digit values, and shift them up so the missing digits become leading zeros.
+	chunk = (chunk & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - digit_count));
+	// Combine adjacent digits into 2, 4 and finally 8 digit numbers.
+	chunk = (chunk * 10) + (chunk >> 8);
+	chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+	         (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+	        32;
+	return chunk;
+}
+
+// Parse the leading decimal digits of [text] into [value]; return the number of digits, or 0 if there are none or the
+// number overflows.
+size_t ParseDigits(std::string_view text, uint64_t &value) {
+	uint64_t result = 0;
+	size_t pos = 0;
+	// 8 digits at a time while a whole chunk is left.
+	while (pos + 8 <= text.size()) {
+		const size_t digit_count = CountLeadingDigits(LoadChunk(text.data() + pos));
+		if (digit_count == 0) {
+			break;
+		}
+		const uint64_t chunk_value = ConvertDigits(LoadChunk(text.data() + pos), digit_count);
+		const uint64_t multiplier = POWERS_OF_TEN[digit_count];
+		if (pos + digit_count > MAX_SAFE_DIGITS && result > (UINT64_MAX - chunk_value) / multiplier) {
+			return 0;
+		}
+		result = result * multiplier + chunk_value;
+		pos += digit_count;
+		if (digit_count < 8) {
+			break;
+		}
+	}
+	// Remaining digits one at a time, which is faster than assembling a partial chunk.
+	for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; pos++) {
+		const uint64_t digit = static_cast<uint64_t>(text[pos] - '0');
+		if (pos >= MAX_SAFE_DIGITS && result > (UINT64_MAX - digit) / 10) {
+			return 0;
+		}
+		result = result * 10 + digit;
+	}
+	if (pos == 0) {
+		return 0;
+	}
+	value = result;
+	return pos;
+}
+
+} // namespace
+
+bool NextLine(std::string_view text, size_t &pos, std::string_view &line) {
+	if (pos >= text.size()) {
+		return false;
+	}
+	// memchr is already vectorized by the C library for a single byte.
+	const void *line_end = memchr(text.data() + pos, '\n', text.size() - pos);
+	const size_t end = line_end ? static_cast<const char *>(line_end) - text.data() : text.size();
+	line = text.substr(pos, end - pos);
+	pos = end + 1;
+	return true;
+}
+
+bool NextToken(std::string_view text, size_t &pos, std::string_view &token) {
+	const size_t start = FindFirst<false>(text, pos);
+	if (start >= text.size()) {
+		pos = text.size();
+		return false;
+	}
+	pos = FindFirst<true>(text, start);
+	token = text.substr(start, pos - start);
+	return true;
+}
+
+idx_t SplitTokens(std::string_view text, std::string_view *tokens, idx_t max_tokens) {
+	// Tokens are first recorded with their start only, and get their size once the end is found.
+	idx_t start_count = 0;
+	idx_t end_count = 0;
+	// The start of the text behaves like a preceding separator.
+	uint64_t previous_separator = 1;
+	for (size_t block = 0; block < text.size() && end_count < max_tokens; block += BLOCK_SIZE) {
+		const uint64_t separators = GetSeparatorMask(text, block);
+		const uint64_t after_separator = (separators << 1) | previous_separator;
+		previous_separator = separators >> 63;
+		uint64_t starts = ~separators & after_separator;
+		uint64_t ends = separators & ~after_separator;
+		for (; starts != 0 && start_count < max_tokens; starts &= starts - 1) {
+			tokens[start_count++] = std::string_view {text.data() + block + CountTrailingZeros(starts), 0};
+		}
+		for (; ends != 0 && end_count < start_count; ends &= ends - 1) {
+			const char *start = tokens[end_count].data();
+			const size_t end = block + CountTrailingZeros(ends);
+			tokens[end_count++] = std::string_view {start, static_cast<size_t>(text.data() + end - start)};
+		}
+	}
+	// A token running to the end of the text has no separator after it if the text ends at a block boundary.
+	if (end_count < start_count) {
+		const char *start = tokens[end_count].data();
+		tokens[end_count++] = std::string_view {start, static_cast<size_t>(text.data() + text.size() - start)};
+	}
+	return end_count;
+}
+
+size_t FindSeparator(std::string_view text, size_t pos) {
+	return FindFirst<true>(text, pos);
+}
+
+size_t SkipSeparators(std::string_view text, size_t pos) {
+	return FindFirst<false>(text, pos);
+}
+
+size_t ParseUint64Prefix(std::string_view text, uint64_t &value) {
+	return ParseDigits(text, value);
+}
+
+bool ParseUint64(std::string_view token, uint64_t &value) {
+	// Short tokens are the common case, where the digits are cheaper to handle one at a time.
+	if (token.size() < 8) {
+		if (token.empty()) {
+			return false;
+		}
+		uint64_t result = 0;
+		for (const char c : token) {
+			if (c < '0' || c > '9') {
+				return false;
+			}
+			result = result * 10 + static_cast<uint64_t>(c - '0');
+		}
+		value = result;
+		return true;
+	}
+	uint64_t result = 0;
+	if (ParseDigits(token, result) != token.size()) {
+		return false;
+	}
+	value = result;
+	return true;
+}
+
+bool ParseInt64(std::string_view token, int64_t &value) {
+	const bool negative = !token.empty() && token[0] == '-';
+	uint64_t magnitude = 0;
+	if (!ParseUint64(negative ? token.substr(1) : token, magnitude)) {
+		return false;
+	}
+	if (negative) {
+		if (magnitude > static_cast<uint64_t>(INT64_MAX) + 1) {
+			return false;
+		}
+		value = static_cast<int64_t>(0 - magnitude);
+		return true;
+	}
+	if (magnitude > static_cast<uint64_t>(INT64_MAX)) {
+		return false;
+	}
+	value = static_cast<int64_t>(magnitude);
+	return true;
+}
+
+bool ParseHexUint64(std::string_view token, uint64_t &value) {
+	auto result = std::from_chars(token.data(), token.data() + token.size(), value, 16);
+	return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+bool SplitProcStat(std::string_view line, std::string_view &comm, std::string_view &fields) {
+	const size_t comm_start = line.find('(');
+	const size_t comm_end = line.rfind(')');
+	if (comm_start == std::string_view::npos || comm_end == std::string_view::npos || comm_end < comm_start) {
+		return false;
+	}
+	comm = line.substr(comm_start + 1, comm_end - comm_start - 1);
+	fields = line.substr(comm_end + 1);
+	return true;
+}
+
+const char *GetTokenizerImplementation() {
+	return GetKernel().name;
+}
+
+} // namespace duckdb
@@ -0,0 +1,141 @@
+#include "proc_walker.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
+#include "scope_guard.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifdef __linux__
+// Record header of getdents64(2), which glibc only declares since 2.30. The null-terminated name follows the header,
+// and [d_reclen] covers both plus padding to 8 bytes.
+struct LinuxDirent64 {
+	uint64_t d_ino;
+	int64_t d_off;
+	uint16_t d_reclen;
+	uint8_t d_type;
+};
+
+constexpr size_t DIRENT_NAME_OFFSET = offsetof(LinuxDirent64, d_type) + sizeof(uint8_t);
+#endif
+
+} // namespace
+
+ProcDirectory::ProcDirectory(const char *path) : fd(-1), pos(0), end(0) {
+#ifdef __linux__
+	fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+ProcDirectory::ProcDirectory(int dir_fd, const char *path) : fd(-1), pos(0), end(0) {
+#ifdef __linux__
+	fd = openat(dir_fd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+#endif
+}
+
+ProcDirectory::~ProcDirectory() {
+#ifdef __linux__
+	if (fd != -1) {
+		close(fd);
+	}
+#endif
+}
+
+bool ProcDirectory::Next(int32_t &id) {
+#ifdef __linux__
+	while (fd != -1) {
+		if (pos >= end) {
+			const long bytes_read = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+			if (bytes_read <= 0) {
+				return false;
+			}
+			pos = 0;
+			end = static_cast<size_t>(bytes_read);
+		}
+		const auto *ent = reinterpret_cast<const LinuxDirent64 *>(buffer.data() + pos);
+		const char *name = buffer.data() + pos + DIRENT_NAME_OFFSET;
+		pos += ent->d_reclen;
+		// Skips ".", ".." and named entries like /proc/self.
+		if (ParseInteger(std::string_view {name}, id)) {
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+idx_t ProcDirectory::CountRemaining() {
+	idx_t count = 0;
+	int32_t id = 0;
+	while (Next(id)) {
+		count++;
+	}
+	return count;
+}
+
+std::string_view ReadFileAt(int dir_fd, const char *path, char *buf, size_t size) {
+#ifdef __linux__
+	const int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return {};
+	}
+	const ssize_t bytes_read = read(fd, buf, size);
+	close(fd);
+	if (bytes_read <= 0) {
+		return {};
+	}
+	return std::string_view {buf, static_cast<size_t>(bytes_read)};
+#else
+	return {};
+#endif
+}
+
+bool ReadProcFile(ClientContext &context, const char *path, string &content) {
+	content.clear();
+#ifdef __linux__
+	const int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open %s: %s", path, strerror(errno));
+		}
+		return false;
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	std::array<char, 64 * 1024> buf;
+	while (true) {
+		const ssize_t bytes_read = read(fd, buf.data(), buf.size());
+		if (bytes_read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (auto db = GetDbInstance(context)) {
+				DUCKDB_LOG_DEBUG(*db, "Failed to read %s: %s", path, strerror(errno));
+			}
+			return false;
+		}
+		if (bytes_read == 0) {
+			return true;
+		}
+		content.append(buf.data(), static_cast<size_t>(bytes_read));
+	}
+#else
+	return false;
+#endif
+}
+
+} // namespace duckdb
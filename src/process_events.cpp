@@ -0,0 +1,618 @@
+#include "process_events.hpp"
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "proc_walker.hpp"
+#include "process_tracker.hpp"
+#include "scope_guard.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <ctime>
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+#ifdef __linux__
+// Receive buffer of the netlink socket; bursts of short-lived processes beyond it are lost and counted as overruns.
+constexpr int SOCKET_BUFFER_SIZE = 8 * 1024 * 1024;
+// Time to wait for the kernel to acknowledge the subscription.
+constexpr int ACK_TIMEOUT_MILLIS = 1000;
+
+int64_t GetClockNs(clockid_t clock_id) {
+	struct timespec ts;
+	clock_gettime(clock_id, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+// State shared between the cache entry and the listener thread.
+struct ProcessEventsState {
+	explicit ProcessEventsState(idx_t exit_log_size) : exit_log(exit_log_size), exit_log_size(exit_log_size) {
+	}
+	~ProcessEventsState() {
+#ifdef __linux__
+		if (sock != -1) {
+			close(sock);
+		}
+		if (stop_fd != -1) {
+			close(stop_fd);
+		}
+#endif
+	}
+
+	// Netlink socket subscribed to the proc connector, and the eventfd signaled to stop the listener.
+	int sock = -1;
+	int stop_fd = -1;
+	// Whether the kernel was asked to send events to [sock], which must be undone before closing it.
+	bool listening = false;
+	// Offset of the wall clock from the monotonic clock of event timestamps, in nanoseconds.
+	int64_t realtime_offset_ns = 0;
+	double ticks_per_second = 100.0;
+	// Walk of /proc the counts were last seeded from; only used by the listener thread once it runs.
+	ProcessEventSeed seed;
+
+	// Protects the fields below.
+	mutex mu;
+	bool running = false;
+	ProcessEventCounts counts;
+	ProcessExitLog exit_log;
+	idx_t exit_log_size;
+	string last_error;
+};
+
+ProcessEventsStatus MakeStatus(ProcessEventsState &state) {
+	lock_guard<mutex> lock(state.mu);
+	ProcessEventsStatus status;
+	status.running = state.running;
+	status.counts = state.counts;
+	status.exit_log_size = state.exit_log_size;
+	status.exits_dropped = state.exit_log.GetDropped();
+	status.last_error = state.last_error;
+	return status;
+}
+
+#ifdef __linux__
+void SetError(ProcessEventsState &state, const string &error) {
+	lock_guard<mutex> lock(state.mu);
+	state.running = false;
+	state.last_error = error;
+}
+
+// Walk the threads of every process in /proc into [seed], and count them. Must run after subscribing, so no thread
+// created during the walk is missed.
+void WalkThreads(ProcessEventSeed &seed, int64_t &process_count, int64_t &thread_count) {
+	seed.tids.clear();
+	seed.forked.clear();
+	process_count = 0;
+	ProcDirectory proc_dir("/proc");
+	int32_t pid = 0;
+	std::array<char, 32> path;
+	while (proc_dir.Next(pid)) {
+		snprintf(path.data(), path.size(), "%d/task", pid);
+		ProcDirectory task_dir(proc_dir.GetFd(), path.data());
+		if (!task_dir.IsOpen()) {
+			continue; // exited process
+		}
+		process_count++;
+		int32_t tid = 0;
+		while (task_dir.Next(tid)) {
+			seed.tids.insert(tid);
+		}
+	}
+	thread_count = static_cast<int64_t>(seed.tids.size());
+	seed.end_ns = static_cast<uint64_t>(GetClockNs(CLOCK_MONOTONIC));
+}
+
+// Seed process and thread counts from a walk of /proc, when starting and after events were lost.
+void SeedCounts(ProcessEventsState &state, bool overrun) {
+	int64_t process_count = 0;
+	int64_t thread_count = 0;
+	WalkThreads(state.seed, process_count, thread_count);
+	lock_guard<mutex> lock(state.mu);
+	if (overrun) {
+		state.counts.overruns++;
+	}
+	state.counts.process_count = process_count;
+	state.counts.thread_count = thread_count;
+}
+
+ProcessExit MakeProcessExit(const ProcessEventsState &state, const ProcEvent &event) {
+	ProcessExit exit;
+	exit.exit_time = timestamp_t {(static_cast<int64_t>(event.timestamp_ns) + state.realtime_offset_ns) / 1000};
+	exit.pid = event.tgid;
+	exit.ppid = event.parent_tgid;
+	exit.exit_code = event.exit_code;
+
+	// The exited process stays a zombie until its parent reaps it, so its final usage is usually still readable. A
+	// process in another state is a new one which reused the pid.
+	std::array<char, 64> path;
+	std::array<char, 4096> buf;
+	snprintf(path.data(), path.size(), "/proc/%d/stat", event.tgid);
+	const int fd = open(path.data(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return exit;
+	}
+	SCOPE_EXIT {
+		close(fd);
+	};
+	const ssize_t bytes_read = read(fd, buf.data(), buf.size());
+	ProcessStat stat;
+	if (bytes_read <= 0 || !ParseProcessStat(std::string_view {buf.data(), static_cast<size_t>(bytes_read)}, stat) ||
+	    (stat.state != 'Z' && stat.state != 'X')) {
+		return exit;
+	}
+	exit.has_usage = true;
+	exit.name = std::move(stat.name);
+	if (exit.ppid == 0) {
+		// Exit events of kernels before 4.18 have no parent.
+		exit.ppid = stat.ppid;
+	}
+	exit.utime_seconds = static_cast<double>(stat.utime_ticks) / state.ticks_per_second;
+	exit.stime_seconds = static_cast<double>(stat.stime_ticks) / state.ticks_per_second;
+	exit.minor_faults = stat.minor_faults;
+	exit.major_faults = stat.major_faults;
+	return exit;
+}
+
+bool SendMulticastOp(int sock, proc_cn_mcast_op op) {
+	alignas(nlmsghdr) std::array<char, NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))> buf {};
+	auto *header = reinterpret_cast<nlmsghdr *>(buf.data());
+	header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+	header->nlmsg_type = NLMSG_DONE;
+	auto *msg = static_cast<cn_msg *>(NLMSG_DATA(header));
+	msg->id.idx = CN_IDX_PROC;
+	msg->id.val = CN_VAL_PROC;
+	msg->len = sizeof(proc_cn_mcast_op);
+	std::memcpy(msg->data, &op, sizeof(op));
+	return send(sock, buf.data(), header->nlmsg_len, 0) == static_cast<ssize_t>(header->nlmsg_len);
+}
+
+// Ask the kernel to stop sending events to [state]. Closing the socket alone does not decrement the kernel's count of
+// listeners, so it would keep building events for every fork and exit.
+void Unsubscribe(ProcessEventsState &state) {
+	if (state.listening) {
+		SendMulticastOp(state.sock, PROC_CN_MCAST_IGNORE);
+		state.listening = false;
+	}
+}
+
+// Wait for the kernel to acknowledge the subscription. The proc connector only serves the initial user and pid
+// namespace, and silently ignores requests from containers.
+bool WaitForAck(int sock, string &error) {
+	alignas(nlmsghdr) std::array<char, 8192> buf;
+	vector<ProcEvent> events;
+	pollfd fds {sock, POLLIN, 0};
+	while (true) {
+		const int ready = poll(&fds, 1, ACK_TIMEOUT_MILLIS);
+		if (ready < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ready <= 0) {
+			error = "Process events were not acknowledged by the kernel; the proc connector is not available in "
+			        "containers";
+			return false;
+		}
+		const ssize_t bytes_read = recv(sock, buf.data(), buf.size(), 0);
+		if (bytes_read < 0) {
+			if (errno == EINTR || errno == ENOBUFS) {
+				continue;
+			}
+			error = StringUtil::Format("Failed to receive process events: %s", strerror(errno));
+			return false;
+		}
+		events.clear();
+		ParseProcConnectorMessage(buf.data(), static_cast<size_t>(bytes_read), events);
+		for (const auto &event : events) {
+			if (event.type != ProcEventType::ACK) {
+				continue;
+			}
+			if (event.error != 0) {
+				error = StringUtil::Format("Subscribing to process events failed: %s",
+				                           strerror(static_cast<int>(event.error)));
+				return false;
+			}
+			return true;
+		}
+	}
+}
+
+// Subscribe [state] to the proc connector; requires CAP_NET_ADMIN.
+bool Subscribe(ProcessEventsState &state, string &error) {
+	state.sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+	if (state.sock == -1) {
+		error = StringUtil::Format("Failed to open netlink connector socket: %s", strerror(errno));
+		return false;
+	}
+	sockaddr_nl addr {};
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = CN_IDX_PROC;
+	if (bind(state.sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+		error = StringUtil::Format("Failed to subscribe to process events, which requires CAP_NET_ADMIN: %s",
+		                           strerror(errno));
+		return false;
+	}
+	// SO_RCVBUFFORCE exceeds net.core.rmem_max, and is allowed with the same capability as subscribing.
+	if (setsockopt(state.sock, SOL_SOCKET, SO_RCVBUFFORCE, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE)) != 0) {
+		setsockopt(state.sock, SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+	}
+	if (!SendMulticastOp(state.sock, PROC_CN_MCAST_LISTEN)) {
+		error = StringUtil::Format("Failed to subscribe to process events: %s", strerror(errno));
+		return false;
+	}
+	state.listening = true;
+	if (!WaitForAck(state.sock, error)) {
+		Unsubscribe(state);
+		return false;
+	}
+	state.stop_fd = eventfd(0, EFD_CLOEXEC);
+	if (state.stop_fd == -1) {
+		error = StringUtil::Format("Failed to create eventfd: %s", strerror(errno));
+		Unsubscribe(state);
+		return false;
+	}
+	return true;
+}
+
+void RunListener(shared_ptr<ProcessEventsState> state) {
+	alignas(nlmsghdr) std::array<char, 64 * 1024> buf;
+	vector<ProcEvent> events;
+	vector<ProcessExit> exits;
+	std::array<pollfd, 2> fds {{{state->sock, POLLIN, 0}, {state->stop_fd, POLLIN, 0}}};
+	while (true) {
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			SetError(*state, StringUtil::Format("Failed to wait for process events: %s", strerror(errno)));
+			return;
+		}
+		if (fds[1].revents != 0) {
+			return;
+		}
+		const ssize_t bytes_read = recv(state->sock, buf.data(), buf.size(), 0);
+		if (bytes_read < 0) {
+			if (errno == EINTR || errno == EAGAIN) {
+				continue;
+			}
+			if (errno == ENOBUFS) {
+				SeedCounts(*state, true);
+				continue;
+			}
+			SetError(*state, StringUtil::Format("Failed to receive process events: %s", strerror(errno)));
+			return;
+		}
+
+		events.clear();
+		exits.clear();
+		ParseProcConnectorMessage(buf.data(), static_cast<size_t>(bytes_read), events);
+		// Read usage of exited processes before taking the lock.
+		for (const auto &event : events) {
+			if (event.type == ProcEventType::EXIT && event.pid == event.tgid) {
+				exits.emplace_back(MakeProcessExit(*state, event));
+			}
+		}
+		lock_guard<mutex> lock(state->mu);
+		for (const auto &event : events) {
+			ApplyProcEvent(event, state->counts, ReconcileSeededEvent(event, state->seed));
+		}
+		for (auto &exit : exits) {
+			state->exit_log.Append(std::move(exit));
+		}
+	}
+}
+#endif
+
+// ObjectCacheEntry that owns the process event listener of one database instance.
+class ProcessEventsCacheEntry : public ObjectCacheEntry {
+public:
+	~ProcessEventsCacheEntry() override {
+		StopThread();
+	}
+
+	static string ObjectType() {
+		return "system_stats_process_events";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise a running listener is lost.
+		return optional_idx {};
+	}
+
+	ProcessEventsStatus Start(idx_t exit_log_size) {
+		lock_guard<mutex> lock(mu);
+		if (state && MakeStatus(*state).running) {
+			throw InvalidInputException("sys_process_events is already running, call sys_process_events_stop() first");
+		}
+		// The previous listener could have stopped on an error.
+		StopThread();
+		state = make_shared_ptr<ProcessEventsState>(exit_log_size);
+#ifdef __linux__
+		string error;
+		if (!Subscribe(*state, error)) {
+			state->last_error = std::move(error);
+			return MakeStatus(*state);
+		}
+		state->ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+		state->realtime_offset_ns = GetClockNs(CLOCK_REALTIME) - GetClockNs(CLOCK_MONOTONIC);
+		// Counts start from a walk of /proc taken after subscribing, so no process is missed in between; events queued
+		// meanwhile are reconciled against the threads it found.
+		SeedCounts(*state, false);
+		state->running = true;
+		thread = std::thread(RunListener, state);
+#else
+		state->last_error = "Process events are only supported on Linux";
+#endif
+		return MakeStatus(*state);
+	}
+
+	ProcessEventsStatus Stop() {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return ProcessEventsStatus {};
+		}
+		StopThread();
+		{
+			lock_guard<mutex> state_lock(state->mu);
+			state->running = false;
+		}
+		return MakeStatus(*state);
+	}
+
+	ProcessEventsStatus GetStatus() {
+		lock_guard<mutex> lock(mu);
+		return state ? MakeStatus(*state) : ProcessEventsStatus {};
+	}
+
+	vector<ProcessExit> GetExits() {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return {};
+		}
+		lock_guard<mutex> state_lock(state->mu);
+		return state->exit_log.GetEntries();
+	}
+
+	bool GetCounts(int64_t &process_count, int64_t &thread_count) {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return false;
+		}
+		lock_guard<mutex> state_lock(state->mu);
+		if (!state->running) {
+			return false;
+		}
+		// Events are reconciled against the walk of /proc which seeded the counts, but zombies found by the walk whose
+		// exit preceded the subscription are never subtracted; clamp so counts never go below 0.
+		process_count = MaxValue<int64_t>(state->counts.process_count, 0);
+		thread_count = MaxValue<int64_t>(state->counts.thread_count, 0);
+		return true;
+	}
+
+private:
+	// Signal the listener thread to stop, wait for it and unsubscribe, so the kernel stops queueing events.
+	void StopThread() {
+#ifdef __linux__
+		if (state && state->stop_fd != -1) {
+			eventfd_write(state->stop_fd, 1);
+		}
+#endif
+		if (thread.joinable()) {
+			thread.join();
+		}
+#ifdef __linux__
+		if (state && state->sock != -1) {
+			Unsubscribe(*state);
+			close(state->sock);
+			state->sock = -1;
+		}
+#endif
+	}
+
+	mutex mu;
+	shared_ptr<ProcessEventsState> state;
+	std::thread thread;
+};
+
+shared_ptr<ProcessEventsCacheEntry> GetProcessEventsEntry(ClientContext &context) {
+	auto &cache = context.db->GetObjectCache();
+	return cache.GetOrCreate<ProcessEventsCacheEntry>(ProcessEventsCacheEntry::ObjectType());
+}
+
+} // namespace
+
+ProcessExitLog::ProcessExitLog(idx_t capacity_p) : capacity(capacity_p), next(0), dropped(0) {
+}
+
+void ProcessExitLog::Append(ProcessExit exit) {
+	if (capacity == 0) {
+		dropped++;
+		return;
+	}
+	if (entries.size() < capacity) {
+		entries.emplace_back(std::move(exit));
+		return;
+	}
+	entries[next] = std::move(exit);
+	next = (next + 1) % capacity;
+	dropped++;
+}
+
+vector<ProcessExit> ProcessExitLog::GetEntries() const {
+	vector<ProcessExit> result;
+	result.reserve(entries.size());
+	for (idx_t idx = 0; idx < entries.size(); idx++) {
+		result.emplace_back(entries[(next + idx) % entries.size()]);
+	}
+	return result;
+}
+
+bool ParseProcConnectorMessage(const char *buf, size_t size, vector<ProcEvent> &events) {
+#ifdef __linux__
+	auto remaining = static_cast<uint32_t>(size);
+	for (auto *header = reinterpret_cast<const nlmsghdr *>(buf); NLMSG_OK(header, remaining);
+	     header = NLMSG_NEXT(header, remaining)) {
+		if (header->nlmsg_type == NLMSG_NOOP) {
+			continue;
+		}
+		if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_OVERRUN) {
+			return false;
+		}
+		if (NLMSG_PAYLOAD(header, 0) < sizeof(cn_msg)) {
+			return false;
+		}
+		const auto *msg = static_cast<const cn_msg *>(NLMSG_DATA(header));
+		if (msg->id.idx != CN_IDX_PROC || msg->id.val != CN_VAL_PROC) {
+			continue;
+		}
+		if (NLMSG_PAYLOAD(header, 0) < sizeof(cn_msg) + msg->len || msg->len < offsetof(proc_event, event_data)) {
+			return false;
+		}
+		// The event union grew over kernel versions; fields missing from older kernels stay 0.
+		proc_event raw {};
+		std::memcpy(&raw, msg->data, MinValue<size_t>(msg->len, sizeof(raw)));
+
+		ProcEvent event;
+		event.timestamp_ns = raw.timestamp_ns;
+		switch (raw.what) {
+		case proc_event::PROC_EVENT_NONE:
+			event.type = ProcEventType::ACK;
+			event.error = raw.event_data.ack.err;
+			break;
+		case proc_event::PROC_EVENT_FORK:
+			event.type = ProcEventType::FORK;
+			event.pid = raw.event_data.fork.child_pid;
+			event.tgid = raw.event_data.fork.child_tgid;
+			event.parent_tgid = raw.event_data.fork.parent_tgid;
+			break;
+		case proc_event::PROC_EVENT_EXEC:
+			event.type = ProcEventType::EXEC;
+			event.pid = raw.event_data.exec.process_pid;
+			event.tgid = raw.event_data.exec.process_tgid;
+			break;
+		case proc_event::PROC_EVENT_EXIT:
+			event.type = ProcEventType::EXIT;
+			event.pid = raw.event_data.exit.process_pid;
+			event.tgid = raw.event_data.exit.process_tgid;
+			event.parent_tgid = raw.event_data.exit.parent_tgid;
+			event.exit_code = raw.event_data.exit.exit_code;
+			break;
+		default:
+			break;
+		}
+		events.emplace_back(event);
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ApplyProcEvent(const ProcEvent &event, ProcessEventCounts &counts, bool live) {
+	const bool is_process = event.pid == event.tgid;
+	const int64_t delta = live ? 1 : 0;
+	switch (event.type) {
+	case ProcEventType::FORK:
+		counts.thread_count += delta;
+		if (is_process) {
+			counts.forks++;
+			counts.process_count += delta;
+		} else {
+			counts.clones++;
+		}
+		break;
+	case ProcEventType::EXEC:
+		counts.execs++;
+		break;
+	case ProcEventType::EXIT:
+		counts.thread_count -= delta;
+		if (is_process) {
+			counts.exits++;
+			counts.process_count -= delta;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+bool ReconcileSeededEvent(const ProcEvent &event, ProcessEventSeed &seed) {
+	// Events reach the socket about in the order they happened; well after the walk, none of them predate it.
+	static constexpr uint64_t SEED_GRACE_NS = 1000000000;
+	if (seed.tids.empty() && seed.forked.empty()) {
+		return true;
+	}
+	if (event.timestamp_ns > seed.end_ns + SEED_GRACE_NS) {
+		seed.tids.clear();
+		seed.forked.clear();
+		return true;
+	}
+	const bool before_walk_end = event.timestamp_ns <= seed.end_ns;
+	switch (event.type) {
+	case ProcEventType::FORK:
+		if (!before_walk_end) {
+			return true;
+		}
+		// The walk counted the thread already, or missed it because it was created after the walk passed its pid.
+		if (seed.tids.erase(event.pid) > 0) {
+			return false;
+		}
+		seed.forked.insert(event.pid);
+		return true;
+	case ProcEventType::EXIT: {
+		const bool counted = seed.tids.erase(event.pid) > 0 || seed.forked.erase(event.pid) > 0;
+		// A thread which exited before the walk got to it was never counted.
+		return counted || !before_walk_end;
+	}
+	default:
+		return true;
+	}
+}
+
+ProcessEventsStatus StartProcessEvents(ClientContext &context, idx_t exit_log_size) {
+	return GetProcessEventsEntry(context)->Start(exit_log_size);
+}
+
+ProcessEventsStatus StopProcessEvents(ClientContext &context) {
+	return GetProcessEventsEntry(context)->Stop();
+}
+
+ProcessEventsStatus GetProcessEventsStatus(ClientContext &context) {
+	return GetProcessEventsEntry(context)->GetStatus();
+}
+
+vector<ProcessExit> GetProcessExits(ClientContext &context) {
+	return GetProcessEventsEntry(context)->GetExits();
+}
+
+bool GetProcessEventCounts(ClientContext &context, int64_t &process_count, int64_t &thread_count) {
+	// Do not create the entry just to find out that the listener is not running.
+	auto &cache = context.db->GetObjectCache();
+	auto entry = cache.Get<ProcessEventsCacheEntry>(ProcessEventsCacheEntry::ObjectType());
+	return entry && entry->GetCounts(process_count, thread_count);
+}
+
+} // namespace duckdb
@@ -0,0 +1,324 @@
+#include "process_events_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "process_events.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Default number of exits kept in the exit log.
+constexpr int64_t DEFAULT_EXIT_LOG_SIZE = 10000;
+
+void AddProcessEventsStatusColumns(vector<LogicalType> &return_types, vector<string> &names) {
+	return_types.reserve(11);
+	names.reserve(11);
+
+	names.emplace_back("running");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("process_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+
+	names.emplace_back("thread_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+
+	names.emplace_back("forks");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("clones");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("execs");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("exits");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("overruns");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("exit_log_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("exits_dropped");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("last_error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+}
+
+void SetProcessEventsStatusRow(DataChunk &output, const ProcessEventsStatus &status) {
+	idx_t col_idx = 0;
+
+	// running
+	output.SetValue(col_idx++, 0, Value::BOOLEAN(status.running));
+
+	// process_count, NULL unless running since counts are only kept up to date by the listener
+	output.SetValue(col_idx++, 0,
+	                status.running ? Value::BIGINT(status.counts.process_count) : Value(LogicalType::BIGINT));
+
+	// thread_count
+	output.SetValue(col_idx++, 0,
+	                status.running ? Value::BIGINT(status.counts.thread_count) : Value(LogicalType::BIGINT));
+
+	// forks
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.counts.forks));
+
+	// clones
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.counts.clones));
+
+	// execs
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.counts.execs));
+
+	// exits
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.counts.exits));
+
+	// overruns
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.counts.overruns));
+
+	// exit_log_size
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.exit_log_size));
+
+	// exits_dropped
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.exits_dropped));
+
+	// last_error, NULL if none
+	output.SetValue(col_idx++, 0, status.last_error.empty() ? Value(LogicalType::VARCHAR) : Value(status.last_error));
+
+	output.SetCardinality(1);
+}
+
+struct SysProcessEventsStartBindData : public FunctionData {
+	idx_t exit_log_size = DEFAULT_EXIT_LOG_SIZE;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysProcessEventsStartBindData>();
+		return exit_log_size == other.exit_log_size;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysProcessEventsStartBindData>();
+		result->exit_log_size = exit_log_size;
+		return std::move(result);
+	}
+};
+
+struct SysProcessEventsData : public GlobalTableFunctionState {
+	SysProcessEventsData() : finished(false) {
+	}
+	bool finished;
+};
+
+unique_ptr<FunctionData> SysProcessEventsStartBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+
+	auto result = make_uniq<SysProcessEventsStartBindData>();
+
+	// Parse exit_log_size parameter if provided
+	auto size_it = input.named_parameters.find("exit_log_size");
+	if (size_it != input.named_parameters.end()) {
+		const int64_t exit_log_size = size_it->second.IsNull() ? 0 : size_it->second.GetValue<int64_t>();
+		if (exit_log_size <= 0) {
+			throw InvalidInputException("Exit log size for sys_process_events_start must be positive, but got '%s'",
+			                            size_it->second.ToString());
+		}
+		result->exit_log_size = static_cast<idx_t>(exit_log_size);
+	}
+
+	AddProcessEventsStatusColumns(return_types, names);
+	return std::move(result);
+}
+
+unique_ptr<FunctionData> SysProcessEventsStatusBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	AddProcessEventsStatusColumns(return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysProcessEventsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysProcessEventsData>();
+}
+
+void SysProcessEventsStartFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessEventsData>();
+	auto &bind_data = data_p.bind_data->Cast<SysProcessEventsStartBindData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetProcessEventsStatusRow(output, StartProcessEvents(context, bind_data.exit_log_size));
+	data.finished = true;
+}
+
+void SysProcessEventsStopFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessEventsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetProcessEventsStatusRow(output, StopProcessEvents(context));
+	data.finished = true;
+}
+
+void SysProcessEventsStatusFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessEventsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetProcessEventsStatusRow(output, GetProcessEventsStatus(context));
+	data.finished = true;
+}
+
+struct SysProcessExitsData : public GlobalTableFunctionState {
+	explicit SysProcessExitsData(ClientContext &context)
+	    : finished(false), current_index(0), exits(GetProcessExits(context)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<ProcessExit> exits;
+};
+
+unique_ptr<FunctionData> SysProcessExitsBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(10);
+	names.reserve(10);
+
+	names.emplace_back("exit_time");
+	return_types.emplace_back(LogicalType {LogicalTypeId::TIMESTAMP});
+
+	names.emplace_back("pid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("ppid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("exit_code");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("signal");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("utime_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("stime_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("minor_faults");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("major_faults");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysProcessExitsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysProcessExitsData>(context);
+}
+
+void SysProcessExitsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessExitsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.exits.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &exit = data.exits[data.current_index];
+		col_idx = 0;
+		// The wait status holds either the exit code or the terminating signal.
+		const int32_t signal = static_cast<int32_t>(exit.exit_code & 0x7f);
+		const int32_t exit_code = static_cast<int32_t>((exit.exit_code >> 8) & 0xff);
+
+		// exit_time
+		output.SetValue(col_idx++, output_count, Value::TIMESTAMP(exit.exit_time));
+
+		// pid
+		output.SetValue(col_idx++, output_count, Value::INTEGER(exit.pid));
+
+		// ppid
+		output.SetValue(col_idx++, output_count, Value::INTEGER(exit.ppid));
+
+		// name, NULL if the process was reaped before its usage could be read
+		output.SetValue(col_idx++, output_count, exit.has_usage ? Value(exit.name) : Value(LogicalType::VARCHAR));
+
+		// exit_code, NULL if terminated by a signal
+		output.SetValue(col_idx++, output_count, signal == 0 ? Value::INTEGER(exit_code) : Value(LogicalType::INTEGER));
+
+		// signal, NULL if exited normally
+		output.SetValue(col_idx++, output_count, signal != 0 ? Value::INTEGER(signal) : Value(LogicalType::INTEGER));
+
+		// utime_seconds
+		output.SetValue(col_idx++, output_count,
+		                exit.has_usage ? Value::DOUBLE(exit.utime_seconds) : Value(LogicalType::DOUBLE));
+
+		// stime_seconds
+		output.SetValue(col_idx++, output_count,
+		                exit.has_usage ? Value::DOUBLE(exit.stime_seconds) : Value(LogicalType::DOUBLE));
+
+		// minor_faults
+		output.SetValue(col_idx++, output_count,
+		                exit.has_usage ? Value::UBIGINT(exit.minor_faults) : Value(LogicalType::UBIGINT));
+
+		// major_faults
+		output.SetValue(col_idx++, output_count,
+		                exit.has_usage ? Value::UBIGINT(exit.major_faults) : Value(LogicalType::UBIGINT));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.exits.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysProcessEventsFunctions(ExtensionLoader &loader) {
+	TableFunction sys_process_events_start_func("sys_process_events_start", {}, SysProcessEventsStartFunc,
+	                                            SysProcessEventsStartBind, SysProcessEventsInit);
+	sys_process_events_start_func.named_parameters["exit_log_size"] = LogicalType::BIGINT;
+	loader.RegisterFunction(sys_process_events_start_func);
+
+	TableFunction sys_process_events_stop_func("sys_process_events_stop", {}, SysProcessEventsStopFunc,
+	                                           SysProcessEventsStatusBind, SysProcessEventsInit);
+	loader.RegisterFunction(sys_process_events_stop_func);
+
+	TableFunction sys_process_events_func("sys_process_events", {}, SysProcessEventsStatusFunc,
+	                                      SysProcessEventsStatusBind, SysProcessEventsInit);
+	loader.RegisterFunction(sys_process_events_func);
+
+	TableFunction sys_process_exits_func("sys_process_exits", {}, SysProcessExitsFunc, SysProcessExitsBind,
+	                                     SysProcessExitsInit);
+	loader.RegisterFunction(sys_process_exits_func);
+}
+
+} // namespace duckdb
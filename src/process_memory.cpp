@@ -0,0 +1,278 @@
+#include "process_memory.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Size of each read from smaps; a mapping takes about 1KiB of text.
+constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+
+struct SmapsField {
+	std::string_view key;
+	uint64_t MemoryMapping::*member;
+};
+
+// Fields reported in kB, other fields (i.e. THPeligible, VmFlags) are ignored.
+constexpr SmapsField SMAPS_FIELDS[] = {
+    {"Size", &MemoryMapping::size},
+    {"Rss", &MemoryMapping::rss},
+    {"Pss", &MemoryMapping::pss},
+    {"Pss_Anon", &MemoryMapping::pss_anon},
+    {"Pss_File", &MemoryMapping::pss_file},
+    {"Pss_Shmem", &MemoryMapping::pss_shmem},
+    {"Shared_Clean", &MemoryMapping::shared_clean},
+    {"Shared_Dirty", &MemoryMapping::shared_dirty},
+    {"Private_Clean", &MemoryMapping::private_clean},
+    {"Private_Dirty", &MemoryMapping::private_dirty},
+    {"Referenced", &MemoryMapping::referenced},
+    {"Anonymous", &MemoryMapping::anonymous},
+    {"AnonHugePages", &MemoryMapping::anon_huge_pages},
+    {"ShmemPmdMapped", &MemoryMapping::shmem_pmd_mapped},
+    {"FilePmdMapped", &MemoryMapping::file_pmd_mapped},
+    {"Shared_Hugetlb", &MemoryMapping::hugetlb},
+    {"Private_Hugetlb", &MemoryMapping::hugetlb},
+    {"Swap", &MemoryMapping::swap},
+    {"SwapPss", &MemoryMapping::swap_pss},
+    {"Locked", &MemoryMapping::locked},
+};
+
+// Parse the mapping header line, i.e.
+//   7f0c1c000000-7f0c1c021000 rw-p 00000000 00:00 0                          [heap]
+bool ParseMappingHeader(std::string_view line, MemoryMapping &mapping) {
+	size_t pos = 0;
+	std::string_view token;
+	if (!NextToken(line, pos, token)) {
+		return false;
+	}
+	size_t dash_pos = token.find('-');
+	if (dash_pos == std::string_view::npos || !ParseHexUint64(token.substr(0, dash_pos), mapping.start_address) ||
+	    !ParseHexUint64(token.substr(dash_pos + 1), mapping.end_address)) {
+		return false;
+	}
+	if (!NextToken(line, pos, token)) {
+		return false;
+	}
+	mapping.permissions = string {token};
+	if (!NextToken(line, pos, token) || !ParseHexUint64(token, mapping.offset)) {
+		return false;
+	}
+	if (!NextToken(line, pos, token)) {
+		return false;
+	}
+	mapping.device = string {token};
+	if (!NextToken(line, pos, token) || !ParseUint64(token, mapping.inode)) {
+		return false;
+	}
+	// The path is the rest of the line and could contain spaces.
+	mapping.pathname = string {line.substr(SkipSeparators(line, pos))};
+	return true;
+}
+
+} // namespace
+
+void MemoryMapping::Accumulate(const MemoryMapping &other) {
+	start_address = std::min(start_address, other.start_address);
+	end_address = std::max(end_address, other.end_address);
+	for (const auto &field : SMAPS_FIELDS) {
+		// Shared_Hugetlb and Private_Hugetlb refer to the same member, only add it once.
+		if (field.key == "Private_Hugetlb") {
+			continue;
+		}
+		this->*field.member += other.*field.member;
+	}
+}
+
+void SmapsParser::Feed(std::string_view chunk, vector<MemoryMapping> &mappings) {
+	size_t pos = 0;
+	// Complete the line split across the previous and this chunk.
+	if (!partial_line.empty()) {
+		size_t end = chunk.find('\n');
+		if (end == std::string_view::npos) {
+			partial_line.append(chunk.data(), chunk.size());
+			return;
+		}
+		partial_line.append(chunk.data(), end);
+		ParseLine(partial_line, mappings);
+		partial_line.clear();
+		pos = end + 1;
+	}
+	while (pos < chunk.size()) {
+		size_t end = chunk.find('\n', pos);
+		if (end == std::string_view::npos) {
+			partial_line.assign(chunk.data() + pos, chunk.size() - pos);
+			return;
+		}
+		ParseLine(chunk.substr(pos, end - pos), mappings);
+		pos = end + 1;
+	}
+}
+
+void SmapsParser::Finish(vector<MemoryMapping> &mappings) {
+	if (!partial_line.empty()) {
+		ParseLine(partial_line, mappings);
+		partial_line.clear();
+	}
+	if (has_current) {
+		mappings.emplace_back(std::move(current));
+		current = MemoryMapping {};
+		has_current = false;
+	}
+}
+
+void SmapsParser::ParseLine(std::string_view line, vector<MemoryMapping> &mappings) {
+	size_t pos = 0;
+	std::string_view key;
+	if (!NextToken(line, pos, key)) {
+		return;
+	}
+
+	// Field lines look like "Rss:  1234 kB", anything else starts a new mapping.
+	if (key.back() != ':') {
+		MemoryMapping mapping;
+		if (!ParseMappingHeader(line, mapping)) {
+			return;
+		}
+		if (has_current) {
+			mappings.emplace_back(std::move(current));
+		}
+		current = std::move(mapping);
+		has_current = true;
+		return;
+	}
+
+	if (!has_current) {
+		return;
+	}
+	key.remove_suffix(1);
+	for (const auto &field : SMAPS_FIELDS) {
+		if (field.key != key) {
+			continue;
+		}
+		std::string_view value;
+		uint64_t kib = 0;
+		if (NextToken(line, pos, value) && ParseUint64(value, kib)) {
+			current.*field.member += kib * 1024;
+		}
+		return;
+	}
+}
+
+ProcessMemoryReader::ProcessMemoryReader(ClientContext &context, int32_t pid, bool detail) {
+#ifdef __linux__
+	const string proc_dir = pid == 0 ? string {"/proc/self"} : StringUtil::Format("/proc/%d", pid);
+	string path = proc_dir + (detail ? "/smaps" : "/smaps_rollup");
+	fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	// smaps_rollup is only available since Linux 4.14, fall back to summing up all mappings.
+	if (fd == -1 && !detail && errno == ENOENT) {
+		path = proc_dir + "/smaps";
+		fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		aggregate = true;
+	}
+	if (fd == -1) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open %s: %s", path.c_str(), strerror(errno));
+		}
+		eof = true;
+	}
+#elif __APPLE__
+	// procfs is not available on macOS.
+	eof = true;
+#else
+	throw NotImplementedException("Process memory statistics are not supported on this platform");
+#endif
+}
+
+ProcessMemoryReader::~ProcessMemoryReader() {
+#ifdef __linux__
+	if (fd != -1) {
+		close(fd);
+	}
+#endif
+}
+
+bool ProcessMemoryReader::ReadChunk() {
+#ifdef __linux__
+	if (eof) {
+		return false;
+	}
+	char buf[READ_CHUNK_SIZE];
+	ssize_t bytes_read = 0;
+	do {
+		bytes_read = read(fd, buf, sizeof(buf));
+	} while (bytes_read == -1 && errno == EINTR);
+	if (bytes_read > 0) {
+		parser.Feed(std::string_view {buf, static_cast<size_t>(bytes_read)}, pending);
+		return true;
+	}
+	// Process exited or end of file, either way return the mappings read so far.
+	parser.Finish(pending);
+	eof = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool ProcessMemoryReader::Read(vector<MemoryMapping> &mappings, idx_t max_count) {
+	if (aggregate) {
+		// Sum up the mappings chunk by chunk, so only the total is kept in memory.
+		MemoryMapping total;
+		bool has_total = false;
+		while (ReadChunk()) {
+			for (auto &mapping : pending) {
+				if (!has_total) {
+					total = std::move(mapping);
+					has_total = true;
+				} else {
+					total.Accumulate(mapping);
+				}
+			}
+			pending.clear();
+		}
+		aggregate = false;
+		if (!has_total) {
+			return false;
+		}
+		total.permissions = "---p";
+		total.offset = 0;
+		total.device = "00:00";
+		total.inode = 0;
+		total.pathname = "[rollup]";
+		mappings.emplace_back(std::move(total));
+		return true;
+	}
+
+	idx_t added = 0;
+	while (added < max_count) {
+		if (pending_offset >= pending.size()) {
+			pending.clear();
+			pending_offset = 0;
+			if (!ReadChunk()) {
+				break;
+			}
+			continue;
+		}
+		mappings.emplace_back(std::move(pending[pending_offset++]));
+		added++;
+	}
+	return added > 0;
+}
+
+} // namespace duckdb
@@ -0,0 +1,288 @@
+#include "process_memory_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "memory_unit_util.hpp"
+#include "process_memory.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct SysProcessMemoryBindData : public FunctionData {
+	// 0 refers to the current process.
+	int32_t pid = 0;
+	// Whether to report every mapping from smaps, instead of the summary from smaps_rollup.
+	bool detail = false;
+	MemoryUnit unit = MemoryUnit::BYTES;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysProcessMemoryBindData>();
+		return pid == other.pid && detail == other.detail && unit == other.unit;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysProcessMemoryBindData>();
+		result->pid = pid;
+		result->detail = detail;
+		result->unit = unit;
+		return std::move(result);
+	}
+};
+
+struct SysProcessMemoryData : public GlobalTableFunctionState {
+	SysProcessMemoryData(ClientContext &context, int32_t pid, bool detail)
+	    : finished(false), reader(context, pid, detail) {
+	}
+	bool finished;
+	// Mappings are read lazily one output chunk at a time, so smaps of huge processes is never fully buffered.
+	ProcessMemoryReader reader;
+	vector<MemoryMapping> batch;
+};
+
+unique_ptr<FunctionData> SysProcessMemoryBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(26);
+	names.reserve(26);
+
+	auto result = make_uniq<SysProcessMemoryBindData>();
+
+	// Parse pid parameter if provided
+	auto pid_it = input.named_parameters.find("pid");
+	if (pid_it != input.named_parameters.end()) {
+		result->pid = pid_it->second.GetValue<int32_t>();
+		if (result->pid <= 0) {
+			throw InvalidInputException("Process id for sys_process_memory must be positive, but got '%s'",
+			                            pid_it->second.ToString());
+		}
+	}
+
+	// Parse detail parameter if provided
+	auto detail_it = input.named_parameters.find("detail");
+	if (detail_it != input.named_parameters.end()) {
+		result->detail = detail_it->second.GetValue<bool>();
+	}
+
+	// Parse unit parameter if provided
+	auto unit_it = input.named_parameters.find("unit");
+	if (unit_it != input.named_parameters.end()) {
+		result->unit = ParseUnit(unit_it->second.ToString());
+	}
+
+	names.emplace_back("start_address");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("end_address");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("permissions");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("offset");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("device");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("inode");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("pathname");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("rss");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("pss");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("pss_anon");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("pss_file");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("pss_shmem");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("shared_clean");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("shared_dirty");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("private_clean");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("private_dirty");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("referenced");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("anonymous");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("anon_huge_pages");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("shmem_pmd_mapped");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("file_pmd_mapped");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("hugetlb");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("swap");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("swap_pss");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("locked");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysProcessMemoryInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysProcessMemoryBindData>();
+	return make_uniq<SysProcessMemoryData>(context, bind_data.pid, bind_data.detail);
+}
+
+void SysProcessMemoryFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessMemoryData>();
+	auto &bind_data = data_p.bind_data->Cast<SysProcessMemoryBindData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	data.batch.clear();
+	if (!data.reader.Read(data.batch, STANDARD_VECTOR_SIZE)) {
+		data.finished = true;
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	for (const auto &mapping : data.batch) {
+		col_idx = 0;
+
+		// start_address
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(mapping.start_address));
+
+		// end_address
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(mapping.end_address));
+
+		// permissions
+		output.SetValue(col_idx++, output_count, Value(mapping.permissions));
+
+		// offset
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(mapping.offset));
+
+		// device
+		output.SetValue(col_idx++, output_count, Value(mapping.device));
+
+		// inode
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(mapping.inode));
+
+		// pathname
+		output.SetValue(col_idx++, output_count, Value(mapping.pathname));
+
+		// size, NULL for the summary since smaps_rollup does not report it
+		output.SetValue(col_idx++, output_count,
+		                bind_data.detail ? Value::UBIGINT(ConvertBytes(mapping.size, bind_data.unit))
+		                                 : Value(LogicalType::UBIGINT));
+
+		// rss
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.rss, bind_data.unit)));
+
+		// pss
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.pss, bind_data.unit)));
+
+		// pss_anon, NULL per mapping since only smaps_rollup reports it
+		output.SetValue(col_idx++, output_count,
+		                bind_data.detail ? Value(LogicalType::UBIGINT)
+		                                 : Value::UBIGINT(ConvertBytes(mapping.pss_anon, bind_data.unit)));
+
+		// pss_file, NULL per mapping since only smaps_rollup reports it
+		output.SetValue(col_idx++, output_count,
+		                bind_data.detail ? Value(LogicalType::UBIGINT)
+		                                 : Value::UBIGINT(ConvertBytes(mapping.pss_file, bind_data.unit)));
+
+		// pss_shmem, NULL per mapping since only smaps_rollup reports it
+		output.SetValue(col_idx++, output_count,
+		                bind_data.detail ? Value(LogicalType::UBIGINT)
+		                                 : Value::UBIGINT(ConvertBytes(mapping.pss_shmem, bind_data.unit)));
+
+		// shared_clean
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.shared_clean, bind_data.unit)));
+
+		// shared_dirty
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.shared_dirty, bind_data.unit)));
+
+		// private_clean
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.private_clean, bind_data.unit)));
+
+		// private_dirty
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.private_dirty, bind_data.unit)));
+
+		// referenced
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.referenced, bind_data.unit)));
+
+		// anonymous
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.anonymous, bind_data.unit)));
+
+		// anon_huge_pages
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.anon_huge_pages, bind_data.unit)));
+
+		// shmem_pmd_mapped
+		output.SetValue(col_idx++, output_count,
+		                Value::UBIGINT(ConvertBytes(mapping.shmem_pmd_mapped, bind_data.unit)));
+
+		// file_pmd_mapped
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.file_pmd_mapped, bind_data.unit)));
+
+		// hugetlb
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.hugetlb, bind_data.unit)));
+
+		// swap
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.swap, bind_data.unit)));
+
+		// swap_pss
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.swap_pss, bind_data.unit)));
+
+		// locked
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(ConvertBytes(mapping.locked, bind_data.unit)));
+
+		output_count++;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysProcessMemoryFunction(ExtensionLoader &loader) {
+	TableFunction sys_process_memory_func("sys_process_memory", {}, SysProcessMemoryFunc, SysProcessMemoryBind,
+	                                      SysProcessMemoryInit);
+	sys_process_memory_func.named_parameters["pid"] = LogicalType::INTEGER;
+	sys_process_memory_func.named_parameters["detail"] = LogicalType::BOOLEAN;
+	sys_process_memory_func.named_parameters["unit"] = LogicalType::VARCHAR;
+	loader.RegisterFunction(sys_process_memory_func);
+}
+
+} // namespace duckdb
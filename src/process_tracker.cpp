@@ -0,0 +1,270 @@
+#include "process_tracker.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "time_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Whether [lhs] used more CPU than [rhs]: processes with CPU percentage first, then by CPU time, then by pid.
+bool RanksHigher(const TrackedProcess *lhs, const TrackedProcess *rhs) {
+	if (lhs->has_rates != rhs->has_rates) {
+		return lhs->has_rates;
+	}
+	if (lhs->has_rates && lhs->cpu_pct != rhs->cpu_pct) {
+		return lhs->cpu_pct > rhs->cpu_pct;
+	}
+	const uint64_t lhs_ticks = lhs->stat.utime_ticks + lhs->stat.stime_ticks;
+	const uint64_t rhs_ticks = rhs->stat.utime_ticks + rhs->stat.stime_ticks;
+	if (lhs_ticks != rhs_ticks) {
+		return lhs_ticks > rhs_ticks;
+	}
+	return lhs->pid < rhs->pid;
+}
+
+double GetTicksPerSecond() {
+#ifdef __linux__
+	return static_cast<double>(sysconf(_SC_CLK_TCK));
+#else
+	// Clock ticks are only used for procfs.
+	return 100.0;
+#endif
+}
+
+#ifdef __linux__
+// Read the fields of [process] which do not change while it runs.
+void ReadProcessDetails(TrackedProcess &process) {
+	std::array<char, 64> path;
+
+	// /proc/[pid] is owned by the effective user of the process.
+	snprintf(path.data(), path.size(), "/proc/%d", process.pid);
+	struct stat st;
+	process.has_uid = stat(path.data(), &st) == 0;
+	process.uid = process.has_uid ? static_cast<uint32_t>(st.st_uid) : 0;
+
+	// Arguments are separated by NUL bytes; long command lines are truncated to the buffer size.
+	std::array<char, 4096> buf;
+	snprintf(path.data(), path.size(), "/proc/%d/cmdline", process.pid);
+	const auto cmdline = ReadFileAt(AT_FDCWD, path.data(), buf);
+	process.cmdline.assign(cmdline.data(), cmdline.size());
+	while (!process.cmdline.empty() && process.cmdline.back() == '\0') {
+		process.cmdline.pop_back();
+	}
+	std::replace(process.cmdline.begin(), process.cmdline.end(), '\0', ' ');
+
+	// Only readable for processes of the same user, or with CAP_SYS_PTRACE.
+	snprintf(path.data(), path.size(), "/proc/%d/exe", process.pid);
+	const ssize_t exe_size = readlink(path.data(), buf.data(), buf.size());
+	process.exe.assign(buf.data(), exe_size > 0 ? static_cast<size_t>(exe_size) : 0);
+	process.details_loaded = true;
+}
+
+// Read /proc/[pid]/stat of all processes into [tracker].
+void SampleProcesses(ClientContext &context, ProcessTracker &tracker) {
+	ProcDirectory proc_dir("/proc");
+	if (!proc_dir.IsOpen()) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open /proc: %s", strerror(errno));
+		}
+		return;
+	}
+
+	std::array<char, 4096> buf;
+	std::array<char, 32> path;
+	tracker.BeginSample(GetMonotonicTimestampNs());
+	int32_t pid = 0;
+	while (proc_dir.Next(pid)) {
+		snprintf(path.data(), path.size(), "%d/stat", pid);
+		ProcessStat stat;
+		// The process could have exited since the directory was read.
+		if (ParseProcessStat(ReadFileAt(proc_dir.GetFd(), path.data(), buf), stat)) {
+			tracker.Update(pid, std::move(stat));
+		}
+	}
+	tracker.EndSample();
+}
+#endif
+
+} // namespace
+
+ProcessTracker::ProcessTracker(double ticks_per_second_p)
+    : ticks_per_second(ticks_per_second_p), sample_count(0), sample_ns(0), previous_sample_ns(0) {
+}
+
+void ProcessTracker::BeginSample(uint64_t timestamp_ns) {
+	sample_count++;
+	previous_sample_ns = sample_ns;
+	sample_ns = timestamp_ns;
+}
+
+TrackedProcess &ProcessTracker::Update(int32_t pid, ProcessStat stat) {
+	auto &process = processes[ProcessKey {pid, stat.start_time_ticks}];
+	const bool in_previous_sample = process.last_sample != 0 && process.last_sample + 1 == sample_count;
+	process.has_rates = in_previous_sample && sample_ns > previous_sample_ns;
+	if (process.has_rates) {
+		const uint64_t ticks_before = process.stat.utime_ticks + process.stat.stime_ticks;
+		const uint64_t ticks_after = stat.utime_ticks + stat.stime_ticks;
+		const double cpu_seconds =
+		    static_cast<double>(ticks_after >= ticks_before ? ticks_after - ticks_before : 0) / ticks_per_second;
+		process.cpu_pct = cpu_seconds * 1e9 / static_cast<double>(sample_ns - previous_sample_ns) * 100.0;
+	}
+	if (process.details_loaded && process.stat.name != stat.name) {
+		process.details_loaded = false;
+	}
+	process.pid = pid;
+	process.stat = std::move(stat);
+	process.last_sample = sample_count;
+	return process;
+}
+
+void ProcessTracker::EndSample() {
+	for (auto iter = processes.begin(); iter != processes.end();) {
+		if (iter->second.last_sample != sample_count) {
+			iter = processes.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
+vector<TrackedProcess *> ProcessTracker::SelectTop(idx_t n) {
+	// Min-heap of the best [n] so far, with the lowest ranked process on top; O(P log n) instead of sorting all.
+	vector<TrackedProcess *> heap;
+	heap.reserve(MinValue<idx_t>(n, processes.size()));
+	for (auto &entry : processes) {
+		auto *process = &entry.second;
+		if (heap.size() < n) {
+			heap.push_back(process);
+			std::push_heap(heap.begin(), heap.end(), RanksHigher);
+		} else if (n > 0 && RanksHigher(process, heap.front())) {
+			std::pop_heap(heap.begin(), heap.end(), RanksHigher);
+			heap.back() = process;
+			std::push_heap(heap.begin(), heap.end(), RanksHigher);
+		}
+	}
+	std::sort_heap(heap.begin(), heap.end(), RanksHigher);
+	return heap;
+}
+
+bool ParseProcessStat(std::string_view content, ProcessStat &stat) {
+	std::string_view name;
+	std::string_view fields;
+	if (!SplitProcStat(content, name, fields)) {
+		return false;
+	}
+
+	// Field positions after the name, see proc(5).
+	static constexpr size_t STATE_IDX = 0;
+	static constexpr size_t PPID_IDX = 1;
+	static constexpr size_t MINFLT_IDX = 7;
+	static constexpr size_t MAJFLT_IDX = 9;
+	static constexpr size_t UTIME_IDX = 11;
+	static constexpr size_t STIME_IDX = 12;
+	static constexpr size_t NUM_THREADS_IDX = 17;
+	static constexpr size_t START_TIME_IDX = 19;
+	static constexpr size_t RSS_IDX = 21;
+
+	std::array<std::string_view, RSS_IDX + 1> tokens;
+	if (SplitTokens(fields, tokens.data(), tokens.size()) != tokens.size() || tokens[STATE_IDX].size() != 1 ||
+	    !ParseInteger(tokens[PPID_IDX], stat.ppid) || !ParseUint64(tokens[MINFLT_IDX], stat.minor_faults) ||
+	    !ParseUint64(tokens[MAJFLT_IDX], stat.major_faults) || !ParseUint64(tokens[UTIME_IDX], stat.utime_ticks) ||
+	    !ParseUint64(tokens[STIME_IDX], stat.stime_ticks) || !ParseUint64(tokens[NUM_THREADS_IDX], stat.num_threads) ||
+	    !ParseUint64(tokens[START_TIME_IDX], stat.start_time_ticks) || !ParseUint64(tokens[RSS_IDX], stat.rss_pages)) {
+		return false;
+	}
+	stat.name = string {name};
+	stat.state = tokens[STATE_IDX][0];
+	return true;
+}
+
+ProcessTrackerCacheEntry::ProcessTrackerCacheEntry() : tracker(GetTicksPerSecond()) {
+}
+
+string ProcessTrackerCacheEntry::ObjectType() {
+	return "system_stats_process_tracker";
+}
+
+string ProcessTrackerCacheEntry::GetObjectType() {
+	return ObjectType();
+}
+
+void ProcessTrackerCacheEntry::Sample(ClientContext &context) {
+#ifdef __linux__
+	lock_guard<mutex> lock(mu);
+	SampleProcesses(context, tracker);
+#endif
+}
+
+vector<ProcessUsage> ProcessTrackerCacheEntry::SampleTop(ClientContext &context, idx_t n) {
+	vector<ProcessUsage> result;
+#ifdef __linux__
+	lock_guard<mutex> lock(mu);
+	SampleProcesses(context, tracker);
+
+	const double ticks_per_second = GetTicksPerSecond();
+	const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	auto top = tracker.SelectTop(n);
+	result.reserve(top.size());
+	for (auto *process : top) {
+		if (!process->details_loaded) {
+			ReadProcessDetails(*process);
+		}
+		ProcessUsage usage;
+		usage.pid = process->pid;
+		usage.ppid = process->stat.ppid;
+		usage.name = process->stat.name;
+		usage.state = string(1, process->stat.state);
+		usage.has_uid = process->has_uid;
+		usage.uid = process->uid;
+		usage.cmdline = process->cmdline;
+		usage.exe = process->exe;
+		usage.num_threads = process->stat.num_threads;
+		usage.rss_bytes = process->stat.rss_pages * page_size;
+		usage.cpu_seconds =
+		    static_cast<double>(process->stat.utime_ticks + process->stat.stime_ticks) / ticks_per_second;
+		usage.has_rates = process->has_rates;
+		usage.cpu_pct = process->cpu_pct;
+		result.emplace_back(std::move(usage));
+	}
+#endif
+	return result;
+}
+
+vector<ProcessUsage> GetTopProcesses(ClientContext &context, idx_t n, int64_t interval_micros) {
+#ifdef __linux__
+	auto &cache = context.db->GetObjectCache();
+	auto tracker = cache.GetOrCreate<ProcessTrackerCacheEntry>(ProcessTrackerCacheEntry::ObjectType());
+	if (interval_micros > 0) {
+		tracker->Sample(context);
+		std::this_thread::sleep_for(std::chrono::microseconds(interval_micros));
+	}
+	return tracker->SampleTop(context, n);
+#elif __APPLE__
+	// procfs is not available on macOS.
+	return {};
+#else
+	throw NotImplementedException("Process statistics are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
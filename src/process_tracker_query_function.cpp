@@ -0,0 +1,189 @@
+#include "process_tracker_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "process_tracker.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Sampling sleeps for the whole interval, and the query cannot be interrupted until it is over.
+constexpr int64_t MAX_INTERVAL_MICROS = 60 * Interval::MICROS_PER_SEC;
+
+struct SysProcessTopBindData : public FunctionData {
+	idx_t n = 0;
+	// No sampling interval by default, so CPU percentage covers the time since the previous call.
+	int64_t interval_micros = 0;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysProcessTopBindData>();
+		return n == other.n && interval_micros == other.interval_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysProcessTopBindData>();
+		result->n = n;
+		result->interval_micros = interval_micros;
+		return std::move(result);
+	}
+};
+
+struct SysProcessTopData : public GlobalTableFunctionState {
+	SysProcessTopData(ClientContext &context, idx_t n, int64_t interval_micros)
+	    : finished(false), current_index(0), processes(GetTopProcesses(context, n, interval_micros)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<ProcessUsage> processes;
+};
+
+unique_ptr<FunctionData> SysProcessTopBind(ClientContext &context, TableFunctionBindInput &input,
+                                           vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(11);
+	names.reserve(11);
+
+	auto result = make_uniq<SysProcessTopBindData>();
+
+	if (input.inputs[0].IsNull()) {
+		throw InvalidInputException("Number of processes for sys_process_top cannot be NULL");
+	}
+	const int64_t n = input.inputs[0].GetValue<int64_t>();
+	if (n <= 0) {
+		throw InvalidInputException("Number of processes for sys_process_top must be positive, but got '%s'",
+		                            input.inputs[0].ToString());
+	}
+	result->n = static_cast<idx_t>(n);
+
+	// Parse interval parameter if provided
+	auto interval_it = input.named_parameters.find("interval");
+	if (interval_it != input.named_parameters.end()) {
+		result->interval_micros = Interval::GetMicro(interval_it->second.GetValue<interval_t>());
+		if (result->interval_micros <= 0 || result->interval_micros > MAX_INTERVAL_MICROS) {
+			throw InvalidInputException(
+			    "Sampling interval for sys_process_top must be positive and at most 60 seconds, but got '%s'",
+			    interval_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("pid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("ppid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("state");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("uid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UINTEGER});
+
+	names.emplace_back("cmdline");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("exe");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("num_threads");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("rss_bytes");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("cpu_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("cpu_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysProcessTopInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysProcessTopBindData>();
+	return make_uniq<SysProcessTopData>(context, bind_data.n, bind_data.interval_micros);
+}
+
+void SysProcessTopFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysProcessTopData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.processes.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &process = data.processes[data.current_index];
+		col_idx = 0;
+
+		// pid
+		output.SetValue(col_idx++, output_count, Value::INTEGER(process.pid));
+
+		// ppid
+		output.SetValue(col_idx++, output_count, Value::INTEGER(process.ppid));
+
+		// name
+		output.SetValue(col_idx++, output_count, Value(process.name));
+
+		// state
+		output.SetValue(col_idx++, output_count, Value(process.state));
+
+		// uid
+		output.SetValue(col_idx++, output_count,
+		                process.has_uid ? Value::UINTEGER(process.uid) : Value(LogicalType::UINTEGER));
+
+		// cmdline, NULL for kernel threads
+		output.SetValue(col_idx++, output_count,
+		                process.cmdline.empty() ? Value(LogicalType::VARCHAR) : Value(process.cmdline));
+
+		// exe, NULL if not readable
+		output.SetValue(col_idx++, output_count,
+		                process.exe.empty() ? Value(LogicalType::VARCHAR) : Value(process.exe));
+
+		// num_threads
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(process.num_threads));
+
+		// rss_bytes
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(process.rss_bytes));
+
+		// cpu_seconds
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(process.cpu_seconds));
+
+		// cpu_pct, NULL for processes not seen in the previous sample
+		output.SetValue(col_idx++, output_count,
+		                process.has_rates ? Value::DOUBLE(process.cpu_pct) : Value(LogicalType::DOUBLE));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.processes.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysProcessTopFunction(ExtensionLoader &loader) {
+	TableFunction sys_process_top_func("sys_process_top", {LogicalType::BIGINT}, SysProcessTopFunc, SysProcessTopBind,
+	                                   SysProcessTopInit);
+	sys_process_top_func.named_parameters["interval"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_process_top_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,780 @@
+#include "shared_metrics.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "scope_guard.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Opened through /dev/shm rather than shm_open(3), which needs librt with glibc before 2.34. The effective user id is
+// appended.
+constexpr const char *SEGMENT_PATH_PREFIX = "/dev/shm/duckdb_system_stats_v1_";
+
+constexpr const char *SHARED_METRICS_OPTION = "system_stats_shared_metrics";
+
+// "DDBSTATS" in little endian, set once the publisher initialized the segment.
+constexpr uint64_t SEGMENT_MAGIC = 0x5354415453424444ULL;
+constexpr uint32_t LAYOUT_VERSION = 1;
+
+constexpr idx_t MAX_INTERFACES = 64;
+constexpr idx_t MAX_INTERFACE_ADDRESSES = 16;
+// IFNAMSIZ is 16 on Linux.
+constexpr idx_t INTERFACE_NAME_SIZE = 32;
+// Large enough for IPv6 addresses with a scope, i.e. "fe80::1%eth0".
+constexpr idx_t ADDRESS_SIZE = 64;
+
+// Reads retried while the publisher is writing; a write takes microseconds, so running out of attempts is rare and
+// only means this read collects locally.
+constexpr idx_t MAX_READ_ATTEMPTS = 64;
+// Snapshots older than this many publish intervals are stale.
+constexpr uint64_t STALE_INTERVALS = 3;
+constexpr uint64_t MIN_STALE_NS = 1000000000ULL;
+// How often readers retry mapping the segment while no fresh snapshot is published.
+constexpr uint64_t ATTACH_RETRY_NS = 1000000000ULL;
+
+// All fields have fixed width and explicit padding, so processes built by different compilers agree on the layout.
+struct SharedAddress {
+	std::array<char, ADDRESS_SIZE> address;
+	int32_t prefix_len;
+	uint8_t is_ipv6;
+	std::array<uint8_t, 3> padding;
+};
+
+struct SharedInterface {
+	std::array<char, INTERFACE_NAME_SIZE> name;
+	uint64_t tx_bytes;
+	uint64_t tx_packets;
+	uint64_t tx_errors;
+	uint64_t tx_dropped;
+	uint64_t rx_bytes;
+	uint64_t rx_packets;
+	uint64_t rx_errors;
+	uint64_t rx_dropped;
+	uint64_t speed_mbps;
+	uint32_t address_count;
+	uint32_t padding;
+	std::array<SharedAddress, MAX_INTERFACE_ADDRESSES> addresses;
+};
+
+struct SharedPayload {
+	uint64_t publish_time_ns;
+	uint64_t interval_ns;
+	int32_t publisher_pid;
+	uint32_t has_networks;
+	uint64_t total_memory;
+	uint64_t used_memory;
+	uint64_t free_memory;
+	uint64_t total_swap;
+	uint64_t used_swap;
+	uint64_t free_swap;
+	uint64_t cached_memory;
+	int32_t handle_count;
+	int32_t process_count;
+	int32_t thread_count;
+	uint32_t interface_count;
+	std::array<SharedInterface, MAX_INTERFACES> interfaces;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock must not depend on a process-local lock");
+
+// Copy [src] into the null-terminated [dst]; return false if it does not fit.
+template <size_t N>
+bool CopyToArray(const string &src, std::array<char, N> &dst) {
+	if (src.size() >= N) {
+		return false;
+	}
+	std::memcpy(dst.data(), src.data(), src.size());
+	std::fill(dst.begin() + static_cast<std::ptrdiff_t>(src.size()), dst.end(), '\0');
+	return true;
+}
+
+// Read a string from [src], which might be torn and lack the null terminator while being read.
+template <size_t N>
+string CopyFromArray(const std::array<char, N> &src) {
+	return string(src.data(), strnlen(src.data(), N));
+}
+
+// Encode [networks] into [payload]; return false if some interface or address did not fit.
+bool EncodeNetworks(const vector<NetworkInfo> &networks, SharedPayload &payload) {
+	payload.interface_count = 0;
+	if (networks.size() > MAX_INTERFACES) {
+		return false;
+	}
+	for (const auto &info : networks) {
+		auto &shared = payload.interfaces[payload.interface_count];
+		if (!CopyToArray(info.interface_name, shared.name) || info.addresses.size() > MAX_INTERFACE_ADDRESSES) {
+			payload.interface_count = 0;
+			return false;
+		}
+		shared.tx_bytes = info.tx_bytes;
+		shared.tx_packets = info.tx_packets;
+		shared.tx_errors = info.tx_errors;
+		shared.tx_dropped = info.tx_dropped;
+		shared.rx_bytes = info.rx_bytes;
+		shared.rx_packets = info.rx_packets;
+		shared.rx_errors = info.rx_errors;
+		shared.rx_dropped = info.rx_dropped;
+		shared.speed_mbps = info.speed_mbps;
+		shared.address_count = 0;
+		for (const auto &address : info.addresses) {
+			auto &shared_address = shared.addresses[shared.address_count++];
+			if (!CopyToArray(address.address, shared_address.address)) {
+				payload.interface_count = 0;
+				return false;
+			}
+			shared_address.prefix_len = address.prefix_len;
+			shared_address.is_ipv6 = address.family == "ipv6";
+		}
+		payload.interface_count++;
+	}
+	return true;
+}
+
+void DecodeNetworks(const SharedPayload &payload, vector<NetworkInfo> &networks) {
+	// Counts are clamped, a torn read is discarded afterwards but must not read out of bounds.
+	const idx_t interface_count = MinValue<idx_t>(payload.interface_count, MAX_INTERFACES);
+	networks.clear();
+	networks.reserve(interface_count);
+	for (idx_t idx = 0; idx < interface_count; idx++) {
+		const auto &shared = payload.interfaces[idx];
+		NetworkInfo info;
+		info.interface_name = CopyFromArray(shared.name);
+		info.tx_bytes = shared.tx_bytes;
+		info.tx_packets = shared.tx_packets;
+		info.tx_errors = shared.tx_errors;
+		info.tx_dropped = shared.tx_dropped;
+		info.rx_bytes = shared.rx_bytes;
+		info.rx_packets = shared.rx_packets;
+		info.rx_errors = shared.rx_errors;
+		info.rx_dropped = shared.rx_dropped;
+		info.speed_mbps = shared.speed_mbps;
+		const idx_t address_count = MinValue<idx_t>(shared.address_count, MAX_INTERFACE_ADDRESSES);
+		for (idx_t address_idx = 0; address_idx < address_count; address_idx++) {
+			const auto &shared_address = shared.addresses[address_idx];
+			NetworkAddress address;
+			address.family = shared_address.is_ipv6 ? "ipv6" : "ipv4";
+			address.address = CopyFromArray(shared_address.address);
+			address.prefix_len = shared_address.prefix_len;
+			if (info.ipv4_address.empty() && address.family == "ipv4") {
+				info.ipv4_address = address.address;
+			}
+			info.addresses.emplace_back(std::move(address));
+		}
+		networks.emplace_back(std::move(info));
+	}
+}
+
+#ifdef __linux__
+// Open the segment at [path] with [flags]. /dev/shm is writable by all users, so only a regular file of the effective
+// user which no other user may write is accepted; a planted symlink or a segment with forged metrics is refused.
+// Return -1 and set [error] otherwise.
+int OpenSegment(const string &path, int flags, string &error) {
+	const int fd = open(path.c_str(), flags | O_NOFOLLOW | O_CLOEXEC, 0600);
+	if (fd == -1) {
+		error = StringUtil::Format("Failed to open %s: %s", path, strerror(errno));
+		return -1;
+	}
+	struct stat segment_stat;
+	if (fstat(fd, &segment_stat) != 0) {
+		error = StringUtil::Format("Failed to stat %s: %s", path, strerror(errno));
+	} else if (!S_ISREG(segment_stat.st_mode)) {
+		error = StringUtil::Format("Refusing to use %s, which is not a regular file", path);
+	} else if (segment_stat.st_uid != geteuid()) {
+		error = StringUtil::Format("Refusing to use %s, which is owned by another user", path);
+	} else if ((segment_stat.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+		error = StringUtil::Format("Refusing to use %s, which is writable by other users", path);
+	} else {
+		return fd;
+	}
+	close(fd);
+	return -1;
+}
+
+// Return whether the file [fd] covers the whole segment, which is checked before mapping it. Only the publisher resizes
+// the file, and only grows it to the segment size while holding its lock, so a mapped segment is never cut short;
+// touching a page past the end of a truncated file would raise SIGBUS.
+bool HasSegmentSize(int fd) {
+	struct stat segment_stat;
+	return fstat(fd, &segment_stat) == 0 && static_cast<idx_t>(segment_stat.st_size) >= GetSharedMetricsSegmentSize();
+}
+
+uint64_t GetMonotonicNs() {
+	// Served by the vDSO, so reading a snapshot needs no system call.
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+#endif
+
+} // namespace
+
+// The sequence is odd while the publisher writes; readers retry until they see the same even sequence before and
+// after copying the payload.
+struct SharedMetricsSegment {
+	uint64_t magic;
+	uint32_t layout_version;
+	uint32_t payload_size;
+	std::atomic<uint64_t> sequence;
+	SharedPayload payload;
+};
+
+idx_t GetSharedMetricsSegmentSize() {
+	return sizeof(SharedMetricsSegment);
+}
+
+string GetSharedMetricsSegmentPath() {
+#ifdef __linux__
+	return SEGMENT_PATH_PREFIX + std::to_string(geteuid());
+#else
+	return SEGMENT_PATH_PREFIX;
+#endif
+}
+
+void InitializeSharedMetricsSegment(SharedMetricsSegment &segment) {
+	if (segment.magic == SEGMENT_MAGIC && segment.layout_version == LAYOUT_VERSION &&
+	    segment.payload_size == sizeof(SharedPayload)) {
+		// A previous publisher died while writing. Its torn payload could carry a fresh publish time, so clear it
+		// before making the sequence even again; readers then see no snapshot until the next write.
+		const uint64_t sequence = segment.sequence.load(std::memory_order_relaxed);
+		if (sequence % 2 != 0) {
+			std::memset(&segment.payload, 0, sizeof(SharedPayload));
+			segment.sequence.store(sequence + 1, std::memory_order_release);
+		}
+		return;
+	}
+	segment.sequence.store(0, std::memory_order_relaxed);
+	segment.layout_version = LAYOUT_VERSION;
+	segment.payload_size = sizeof(SharedPayload);
+	std::memset(&segment.payload, 0, sizeof(SharedPayload));
+	std::atomic_thread_fence(std::memory_order_release);
+	segment.magic = SEGMENT_MAGIC;
+}
+
+void WriteSharedMetrics(SharedMetricsSegment &segment, const SharedMetricsSnapshot &snapshot) {
+	const uint64_t sequence = segment.sequence.load(std::memory_order_relaxed);
+	segment.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	auto &payload = segment.payload;
+	payload.publish_time_ns = snapshot.publish_time_ns;
+	payload.interval_ns = snapshot.interval_ns;
+	payload.publisher_pid = snapshot.publisher_pid;
+	payload.total_memory = snapshot.memory.total_memory;
+	payload.used_memory = snapshot.memory.used_memory;
+	payload.free_memory = snapshot.memory.free_memory;
+	payload.total_swap = snapshot.memory.total_swap;
+	payload.used_swap = snapshot.memory.used_swap;
+	payload.free_swap = snapshot.memory.free_swap;
+	payload.cached_memory = snapshot.memory.cached_memory;
+	payload.handle_count = snapshot.handle_count;
+	payload.process_count = snapshot.process_count;
+	payload.thread_count = snapshot.thread_count;
+	payload.has_networks = snapshot.has_networks && EncodeNetworks(snapshot.networks, payload);
+
+	segment.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool ReadSharedMetrics(const SharedMetricsSegment &segment, bool with_networks, SharedMetricsSnapshot &snapshot) {
+	if (segment.magic != SEGMENT_MAGIC || segment.layout_version != LAYOUT_VERSION ||
+	    segment.payload_size != sizeof(SharedPayload)) {
+		return false;
+	}
+	const auto &payload = segment.payload;
+	for (idx_t attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+		const uint64_t sequence = segment.sequence.load(std::memory_order_acquire);
+		if (sequence % 2 != 0) {
+			continue;
+		}
+		snapshot.publish_time_ns = payload.publish_time_ns;
+		snapshot.interval_ns = payload.interval_ns;
+		snapshot.publisher_pid = payload.publisher_pid;
+		snapshot.memory.total_memory = payload.total_memory;
+		snapshot.memory.used_memory = payload.used_memory;
+		snapshot.memory.free_memory = payload.free_memory;
+		snapshot.memory.total_swap = payload.total_swap;
+		snapshot.memory.used_swap = payload.used_swap;
+		snapshot.memory.free_swap = payload.free_swap;
+		snapshot.memory.cached_memory = payload.cached_memory;
+		snapshot.handle_count = payload.handle_count;
+		snapshot.process_count = payload.process_count;
+		snapshot.thread_count = payload.thread_count;
+		snapshot.has_networks = payload.has_networks != 0;
+		if (with_networks && snapshot.has_networks) {
+			DecodeNetworks(payload, snapshot.networks);
+		} else {
+			snapshot.networks.clear();
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (segment.sequence.load(std::memory_order_relaxed) == sequence) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool IsSharedMetricsFresh(const SharedMetricsSnapshot &snapshot, uint64_t now_ns) {
+	// A publish time in the future means the publisher runs in another time namespace, so its clock is not ours.
+	if (snapshot.publish_time_ns == 0 || snapshot.publish_time_ns > now_ns) {
+		return false;
+	}
+	const uint64_t max_age_ns = MaxValue<uint64_t>(snapshot.interval_ns * STALE_INTERVALS, MIN_STALE_NS);
+	return now_ns - snapshot.publish_time_ns <= max_age_ns;
+}
+
+vector<NetworkInfo> FilterNetworkInfo(const vector<NetworkInfo> &networks, AddressFamily family) {
+	if (family == AddressFamily::ALL) {
+		return networks;
+	}
+	const char *family_name = family == AddressFamily::IPV4 ? "ipv4" : "ipv6";
+	vector<NetworkInfo> result;
+	for (const auto &info : networks) {
+		NetworkInfo filtered = info;
+		filtered.addresses.clear();
+		filtered.ipv4_address.clear();
+		for (const auto &address : info.addresses) {
+			if (address.family != family_name) {
+				continue;
+			}
+			if (filtered.ipv4_address.empty() && address.family == "ipv4") {
+				filtered.ipv4_address = address.address;
+			}
+			filtered.addresses.emplace_back(address);
+		}
+		if (!filtered.addresses.empty()) {
+			result.emplace_back(std::move(filtered));
+		}
+	}
+	return result;
+}
+
+namespace {
+
+// ObjectCacheEntry that keeps the segment mapped read-only for one database instance, so reads only touch memory.
+class SharedMetricsReaderCacheEntry : public ObjectCacheEntry {
+public:
+	~SharedMetricsReaderCacheEntry() override {
+		Detach();
+	}
+
+	static string ObjectType() {
+		return "system_stats_shared_metrics_reader_cache";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Only holds a mapping, which is not worth evicting.
+		return optional_idx {};
+	}
+
+	// Read the published snapshot into [snapshot]; return whether it is fresh. [snapshot] is filled even if it is
+	// stale, publish_time_ns stays 0 if there is none.
+	bool Read(bool with_networks, SharedMetricsSnapshot &snapshot, uint64_t &now_ns) {
+#ifdef __linux__
+		lock_guard<mutex> lock(mu);
+		now_ns = GetMonotonicNs();
+		if (segment && ReadSharedMetrics(*segment, with_networks, snapshot) &&
+		    IsSharedMetricsFresh(snapshot, now_ns)) {
+			return true;
+		}
+		// The segment might not exist yet, or be replaced after an administrator removed it.
+		if (now_ns < next_attach_ns) {
+			return false;
+		}
+		next_attach_ns = now_ns + ATTACH_RETRY_NS;
+		Detach();
+		Attach();
+		return segment && ReadSharedMetrics(*segment, with_networks, snapshot) &&
+		       IsSharedMetricsFresh(snapshot, now_ns);
+#else
+		return false;
+#endif
+	}
+
+private:
+	void Attach() {
+#ifdef __linux__
+		// A segment which cannot be used is treated as missing, and readers collect locally.
+		string error;
+		const int fd = OpenSegment(GetSharedMetricsSegmentPath(), O_RDONLY, error);
+		if (fd == -1) {
+			return;
+		}
+		void *addr = MAP_FAILED;
+		if (HasSegmentSize(fd)) {
+			addr = mmap(nullptr, GetSharedMetricsSegmentSize(), PROT_READ, MAP_SHARED, fd, 0);
+		}
+		// The mapping stays valid after closing the file.
+		close(fd);
+		if (addr != MAP_FAILED) {
+			segment = static_cast<const SharedMetricsSegment *>(addr);
+		}
+#endif
+	}
+
+	void Detach() {
+#ifdef __linux__
+		if (segment) {
+			munmap(const_cast<SharedMetricsSegment *>(segment), GetSharedMetricsSegmentSize());
+			segment = nullptr;
+		}
+#endif
+	}
+
+	mutex mu;
+	const SharedMetricsSegment *segment = nullptr;
+	uint64_t next_attach_ns = 0;
+};
+
+shared_ptr<SharedMetricsReaderCacheEntry> GetReaderEntry(ClientContext &context) {
+	auto &cache = context.db->GetObjectCache();
+	return cache.GetOrCreate<SharedMetricsReaderCacheEntry>(SharedMetricsReaderCacheEntry::ObjectType());
+}
+
+bool IsSharedMetricsEnabled(ClientContext &context) {
+	Value value;
+	return context.TryGetCurrentSetting(SHARED_METRICS_OPTION, value) && !value.IsNull() && value.GetValue<bool>();
+}
+
+bool ReadFreshSnapshot(ClientContext &context, bool with_networks, SharedMetricsSnapshot &snapshot) {
+	if (!IsSharedMetricsEnabled(context)) {
+		return false;
+	}
+	uint64_t now_ns = 0;
+	return GetReaderEntry(context)->Read(with_networks, snapshot, now_ns);
+}
+
+// Publisher state shared between the cache entry and the background thread, as for the recorder.
+struct SharedMetricsPublisherState {
+	~SharedMetricsPublisherState() {
+#ifdef __linux__
+		if (segment) {
+			munmap(segment, GetSharedMetricsSegmentSize());
+		}
+		// Closing the file releases the lock, and a standby publisher takes over.
+		if (fd != -1) {
+			close(fd);
+		}
+#endif
+	}
+
+	int64_t interval_micros = 0;
+	weak_ptr<DatabaseInstance> db_weak;
+
+	// Only accessed by the background thread while it is running, and by the stopping thread after join.
+	int fd = -1;
+	SharedMetricsSegment *segment = nullptr;
+
+	// Protects the fields below.
+	mutex mu;
+	std::condition_variable cv;
+	bool stop = false;
+	bool publishing = false;
+	uint64_t publish_count = 0;
+	string last_error;
+};
+
+void SetLastError(SharedMetricsPublisherState &state, const string &error) {
+	lock_guard<mutex> lock(state.mu);
+	state.last_error = error;
+}
+
+#ifdef __linux__
+// Try to become the publisher; return false while another publisher holds the lock of the segment.
+bool AcquireSegment(SharedMetricsPublisherState &state) {
+	const string path = GetSharedMetricsSegmentPath();
+	if (state.fd == -1) {
+		string error;
+		state.fd = OpenSegment(path, O_RDWR | O_CREAT, error);
+		if (state.fd == -1) {
+			throw IOException(error);
+		}
+	}
+	// The lock is released by the kernel when the publisher exits, however it exits.
+	if (flock(state.fd, LOCK_EX | LOCK_NB) != 0) {
+		if (errno == EWOULDBLOCK) {
+			return false;
+		}
+		throw IOException("Failed to lock %s: %s", path, strerror(errno));
+	}
+	bool mapped = false;
+	SCOPE_EXIT {
+		if (!mapped) {
+			flock(state.fd, LOCK_UN);
+		}
+	};
+	const idx_t size = GetSharedMetricsSegmentSize();
+	if (!HasSegmentSize(state.fd) && ftruncate(state.fd, static_cast<off_t>(size)) != 0) {
+		throw IOException("Failed to resize %s: %s", path, strerror(errno));
+	}
+	void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, state.fd, 0);
+	if (addr == MAP_FAILED) {
+		throw IOException("Failed to map %s: %s", path, strerror(errno));
+	}
+	mapped = true;
+	state.segment = static_cast<SharedMetricsSegment *>(addr);
+	InitializeSharedMetricsSegment(*state.segment);
+	return true;
+}
+
+void PublishTick(ClientContext &context, SharedMetricsPublisherState &state) {
+	if (!state.segment && !AcquireSegment(state)) {
+		return;
+	}
+	{
+		lock_guard<mutex> lock(state.mu);
+		state.publishing = true;
+	}
+	SharedMetricsSnapshot snapshot;
+	snapshot.interval_ns = static_cast<uint64_t>(state.interval_micros) * 1000;
+	snapshot.publisher_pid = static_cast<int32_t>(getpid());
+	snapshot.memory = CollectMemoryInfo(context);
+	const OSInfo os = CollectOSInfo(context, OS_INFO_HANDLE_COUNT | OS_INFO_PROCESS_COUNT | OS_INFO_THREAD_COUNT);
+	snapshot.handle_count = os.handle_count;
+	snapshot.process_count = os.process_count;
+	snapshot.thread_count = os.thread_count;
+	snapshot.networks = CollectNetworkInfo(context, AddressFamily::ALL);
+	snapshot.has_networks = true;
+	// Taken after collecting, so the age seen by readers covers the whole collection.
+	snapshot.publish_time_ns = GetMonotonicNs();
+	WriteSharedMetrics(*state.segment, snapshot);
+
+	lock_guard<mutex> lock(state.mu);
+	state.publish_count++;
+}
+#endif
+
+void RunPublisher(shared_ptr<SharedMetricsPublisherState> state) {
+	const auto interval = std::chrono::microseconds(state->interval_micros);
+	auto next_tick = std::chrono::steady_clock::now();
+	while (true) {
+		{
+			// The database is only referenced during a tick, so the publisher never keeps it alive.
+			auto db = state->db_weak.lock();
+			if (!db) {
+				return;
+			}
+#ifdef __linux__
+			try {
+				Connection con(*db);
+				PublishTick(*con.context, *state);
+			} catch (std::exception &ex) {
+				SetLastError(*state, ErrorData(ex).Message());
+			}
+#endif
+		}
+
+		// Standby publishers retry the lock once per interval, so a failover takes at most one interval.
+		next_tick += interval;
+		const auto now = std::chrono::steady_clock::now();
+		if (next_tick < now) {
+			next_tick = now;
+		}
+		std::unique_lock<mutex> lock(state->mu);
+		if (state->cv.wait_until(lock, next_tick, [&]() { return state->stop; })) {
+			return;
+		}
+	}
+}
+
+// ObjectCacheEntry that owns the publisher thread of one database instance.
+class SharedMetricsPublisherCacheEntry : public ObjectCacheEntry {
+public:
+	~SharedMetricsPublisherCacheEntry() override {
+		StopThread();
+	}
+
+	static string ObjectType() {
+		return "system_stats_shared_metrics_publisher_cache";
+	}
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	optional_idx GetEstimatedCacheMemory() const override {
+		// Cannot be evicted, otherwise a running publisher is lost.
+		return optional_idx {};
+	}
+
+	SharedMetricsStatus Start(ClientContext &context, int64_t interval_micros) {
+		lock_guard<mutex> lock(mu);
+		if (state) {
+			throw InvalidInputException("sys_shared_metrics is already running, call sys_shared_metrics_stop() first");
+		}
+#ifdef __linux__
+		state = make_shared_ptr<SharedMetricsPublisherState>();
+		state->interval_micros = interval_micros;
+		state->db_weak = GetDbInstance(context);
+		thread = std::thread(RunPublisher, state);
+		return GetStatus(*state);
+#else
+		SharedMetricsStatus status;
+		status.interval_micros = interval_micros;
+		status.last_error = "Shared metrics are only supported on Linux";
+		return status;
+#endif
+	}
+
+	SharedMetricsStatus Stop() {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return SharedMetricsStatus {};
+		}
+		StopThread();
+		// Unmaps the segment and releases the lock.
+		auto stopped_state = std::move(state);
+		auto status = GetStatus(*stopped_state);
+		status.running = false;
+		status.publishing = false;
+		return status;
+	}
+
+	SharedMetricsStatus GetStatus() {
+		lock_guard<mutex> lock(mu);
+		if (!state) {
+			return SharedMetricsStatus {};
+		}
+		return GetStatus(*state);
+	}
+
+private:
+	static SharedMetricsStatus GetStatus(SharedMetricsPublisherState &publisher_state) {
+		lock_guard<mutex> lock(publisher_state.mu);
+		SharedMetricsStatus status;
+		status.running = !publisher_state.stop;
+		status.publishing = publisher_state.publishing;
+		status.interval_micros = publisher_state.interval_micros;
+		status.publish_count = publisher_state.publish_count;
+		status.last_error = publisher_state.last_error;
+		return status;
+	}
+
+	// Signal the background thread to stop and wait for it.
+	void StopThread() {
+		if (state) {
+			lock_guard<mutex> lock(state->mu);
+			state->stop = true;
+		}
+		if (state) {
+			state->cv.notify_all();
+		}
+		if (!thread.joinable()) {
+			return;
+		}
+		// The last reference to the database could be released by the publisher thread itself, in which case the
+		// entry is destroyed on that thread; it exits on its own as soon as it sees [stop].
+		if (thread.get_id() == std::this_thread::get_id()) {
+			thread.detach();
+		} else {
+			thread.join();
+		}
+	}
+
+	mutex mu;
+	shared_ptr<SharedMetricsPublisherState> state;
+	std::thread thread;
+};
+
+shared_ptr<SharedMetricsPublisherCacheEntry> GetPublisherEntry(ClientContext &context) {
+	auto &cache = context.db->GetObjectCache();
+	return cache.GetOrCreate<SharedMetricsPublisherCacheEntry>(SharedMetricsPublisherCacheEntry::ObjectType());
+}
+
+// Add the snapshot seen by readers to [status], regardless of the setting.
+SharedMetricsStatus AddSnapshotStatus(ClientContext &context, SharedMetricsStatus status) {
+	uint64_t now_ns = 0;
+	status.snapshot_fresh = GetReaderEntry(context)->Read(false, status.snapshot, now_ns);
+	if (status.snapshot.publish_time_ns != 0 && status.snapshot.publish_time_ns <= now_ns) {
+		status.snapshot_age_micros = static_cast<int64_t>((now_ns - status.snapshot.publish_time_ns) / 1000);
+	}
+	return status;
+}
+
+} // namespace
+
+bool ReadSharedMemoryInfo(ClientContext &context, MemoryInfo &info) {
+	SharedMetricsSnapshot snapshot;
+	if (!ReadFreshSnapshot(context, false, snapshot)) {
+		return false;
+	}
+	info = snapshot.memory;
+	return true;
+}
+
+bool ReadSharedNetworkInfo(ClientContext &context, AddressFamily family, vector<NetworkInfo> &networks) {
+	SharedMetricsSnapshot snapshot;
+	if (!ReadFreshSnapshot(context, true, snapshot) || !snapshot.has_networks) {
+		return false;
+	}
+	networks = FilterNetworkInfo(snapshot.networks, family);
+	return true;
+}
+
+bool ReadSharedOSCounts(ClientContext &context, OSInfo &info) {
+	SharedMetricsSnapshot snapshot;
+	if (!ReadFreshSnapshot(context, false, snapshot)) {
+		return false;
+	}
+	info.handle_count = snapshot.handle_count;
+	info.process_count = snapshot.process_count;
+	info.thread_count = snapshot.thread_count;
+	return true;
+}
+
+SharedMetricsStatus StartSharedMetrics(ClientContext &context, int64_t interval_micros) {
+	if (!DBConfig::GetConfig(context).options.enable_external_access) {
+		throw PermissionException("sys_shared_metrics_start is disabled through configuration");
+	}
+	return AddSnapshotStatus(context, GetPublisherEntry(context)->Start(context, interval_micros));
+}
+
+SharedMetricsStatus StopSharedMetrics(ClientContext &context) {
+	return AddSnapshotStatus(context, GetPublisherEntry(context)->Stop());
+}
+
+SharedMetricsStatus GetSharedMetricsStatus(ClientContext &context) {
+	return AddSnapshotStatus(context, GetPublisherEntry(context)->GetStatus());
+}
+
+void RegisterSharedMetricsOptions(DatabaseInstance &db) {
+	auto &config = DBConfig::GetConfig(db);
+	config.AddExtensionOption(SHARED_METRICS_OPTION,
+	                          "Read memory, network and process counts published by sys_shared_metrics_start() in any "
+	                          "DuckDB process of the host, instead of collecting them",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+}
+
+} // namespace duckdb
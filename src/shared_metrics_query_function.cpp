@@ -0,0 +1,201 @@
+#include "shared_metrics_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "shared_metrics.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Default publish interval.
+constexpr int64_t DEFAULT_INTERVAL_MICROS = Interval::MICROS_PER_SEC;
+// Min publish interval, collecting the shared metrics takes a few milliseconds.
+constexpr int64_t MIN_INTERVAL_MICROS = 100 * Interval::MICROS_PER_MSEC;
+
+void AddSharedMetricsStatusColumns(vector<LogicalType> &return_types, vector<string> &names) {
+	return_types.reserve(9);
+	names.reserve(9);
+
+	names.emplace_back("running");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("publishing");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("segment");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("interval");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	names.emplace_back("publish_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("publisher_pid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("snapshot_age");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTERVAL});
+
+	names.emplace_back("snapshot_fresh");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("last_error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+}
+
+void SetSharedMetricsStatusRow(DataChunk &output, const SharedMetricsStatus &status) {
+	idx_t col_idx = 0;
+	// Snapshot columns are NULL when nothing was published to the segment yet.
+	const bool has_snapshot = status.snapshot.publish_time_ns != 0;
+
+	// running
+	output.SetValue(col_idx++, 0, Value::BOOLEAN(status.running));
+
+	// publishing
+	output.SetValue(col_idx++, 0, Value::BOOLEAN(status.publishing));
+
+	// segment
+	output.SetValue(col_idx++, 0, Value(GetSharedMetricsSegmentPath()));
+
+	// interval, NULL when no publisher has been started
+	output.SetValue(col_idx++, 0,
+	                status.interval_micros != 0 ? Value::INTERVAL(Interval::FromMicro(status.interval_micros))
+	                                            : Value(LogicalType::INTERVAL));
+
+	// publish_count
+	output.SetValue(col_idx++, 0, Value::UBIGINT(status.publish_count));
+
+	// publisher_pid, of the process which published the snapshot
+	output.SetValue(col_idx++, 0,
+	                has_snapshot ? Value::INTEGER(status.snapshot.publisher_pid) : Value(LogicalType::INTEGER));
+
+	// snapshot_age
+	output.SetValue(col_idx++, 0,
+	                has_snapshot ? Value::INTERVAL(Interval::FromMicro(status.snapshot_age_micros))
+	                             : Value(LogicalType::INTERVAL));
+
+	// snapshot_fresh
+	output.SetValue(col_idx++, 0, Value::BOOLEAN(status.snapshot_fresh));
+
+	// last_error, NULL if none
+	output.SetValue(col_idx++, 0, status.last_error.empty() ? Value(LogicalType::VARCHAR) : Value(status.last_error));
+
+	output.SetCardinality(1);
+}
+
+struct SysSharedMetricsStartBindData : public FunctionData {
+	int64_t interval_micros = DEFAULT_INTERVAL_MICROS;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysSharedMetricsStartBindData>();
+		return interval_micros == other.interval_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysSharedMetricsStartBindData>();
+		result->interval_micros = interval_micros;
+		return std::move(result);
+	}
+};
+
+struct SysSharedMetricsData : public GlobalTableFunctionState {
+	SysSharedMetricsData() : finished(false) {
+	}
+	bool finished;
+};
+
+unique_ptr<FunctionData> SysSharedMetricsStartBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+
+	auto result = make_uniq<SysSharedMetricsStartBindData>();
+
+	// Parse interval parameter if provided
+	auto interval_it = input.named_parameters.find("interval");
+	if (interval_it != input.named_parameters.end()) {
+		if (interval_it->second.IsNull()) {
+			throw InvalidInputException("Interval for sys_shared_metrics_start cannot be NULL");
+		}
+		result->interval_micros = Interval::GetMicro(interval_it->second.GetValue<interval_t>());
+		if (result->interval_micros < MIN_INTERVAL_MICROS) {
+			throw InvalidInputException(
+			    "Publish interval for sys_shared_metrics_start must be at least 100 milliseconds, but got '%s'",
+			    interval_it->second.ToString());
+		}
+	}
+
+	AddSharedMetricsStatusColumns(return_types, names);
+	return std::move(result);
+}
+
+unique_ptr<FunctionData> SysSharedMetricsStatusBind(ClientContext &context, TableFunctionBindInput &input,
+                                                    vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	AddSharedMetricsStatusColumns(return_types, names);
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> SysSharedMetricsInit(ClientContext &context, TableFunctionInitInput &input) {
+	return make_uniq<SysSharedMetricsData>();
+}
+
+void SysSharedMetricsStartFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysSharedMetricsData>();
+	auto &bind_data = data_p.bind_data->Cast<SysSharedMetricsStartBindData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetSharedMetricsStatusRow(output, StartSharedMetrics(context, bind_data.interval_micros));
+	data.finished = true;
+}
+
+void SysSharedMetricsStopFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysSharedMetricsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetSharedMetricsStatusRow(output, StopSharedMetrics(context));
+	data.finished = true;
+}
+
+void SysSharedMetricsStatusFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysSharedMetricsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	SetSharedMetricsStatusRow(output, GetSharedMetricsStatus(context));
+	data.finished = true;
+}
+
+} // namespace
+
+void RegisterSysSharedMetricsFunctions(ExtensionLoader &loader) {
+	TableFunction sys_shared_metrics_start_func("sys_shared_metrics_start", {}, SysSharedMetricsStartFunc,
+	                                            SysSharedMetricsStartBind, SysSharedMetricsInit);
+	sys_shared_metrics_start_func.named_parameters["interval"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_shared_metrics_start_func);
+
+	TableFunction sys_shared_metrics_stop_func("sys_shared_metrics_stop", {}, SysSharedMetricsStopFunc,
+	                                           SysSharedMetricsStatusBind, SysSharedMetricsInit);
+	loader.RegisterFunction(sys_shared_metrics_stop_func);
+
+	TableFunction sys_shared_metrics_status_func("sys_shared_metrics_status", {}, SysSharedMetricsStatusFunc,
+	                                             SysSharedMetricsStatusBind, SysSharedMetricsInit);
+	loader.RegisterFunction(sys_shared_metrics_status_func);
+}
+
+} // namespace duckdb
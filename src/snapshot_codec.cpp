@@ -0,0 +1,255 @@
+#include "snapshot_codec.hpp"
+
+#include "duckdb/common/exception.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[] = "SYSSNAP";
+constexpr idx_t SNAPSHOT_MAGIC_LENGTH = sizeof(SNAPSHOT_MAGIC) - 1;
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+// Maximum length of a LEB128 encoded 64-bit integer.
+constexpr idx_t MAX_VARINT_LENGTH = 10;
+
+void WriteVarint(string &out, uint64_t value) {
+	char buf[MAX_VARINT_LENGTH];
+	idx_t len = 0;
+	while (value >= 0x80) {
+		buf[len++] = static_cast<char>((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	buf[len++] = static_cast<char>(value);
+	out.append(buf, len);
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+string GetSeriesKey(uint32_t source, uint32_t entity, uint32_t metric) {
+	char buf[3 * sizeof(uint32_t)];
+	memcpy(buf, &source, sizeof(uint32_t));
+	memcpy(buf + sizeof(uint32_t), &entity, sizeof(uint32_t));
+	memcpy(buf + 2 * sizeof(uint32_t), &metric, sizeof(uint32_t));
+	return string {buf, sizeof(buf)};
+}
+
+} // namespace
+
+SnapshotEncoder::SnapshotEncoder() {
+	Reset();
+}
+
+void SnapshotEncoder::Reset() {
+	data.assign(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LENGTH);
+	data.push_back(static_cast<char>(SNAPSHOT_VERSION));
+	sample_count = 0;
+	first_timestamp = 0;
+	last_timestamp = 0;
+	last_delta = 0;
+	string_ids.clear();
+	strings.clear();
+	series_ids.clear();
+	series_keys.clear();
+	last_values.clear();
+	last_layout.clear();
+}
+
+void SnapshotEncoder::Append(const MetricsBatch &batch) {
+	idx_t begin = 0;
+	while (begin < batch.Size()) {
+		idx_t end = begin + 1;
+		while (end < batch.Size() && batch.timestamps[end].value == batch.timestamps[begin].value) {
+			end++;
+		}
+		AppendSnapshot(batch, begin, end);
+		begin = end;
+	}
+}
+
+uint32_t SnapshotEncoder::GetStringId(std::string_view str, vector<uint32_t> &new_strings) {
+	auto result = string_ids.emplace(string {str}, static_cast<uint32_t>(strings.size()));
+	if (result.second) {
+		new_strings.emplace_back(result.first->second);
+		strings.emplace_back(str);
+	}
+	return result.first->second;
+}
+
+void SnapshotEncoder::AppendSnapshot(const MetricsBatch &batch, idx_t begin, idx_t end) {
+	const int64_t timestamp = batch.timestamps[begin].value;
+	// Resolve the series of each sample; collectors report them in the same order every time, so first try the series
+	// at the same position in the previous snapshot, which avoids hashing the names.
+	vector<uint32_t> new_strings;
+	vector<uint32_t> new_series;
+	layout.clear();
+	for (idx_t row = begin; row < end; row++) {
+		const idx_t sample_idx = row - begin;
+		if (sample_idx < last_layout.size()) {
+			const uint32_t candidate = last_layout[sample_idx];
+			const string &key = series_keys[candidate];
+			uint32_t ids[3];
+			memcpy(ids, key.data(), sizeof(ids));
+			if (strings[ids[0]] == batch.sources[row] && strings[ids[1]] == batch.entities[row] &&
+			    strings[ids[2]] == batch.metrics[row]) {
+				layout.emplace_back(candidate);
+				continue;
+			}
+		}
+		const uint32_t source_id = GetStringId(batch.sources[row], new_strings);
+		const uint32_t entity_id = GetStringId(batch.entities[row], new_strings);
+		const uint32_t metric_id = GetStringId(batch.metrics[row], new_strings);
+		auto result = series_ids.emplace(GetSeriesKey(source_id, entity_id, metric_id),
+		                                 static_cast<uint32_t>(series_keys.size()));
+		if (result.second) {
+			new_series.emplace_back(result.first->second);
+			series_keys.emplace_back(result.first->first);
+			last_values.emplace_back(0);
+		}
+		layout.emplace_back(result.first->second);
+	}
+
+	// Timestamp, the first one is encoded relative to the epoch
+	if (sample_count == 0) {
+		first_timestamp = timestamp;
+	}
+	const int64_t delta = timestamp - last_timestamp;
+	WriteVarint(data, ZigZagEncode(delta - last_delta));
+	last_delta = delta;
+	last_timestamp = timestamp;
+
+	// Dictionary additions
+	WriteVarint(data, new_strings.size());
+	for (const auto string_id : new_strings) {
+		const auto &str = strings[string_id];
+		WriteVarint(data, str.size());
+		data.append(str);
+	}
+	WriteVarint(data, new_series.size());
+	for (const auto series_id : new_series) {
+		uint32_t ids[3];
+		memcpy(ids, series_keys[series_id].data(), sizeof(ids));
+		WriteVarint(data, ids[0]);
+		WriteVarint(data, ids[1]);
+		WriteVarint(data, ids[2]);
+	}
+
+	// Samples
+	WriteVarint(data, layout.size());
+	if (layout == last_layout) {
+		data.push_back(1);
+	} else {
+		data.push_back(0);
+		for (const auto series_id : layout) {
+			WriteVarint(data, series_id);
+		}
+		last_layout = layout;
+	}
+	for (idx_t row = begin; row < end; row++) {
+		const uint32_t series_id = layout[row - begin];
+		// Unsigned wrap-around keeps the delta exact for counters anywhere in the uint64 range.
+		const uint64_t value = batch.values[row];
+		WriteVarint(data, ZigZagEncode(static_cast<int64_t>(value - last_values[series_id])));
+		last_values[series_id] = value;
+	}
+	sample_count += end - begin;
+}
+
+SnapshotDecoder::SnapshotDecoder(std::string_view data_p) : data(data_p) {
+	if (data.size() < SNAPSHOT_MAGIC_LENGTH + 1 || data.substr(0, SNAPSHOT_MAGIC_LENGTH) != SNAPSHOT_MAGIC) {
+		throw InvalidInputException("Invalid metric snapshot: missing header");
+	}
+	const uint8_t version = static_cast<uint8_t>(data[SNAPSHOT_MAGIC_LENGTH]);
+	if (version != SNAPSHOT_VERSION) {
+		throw InvalidInputException("Unsupported metric snapshot version %d", static_cast<int32_t>(version));
+	}
+	pos = SNAPSHOT_MAGIC_LENGTH + 1;
+}
+
+uint64_t SnapshotDecoder::ReadVarint() {
+	uint64_t value = 0;
+	for (idx_t shift = 0; shift < 7 * MAX_VARINT_LENGTH; shift += 7) {
+		if (pos >= data.size()) {
+			throw InvalidInputException("Invalid metric snapshot: truncated at offset %llu", pos);
+		}
+		const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return value;
+		}
+	}
+	throw InvalidInputException("Invalid metric snapshot: malformed integer at offset %llu", pos);
+}
+
+uint32_t SnapshotDecoder::ReadId(idx_t limit) {
+	const uint64_t id = ReadVarint();
+	if (id >= limit) {
+		throw InvalidInputException("Invalid metric snapshot: unknown dictionary id %llu at offset %llu", id, pos);
+	}
+	return static_cast<uint32_t>(id);
+}
+
+bool SnapshotDecoder::Next(MetricsBatch &batch) {
+	if (pos >= data.size()) {
+		return false;
+	}
+
+	// Timestamp
+	last_delta += ZigZagDecode(ReadVarint());
+	last_timestamp += last_delta;
+	const timestamp_t timestamp {last_timestamp};
+
+	// Dictionary additions
+	const uint64_t new_string_count = ReadVarint();
+	for (uint64_t idx = 0; idx < new_string_count; idx++) {
+		const uint64_t length = ReadVarint();
+		if (length > data.size() - pos) {
+			throw InvalidInputException("Invalid metric snapshot: truncated at offset %llu", pos);
+		}
+		strings.emplace_back(data.substr(pos, length));
+		pos += length;
+	}
+	const uint64_t new_series_count = ReadVarint();
+	for (uint64_t idx = 0; idx < new_series_count; idx++) {
+		Series new_series;
+		new_series.source = ReadId(strings.size());
+		new_series.entity = ReadId(strings.size());
+		new_series.metric = ReadId(strings.size());
+		series.emplace_back(new_series);
+		last_values.emplace_back(0);
+	}
+
+	// Samples
+	const uint64_t sample_count = ReadVarint();
+	if (pos >= data.size()) {
+		throw InvalidInputException("Invalid metric snapshot: truncated at offset %llu", pos);
+	}
+	const bool same_layout = data[pos++] != 0;
+	if (same_layout) {
+		if (sample_count != layout.size()) {
+			throw InvalidInputException("Invalid metric snapshot: sample count mismatch at offset %llu", pos);
+		}
+	} else {
+		layout.clear();
+		for (uint64_t idx = 0; idx < sample_count; idx++) {
+			layout.emplace_back(ReadId(series.size()));
+		}
+	}
+	for (const auto series_id : layout) {
+		const uint64_t value = last_values[series_id] + static_cast<uint64_t>(ZigZagDecode(ReadVarint()));
+		last_values[series_id] = value;
+		const auto &sample_series = series[series_id];
+		batch.Append(timestamp, strings[sample_series.source], strings[sample_series.entity],
+		             strings[sample_series.metric], value);
+	}
+	return true;
+}
+
+} // namespace duckdb
@@ -0,0 +1,121 @@
+#include "snapshot_codec_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/execution/execution_context.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "snapshot_codec.hpp"
+
+namespace duckdb {
+
+namespace {
+
+struct SysSnapshotDecodeState : public LocalTableFunctionState {
+	// Next row of the input chunk to decode.
+	idx_t input_row = 0;
+	// Copy of the blob being decoded, which the decoder and the decoded names point into.
+	string blob;
+	unique_ptr<SnapshotDecoder> decoder;
+	// Decoded samples of the current snapshot, and the next one to output.
+	MetricsBatch batch;
+	idx_t batch_row = 0;
+};
+
+unique_ptr<FunctionData> SysSnapshotDecodeBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(5);
+	names.reserve(5);
+
+	names.emplace_back("ts");
+	return_types.emplace_back(LogicalType {LogicalTypeId::TIMESTAMP});
+
+	names.emplace_back("source");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("entity");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("metric");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("value");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	return nullptr;
+}
+
+unique_ptr<LocalTableFunctionState> SysSnapshotDecodeInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                               GlobalTableFunctionState *global_state) {
+	return make_uniq<SysSnapshotDecodeState>();
+}
+
+// Decode the blobs of the input chunk one snapshot at a time, so a long recording is never fully materialized.
+OperatorResultType SysSnapshotDecodeFunc(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+                                         DataChunk &output) {
+	auto &state = data_p.local_state->Cast<SysSnapshotDecodeState>();
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+	while (output_count < STANDARD_VECTOR_SIZE) {
+		if (state.batch_row < state.batch.Size()) {
+			const idx_t row = state.batch_row++;
+			col_idx = 0;
+
+			// ts
+			output.SetValue(col_idx++, output_count, Value::TIMESTAMP(state.batch.timestamps[row]));
+
+			// source
+			output.SetValue(col_idx++, output_count, Value(string {state.batch.sources[row]}));
+
+			// entity, NULL for host-wide metrics
+			const auto &entity = state.batch.entities[row];
+			output.SetValue(col_idx++, output_count, entity.empty() ? Value(LogicalType::VARCHAR) : Value(entity));
+
+			// metric
+			output.SetValue(col_idx++, output_count, Value(string {state.batch.metrics[row]}));
+
+			// value
+			output.SetValue(col_idx++, output_count, Value::UBIGINT(state.batch.values[row]));
+
+			output_count++;
+			continue;
+		}
+
+		state.batch.Clear();
+		state.batch_row = 0;
+		if (state.decoder && state.decoder->Next(state.batch)) {
+			continue;
+		}
+		state.decoder.reset();
+
+		if (state.input_row >= input.size()) {
+			state.input_row = 0;
+			output.SetCardinality(output_count);
+			return OperatorResultType::NEED_MORE_INPUT;
+		}
+		const Value blob = input.GetValue(0, state.input_row++);
+		if (blob.IsNull()) {
+			continue;
+		}
+		state.blob = StringValue::Get(blob);
+		state.decoder = make_uniq<SnapshotDecoder>(state.blob);
+	}
+
+	output.SetCardinality(output_count);
+	return OperatorResultType::HAVE_MORE_OUTPUT;
+}
+
+} // namespace
+
+void RegisterSysSnapshotDecodeFunction(ExtensionLoader &loader) {
+	TableFunction sys_snapshot_decode_func("sys_snapshot_decode", {LogicalType::BLOB}, nullptr, SysSnapshotDecodeBind,
+	                                       nullptr, SysSnapshotDecodeInitLocal);
+	sys_snapshot_decode_func.in_out_function = SysSnapshotDecodeFunc;
+	loader.RegisterFunction(sys_snapshot_decode_func);
+}
+
+} // namespace duckdb
@@ -2,14 +2,33 @@
 
 #include "system_stats_extension.hpp"
 
+#include "block_devices_query_function.hpp"
 #include "cpu_stats_query_function.hpp"
 #include "database_instance_cache.hpp"
+#include "disk_probe_query_function.hpp"
 #include "disk_stats_query_function.hpp"
 #include "duckdb.hpp"
+#include "duckdb_resources_query_function.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "interrupt_stats_query_function.hpp"
+#include "memory_benchmark_query_function.hpp"
 #include "memory_stats_query_function.hpp"
+#include "metrics_recorder_query_function.hpp"
+#include "mount_filter.hpp"
+#include "net_protocol_stats_query_function.hpp"
+#include "network_rates_query_function.hpp"
 #include "network_stats_query_function.hpp"
+#include "openmetrics_query_function.hpp"
 #include "os_info_query_function.hpp"
+#include "page_cache_query_function.hpp"
+#include "process_events_query_function.hpp"
+#include "process_memory_query_function.hpp"
+#include "process_tracker_query_function.hpp"
+#include "shared_metrics.hpp"
+#include "shared_metrics_query_function.hpp"
+#include "snapshot_codec_query_function.hpp"
+#include "thread_pinning_query_function.hpp"
+#include "thread_stats_query_function.hpp"
 
 namespace duckdb {
 
@@ -23,11 +42,34 @@ void LoadInternal(ExtensionLoader &loader) {
 	auto entry = make_shared_ptr<DatabaseInstanceCacheEntry>(db_shared);
 	cache.Put(DatabaseInstanceCacheEntry::ObjectType(), std::move(entry));
 
+	RegisterMountFilterOptions(db);
+	RegisterSharedMetricsOptions(db);
+
 	RegisterSysMemoryInfoFunction(loader);
+	RegisterSysMemoryBenchmarkFunction(loader);
 	RegisterSysCPUInfoFunction(loader);
 	RegisterSysDiskInfoFunction(loader);
+	RegisterSysBlockDevicesFunction(loader);
+	RegisterSysDiskProbeFunction(loader);
 	RegisterSysNetworkInfoFunction(loader);
+	RegisterSysNetworkRatesFunction(loader);
+	RegisterSysNetProtocolStatsFunction(loader);
+	RegisterSysSoftnetStatsFunction(loader);
 	RegisterSysOSInfoFunction(loader);
+	RegisterSysThreadsFunction(loader);
+	RegisterSysPinThreadsFunction(loader);
+	RegisterSysInterruptsFunction(loader);
+	RegisterSysProcessMemoryFunction(loader);
+	RegisterSysProcessTopFunction(loader);
+	RegisterSysProcessEventsFunctions(loader);
+	RegisterSysPageCacheFunction(loader);
+	RegisterSysSharedMetricsFunctions(loader);
+	RegisterSysDuckDBResourcesFunction(loader);
+	RegisterSysMetricsOpenMetricsFunction(loader);
+	RegisterSysWriteMetricsFunction(loader);
+	RegisterSysRecorderFunctions(loader);
+	RegisterSysRecordedFunction(loader);
+	RegisterSysSnapshotDecodeFunction(loader);
 
 	// Set description for the extension
 	loader.SetDescription(
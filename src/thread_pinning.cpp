@@ -0,0 +1,358 @@
+#include "thread_pinning.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+#include "interrupt_stats.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+vector<int32_t> GetCpuIds(const vector<CpuTopologyInfo> &cpus) {
+	vector<int32_t> ids;
+	ids.reserve(cpus.size());
+	for (const auto &cpu : cpus) {
+		ids.emplace_back(cpu.cpu);
+	}
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+// Order of the CPUs under COMPACT: hardware threads of a core are adjacent, then cores of a package, then packages
+// of a node.
+vector<CpuTopologyInfo> GetCompactOrder(vector<CpuTopologyInfo> cpus) {
+	std::sort(cpus.begin(), cpus.end(), [](const CpuTopologyInfo &lhs, const CpuTopologyInfo &rhs) {
+		return std::tie(lhs.node, lhs.package, lhs.core, lhs.cpu) < std::tie(rhs.node, rhs.package, rhs.core, rhs.cpu);
+	});
+	return cpus;
+}
+
+// Order of the CPUs under SCATTER: the first hardware thread of every core before any second one, and within each,
+// one CPU of every package of every node in turn.
+vector<CpuTopologyInfo> GetScatterOrder(const vector<CpuTopologyInfo> &cpus) {
+	struct ScatterKey {
+		// Hardware thread within the core.
+		idx_t thread;
+		// Position among CPUs of the same package and node with the same [thread].
+		idx_t position;
+		// Package and node, numbered in compact order.
+		idx_t domain;
+		CpuTopologyInfo cpu;
+	};
+	const auto compact = GetCompactOrder(cpus);
+	vector<ScatterKey> keys;
+	keys.reserve(compact.size());
+	idx_t domain = 0;
+	for (idx_t idx = 0; idx < compact.size(); idx++) {
+		const auto &cpu = compact[idx];
+		ScatterKey key {0, 0, domain, cpu};
+		if (idx > 0) {
+			const auto &prev = keys.back();
+			if (prev.cpu.node != cpu.node || prev.cpu.package != cpu.package) {
+				key.domain = ++domain;
+			} else if (prev.cpu.core == cpu.core) {
+				key.thread = prev.thread + 1;
+			}
+		}
+		keys.emplace_back(key);
+	}
+	// Number the CPUs of each domain and hardware thread, i.e. the first threads of the cores of a package.
+	std::stable_sort(keys.begin(), keys.end(), [](const ScatterKey &lhs, const ScatterKey &rhs) {
+		return std::tie(lhs.domain, lhs.thread) < std::tie(rhs.domain, rhs.thread);
+	});
+	for (idx_t idx = 1; idx < keys.size(); idx++) {
+		const auto &prev = keys[idx - 1];
+		if (prev.domain == keys[idx].domain && prev.thread == keys[idx].thread) {
+			keys[idx].position = prev.position + 1;
+		}
+	}
+	std::stable_sort(keys.begin(), keys.end(), [](const ScatterKey &lhs, const ScatterKey &rhs) {
+		return std::tie(lhs.thread, lhs.position, lhs.domain) < std::tie(rhs.thread, rhs.position, rhs.domain);
+	});
+	vector<CpuTopologyInfo> order;
+	order.reserve(keys.size());
+	for (const auto &key : keys) {
+		order.emplace_back(key.cpu);
+	}
+	return order;
+}
+
+// Get the [id] shared by all of [cpus] in [topology], or -1 if they differ.
+int32_t GetSharedId(const vector<CpuTopologyInfo> &topology, const vector<int32_t> &cpus,
+                    int32_t CpuTopologyInfo::*id) {
+	int32_t shared = -1;
+	for (const auto &cpu : topology) {
+		if (!std::binary_search(cpus.begin(), cpus.end(), cpu.cpu)) {
+			continue;
+		}
+		if (shared == -1) {
+			shared = cpu.*id;
+		} else if (shared != cpu.*id) {
+			return -1;
+		}
+	}
+	return shared;
+}
+
+// Assign one CPU per worker in [order], starting over once every CPU has a worker.
+vector<vector<int32_t>> AssignInOrder(const vector<CpuTopologyInfo> &order, idx_t worker_count) {
+	vector<vector<int32_t>> assignments;
+	assignments.reserve(worker_count);
+	for (idx_t worker = 0; worker < worker_count; worker++) {
+		assignments.push_back({order[worker % order.size()].cpu});
+	}
+	return assignments;
+}
+
+#ifdef __linux__
+// Time the caller waits for every worker to pick up a discovery task.
+constexpr auto WORKER_DISCOVERY_TIMEOUT = std::chrono::seconds(1);
+
+// Thread ids of the task scheduler workers, shared between the caller and the discovery tasks.
+struct WorkerDiscovery {
+	mutex mu;
+	std::condition_variable cv;
+	vector<int32_t> tids;
+	// Set once the caller stops waiting; tasks picked up afterwards finish right away.
+	bool released = false;
+};
+
+// Records the thread id of the worker running it, then blocks until the caller is done waiting, so every worker runs
+// at most one of the tasks.
+class WorkerDiscoveryTask : public Task {
+public:
+	explicit WorkerDiscoveryTask(shared_ptr<WorkerDiscovery> discovery_p) : discovery(std::move(discovery_p)) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		std::unique_lock<mutex> lock(discovery->mu);
+		if (discovery->released) {
+			return TaskExecutionResult::TASK_FINISHED;
+		}
+		discovery->tids.emplace_back(static_cast<int32_t>(syscall(SYS_gettid)));
+		discovery->cv.notify_all();
+		discovery->cv.wait(lock, [&] { return discovery->released; });
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+private:
+	shared_ptr<WorkerDiscovery> discovery;
+};
+
+// Get the thread ids of the task scheduler workers of [db] which are idle or pick up a task within the timeout.
+vector<int32_t> DiscoverWorkerThreads(DatabaseInstance &db) {
+	auto &scheduler = TaskScheduler::GetScheduler(db);
+	// Threads of the scheduler include the external ones running queries, which never pick up scheduled tasks.
+	const int64_t worker_count = static_cast<int64_t>(scheduler.NumberOfThreads()) -
+	                             static_cast<int64_t>(DBConfig::GetConfig(db).options.external_threads);
+	if (worker_count <= 0) {
+		return {};
+	}
+
+	auto discovery = make_shared_ptr<WorkerDiscovery>();
+	auto producer = scheduler.CreateProducer();
+	for (int64_t idx = 0; idx < worker_count; idx++) {
+		scheduler.ScheduleTask(*producer, make_shared_ptr<WorkerDiscoveryTask>(discovery));
+	}
+
+	vector<int32_t> tids;
+	{
+		std::unique_lock<mutex> lock(discovery->mu);
+		discovery->cv.wait_for(lock, WORKER_DISCOVERY_TIMEOUT, [&] {
+			return static_cast<int64_t>(discovery->tids.size()) >= worker_count;
+		});
+		discovery->released = true;
+		tids = discovery->tids;
+	}
+	discovery->cv.notify_all();
+
+	if (static_cast<int64_t>(tids.size()) < worker_count) {
+		DUCKDB_LOG_DEBUG(db, "Only %llu of %lld task scheduler workers were idle, the others are not pinned",
+		                 static_cast<unsigned long long>(tids.size()), static_cast<long long>(worker_count));
+	}
+	std::sort(tids.begin(), tids.end());
+	return tids;
+}
+
+// Read the CPU list at [path] into [cpus]; false if it cannot be read or parsed.
+bool ReadIrqCpuList(const char *path, vector<int32_t> &cpus) {
+	std::array<char, 4096> buf;
+	const std::string_view content = ReadFileAt(AT_FDCWD, path, buf);
+	return !content.empty() && ParseCpuList(content, cpus);
+}
+
+// Serializes pinning, since concurrent calls would split the workers between their discovery tasks.
+mutex pin_mutex;
+#endif
+
+} // namespace
+
+ThreadPinPolicy ParseThreadPinPolicy(const string &policy) {
+	const string lower = StringUtil::Lower(policy);
+	if (lower == "none") {
+		return ThreadPinPolicy::NONE;
+	}
+	if (lower == "compact") {
+		return ThreadPinPolicy::COMPACT;
+	}
+	if (lower == "scatter") {
+		return ThreadPinPolicy::SCATTER;
+	}
+	if (lower == "numa_local") {
+		return ThreadPinPolicy::NUMA_LOCAL;
+	}
+	if (lower == "avoid_irq_cpus") {
+		return ThreadPinPolicy::AVOID_IRQ_CPUS;
+	}
+	throw InvalidInputException("Unknown policy '%s' for sys_pin_threads, expected 'compact', 'scatter', "
+	                            "'numa_local', 'avoid_irq_cpus' or 'none'",
+	                            policy);
+}
+
+const char *ThreadPinPolicyToString(ThreadPinPolicy policy) {
+	switch (policy) {
+	case ThreadPinPolicy::NONE:
+		return "none";
+	case ThreadPinPolicy::COMPACT:
+		return "compact";
+	case ThreadPinPolicy::SCATTER:
+		return "scatter";
+	case ThreadPinPolicy::NUMA_LOCAL:
+		return "numa_local";
+	case ThreadPinPolicy::AVOID_IRQ_CPUS:
+		return "avoid_irq_cpus";
+	}
+	return "unknown";
+}
+
+vector<vector<int32_t>> AssignWorkerCpus(ThreadPinPolicy policy, const vector<CpuTopologyInfo> &cpus,
+                                         const vector<int32_t> &irq_cpus, idx_t worker_count) {
+	if (cpus.empty() || worker_count == 0) {
+		return vector<vector<int32_t>>(worker_count);
+	}
+	const vector<int32_t> all_cpus = GetCpuIds(cpus);
+	switch (policy) {
+	case ThreadPinPolicy::COMPACT:
+		return AssignInOrder(GetCompactOrder(cpus), worker_count);
+	case ThreadPinPolicy::SCATTER:
+		return AssignInOrder(GetScatterOrder(cpus), worker_count);
+	case ThreadPinPolicy::NUMA_LOCAL: {
+		// Spreading workers evenly over the CPUs in compact order gives every node a share matching its CPUs.
+		const auto order = GetCompactOrder(cpus);
+		vector<vector<int32_t>> assignments;
+		assignments.reserve(worker_count);
+		for (idx_t worker = 0; worker < worker_count; worker++) {
+			const int32_t node = order[worker * order.size() / worker_count].node;
+			vector<int32_t> node_cpus;
+			for (const auto &cpu : order) {
+				if (cpu.node == node) {
+					node_cpus.emplace_back(cpu.cpu);
+				}
+			}
+			std::sort(node_cpus.begin(), node_cpus.end());
+			assignments.emplace_back(std::move(node_cpus));
+		}
+		return assignments;
+	}
+	case ThreadPinPolicy::AVOID_IRQ_CPUS: {
+		vector<int32_t> quiet_cpus;
+		std::set_difference(all_cpus.begin(), all_cpus.end(), irq_cpus.begin(), irq_cpus.end(),
+		                    std::back_inserter(quiet_cpus));
+		return vector<vector<int32_t>>(worker_count, quiet_cpus.empty() ? all_cpus : quiet_cpus);
+	}
+	case ThreadPinPolicy::NONE:
+		break;
+	}
+	return vector<vector<int32_t>>(worker_count, all_cpus);
+}
+
+vector<int32_t> GetInterruptCpus(ClientContext &context) {
+	vector<int32_t> irq_cpus;
+#ifdef __linux__
+	const auto stats = GetInterruptStats(context, 0, false);
+	std::array<char, 64> path;
+	vector<int32_t> cpus;
+	for (const auto &source : stats.hardirqs.sources) {
+		// Named interrupts, i.e. "LOC" or "RES", are raised on every CPU and not routed to devices.
+		uint32_t irq = 0;
+		if (!ParseInteger(source.irq, irq)) {
+			continue;
+		}
+		uint64_t total = 0;
+		for (idx_t idx = 0; idx < source.count_size; idx++) {
+			total += stats.hardirqs.counts[source.count_offset + idx];
+		}
+		if (total == 0) {
+			continue;
+		}
+		// The effective affinity is where the interrupt controller delivers the interrupt; it is a subset of the
+		// configured affinity and missing before Linux 4.15.
+		snprintf(path.data(), path.size(), "/proc/irq/%u/effective_affinity_list", irq);
+		if (!ReadIrqCpuList(path.data(), cpus) || cpus.empty()) {
+			snprintf(path.data(), path.size(), "/proc/irq/%u/smp_affinity_list", irq);
+			if (!ReadIrqCpuList(path.data(), cpus)) {
+				continue;
+			}
+		}
+		irq_cpus.insert(irq_cpus.end(), cpus.begin(), cpus.end());
+	}
+	std::sort(irq_cpus.begin(), irq_cpus.end());
+	irq_cpus.erase(std::unique(irq_cpus.begin(), irq_cpus.end()), irq_cpus.end());
+#endif
+	return irq_cpus;
+}
+
+vector<PinnedThreadInfo> PinWorkerThreads(ClientContext &context, ThreadPinPolicy policy) {
+#ifdef __linux__
+	lock_guard<mutex> lock(pin_mutex);
+	auto db = GetDbInstance(context);
+	const auto topology = GetCpuTopology();
+	const auto irq_cpus = policy == ThreadPinPolicy::AVOID_IRQ_CPUS ? GetInterruptCpus(context) : vector<int32_t> {};
+	const auto tids = DiscoverWorkerThreads(*db);
+	const auto assignments = AssignWorkerCpus(policy, topology, irq_cpus, tids.size());
+
+	vector<PinnedThreadInfo> threads;
+	threads.reserve(tids.size());
+	for (idx_t idx = 0; idx < tids.size(); idx++) {
+		PinnedThreadInfo thread;
+		thread.tid = tids[idx];
+		thread.cpus = assignments[idx];
+		GetThreadAffinity(thread.tid, thread.previous_cpus);
+		thread.node = GetSharedId(topology, thread.cpus, &CpuTopologyInfo::node);
+		thread.package = GetSharedId(topology, thread.cpus, &CpuTopologyInfo::package);
+		if (!SetThreadAffinity(thread.tid, thread.cpus)) {
+			thread.error = strerror(errno);
+			DUCKDB_LOG_DEBUG(*db, "Failed to set affinity of thread %d: %s", thread.tid, thread.error.c_str());
+		}
+		threads.emplace_back(std::move(thread));
+	}
+	return threads;
+#else
+	throw NotImplementedException("Pinning worker threads is not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,160 @@
+#include "thread_pinning_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "thread_pinning.hpp"
+
+namespace duckdb {
+
+namespace {
+
+Value GetCpuListValue(const vector<int32_t> &cpus) {
+	vector<Value> cpu_values;
+	cpu_values.reserve(cpus.size());
+	for (const auto cpu : cpus) {
+		cpu_values.emplace_back(Value::INTEGER(cpu));
+	}
+	return Value::LIST(LogicalType::INTEGER, std::move(cpu_values));
+}
+
+Value NullIfNegative(int32_t id) {
+	return id < 0 ? Value(LogicalType::INTEGER) : Value::INTEGER(id);
+}
+
+struct SysPinThreadsBindData : public FunctionData {
+	ThreadPinPolicy policy = ThreadPinPolicy::NONE;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysPinThreadsBindData>();
+		return policy == other.policy;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysPinThreadsBindData>();
+		result->policy = policy;
+		return std::move(result);
+	}
+};
+
+struct SysPinThreadsData : public GlobalTableFunctionState {
+	SysPinThreadsData(ClientContext &context, const SysPinThreadsBindData &bind_data)
+	    : finished(false), current_index(0), threads(PinWorkerThreads(context, bind_data.policy)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<PinnedThreadInfo> threads;
+};
+
+unique_ptr<FunctionData> SysPinThreadsBind(ClientContext &context, TableFunctionBindInput &input,
+                                           vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(8);
+	names.reserve(8);
+
+	// Parse policy parameter, which has no default since pinning changes how every later query runs
+	auto result = make_uniq<SysPinThreadsBindData>();
+	auto policy_it = input.named_parameters.find("policy");
+	if (policy_it == input.named_parameters.end() || policy_it->second.IsNull()) {
+		throw InvalidInputException("sys_pin_threads requires a policy, i.e. policy='compact'");
+	}
+	result->policy = ParseThreadPinPolicy(policy_it->second.ToString());
+
+	names.emplace_back("policy");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("tid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+
+	names.emplace_back("cpus");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::INTEGER));
+
+	names.emplace_back("node");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("package");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("previous_cpus");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::INTEGER));
+
+	names.emplace_back("pinned");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+
+	names.emplace_back("error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysPinThreadsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysPinThreadsBindData>();
+	return make_uniq<SysPinThreadsData>(context, bind_data);
+}
+
+void SysPinThreadsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<SysPinThreadsBindData>();
+	auto &data = data_p.global_state->Cast<SysPinThreadsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.threads.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &thread = data.threads[data.current_index];
+		col_idx = 0;
+
+		// policy
+		output.SetValue(col_idx++, output_count, Value(ThreadPinPolicyToString(bind_data.policy)));
+
+		// tid
+		output.SetValue(col_idx++, output_count, Value::BIGINT(thread.tid));
+
+		// cpus
+		output.SetValue(col_idx++, output_count, GetCpuListValue(thread.cpus));
+
+		// node
+		output.SetValue(col_idx++, output_count, NullIfNegative(thread.node));
+
+		// package
+		output.SetValue(col_idx++, output_count, NullIfNegative(thread.package));
+
+		// previous_cpus
+		output.SetValue(col_idx++, output_count, GetCpuListValue(thread.previous_cpus));
+
+		// pinned
+		output.SetValue(col_idx++, output_count, Value::BOOLEAN(thread.error.empty()));
+
+		// error
+		output.SetValue(col_idx++, output_count,
+		                thread.error.empty() ? Value(LogicalType::VARCHAR) : Value(thread.error));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.threads.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysPinThreadsFunction(ExtensionLoader &loader) {
+	TableFunction sys_pin_threads_func("sys_pin_threads", {}, SysPinThreadsFunc, SysPinThreadsBind,
+	                                   SysPinThreadsInit);
+	sys_pin_threads_func.named_parameters["policy"] = LogicalType::VARCHAR;
+	loader.RegisterFunction(sys_pin_threads_func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,249 @@
+#include "thread_stats.hpp"
+
+#include "database_instance_cache.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "proc_tokenizer.hpp"
+#include "proc_walker.hpp"
+#include "time_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+namespace {
+
+// Min number of threads per worker to walk /proc/[pid]/task in parallel; below that, spawning workers costs more
+// than reading the files.
+constexpr idx_t MIN_THREADS_PER_WORKER = 128;
+// Max number of workers to walk /proc/[pid]/task.
+constexpr idx_t MAX_WORKERS = 8;
+
+#ifdef __linux__
+// Read statistics of one thread from [task_fd], the open /proc/[pid]/task directory; return false if the thread has
+// exited.
+bool ReadThreadInfo(int task_fd, int32_t tid, double ticks_per_second, ThreadInfo &info) {
+	std::array<char, 4096> buf;
+	std::array<char, 32> path;
+
+	snprintf(path.data(), path.size(), "%d/stat", tid);
+	TaskStat task_stat;
+	if (!ParseTaskStat(ReadFileAt(task_fd, path.data(), buf), task_stat)) {
+		return false;
+	}
+	info.tid = tid;
+	info.name = std::move(task_stat.name);
+	info.state = string(1, task_stat.state);
+	info.cpu = task_stat.processor;
+	info.utime_seconds = static_cast<double>(task_stat.utime_ticks) / ticks_per_second;
+	info.stime_seconds = static_cast<double>(task_stat.stime_ticks) / ticks_per_second;
+
+	snprintf(path.data(), path.size(), "%d/status", tid);
+	ParseContextSwitches(ReadFileAt(task_fd, path.data(), buf), info.voluntary_ctxt_switches,
+	                     info.nonvoluntary_ctxt_switches);
+
+	// schedstat is only available with CONFIG_SCHED_INFO.
+	snprintf(path.data(), path.size(), "%d/schedstat", tid);
+	SchedStat sched_stat;
+	if (ParseSchedStat(ReadFileAt(task_fd, path.data(), buf), sched_stat)) {
+		info.run_time_ns = sched_stat.run_time_ns;
+		info.wait_time_ns = sched_stat.wait_time_ns;
+		info.timeslices = sched_stat.timeslices;
+	}
+	return true;
+}
+
+// Take one sample of all threads of [pid], reading threads in parallel for large processes.
+vector<ThreadInfo> SampleThreads(ClientContext &context, int32_t pid) {
+	std::array<char, 32> task_path;
+	snprintf(task_path.data(), task_path.size(), "/proc/%d/task", pid);
+	ProcDirectory task_dir(task_path.data());
+	if (!task_dir.IsOpen()) {
+		if (auto db = GetDbInstance(context)) {
+			DUCKDB_LOG_DEBUG(*db, "Failed to open %s: %s", task_path.data(), strerror(errno));
+		}
+		return {};
+	}
+	vector<int32_t> tids;
+	int32_t tid = 0;
+	while (task_dir.Next(tid)) {
+		tids.emplace_back(tid);
+	}
+	const double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+	vector<ThreadInfo> infos(tids.size());
+	// One byte per thread rather than vector<bool>, whose packed bits would be written concurrently by the workers.
+	vector<uint8_t> alive(tids.size(), 0);
+	auto read_range = [&](idx_t begin, idx_t end) {
+		for (idx_t idx = begin; idx < end; idx++) {
+			alive[idx] = ReadThreadInfo(task_dir.GetFd(), tids[idx], ticks_per_second, infos[idx]);
+		}
+	};
+
+	const idx_t hardware_threads = std::max<idx_t>(std::thread::hardware_concurrency(), 1);
+	const idx_t worker_count = std::min({MAX_WORKERS, hardware_threads, tids.size() / MIN_THREADS_PER_WORKER});
+	if (worker_count <= 1) {
+		read_range(0, tids.size());
+	} else {
+		// Each worker owns a disjoint range, so no synchronization is needed besides join.
+		vector<std::thread> workers;
+		workers.reserve(worker_count);
+		const idx_t range_size = (tids.size() + worker_count - 1) / worker_count;
+		for (idx_t begin = 0; begin < tids.size(); begin += range_size) {
+			workers.emplace_back(read_range, begin, std::min<idx_t>(begin + range_size, tids.size()));
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+	}
+
+	// Drop threads exited during the walk.
+	vector<ThreadInfo> result;
+	result.reserve(infos.size());
+	for (idx_t idx = 0; idx < infos.size(); idx++) {
+		if (alive[idx]) {
+			result.emplace_back(std::move(infos[idx]));
+		}
+	}
+	return result;
+}
+#endif
+
+} // namespace
+
+bool ParseTaskStat(std::string_view content, TaskStat &stat) {
+	std::string_view name;
+	std::string_view fields;
+	if (!SplitProcStat(content, name, fields)) {
+		return false;
+	}
+	stat.name = string {name};
+
+	// Fields after name, 0-indexed from state (field 3 in proc(5)).
+	static constexpr size_t STATE_IDX = 0;
+	static constexpr size_t UTIME_IDX = 11;
+	static constexpr size_t STIME_IDX = 12;
+	static constexpr size_t PROCESSOR_IDX = 36;
+
+	std::array<std::string_view, PROCESSOR_IDX + 1> tokens;
+	const idx_t token_count = SplitTokens(fields, tokens.data(), tokens.size());
+	if (token_count <= STATE_IDX) {
+		return false;
+	}
+	stat.state = tokens[STATE_IDX][0];
+	if (token_count > UTIME_IDX) {
+		ParseInteger(tokens[UTIME_IDX], stat.utime_ticks);
+	}
+	if (token_count > STIME_IDX) {
+		ParseInteger(tokens[STIME_IDX], stat.stime_ticks);
+	}
+	if (token_count > PROCESSOR_IDX) {
+		ParseInteger(tokens[PROCESSOR_IDX], stat.processor);
+	}
+	return true;
+}
+
+bool ParseSchedStat(std::string_view content, SchedStat &stat) {
+	size_t pos = 0;
+	std::string_view token;
+	if (!NextToken(content, pos, token) || !ParseInteger(token, stat.run_time_ns)) {
+		return false;
+	}
+	if (!NextToken(content, pos, token) || !ParseInteger(token, stat.wait_time_ns)) {
+		return false;
+	}
+	if (!NextToken(content, pos, token) || !ParseInteger(token, stat.timeslices)) {
+		return false;
+	}
+	return true;
+}
+
+void ParseContextSwitches(std::string_view content, uint64_t &voluntary, uint64_t &nonvoluntary) {
+	static constexpr std::string_view VOLUNTARY_PREFIX = "voluntary_ctxt_switches:";
+	static constexpr std::string_view NONVOLUNTARY_PREFIX = "nonvoluntary_ctxt_switches:";
+
+	size_t pos = 0;
+	std::string_view line;
+	while (NextLine(content, pos, line)) {
+		std::string_view value;
+		uint64_t *target = nullptr;
+		if (line.substr(0, VOLUNTARY_PREFIX.size()) == VOLUNTARY_PREFIX) {
+			value = line.substr(VOLUNTARY_PREFIX.size());
+			target = &voluntary;
+		} else if (line.substr(0, NONVOLUNTARY_PREFIX.size()) == NONVOLUNTARY_PREFIX) {
+			value = line.substr(NONVOLUNTARY_PREFIX.size());
+			target = &nonvoluntary;
+		} else {
+			continue;
+		}
+		size_t value_pos = 0;
+		std::string_view token;
+		if (NextToken(value, value_pos, token)) {
+			ParseInteger(token, *target);
+		}
+	}
+}
+
+void ComputeThreadRates(const vector<ThreadInfo> &before, vector<ThreadInfo> &after, uint64_t interval_ns) {
+	if (interval_ns == 0) {
+		return;
+	}
+	unordered_map<int32_t, const ThreadInfo *> before_by_tid;
+	before_by_tid.reserve(before.size());
+	for (const auto &info : before) {
+		before_by_tid.emplace(info.tid, &info);
+	}
+
+	const double interval = static_cast<double>(interval_ns);
+	for (auto &info : after) {
+		auto iter = before_by_tid.find(info.tid);
+		if (iter == before_by_tid.end()) {
+			continue;
+		}
+		const auto &prev = *iter->second;
+		// A reused tid could have smaller counters, skip instead of reporting bogus rates.
+		if (info.run_time_ns < prev.run_time_ns || info.wait_time_ns < prev.wait_time_ns) {
+			continue;
+		}
+		info.has_rates = true;
+		info.cpu_pct = static_cast<double>(info.run_time_ns - prev.run_time_ns) / interval * 100;
+		info.wait_pct = static_cast<double>(info.wait_time_ns - prev.wait_time_ns) / interval * 100;
+	}
+}
+
+vector<ThreadInfo> GetThreadInfo(ClientContext &context, int32_t pid, int64_t interval_micros) {
+#ifdef __linux__
+	if (pid == 0) {
+		pid = static_cast<int32_t>(getpid());
+	}
+	if (interval_micros <= 0) {
+		return SampleThreads(context, pid);
+	}
+	const uint64_t before_ns = GetMonotonicTimestampNs();
+	auto before = SampleThreads(context, pid);
+	std::this_thread::sleep_for(std::chrono::microseconds(interval_micros));
+	const uint64_t after_ns = GetMonotonicTimestampNs();
+	auto after = SampleThreads(context, pid);
+	ComputeThreadRates(before, after, after_ns - before_ns);
+	return after;
+#elif __APPLE__
+	// procfs is not available on macOS.
+	return {};
+#else
+	throw NotImplementedException("Thread statistics are not supported on this platform");
+#endif
+}
+
+} // namespace duckdb
@@ -0,0 +1,200 @@
+#include "thread_stats_query_function.hpp"
+
+#include "duckdb/common/assert.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/vector_size.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "thread_stats.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Threads are sampled twice, sleeping for the whole interval in between, which cannot be interrupted.
+constexpr int64_t MAX_INTERVAL_MICROS = 60 * Interval::MICROS_PER_SEC;
+
+struct SysThreadsBindData : public FunctionData {
+	// 0 refers to the current process.
+	int32_t pid = 0;
+	// No sampling interval by default, so CPU and wait percentage are NULL.
+	int64_t interval_micros = 0;
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SysThreadsBindData>();
+		return pid == other.pid && interval_micros == other.interval_micros;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		auto result = make_uniq<SysThreadsBindData>();
+		result->pid = pid;
+		result->interval_micros = interval_micros;
+		return std::move(result);
+	}
+};
+
+struct SysThreadsData : public GlobalTableFunctionState {
+	SysThreadsData(ClientContext &context, int32_t pid, int64_t interval_micros)
+	    : finished(false), current_index(0), threads(GetThreadInfo(context, pid, interval_micros)) {
+	}
+	bool finished;
+	size_t current_index;
+	vector<ThreadInfo> threads;
+};
+
+unique_ptr<FunctionData> SysThreadsBind(ClientContext &context, TableFunctionBindInput &input,
+                                        vector<LogicalType> &return_types, vector<string> &names) {
+	D_ASSERT(return_types.empty());
+	D_ASSERT(names.empty());
+	return_types.reserve(13);
+	names.reserve(13);
+
+	auto result = make_uniq<SysThreadsBindData>();
+
+	// Parse pid parameter if provided
+	auto pid_it = input.named_parameters.find("pid");
+	if (pid_it != input.named_parameters.end()) {
+		result->pid = pid_it->second.GetValue<int32_t>();
+		if (result->pid <= 0) {
+			throw InvalidInputException("Process id for sys_threads must be positive, but got '%s'",
+			                            pid_it->second.ToString());
+		}
+	}
+
+	// Parse interval parameter if provided
+	auto interval_it = input.named_parameters.find("interval");
+	if (interval_it != input.named_parameters.end()) {
+		result->interval_micros = Interval::GetMicro(interval_it->second.GetValue<interval_t>());
+		if (result->interval_micros <= 0 || result->interval_micros > MAX_INTERVAL_MICROS) {
+			throw InvalidInputException(
+			    "Sampling interval for sys_threads must be positive and at most 60 seconds, but got '%s'",
+			    interval_it->second.ToString());
+		}
+	}
+
+	names.emplace_back("tid");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("name");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("state");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+
+	names.emplace_back("cpu");
+	return_types.emplace_back(LogicalType {LogicalTypeId::INTEGER});
+
+	names.emplace_back("utime_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("stime_seconds");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("voluntary_ctxt_switches");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("nonvoluntary_ctxt_switches");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("run_time_ns");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("wait_time_ns");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("timeslices");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+
+	names.emplace_back("cpu_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	names.emplace_back("wait_pct");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+
+	return std::move(result);
+}
+
+unique_ptr<GlobalTableFunctionState> SysThreadsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SysThreadsBindData>();
+	return make_uniq<SysThreadsData>(context, bind_data.pid, bind_data.interval_micros);
+}
+
+void SysThreadsFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<SysThreadsData>();
+
+	if (data.finished) {
+		return;
+	}
+
+	idx_t output_count = 0;
+	idx_t col_idx = 0;
+
+	// Output rows in batches
+	while (data.current_index < data.threads.size() && output_count < STANDARD_VECTOR_SIZE) {
+		const auto &thread = data.threads[data.current_index];
+		col_idx = 0;
+
+		// tid
+		output.SetValue(col_idx++, output_count, Value::INTEGER(thread.tid));
+
+		// name
+		output.SetValue(col_idx++, output_count, Value(thread.name));
+
+		// state
+		output.SetValue(col_idx++, output_count, Value(thread.state));
+
+		// cpu
+		output.SetValue(col_idx++, output_count, Value::INTEGER(thread.cpu));
+
+		// utime_seconds
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(thread.utime_seconds));
+
+		// stime_seconds
+		output.SetValue(col_idx++, output_count, Value::DOUBLE(thread.stime_seconds));
+
+		// voluntary_ctxt_switches
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(thread.voluntary_ctxt_switches));
+
+		// nonvoluntary_ctxt_switches
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(thread.nonvoluntary_ctxt_switches));
+
+		// run_time_ns
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(thread.run_time_ns));
+
+		// wait_time_ns
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(thread.wait_time_ns));
+
+		// timeslices
+		output.SetValue(col_idx++, output_count, Value::UBIGINT(thread.timeslices));
+
+		// cpu_pct, NULL without sampling interval
+		output.SetValue(col_idx++, output_count,
+		                thread.has_rates ? Value::DOUBLE(thread.cpu_pct) : Value(LogicalType::DOUBLE));
+
+		// wait_pct, NULL without sampling interval
+		output.SetValue(col_idx++, output_count,
+		                thread.has_rates ? Value::DOUBLE(thread.wait_pct) : Value(LogicalType::DOUBLE));
+
+		data.current_index++;
+		output_count++;
+	}
+
+	if (data.current_index >= data.threads.size()) {
+		data.finished = true;
+	}
+
+	output.SetCardinality(output_count);
+}
+
+} // namespace
+
+void RegisterSysThreadsFunction(ExtensionLoader &loader) {
+	TableFunction sys_threads_func("sys_threads", {}, SysThreadsFunc, SysThreadsBind, SysThreadsInit);
+	sys_threads_func.named_parameters["pid"] = LogicalType::INTEGER;
+	sys_threads_func.named_parameters["interval"] = LogicalType::INTERVAL;
+	loader.RegisterFunction(sys_threads_func);
+}
+
+} // namespace duckdb
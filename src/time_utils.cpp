@@ -0,0 +1,14 @@
+#include "time_utils.hpp"
+
+#include "duckdb/common/numeric_utils.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+uint64_t GetMonotonicTimestampNs() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return NumericCast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+} // namespace duckdb
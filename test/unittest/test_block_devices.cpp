@@ -0,0 +1,124 @@
+#include "block_devices.hpp"
+#include "catch/catch.hpp"
+
+#include <algorithm>
+
+using namespace duckdb;
+
+namespace {
+
+BlockDeviceInfo MakeDisk(const string &name, bool rotational) {
+	BlockDeviceInfo info;
+	info.name = name;
+	info.type = "disk";
+	info.has_hardware = true;
+	info.rotational = rotational;
+	info.logical_block_size = 512;
+	info.physical_block_size = 4096;
+	info.scheduler = "mq-deadline";
+	info.numa_node = 1;
+	info.model = "Model " + name;
+	return info;
+}
+
+BlockDeviceInfo MakePartition(const string &name, const string &parent) {
+	BlockDeviceInfo info;
+	info.name = name;
+	info.type = "partition";
+	info.parent = parent;
+	return info;
+}
+
+BlockDeviceInfo MakeVirtual(const string &name, const string &type, vector<string> slaves) {
+	BlockDeviceInfo info;
+	info.name = name;
+	info.type = type;
+	info.slaves = std::move(slaves);
+	return info;
+}
+
+const BlockDeviceInfo &FindDevice(const vector<BlockDeviceInfo> &devices, const string &name) {
+	auto iter = std::find_if(devices.begin(), devices.end(),
+	                         [&](const BlockDeviceInfo &device) { return device.name == name; });
+	REQUIRE(iter != devices.end());
+	return *iter;
+}
+
+} // namespace
+
+TEST_CASE("ParseActiveScheduler", "[block_devices]") {
+	REQUIRE(ParseActiveScheduler("none [mq-deadline] kyber bfq") == "mq-deadline");
+	REQUIRE(ParseActiveScheduler("[none] mq-deadline") == "none");
+	REQUIRE(ParseActiveScheduler("none") == "none");
+	REQUIRE(ParseActiveScheduler("").empty());
+	REQUIRE(ParseActiveScheduler("none [mq-deadline").empty());
+}
+
+TEST_CASE("ResolveBlockDevices - partitions", "[block_devices]") {
+	vector<BlockDeviceInfo> devices;
+	devices.emplace_back(MakeDisk("nvme0n1", false));
+	devices.emplace_back(MakePartition("nvme0n1p1", "nvme0n1"));
+	devices.emplace_back(MakeDisk("sda", true));
+	devices.emplace_back(MakePartition("sda1", "sda"));
+	ResolveBlockDevices(devices);
+
+	const auto &nvme = FindDevice(devices, "nvme0n1");
+	REQUIRE(nvme.device_class == "nvme");
+	REQUIRE(nvme.physical_devices == vector<string> {"nvme0n1"});
+
+	// Partitions report the queue limits and identity of their disk.
+	const auto &partition = FindDevice(devices, "nvme0n1p1");
+	REQUIRE(partition.device_class == "nvme");
+	REQUIRE(partition.physical_devices == vector<string> {"nvme0n1"});
+	REQUIRE(partition.physical_block_size == 4096);
+	REQUIRE(partition.scheduler == "mq-deadline");
+	REQUIRE(partition.numa_node == 1);
+	REQUIRE(partition.model == "Model nvme0n1");
+
+	const auto &hdd = FindDevice(devices, "sda1");
+	REQUIRE(hdd.device_class == "hdd");
+	REQUIRE(hdd.rotational);
+}
+
+TEST_CASE("ResolveBlockDevices - dm and md devices", "[block_devices]") {
+	vector<BlockDeviceInfo> devices;
+	devices.emplace_back(MakeDisk("sda", false));
+	devices.emplace_back(MakePartition("sda1", "sda"));
+	devices.emplace_back(MakePartition("sda2", "sda"));
+	devices.emplace_back(MakeDisk("sdb", false));
+	devices.emplace_back(MakePartition("sdb1", "sdb"));
+	devices.emplace_back(MakeDisk("sdc", true));
+	devices.emplace_back(MakeVirtual("md0", "md", {"sda1", "sdb1"}));
+	// LVM volume on a RAID array and a partition of the same disk.
+	devices.emplace_back(MakeVirtual("dm-0", "dm", {"md0", "sda2"}));
+	devices.emplace_back(MakeVirtual("dm-1", "dm", {"md0", "sdc"}));
+	devices.emplace_back(MakeVirtual("loop0", "loop", {}));
+	// Slave which is not listed, i.e. removed while reading.
+	devices.emplace_back(MakeVirtual("dm-2", "dm", {"sdz"}));
+	ResolveBlockDevices(devices);
+
+	const auto &md = FindDevice(devices, "md0");
+	REQUIRE(md.physical_devices == vector<string> {"sda", "sdb"});
+	REQUIRE(md.device_class == "ssd");
+
+	const auto &dm0 = FindDevice(devices, "dm-0");
+	REQUIRE(dm0.physical_devices == vector<string> {"sda", "sdb"});
+	REQUIRE(dm0.device_class == "ssd");
+
+	const auto &dm1 = FindDevice(devices, "dm-1");
+	REQUIRE(dm1.physical_devices == vector<string> {"sda", "sdb", "sdc"});
+	REQUIRE(dm1.device_class == "mixed");
+
+	REQUIRE(FindDevice(devices, "loop0").device_class == "virtual");
+	REQUIRE(FindDevice(devices, "dm-2").physical_devices.empty());
+	REQUIRE(FindDevice(devices, "dm-2").device_class == "virtual");
+}
+
+TEST_CASE("ResolveBlockDevices - cycles", "[block_devices]") {
+	vector<BlockDeviceInfo> devices;
+	devices.emplace_back(MakeVirtual("dm-0", "dm", {"dm-1"}));
+	devices.emplace_back(MakeVirtual("dm-1", "dm", {"dm-0"}));
+	ResolveBlockDevices(devices);
+	REQUIRE(devices[0].device_class == "virtual");
+	REQUIRE(devices[1].physical_devices.empty());
+}
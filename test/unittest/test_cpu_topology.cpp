@@ -0,0 +1,60 @@
+#include "catch/catch.hpp"
+#include "cpu_topology.hpp"
+
+#include <algorithm>
+
+using namespace duckdb;
+
+TEST_CASE("ParseCpuList", "[cpu_topology]") {
+	vector<int32_t> ids;
+	REQUIRE(ParseCpuList("0-3,8,10-11\n", ids));
+	REQUIRE(ids == vector<int32_t> {0, 1, 2, 3, 8, 10, 11});
+
+	REQUIRE(ParseCpuList("5", ids));
+	REQUIRE(ids == vector<int32_t> {5});
+
+	// Empty lists, i.e. the cpulist of a memory-only node.
+	REQUIRE(ParseCpuList("\n", ids));
+	REQUIRE(ids.empty());
+
+	// Overlapping and unordered ranges.
+	REQUIRE(ParseCpuList("4-5,0,4", ids));
+	REQUIRE(ids == vector<int32_t> {0, 4, 5});
+
+	REQUIRE_FALSE(ParseCpuList("3-1", ids));
+	REQUIRE_FALSE(ParseCpuList("0-", ids));
+	REQUIRE_FALSE(ParseCpuList("0,,1", ids));
+	REQUIRE_FALSE(ParseCpuList("a-b", ids));
+	REQUIRE_FALSE(ParseCpuList("0-100000000", ids));
+}
+
+TEST_CASE("GetNumaNodes", "[cpu_topology]") {
+	const auto allowed_cpus = GetAllowedCpus();
+	REQUIRE_FALSE(allowed_cpus.empty());
+
+	// Every allowed CPU belongs to exactly one node.
+	const auto nodes = GetNumaNodes();
+	REQUIRE_FALSE(nodes.empty());
+	vector<int32_t> node_cpus;
+	for (const auto &node : nodes) {
+		REQUIRE_FALSE(node.cpus.empty());
+		node_cpus.insert(node_cpus.end(), node.cpus.begin(), node.cpus.end());
+	}
+	std::sort(node_cpus.begin(), node_cpus.end());
+	REQUIRE(node_cpus == allowed_cpus);
+}
+
+TEST_CASE("GetCpuTopology", "[cpu_topology]") {
+	const auto allowed_cpus = GetAllowedCpus();
+	const auto topology = GetCpuTopology();
+	REQUIRE(topology.size() == allowed_cpus.size());
+	for (idx_t idx = 0; idx < topology.size(); idx++) {
+		REQUIRE(topology[idx].cpu == allowed_cpus[idx]);
+		REQUIRE(topology[idx].package >= 0);
+		REQUIRE(topology[idx].core >= 0);
+	}
+
+	vector<int32_t> cpus;
+	REQUIRE(GetThreadAffinity(0, cpus));
+	REQUIRE(cpus == allowed_cpus);
+}
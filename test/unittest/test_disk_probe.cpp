@@ -0,0 +1,49 @@
+#include "catch/catch.hpp"
+#include "disk_probe.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("ParseDiskProbeModes", "[disk_probe]") {
+	REQUIRE(ParseDiskProbeModes("randread") == vector<DiskProbeMode> {DiskProbeMode::RANDREAD});
+	REQUIRE(ParseDiskProbeModes("SeqWrite") == vector<DiskProbeMode> {DiskProbeMode::SEQWRITE});
+	REQUIRE(ParseDiskProbeModes("fsync") == vector<DiskProbeMode> {DiskProbeMode::FSYNC});
+	REQUIRE(ParseDiskProbeModes("all").size() == 3);
+	REQUIRE_THROWS(ParseDiskProbeModes("randwrite"));
+	REQUIRE_THROWS(ParseDiskProbeModes(""));
+
+	REQUIRE(string(DiskProbeModeToString(DiskProbeMode::RANDREAD)) == "randread");
+	REQUIRE(string(DiskProbeModeToString(DiskProbeMode::FSYNC)) == "fsync");
+}
+
+TEST_CASE("SummarizeLatencies", "[disk_probe]") {
+	vector<uint64_t> empty;
+	auto summary = SummarizeLatencies(empty);
+	REQUIRE(summary.p50_ns == 0);
+	REQUIRE(summary.max_ns == 0);
+
+	vector<uint64_t> single {700};
+	summary = SummarizeLatencies(single);
+	REQUIRE(summary.p50_ns == 700);
+	REQUIRE(summary.p99_ns == 700);
+	REQUIRE(summary.max_ns == 700);
+	REQUIRE(summary.mean_ns == 700);
+
+	// 1 to 100 in reverse, with one outlier replacing 100.
+	vector<uint64_t> latencies;
+	for (uint64_t value = 99; value >= 1; value--) {
+		latencies.emplace_back(value);
+	}
+	latencies.emplace_back(10000);
+	summary = SummarizeLatencies(latencies);
+	REQUIRE(summary.p50_ns == 50);
+	REQUIRE(summary.p99_ns == 99);
+	REQUIRE(summary.max_ns == 10000);
+	REQUIRE(summary.mean_ns == 149.5);
+	REQUIRE(latencies.front() == 1);
+
+	// Nearest rank of the 99th percentile is the max for fewer than 100 values.
+	vector<uint64_t> ten {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	summary = SummarizeLatencies(ten);
+	REQUIRE(summary.p50_ns == 5);
+	REQUIRE(summary.p99_ns == 10);
+}
@@ -0,0 +1,25 @@
+#include "catch/catch.hpp"
+#include "duckdb_resources.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("ParseStatm - valid content", "[duckdb_resources]") {
+	ProcessMemoryUsage usage;
+	REQUIRE(ParseStatm("25000 1200 300 50 0 9000 0\n", 4096, usage));
+	REQUIRE(usage.virtual_bytes == 25000ULL * 4096);
+	REQUIRE(usage.rss_bytes == 1200ULL * 4096);
+	REQUIRE(usage.shared_bytes == 300ULL * 4096);
+}
+
+TEST_CASE("ParseStatm - large page size", "[duckdb_resources]") {
+	ProcessMemoryUsage usage;
+	REQUIRE(ParseStatm("10 5 1 1 0 4 0", 65536, usage));
+	REQUIRE(usage.rss_bytes == 5ULL * 65536);
+}
+
+TEST_CASE("ParseStatm - malformed content", "[duckdb_resources]") {
+	ProcessMemoryUsage usage;
+	REQUIRE_FALSE(ParseStatm("", 4096, usage));
+	REQUIRE_FALSE(ParseStatm("25000 1200", 4096, usage));
+	REQUIRE_FALSE(ParseStatm("25000 abc 300", 4096, usage));
+}
@@ -0,0 +1,56 @@
+#include "catch/catch.hpp"
+#include "duckdb.hpp"
+#include "hardware_info_cache.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+// Hardware info cache whose online CPUs and collected CPU information are scripted by the test.
+class ScriptedHardwareInfoCache : public HardwareInfoCacheEntry {
+public:
+	string online = "0-3";
+	int32_t logical_cpus = 4;
+	int collect_count = 0;
+
+protected:
+	string ReadOnlineCPUs() override {
+		return online;
+	}
+	CPUInfo CollectCPUInfo(ClientContext &context) override {
+		++collect_count;
+		CPUInfo info;
+		info.logical_cpus = logical_cpus;
+		return info;
+	}
+};
+
+} // namespace
+
+TEST_CASE("HardwareInfoCacheEntry - rebuilt after CPU hotplug", "[hardware_info_cache]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	ScriptedHardwareInfoCache cache;
+
+	REQUIRE(cache.GetCPUInfo(*con.context).logical_cpus == 4);
+	REQUIRE(cache.collect_count == 1);
+
+	// Unchanged online CPUs are served from cache.
+	cache.logical_cpus = 8;
+	REQUIRE(cache.GetCPUInfo(*con.context).logical_cpus == 4);
+	REQUIRE(cache.collect_count == 1);
+
+	// Taking CPUs offline changes the list, so the entry is rebuilt.
+	cache.online = "0-1";
+	cache.logical_cpus = 2;
+	REQUIRE(cache.GetCPUInfo(*con.context).logical_cpus == 2);
+	REQUIRE(cache.collect_count == 2);
+	REQUIRE(cache.GetCPUInfo(*con.context).logical_cpus == 2);
+	REQUIRE(cache.collect_count == 2);
+
+	// Bringing them back online rebuilds it again.
+	cache.online = "0-3";
+	cache.logical_cpus = 4;
+	REQUIRE(cache.GetCPUInfo(*con.context).logical_cpus == 4);
+	REQUIRE(cache.collect_count == 3);
+}
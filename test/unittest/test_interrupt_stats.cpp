@@ -0,0 +1,128 @@
+#include "catch/catch.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "interrupt_stats.hpp"
+
+#include <cstdint>
+
+using namespace duckdb;
+
+namespace {
+
+// CPU1 is offline, so it has no column.
+constexpr const char *INTERRUPTS = "           CPU0       CPU2       CPU3       \n"
+                                   "  0:         44          0          0  IO-APIC   2-edge      timer\n"
+                                   " 24:       1200        300          7  PCI-MSI 512000-edge      ahci\n"
+                                   "NMI:          1          2          3   Non-maskable interrupts\n"
+                                   "LOC:   34928000   34927000   34926000   Local timer interrupts\n"
+                                   "ERR:          5\n"
+                                   "MIS:          0\n";
+
+constexpr const char *SOFTIRQS = "                    CPU0       CPU1       \n"
+                                 "          HI:          0          1\n"
+                                 "       TIMER:      55411      60000\n"
+                                 "      NET_RX:       6057         12\n";
+
+InterruptTable Parse(const string &content) {
+	InterruptTable table;
+	REQUIRE(ParseInterruptTable(content, table));
+	return table;
+}
+
+} // namespace
+
+TEST_CASE("ParseInterruptTable - /proc/interrupts", "[interrupt_stats]") {
+	auto table = Parse(INTERRUPTS);
+	REQUIRE(table.cpus == vector<int32_t> {0, 2, 3});
+	REQUIRE(table.sources.size() == 6);
+
+	const auto &timer = table.sources[0];
+	REQUIRE(timer.irq == "0");
+	REQUIRE(timer.per_cpu);
+	REQUIRE(timer.count_size == 3);
+	REQUIRE(timer.description == "IO-APIC 2-edge timer");
+
+	const auto &ahci = table.sources[1];
+	REQUIRE(ahci.irq == "24");
+	REQUIRE(table.counts[ahci.count_offset + 1] == 300);
+	REQUIRE(ahci.description == "PCI-MSI 512000-edge ahci");
+
+	const auto &loc = table.sources[3];
+	REQUIRE(loc.irq == "LOC");
+	REQUIRE(table.counts[loc.count_offset + 2] == 34926000);
+	REQUIRE(loc.description == "Local timer interrupts");
+
+	// System-wide totals have a single count and no description.
+	const auto &err = table.sources[4];
+	REQUIRE(err.irq == "ERR");
+	REQUIRE_FALSE(err.per_cpu);
+	REQUIRE(err.count_size == 1);
+	REQUIRE(table.counts[err.count_offset] == 5);
+	REQUIRE(err.description.empty());
+	REQUIRE(table.counts.size() == 4 * 3 + 2);
+}
+
+TEST_CASE("ParseInterruptTable - /proc/softirqs", "[interrupt_stats]") {
+	auto table = Parse(SOFTIRQS);
+	REQUIRE(table.cpus == vector<int32_t> {0, 1});
+	REQUIRE(table.sources.size() == 3);
+	REQUIRE(table.sources[2].irq == "NET_RX");
+	REQUIRE(table.sources[2].per_cpu);
+	REQUIRE(table.sources[2].description.empty());
+	REQUIRE(table.counts[table.sources[2].count_offset + 1] == 12);
+
+	// A single CPU host still has per-CPU counts, except for the system-wide totals.
+	auto single = Parse("           CPU0\n  1:          9   IO-APIC   1-edge      i8042\nERR:          0\n");
+	REQUIRE(single.sources[0].per_cpu);
+	REQUIRE_FALSE(single.sources[1].per_cpu);
+}
+
+TEST_CASE("ParseInterruptTable - wide and malformed content", "[interrupt_stats]") {
+	// 256 CPU columns of 11 bytes each, as printed on large hosts.
+	constexpr idx_t CPU_COUNT = 256;
+	string content;
+	for (idx_t cpu = 0; cpu < CPU_COUNT; cpu++) {
+		content += StringUtil::Format("%11s", "CPU" + std::to_string(cpu));
+	}
+	content += "\n";
+	for (idx_t irq = 0; irq < 4; irq++) {
+		content += StringUtil::Format("%4llu:", irq);
+		for (idx_t cpu = 0; cpu < CPU_COUNT; cpu++) {
+			content += StringUtil::Format(" %10llu", irq * 1000 + cpu);
+		}
+		content += "  IR-PCI-MSI 1-edge      nvme0q1\n";
+	}
+	auto table = Parse(content);
+	REQUIRE(table.cpus.size() == CPU_COUNT);
+	REQUIRE(table.cpus.back() == 255);
+	REQUIRE(table.sources.size() == 4);
+	REQUIRE(table.counts[table.sources[3].count_offset + 255] == 3255);
+	REQUIRE(table.sources[3].description == "IR-PCI-MSI 1-edge nvme0q1");
+
+	InterruptTable malformed;
+	REQUIRE_FALSE(ParseInterruptTable("", malformed));
+	REQUIRE_FALSE(ParseInterruptTable("  CPU0  GPU1\n", malformed));
+	// Lines with a partial set of counts are skipped.
+	auto partial = Parse("  CPU0  CPU1  CPU2\nBAD:  1  2  text\nno colon\n  5:  1  2  3\n");
+	REQUIRE(partial.sources.size() == 1);
+	REQUIRE(partial.sources[0].irq == "5");
+}
+
+TEST_CASE("ComputeInterruptRates - deltas per CPU", "[interrupt_stats]") {
+	auto before = Parse("  CPU0  CPU1\n  1:  100  4294967290\n  2:  5  5\nERR:  3\n");
+	// CPU1 went offline, CPU2 came online and IRQ 3 was registered.
+	auto after = Parse("  CPU0  CPU2\n  1:  300  50\n  3:  1  1\nERR:  7\n");
+	ComputeInterruptRates(before, after, 2000000000);
+
+	REQUIRE(after.rates.size() == after.counts.size());
+	const auto &irq1 = after.sources[0];
+	REQUIRE(after.has_rate[irq1.count_offset]);
+	REQUIRE(after.rates[irq1.count_offset] == 100.0);
+	REQUIRE_FALSE(after.has_rate[irq1.count_offset + 1]);
+	REQUIRE_FALSE(after.has_rate[after.sources[1].count_offset]);
+	REQUIRE(after.rates[after.sources[2].count_offset] == 2.0);
+
+	// Counts are 32-bit in the kernel and wrap around.
+	auto wrapped = Parse("  CPU0  CPU1\n  1:  100  4\n");
+	ComputeInterruptRates(before, wrapped, 1000000000);
+	REQUIRE(wrapped.rates[1] == 10.0);
+}
@@ -0,0 +1,84 @@
+#include "catch/catch.hpp"
+#include "memory_benchmark.hpp"
+
+#include <algorithm>
+
+using namespace duckdb;
+
+namespace {
+
+// 64 byte aligned arrays of [count] doubles.
+struct TestArrays {
+	explicit TestArrays(idx_t count) : a(count + 8), b(count + 8), c(count + 8) {
+		arrays.a = Align(a);
+		arrays.b = Align(b);
+		arrays.c = Align(c);
+		arrays.count = count;
+		std::fill_n(arrays.a, count, 1.0);
+		std::fill_n(arrays.b, count, 2.0);
+		std::fill_n(arrays.c, count, 0.0);
+	}
+	static double *Align(vector<double> &values) {
+		auto address = reinterpret_cast<uintptr_t>(values.data());
+		return reinterpret_cast<double *>((address + 63) & ~static_cast<uintptr_t>(63));
+	}
+	bool AllEqual(const double *values, double expected) const {
+		for (idx_t idx = 0; idx < arrays.count; idx++) {
+			if (values[idx] != expected) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	vector<double> a;
+	vector<double> b;
+	vector<double> c;
+	StreamArrays arrays;
+};
+
+} // namespace
+
+TEST_CASE("STREAM kernels", "[memory_benchmark]") {
+	// Not a multiple of the vector width, so the scalar tail runs as well.
+	TestArrays test(1003);
+	const auto &arrays = test.arrays;
+
+	RunStreamKernel(StreamKernel::COPY, arrays, 0, arrays.count);
+	REQUIRE(test.AllEqual(arrays.c, 1.0));
+
+	RunStreamKernel(StreamKernel::SCALE, arrays, 0, arrays.count);
+	REQUIRE(test.AllEqual(arrays.b, 3.0));
+
+	RunStreamKernel(StreamKernel::ADD, arrays, 0, arrays.count);
+	REQUIRE(test.AllEqual(arrays.c, 4.0));
+
+	// Slices of workers, split at cache lines.
+	RunStreamKernel(StreamKernel::TRIAD, arrays, 0, 504);
+	RunStreamKernel(StreamKernel::TRIAD, arrays, 504, arrays.count);
+	REQUIRE(test.AllEqual(arrays.a, 3.0 + STREAM_SCALAR * 4.0));
+
+	REQUIRE(GetStreamBytesPerElement(StreamKernel::COPY) == 16);
+	REQUIRE(GetStreamBytesPerElement(StreamKernel::TRIAD) == 24);
+	const string implementation = GetStreamImplementation();
+	REQUIRE((implementation == "avx" || implementation == "sse2" || implementation == "scalar"));
+}
+
+TEST_CASE("Pointer chase", "[memory_benchmark]") {
+	constexpr idx_t LINE_COUNT = 1000;
+	vector<uint64_t> buffer(LINE_COUNT * 8);
+	BuildPointerChase(buffer.data(), LINE_COUNT, 42);
+
+	// The chase is a single cycle through every line.
+	vector<bool> visited(LINE_COUNT, false);
+	const void *line = buffer.data();
+	for (idx_t step = 0; step < LINE_COUNT; step++) {
+		const auto index = static_cast<idx_t>(static_cast<const uint64_t *>(line) - buffer.data()) / 8;
+		REQUIRE(index < LINE_COUNT);
+		REQUIRE_FALSE(visited[index]);
+		visited[index] = true;
+		line = ChasePointers(line, 1);
+	}
+	REQUIRE(line == buffer.data());
+	REQUIRE(ChasePointers(buffer.data(), LINE_COUNT * 3) == buffer.data());
+}
@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+#include "metrics_recorder.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+// 2026-10-18 12:00:00 UTC
+constexpr int64_t START_MICROS = 1792324800LL * 1000000;
+
+} // namespace
+
+TEST_CASE("GetRecordingFileName", "[metrics_recorder]") {
+	REQUIRE(GetRecordingFileName(START_MICROS, START_MICROS + 3599LL * 1000000, RecordingFormat::PARQUET) ==
+	        "sys_metrics_20261018T120000Z_20261018T125959Z.parquet");
+	REQUIRE(GetRecordingFileName(START_MICROS, START_MICROS + 3599LL * 1000000, RecordingFormat::SNAPSHOT) ==
+	        "sys_metrics_20261018T120000Z_20261018T125959Z.snap");
+	// Start is rounded down and end is rounded up to full seconds.
+	REQUIRE(GetRecordingFileName(START_MICROS + 500000, START_MICROS + 1500000, RecordingFormat::PARQUET) ==
+	        "sys_metrics_20261018T120000Z_20261018T120002Z.parquet");
+}
+
+TEST_CASE("ParseRecordingFileName - round trip", "[metrics_recorder]") {
+	int64_t start_micros = 0;
+	int64_t end_micros = 0;
+	RecordingFormat format = RecordingFormat::SNAPSHOT;
+	REQUIRE(ParseRecordingFileName(
+	    GetRecordingFileName(START_MICROS, START_MICROS + 60LL * 1000000, RecordingFormat::PARQUET), start_micros,
+	    end_micros, format));
+	REQUIRE(start_micros == START_MICROS);
+	REQUIRE(end_micros == START_MICROS + 60LL * 1000000);
+	REQUIRE(format == RecordingFormat::PARQUET);
+
+	REQUIRE(ParseRecordingFileName(
+	    GetRecordingFileName(START_MICROS, START_MICROS + 60LL * 1000000, RecordingFormat::SNAPSHOT), start_micros,
+	    end_micros, format));
+	REQUIRE(format == RecordingFormat::SNAPSHOT);
+
+	// Suffix added when a file for the same range already exists.
+	REQUIRE(ParseRecordingFileName("sys_metrics_20261018T120000Z_20261018T120100Z_2.parquet", start_micros,
+	                               end_micros, format));
+	REQUIRE(start_micros == START_MICROS);
+}
+
+TEST_CASE("ParseRecordingFileName - other files", "[metrics_recorder]") {
+	int64_t start_micros = 0;
+	int64_t end_micros = 0;
+	RecordingFormat format;
+	REQUIRE_FALSE(ParseRecordingFileName("metrics.parquet", start_micros, end_micros, format));
+	REQUIRE_FALSE(ParseRecordingFileName("sys_metrics_.parquet", start_micros, end_micros, format));
+	REQUIRE_FALSE(ParseRecordingFileName("sys_metrics_20261018T120000Z_20261018T125959Z.parquet.tmp", start_micros,
+	                                     end_micros, format));
+	REQUIRE_FALSE(ParseRecordingFileName("sys_metrics_20261018T120000Z_20261018T125959Z.csv", start_micros,
+	                                     end_micros, format));
+	REQUIRE_FALSE(ParseRecordingFileName("sys_metrics_2026-10-18T12:00_20261018T125959Z.parquet", start_micros,
+	                                     end_micros, format));
+}
+
+TEST_CASE("ParseRecordingFormat", "[metrics_recorder]") {
+	REQUIRE(ParseRecordingFormat("parquet") == RecordingFormat::PARQUET);
+	REQUIRE(ParseRecordingFormat("SNAPSHOT") == RecordingFormat::SNAPSHOT);
+	REQUIRE_THROWS(ParseRecordingFormat("csv"));
+}
+
+TEST_CASE("MetricsBatch", "[metrics_recorder]") {
+	MetricsBatch batch;
+	batch.Append(timestamp_t {START_MICROS}, "memory", "", "used_memory", 1024);
+	batch.Append(timestamp_t {START_MICROS}, "disk", "/", "free_space", 2048);
+	REQUIRE(batch.Size() == 2);
+	REQUIRE(batch.sources[1] == "disk");
+	REQUIRE(batch.entities[1] == "/");
+	REQUIRE(batch.values[1] == 2048);
+
+	batch.Clear();
+	REQUIRE(batch.Size() == 0);
+	REQUIRE(batch.entities.empty());
+}
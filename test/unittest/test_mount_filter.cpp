@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+#include "mount_filter.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("PerfectHashSet - membership", "[mount_filter]") {
+	PerfectHashSet set(ParseFilterList(DEFAULT_EXCLUDE_FILE_SYSTEM_TYPES));
+	REQUIRE(set.Contains("proc"));
+	REQUIRE(set.Contains("cgroup"));
+	REQUIRE(set.Contains("cgroup2"));
+	REQUIRE(set.Contains("overlay"));
+	REQUIRE_FALSE(set.Contains("ext4"));
+	REQUIRE_FALSE(set.Contains("cgroup3"));
+	REQUIRE_FALSE(set.Contains(""));
+}
+
+TEST_CASE("PerfectHashSet - empty and duplicate keys", "[mount_filter]") {
+	PerfectHashSet empty_set;
+	REQUIRE(empty_set.Empty());
+	REQUIRE_FALSE(empty_set.Contains("ext4"));
+
+	PerfectHashSet set({"ext4", "ext4", "xfs"});
+	REQUIRE_FALSE(set.Empty());
+	REQUIRE(set.Contains("ext4"));
+	REQUIRE(set.Contains("xfs"));
+}
+
+TEST_CASE("PathPrefixTrie - component boundary", "[mount_filter]") {
+	PathPrefixTrie trie({"/dev", "/run"});
+	REQUIRE(trie.Matches("/dev"));
+	REQUIRE(trie.Matches("/dev/shm"));
+	REQUIRE(trie.Matches("/run/user/1000"));
+	REQUIRE_FALSE(trie.Matches("/devices"));
+	REQUIRE_FALSE(trie.Matches("/"));
+	REQUIRE_FALSE(trie.Matches("/home"));
+}
+
+TEST_CASE("PathPrefixTrie - trailing slash only matches entries under directory", "[mount_filter]") {
+	PathPrefixTrie trie({"/var/lib/docker/"});
+	REQUIRE(trie.Matches("/var/lib/docker/overlay2/abc/merged"));
+	REQUIRE_FALSE(trie.Matches("/var/lib/docker"));
+	REQUIRE_FALSE(trie.Matches("/var/lib/docker/"));
+	REQUIRE_FALSE(trie.Matches("/var/lib/dockerd/x"));
+}
+
+TEST_CASE("PathPrefixTrie - root prefix", "[mount_filter]") {
+	PathPrefixTrie trie({"/"});
+	REQUIRE(trie.Matches("/"));
+	REQUIRE_FALSE(trie.Matches("/home"));
+}
+
+TEST_CASE("MountFilter - default filter", "[mount_filter]") {
+	auto filter = MountFilter::Default();
+	REQUIRE(filter.IgnoreFileSystemType("sysfs"));
+	REQUIRE_FALSE(filter.IgnoreFileSystemType("ext4"));
+	REQUIRE(filter.IgnoreMountPoint("/proc"));
+	REQUIRE(filter.IgnoreMountPoint("/snap/core/123"));
+	REQUIRE_FALSE(filter.IgnoreMountPoint("/"));
+	REQUIRE_FALSE(filter.IgnoreMountPoint("/home"));
+}
+
+TEST_CASE("MountFilter - include lists", "[mount_filter]") {
+	MountFilter filter({"ext4", "xfs"}, {}, {"/data"}, {"/data/tmp"});
+	REQUIRE_FALSE(filter.IgnoreFileSystemType("ext4"));
+	REQUIRE(filter.IgnoreFileSystemType("btrfs"));
+	REQUIRE_FALSE(filter.IgnoreMountPoint("/data/volume"));
+	REQUIRE(filter.IgnoreMountPoint("/data/tmp"));
+	REQUIRE(filter.IgnoreMountPoint("/home"));
+}
+
+TEST_CASE("ParseFilterList - trims and skips empty items", "[mount_filter]") {
+	auto list = ParseFilterList(" ext4, ,xfs ,");
+	REQUIRE(list.size() == 2);
+	REQUIRE(list[0] == "ext4");
+	REQUIRE(list[1] == "xfs");
+	REQUIRE(ParseFilterList("").empty());
+}
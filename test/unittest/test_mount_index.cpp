@@ -0,0 +1,122 @@
+#include "catch/catch.hpp"
+#include "mount_index.hpp"
+
+#include <cstdlib>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace duckdb;
+
+#ifdef __linux__
+namespace {
+
+constexpr const char *ROOT_MOUNT = "22 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw\n";
+constexpr const char *DATA_MOUNT = "23 22 8:2 / /data rw,relatime - xfs /dev/sda2 rw\n";
+
+// Mount index whose change notifications are scripted by the test.
+class ScriptedMountIndex : public MountIndexCacheEntry {
+public:
+	explicit ScriptedMountIndex(string path) : MountIndexCacheEntry(std::move(path)) {
+	}
+
+	bool poll_succeeds = true;
+	bool changed = false;
+
+protected:
+	bool PollMountTable(int fd_p, bool &changed_p) override {
+		changed_p = changed;
+		return poll_succeeds;
+	}
+};
+
+// Temporary file standing in for /proc/self/mountinfo.
+struct MountInfoFile {
+	MountInfoFile() {
+		const int fd = mkstemp(path);
+		REQUIRE(fd != -1);
+		close(fd);
+	}
+	~MountInfoFile() {
+		unlink(path);
+	}
+	void Write(const string &content) {
+		FILE *file = fopen(path, "w");
+		REQUIRE(file != nullptr);
+		REQUIRE(fwrite(content.data(), 1, content.size(), file) == content.size());
+		fclose(file);
+	}
+
+	char path[64] = "/tmp/system_stats_mountinfo_XXXXXX";
+};
+
+} // namespace
+
+TEST_CASE("MountIndexCacheEntry - unchanged table is served from cache", "[mount_index]") {
+	MountInfoFile file;
+	file.Write(ROOT_MOUNT);
+	// Regular files never signal a change, as the mount table does without mount or unmount.
+	MountIndexCacheEntry index(file.path);
+	const MountFilterConfig config;
+
+	auto first = index.GetMounts(nullptr, config);
+	REQUIRE(first->size() == 1);
+	REQUIRE((*first)[0].mount_point == "/");
+
+	// Content changes are only picked up once the kernel signals them.
+	file.Write(string(ROOT_MOUNT) + DATA_MOUNT);
+	auto second = index.GetMounts(nullptr, config);
+	REQUIRE(second.get() == first.get());
+
+	// Changed filter settings rebuild the index.
+	MountFilterConfig data_only;
+	data_only.include_mount_points = "/data";
+	auto filtered = index.GetMounts(nullptr, data_only);
+	REQUIRE(filtered.get() != first.get());
+	REQUIRE(filtered->size() == 1);
+	REQUIRE((*filtered)[0].mount_point == "/data");
+}
+
+TEST_CASE("MountIndexCacheEntry - rebuilt after a change", "[mount_index]") {
+	MountInfoFile file;
+	file.Write(ROOT_MOUNT);
+	ScriptedMountIndex index(file.path);
+	const MountFilterConfig config;
+
+	auto before = index.GetMounts(nullptr, config);
+	REQUIRE(before->size() == 1);
+
+	file.Write(string(ROOT_MOUNT) + DATA_MOUNT);
+	index.changed = true;
+	auto after = index.GetMounts(nullptr, config);
+	REQUIRE(after.get() != before.get());
+	REQUIRE(after->size() == 2);
+	REQUIRE((*after)[1].mount_point == "/data");
+	// Snapshots handed out earlier are not modified.
+	REQUIRE(before->size() == 1);
+
+	index.changed = false;
+	REQUIRE(index.GetMounts(nullptr, config).get() == after.get());
+}
+
+TEST_CASE("MountIndexCacheEntry - rebuilt when polling fails", "[mount_index]") {
+	MountInfoFile file;
+	file.Write(ROOT_MOUNT);
+	ScriptedMountIndex index(file.path);
+	const MountFilterConfig config;
+
+	auto before = index.GetMounts(nullptr, config);
+	file.Write(string(ROOT_MOUNT) + DATA_MOUNT);
+	index.poll_succeeds = false;
+	auto after = index.GetMounts(nullptr, config);
+	REQUIRE(after.get() != before.get());
+	REQUIRE(after->size() == 2);
+}
+
+TEST_CASE("MountIndexCacheEntry - missing file", "[mount_index]") {
+	MountIndexCacheEntry index("/nonexistent/system_stats_mountinfo");
+	REQUIRE(index.GetMounts(nullptr, MountFilterConfig()).get() != nullptr);
+	REQUIRE(index.GetMounts(nullptr, MountFilterConfig())->empty());
+}
+#endif
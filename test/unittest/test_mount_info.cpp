@@ -0,0 +1,65 @@
+#include "catch/catch.hpp"
+#include "mount_info.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("ParseMountInfoLine - with optional fields", "[mount_info]") {
+	MountInfoEntry entry;
+	REQUIRE(ParseMountInfoLine("36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 shared:2 - ext3 /dev/root rw,errors=continue",
+	                           entry));
+	REQUIRE(entry.mount_id == 36);
+	REQUIRE(entry.parent_id == 35);
+	REQUIRE(entry.major == 98);
+	REQUIRE(entry.minor == 0);
+	REQUIRE(entry.root == "/mnt1");
+	REQUIRE(entry.mount_point == "/mnt2");
+	REQUIRE(entry.mount_options == "rw,noatime");
+	REQUIRE(entry.propagation == "master:1 shared:2");
+	REQUIRE(entry.file_system_type == "ext3");
+	REQUIRE(entry.source == "/dev/root");
+	REQUIRE(entry.super_options == "rw,errors=continue");
+}
+
+TEST_CASE("ParseMountInfoLine - without optional fields", "[mount_info]") {
+	MountInfoEntry entry;
+	REQUIRE(ParseMountInfoLine("22 1 8:1 / / rw,relatime - ext4 /dev/sda1 rw", entry));
+	REQUIRE(entry.propagation.empty());
+	REQUIRE(entry.mount_point == "/");
+	REQUIRE(entry.file_system_type == "ext4");
+}
+
+TEST_CASE("ParseMountInfoLine - escaped path", "[mount_info]") {
+	MountInfoEntry entry;
+	REQUIRE(ParseMountInfoLine("40 22 8:2 / /mnt/my\\040disk rw - ext4 /dev/sda2 rw", entry));
+	REQUIRE(entry.mount_point == "/mnt/my disk");
+}
+
+TEST_CASE("ParseMountInfoLine - malformed line", "[mount_info]") {
+	MountInfoEntry entry;
+	REQUIRE_FALSE(ParseMountInfoLine("", entry));
+	REQUIRE_FALSE(ParseMountInfoLine("abc 1 8:1 / / rw - ext4 /dev/sda1 rw", entry));
+	REQUIRE_FALSE(ParseMountInfoLine("22 1 8-1 / / rw - ext4 /dev/sda1 rw", entry));
+	// Missing separator.
+	REQUIRE_FALSE(ParseMountInfoLine("22 1 8:1 / / rw shared:1", entry));
+}
+
+TEST_CASE("UnescapeMountPath - octal sequences", "[mount_info]") {
+	REQUIRE(UnescapeMountPath("/a\\040b") == "/a b");
+	REQUIRE(UnescapeMountPath("/a\\011b\\012") == "/a\tb\n");
+	REQUIRE(UnescapeMountPath("/a\\134b") == "/a\\b");
+	// Incomplete sequences are kept as is.
+	REQUIRE(UnescapeMountPath("/a\\04") == "/a\\04");
+}
+
+TEST_CASE("DeduplicateBindMounts - prefer filesystem root", "[mount_info]") {
+	vector<MountInfoEntry> entries(4);
+	ParseMountInfoLine("30 1 8:1 /data/app /srv/app rw - ext4 /dev/sda1 rw", entries[0]);
+	ParseMountInfoLine("31 1 8:1 / /data rw - ext4 /dev/sda1 rw", entries[1]);
+	ParseMountInfoLine("32 1 8:2 / /home rw - ext4 /dev/sda2 rw", entries[2]);
+	ParseMountInfoLine("33 1 8:1 / /mnt/data-copy rw - ext4 /dev/sda1 rw", entries[3]);
+
+	DeduplicateBindMounts(entries);
+	REQUIRE(entries.size() == 2);
+	REQUIRE(entries[0].mount_point == "/data");
+	REQUIRE(entries[1].mount_point == "/home");
+}
@@ -0,0 +1,88 @@
+#include "catch/catch.hpp"
+#include "net_protocol_stats.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("ParseHeaderValueLines - snmp format", "[net_protocol_stats]") {
+	const char *content = "Ip: Forwarding DefaultTTL\n"
+	                      "Ip: 1 64\n"
+	                      "Tcp: RtoAlgorithm RtoMin MaxConn RetransSegs\n"
+	                      "Tcp: 1 200 -1 42\n";
+	vector<ProtocolCounter> counters;
+	ParseHeaderValueLines(content, "snmp", counters);
+	REQUIRE(counters.size() == 6);
+	REQUIRE(counters[0].source == "snmp");
+	REQUIRE(counters[0].protocol == "Ip");
+	REQUIRE(counters[0].name == "Forwarding");
+	REQUIRE(counters[0].value == 1);
+	REQUIRE(counters[4].protocol == "Tcp");
+	REQUIRE(counters[4].name == "MaxConn");
+	REQUIRE(counters[4].value == -1);
+	REQUIRE(counters[5].name == "RetransSegs");
+	REQUIRE(counters[5].value == 42);
+}
+
+TEST_CASE("ParseHeaderValueLines - unpaired header line", "[net_protocol_stats]") {
+	const char *content = "TcpExt: SyncookiesSent\n"
+	                      "IpExt: InNoRoutes InTruncatedPkts\n"
+	                      "IpExt: 3 4";
+	vector<ProtocolCounter> counters;
+	ParseHeaderValueLines(content, "netstat", counters);
+	REQUIRE(counters.size() == 2);
+	REQUIRE(counters[0].protocol == "IpExt");
+	REQUIRE(counters[0].name == "InNoRoutes");
+	REQUIRE(counters[0].value == 3);
+	REQUIRE(counters[1].name == "InTruncatedPkts");
+	REQUIRE(counters[1].value == 4);
+}
+
+TEST_CASE("ParseHeaderValueLines - empty content", "[net_protocol_stats]") {
+	vector<ProtocolCounter> counters;
+	ParseHeaderValueLines("", "snmp", counters);
+	REQUIRE(counters.empty());
+}
+
+TEST_CASE("ParseKeyValueLines - sockstat format", "[net_protocol_stats]") {
+	const char *content = "sockets: used 290\n"
+	                      "TCP: inuse 5 orphan 0 tw 2 alloc 7 mem 1\n";
+	vector<ProtocolCounter> counters;
+	ParseKeyValueLines(content, "sockstat", counters);
+	REQUIRE(counters.size() == 6);
+	REQUIRE(counters[0].protocol == "sockets");
+	REQUIRE(counters[0].name == "used");
+	REQUIRE(counters[0].value == 290);
+	REQUIRE(counters[3].protocol == "TCP");
+	REQUIRE(counters[3].name == "tw");
+	REQUIRE(counters[3].value == 2);
+}
+
+TEST_CASE("ParseSoftnetStat - current kernel format", "[net_protocol_stats]") {
+	const char *content = "0000a1b2 00000001 00000003 00000000 00000000 00000000 00000000 00000000 00000000 "
+	                      "00000010 00000002 00000005 00000000\n"
+	                      "00000100 00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000 "
+	                      "00000000 00000000 00000000 00000003\n";
+	auto stats = ParseSoftnetStat(content);
+	REQUIRE(stats.size() == 2);
+	REQUIRE(stats[0].cpu == 0);
+	REQUIRE(stats[0].processed == 0xa1b2);
+	REQUIRE(stats[0].dropped == 1);
+	REQUIRE(stats[0].time_squeeze == 3);
+	REQUIRE(stats[0].received_rps == 0x10);
+	REQUIRE(stats[0].flow_limit_count == 2);
+	REQUIRE(stats[0].backlog_len == 5);
+	// CPU index is reported by the kernel, offline CPUs are skipped.
+	REQUIRE(stats[1].cpu == 3);
+	REQUIRE(stats[1].processed == 0x100);
+}
+
+TEST_CASE("ParseSoftnetStat - older kernel format without CPU index", "[net_protocol_stats]") {
+	const char *content = "00000001 00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000 "
+	                      "00000000 00000000\n"
+	                      "00000002 00000000 00000000 00000000 00000000 00000000 00000000 00000000 00000000 "
+	                      "00000000 00000000\n";
+	auto stats = ParseSoftnetStat(content);
+	REQUIRE(stats.size() == 2);
+	REQUIRE(stats[0].cpu == 0);
+	REQUIRE(stats[1].cpu == 1);
+	REQUIRE(stats[1].processed == 2);
+}
@@ -0,0 +1,138 @@
+#include "catch/catch.hpp"
+#include "network_rates.hpp"
+
+#include <cstdint>
+
+using namespace duckdb;
+
+namespace {
+
+InterfaceCounters MakeNetworkInfo(const string &name, uint64_t tx_bytes, uint64_t rx_bytes, uint64_t speed_mbps,
+                                  int32_t ifindex = 1) {
+	InterfaceCounters info;
+	info.interface_name = name;
+	info.ifindex = ifindex;
+	info.tx_bytes = tx_bytes;
+	info.rx_bytes = rx_bytes;
+	info.speed_mbps = speed_mbps;
+	return info;
+}
+
+} // namespace
+
+TEST_CASE("GetCounterDelta - monotonic counter", "[network_rates]") {
+	REQUIRE(GetCounterDelta(0, 0) == 0);
+	REQUIRE(GetCounterDelta(100, 250) == 150);
+	REQUIRE(GetCounterDelta(UINT64_MAX - 1, UINT64_MAX) == 1);
+}
+
+TEST_CASE("GetCounterDelta - 32-bit wraparound", "[network_rates]") {
+	REQUIRE(GetCounterDelta(UINT32_MAX, 0) == 1);
+	REQUIRE(GetCounterDelta(UINT32_MAX - 9, 10) == 20);
+}
+
+TEST_CASE("GetCounterDelta - counter reset", "[network_rates]") {
+	REQUIRE(GetCounterDelta(1ULL << 40, 500) == 500);
+}
+
+TEST_CASE("ComputeNetworkRates - rates and utilization", "[network_rates]") {
+	NetworkSnapshot before;
+	before.timestamp_ns = 1000000000;
+	before.interfaces.emplace_back(MakeNetworkInfo("eth0", 1000, 2000, 1000));
+
+	NetworkSnapshot after;
+	after.timestamp_ns = 3000000000;
+	after.interfaces.emplace_back(MakeNetworkInfo("eth0", 1000 + 250000000, 2000 + 50000000, 1000));
+
+	auto rates = ComputeNetworkRates(before, after);
+	REQUIRE(rates.size() == 1);
+	REQUIRE(rates[0].interface_name == "eth0");
+	REQUIRE(rates[0].interval_seconds == 2.0);
+	REQUIRE(rates[0].tx_bytes_per_sec == 125000000.0);
+	REQUIRE(rates[0].rx_bytes_per_sec == 25000000.0);
+	REQUIRE(rates[0].has_utilization);
+	REQUIRE(rates[0].tx_utilization == 100.0);
+	REQUIRE(rates[0].rx_utilization == 20.0);
+}
+
+TEST_CASE("ComputeNetworkRates - unknown link speed", "[network_rates]") {
+	NetworkSnapshot before;
+	before.timestamp_ns = 0;
+	before.interfaces.emplace_back(MakeNetworkInfo("lo", 0, 0, 0));
+
+	NetworkSnapshot after;
+	after.timestamp_ns = 1000000000;
+	after.interfaces.emplace_back(MakeNetworkInfo("lo", 10, 10, 0));
+
+	auto rates = ComputeNetworkRates(before, after);
+	REQUIRE(rates.size() == 1);
+	REQUIRE_FALSE(rates[0].has_utilization);
+}
+
+TEST_CASE("ComputeNetworkRates - interface churn", "[network_rates]") {
+	NetworkSnapshot before;
+	before.timestamp_ns = 0;
+	before.interfaces.emplace_back(MakeNetworkInfo("eth0", 0, 0, 0));
+	before.interfaces.emplace_back(MakeNetworkInfo("veth_removed", 0, 0, 0));
+
+	NetworkSnapshot after;
+	after.timestamp_ns = 1000000000;
+	after.interfaces.emplace_back(MakeNetworkInfo("veth_added", 10, 10, 0));
+	after.interfaces.emplace_back(MakeNetworkInfo("eth0", 10, 10, 0));
+
+	auto rates = ComputeNetworkRates(before, after);
+	REQUIRE(rates.size() == 1);
+	REQUIRE(rates[0].interface_name == "eth0");
+}
+
+TEST_CASE("ComputeNetworkRates - non-increasing timestamps", "[network_rates]") {
+	NetworkSnapshot snapshot;
+	snapshot.timestamp_ns = 1000;
+	snapshot.interfaces.emplace_back(MakeNetworkInfo("eth0", 0, 0, 0));
+	REQUIRE(ComputeNetworkRates(snapshot, snapshot).empty());
+}
+
+TEST_CASE("ComputeNetworkRates - re-created interface", "[network_rates]") {
+	NetworkSnapshot before;
+	before.timestamp_ns = 0;
+	before.interfaces.emplace_back(MakeNetworkInfo("veth0", 5000, 5000, 0, 7));
+
+	// Same name, new ifindex and counters restarted from zero; no 32-bit wraparound.
+	NetworkSnapshot after;
+	after.timestamp_ns = 1000000000;
+	after.interfaces.emplace_back(MakeNetworkInfo("veth0", 100, 200, 0, 8));
+
+	auto rates = ComputeNetworkRates(before, after);
+	REQUIRE(rates.size() == 1);
+	REQUIRE(rates[0].tx_bytes_per_sec == 100.0);
+	REQUIRE(rates[0].rx_bytes_per_sec == 200.0);
+}
+
+TEST_CASE("ParseProcNetDev", "[network_rates]") {
+	const char *content =
+	    "Inter-|   Receive                                                |  Transmit\n"
+	    " face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls "
+	    "carrier compressed\n"
+	    "    lo:    1000      10    0    0    0     0          0         0     1000      10    0    0    0     0 "
+	    "      0          0\n"
+	    "bond0-member:12345678901 20 1 2 0 0 0 0 300 30 3 4 0 0 0 0\n"
+	    "  bad: 1 2 3\n";
+	vector<InterfaceCounters> interfaces;
+	ParseProcNetDev(content, interfaces);
+	REQUIRE(interfaces.size() == 2);
+	REQUIRE(interfaces[0].interface_name == "lo");
+	REQUIRE(interfaces[0].rx_bytes == 1000);
+	REQUIRE(interfaces[0].tx_packets == 10);
+
+	// Interfaces without addresses are included, and counters may follow the colon without a space.
+	REQUIRE(interfaces[1].interface_name == "bond0-member");
+	REQUIRE(interfaces[1].rx_bytes == 12345678901ULL);
+	REQUIRE(interfaces[1].rx_packets == 20);
+	REQUIRE(interfaces[1].rx_errors == 1);
+	REQUIRE(interfaces[1].rx_dropped == 2);
+	REQUIRE(interfaces[1].tx_bytes == 300);
+	REQUIRE(interfaces[1].tx_packets == 30);
+	REQUIRE(interfaces[1].tx_errors == 3);
+	REQUIRE(interfaces[1].tx_dropped == 4);
+	REQUIRE(interfaces[1].ifindex == 0);
+}
@@ -0,0 +1,60 @@
+#include "catch/catch.hpp"
+#include "openmetrics.hpp"
+
+using namespace duckdb;
+
+TEST_CASE("MetricsWriter - OpenMetrics format", "[openmetrics]") {
+	MetricsWriter writer(MetricsFormat::OPENMETRICS, 256);
+	writer.AddFamily("test_memory_bytes", MetricType::GAUGE, "bytes", "Memory.");
+	writer.AddSample({}, 1024);
+	writer.AddFamily("test_receive_bytes", MetricType::COUNTER, "bytes", "Received.");
+	writer.AddSample({{"interface", "eth0"}}, 10);
+	writer.AddSample({{"interface", "lo"}}, 0);
+	writer.AddFamily("test_os", MetricType::INFO, "", "OS.");
+	writer.AddSample({{"name", "Linux"}, {"version", "6.1"}}, 1);
+
+	REQUIRE(writer.Finish() == "# TYPE test_memory_bytes gauge\n"
+	                           "# UNIT test_memory_bytes bytes\n"
+	                           "# HELP test_memory_bytes Memory.\n"
+	                           "test_memory_bytes 1024\n"
+	                           "# TYPE test_receive_bytes counter\n"
+	                           "# UNIT test_receive_bytes bytes\n"
+	                           "# HELP test_receive_bytes Received.\n"
+	                           "test_receive_bytes_total{interface=\"eth0\"} 10\n"
+	                           "test_receive_bytes_total{interface=\"lo\"} 0\n"
+	                           "# TYPE test_os info\n"
+	                           "# HELP test_os OS.\n"
+	                           "test_os_info{name=\"Linux\",version=\"6.1\"} 1\n"
+	                           "# EOF\n");
+}
+
+TEST_CASE("MetricsWriter - Prometheus format", "[openmetrics]") {
+	MetricsWriter writer(MetricsFormat::PROMETHEUS, 256);
+	writer.AddFamily("test_receive_bytes", MetricType::COUNTER, "bytes", "Received.");
+	writer.AddSample({}, UINT64_MAX);
+	writer.AddFamily("test_os", MetricType::INFO, "", "OS.");
+	writer.AddSample({{"name", "Linux"}}, 1);
+
+	REQUIRE(writer.Finish() == "# TYPE test_receive_bytes_total counter\n"
+	                           "# HELP test_receive_bytes_total Received.\n"
+	                           "test_receive_bytes_total 18446744073709551615\n"
+	                           "# TYPE test_os_info gauge\n"
+	                           "# HELP test_os_info OS.\n"
+	                           "test_os_info{name=\"Linux\"} 1\n");
+}
+
+TEST_CASE("MetricsWriter - label value escaping", "[openmetrics]") {
+	MetricsWriter writer(MetricsFormat::PROMETHEUS, 0);
+	writer.AddFamily("test_filesystem_size_bytes", MetricType::GAUGE, "bytes", "Size.");
+	writer.AddSample({{"mountpoint", "/mnt/a \"b\"\\c\nd"}}, 1);
+
+	REQUIRE(writer.Finish() == "# TYPE test_filesystem_size_bytes gauge\n"
+	                           "# HELP test_filesystem_size_bytes Size.\n"
+	                           "test_filesystem_size_bytes{mountpoint=\"/mnt/a \\\"b\\\"\\\\c\\nd\"} 1\n");
+}
+
+TEST_CASE("ParseMetricsFormat", "[openmetrics]") {
+	REQUIRE(ParseMetricsFormat("openmetrics") == MetricsFormat::OPENMETRICS);
+	REQUIRE(ParseMetricsFormat("Prometheus") == MetricsFormat::PROMETHEUS);
+	REQUIRE_THROWS(ParseMetricsFormat("json"));
+}
@@ -0,0 +1,68 @@
+#include "catch/catch.hpp"
+#include "page_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace duckdb;
+
+#ifdef __linux__
+TEST_CASE("ReadFilePageCache - written file is cached", "[page_cache]") {
+	char path[] = "/tmp/system_stats_page_cache_XXXXXX";
+	const int fd = mkstemp(path);
+	REQUIRE(fd != -1);
+	// 100 pages and a partial one.
+	const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const vector<char> content(page_size * 100 + 1, 'x');
+	REQUIRE(write(fd, content.data(), content.size()) == static_cast<ssize_t>(content.size()));
+
+	FilePageCache cache;
+	cache.path = path;
+	REQUIRE(ReadFilePageCache(cache));
+	REQUIRE(cache.size_bytes == content.size());
+	REQUIRE(cache.total_pages == 101);
+	REQUIRE(cache.cached_pages == 101);
+	REQUIRE(cache.cached_bytes == 101 * page_size);
+
+	// Both methods agree; mincore(2) is always available.
+	FilePageCache mincore_cache;
+	REQUIRE(ReadPageCacheMincore(fd, content.size(), mincore_cache));
+	REQUIRE(mincore_cache.method == PageCacheMethod::MINCORE);
+	REQUIRE(mincore_cache.cached_pages == 101);
+	FilePageCache cachestat_cache;
+	if (ReadPageCacheCachestat(fd, cachestat_cache)) {
+		REQUIRE(cachestat_cache.method == PageCacheMethod::CACHESTAT);
+		REQUIRE(cachestat_cache.cached_pages == 101);
+	}
+
+	close(fd);
+	unlink(path);
+}
+
+TEST_CASE("ReadFilePageCache - not a regular file", "[page_cache]") {
+	FilePageCache missing;
+	missing.path = "/nonexistent/system_stats_page_cache";
+	REQUIRE_FALSE(ReadFilePageCache(missing));
+
+	FilePageCache directory;
+	directory.path = "/tmp";
+	REQUIRE_FALSE(ReadFilePageCache(directory));
+
+	// A FIFO in a globbed directory is skipped instead of waiting for a writer.
+	char dir[] = "/tmp/system_stats_page_cache_XXXXXX";
+	REQUIRE(mkdtemp(dir) != nullptr);
+	const string fifo_path = string(dir) + "/fifo";
+	REQUIRE(mkfifo(fifo_path.c_str(), 0600) == 0);
+	FilePageCache fifo;
+	fifo.path = fifo_path;
+	REQUIRE_FALSE(ReadFilePageCache(fifo));
+	unlink(fifo_path.c_str());
+	rmdir(dir);
+}
+#endif
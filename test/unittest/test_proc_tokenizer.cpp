@@ -0,0 +1,196 @@
+#include "catch/catch.hpp"
+#include "proc_tokenizer.hpp"
+
+#include <charconv>
+#include <random>
+#include <string>
+
+using namespace duckdb;
+
+namespace {
+
+vector<string> Tokenize(std::string_view text) {
+	vector<string> tokens;
+	size_t pos = 0;
+	std::string_view token;
+	while (NextToken(text, pos, token)) {
+		tokens.emplace_back(token);
+	}
+	return tokens;
+}
+
+vector<string> Split(std::string_view text, idx_t max_tokens = 256) {
+	vector<std::string_view> tokens(max_tokens);
+	const idx_t token_count = SplitTokens(text, tokens.data(), max_tokens);
+	return vector<string>(tokens.begin(), tokens.begin() + static_cast<int64_t>(token_count));
+}
+
+// Reference tokenizer, one character at a time.
+vector<string> TokenizeScalar(std::string_view text) {
+	vector<string> tokens;
+	string current;
+	for (const char c : text) {
+		if (c == ' ' || c == '\t' || c == '\n') {
+			if (!current.empty()) {
+				tokens.emplace_back(std::move(current));
+				current.clear();
+			}
+		} else {
+			current.push_back(c);
+		}
+	}
+	if (!current.empty()) {
+		tokens.emplace_back(std::move(current));
+	}
+	return tokens;
+}
+
+} // namespace
+
+TEST_CASE("NextToken - separators", "[proc_tokenizer]") {
+	REQUIRE(Tokenize("").empty());
+	REQUIRE(Tokenize(" \t\n ").empty());
+	REQUIRE(Tokenize("a") == vector<string> {"a"});
+	REQUIRE(Tokenize("  Rss:\t\t  1234 kB\n") == vector<string> {"Rss:", "1234", "kB"});
+	REQUIRE(Tokenize("1 2\n3\t4") == vector<string> {"1", "2", "3", "4"});
+
+	// Long runs cross the 64 byte blocks of the vectorized search.
+	const string padding(70, ' ');
+	const string long_token(70, 'x');
+	REQUIRE(Tokenize(padding + long_token + padding + "y") == vector<string> {long_token, "y"});
+	REQUIRE(GetTokenizerImplementation() != nullptr);
+}
+
+TEST_CASE("SplitTokens - block boundaries and limit", "[proc_tokenizer]") {
+	REQUIRE(Split("").empty());
+	REQUIRE(Split("\t \n").empty());
+	REQUIRE(Split(" a  bb\tccc\n") == vector<string> {"a", "bb", "ccc"});
+	REQUIRE(Split("1 2 3 4", 2) == vector<string> {"1", "2"});
+
+	// Tokens ending right before, at and after the 64 byte block boundary, with and without trailing separators.
+	for (size_t length = 60; length <= 130; length++) {
+		const string text = string(length - 1, 'x') + "y";
+		REQUIRE(Split(text) == vector<string> {text});
+		REQUIRE(Split(text + " z") == vector<string> {text, "z"});
+		REQUIRE(Split(" " + text + "\n") == vector<string> {text});
+	}
+}
+
+TEST_CASE("NextToken and SplitTokens - match scalar reference", "[proc_tokenizer]") {
+	std::mt19937 rng(42);
+	const char alphabet[] = {' ', '\t', '\n', 'a', '0', ')', '('};
+	for (int iteration = 0; iteration < 2000; iteration++) {
+		string text;
+		const size_t length = rng() % 200;
+		for (size_t idx = 0; idx < length; idx++) {
+			text.push_back(alphabet[rng() % sizeof(alphabet)]);
+		}
+		const auto expected = TokenizeScalar(text);
+		REQUIRE(Tokenize(text) == expected);
+		REQUIRE(Split(text) == expected);
+	}
+}
+
+TEST_CASE("NextLine - line breaks", "[proc_tokenizer]") {
+	const std::string_view text = "first\n\nthird";
+	size_t pos = 0;
+	std::string_view line;
+	REQUIRE(NextLine(text, pos, line));
+	REQUIRE(line == "first");
+	REQUIRE(NextLine(text, pos, line));
+	REQUIRE(line.empty());
+	REQUIRE(NextLine(text, pos, line));
+	REQUIRE(line == "third");
+	REQUIRE_FALSE(NextLine(text, pos, line));
+}
+
+TEST_CASE("ParseUint64 - digit counts", "[proc_tokenizer]") {
+	// Every length from 1 to 19 digits, covering partial, full and multiple 8 digit chunks.
+	string digits;
+	for (int count = 1; count <= 19; count++) {
+		digits.push_back(static_cast<char>('0' + count % 10));
+		uint64_t expected = 0;
+		std::from_chars(digits.data(), digits.data() + digits.size(), expected);
+		uint64_t value = 0;
+		REQUIRE(ParseUint64(digits, value));
+		REQUIRE(value == expected);
+	}
+
+	uint64_t value = 0;
+	REQUIRE(ParseUint64("0", value));
+	REQUIRE(value == 0);
+	REQUIRE(ParseUint64("00000000000000000000042", value));
+	REQUIRE(value == 42);
+	REQUIRE(ParseUint64("18446744073709551615", value));
+	REQUIRE(value == UINT64_MAX);
+}
+
+TEST_CASE("ParseUint64 - invalid input", "[proc_tokenizer]") {
+	uint64_t value = 7;
+	REQUIRE_FALSE(ParseUint64("", value));
+	REQUIRE_FALSE(ParseUint64("18446744073709551616", value));
+	REQUIRE_FALSE(ParseUint64("99999999999999999999", value));
+	REQUIRE_FALSE(ParseUint64("-1", value));
+	REQUIRE_FALSE(ParseUint64("+1", value));
+	REQUIRE_FALSE(ParseUint64("12 ", value));
+	REQUIRE_FALSE(ParseUint64("1234567a", value));
+	REQUIRE_FALSE(ParseUint64("12345678:", value));
+	// Bytes right after '9' and before '0' in ASCII.
+	REQUIRE_FALSE(ParseUint64("123:", value));
+	REQUIRE_FALSE(ParseUint64("123/", value));
+	REQUIRE_FALSE(ParseUint64("\xff\xff\xff\xff\xff\xff\xff\xff", value));
+	REQUIRE(value == 7);
+}
+
+TEST_CASE("ParseUint64Prefix - trailing unit", "[proc_tokenizer]") {
+	uint64_t value = 0;
+	REQUIRE(ParseUint64Prefix("32K\n", value) == 2);
+	REQUIRE(value == 32);
+	REQUIRE(ParseUint64Prefix("123456789012kB", value) == 12);
+	REQUIRE(value == 123456789012ULL);
+	REQUIRE(ParseUint64Prefix("K32", value) == 0);
+	REQUIRE(ParseUint64Prefix("", value) == 0);
+}
+
+TEST_CASE("ParseInt64 and ParseInteger - ranges", "[proc_tokenizer]") {
+	int64_t value = 0;
+	REQUIRE(ParseInt64("-9223372036854775808", value));
+	REQUIRE(value == INT64_MIN);
+	REQUIRE(ParseInt64("9223372036854775807", value));
+	REQUIRE(value == INT64_MAX);
+	REQUIRE_FALSE(ParseInt64("9223372036854775808", value));
+	REQUIRE_FALSE(ParseInt64("-", value));
+
+	int32_t processor = 0;
+	REQUIRE(ParseInteger("-1", processor));
+	REQUIRE(processor == -1);
+	REQUIRE_FALSE(ParseInteger("2147483648", processor));
+	uint32_t minor = 0;
+	REQUIRE(ParseInteger("4294967295", minor));
+	REQUIRE_FALSE(ParseInteger("4294967296", minor));
+	REQUIRE_FALSE(ParseInteger("-1", minor));
+
+	uint64_t address = 0;
+	REQUIRE(ParseHexUint64("7f0c1c021000", address));
+	REQUIRE(address == 0x7f0c1c021000ULL);
+	REQUIRE_FALSE(ParseHexUint64("0x10", address));
+}
+
+TEST_CASE("SplitProcStat - command names", "[proc_tokenizer]") {
+	std::string_view comm;
+	std::string_view fields;
+	REQUIRE(SplitProcStat("1234 (bash) S 1 1234", comm, fields));
+	REQUIRE(comm == "bash");
+	REQUIRE(Tokenize(fields) == vector<string> {"S", "1", "1234"});
+
+	// Names could contain spaces and ") " themselves.
+	REQUIRE(SplitProcStat("42 (my (weird) ) name) R 1 42", comm, fields));
+	REQUIRE(comm == "my (weird) ) name");
+	REQUIRE(Tokenize(fields) == vector<string> {"R", "1", "42"});
+	REQUIRE(SplitProcStat("7 () Z 1", comm, fields));
+	REQUIRE(comm.empty());
+
+	REQUIRE_FALSE(SplitProcStat("", comm, fields));
+	REQUIRE_FALSE(SplitProcStat("1234 bash S 1", comm, fields));
+	REQUIRE_FALSE(SplitProcStat("1234 )bash( S 1", comm, fields));
+}
@@ -0,0 +1,48 @@
+#include "catch/catch.hpp"
+#include "proc_walker.hpp"
+
+#include <cstdio>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace duckdb;
+
+#ifdef __linux__
+TEST_CASE("ProcDirectory - pids and relative reads", "[proc_walker]") {
+	ProcDirectory proc_dir("/proc");
+	REQUIRE(proc_dir.IsOpen());
+
+	const int32_t own_pid = getpid();
+	bool found = false;
+	int32_t pid = 0;
+	while (proc_dir.Next(pid)) {
+		// Named entries like /proc/self are skipped.
+		REQUIRE(pid > 0);
+		found = found || pid == own_pid;
+	}
+	REQUIRE(found);
+	REQUIRE_FALSE(proc_dir.Next(pid));
+
+	std::array<char, 32> path;
+	std::array<char, 4096> buf;
+	snprintf(path.data(), path.size(), "%d/stat", own_pid);
+	const auto stat = ReadFileAt(proc_dir.GetFd(), path.data(), buf);
+	REQUIRE(stat.substr(0, stat.find(' ')) == std::to_string(own_pid));
+	REQUIRE(ReadFileAt(proc_dir.GetFd(), "0/stat", buf).empty());
+
+	// At least stdin, stdout and stderr are open.
+	snprintf(path.data(), path.size(), "%d/fd", own_pid);
+	ProcDirectory fd_dir(proc_dir.GetFd(), path.data());
+	REQUIRE(fd_dir.CountRemaining() >= 3);
+}
+#endif
+
+TEST_CASE("ProcDirectory - missing directory", "[proc_walker]") {
+	ProcDirectory dir("/nonexistent/proc");
+	REQUIRE_FALSE(dir.IsOpen());
+	int32_t id = 0;
+	REQUIRE_FALSE(dir.Next(id));
+	REQUIRE(dir.CountRemaining() == 0);
+}
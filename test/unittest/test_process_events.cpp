@@ -0,0 +1,180 @@
+#include "catch/catch.hpp"
+#include "process_events.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#endif
+
+using namespace duckdb;
+
+namespace {
+
+ProcEvent MakeEvent(ProcEventType type, int32_t pid, int32_t tgid) {
+	ProcEvent event;
+	event.type = type;
+	event.pid = pid;
+	event.tgid = tgid;
+	return event;
+}
+
+ProcessExit MakeExit(int32_t pid) {
+	ProcessExit exit;
+	exit.pid = pid;
+	return exit;
+}
+
+#ifdef __linux__
+// Append one proc connector message carrying [event] to [buf], as the kernel sends it.
+void AppendMessage(vector<char> &buf, const proc_event &event) {
+	const size_t offset = buf.size();
+	buf.resize(offset + NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_event)));
+	auto *header = reinterpret_cast<nlmsghdr *>(buf.data() + offset);
+	header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_event));
+	header->nlmsg_type = NLMSG_DONE;
+	auto *msg = static_cast<cn_msg *>(NLMSG_DATA(header));
+	msg->id.idx = CN_IDX_PROC;
+	msg->id.val = CN_VAL_PROC;
+	msg->len = sizeof(proc_event);
+	std::memcpy(msg->data, &event, sizeof(event));
+}
+#endif
+
+} // namespace
+
+#ifdef __linux__
+TEST_CASE("ParseProcConnectorMessage - events", "[process_events]") {
+	vector<char> buf;
+	proc_event fork {};
+	fork.what = proc_event::PROC_EVENT_FORK;
+	fork.timestamp_ns = 1000;
+	fork.event_data.fork.parent_tgid = 1;
+	fork.event_data.fork.child_pid = 42;
+	fork.event_data.fork.child_tgid = 42;
+	AppendMessage(buf, fork);
+
+	proc_event exit {};
+	exit.what = proc_event::PROC_EVENT_EXIT;
+	exit.event_data.exit.process_pid = 43;
+	exit.event_data.exit.process_tgid = 42;
+	exit.event_data.exit.exit_code = 9;
+	exit.event_data.exit.parent_tgid = 1;
+	AppendMessage(buf, exit);
+
+	proc_event comm {};
+	comm.what = proc_event::PROC_EVENT_COMM;
+	AppendMessage(buf, comm);
+
+	vector<ProcEvent> events;
+	REQUIRE(ParseProcConnectorMessage(buf.data(), buf.size(), events));
+	REQUIRE(events.size() == 3);
+	REQUIRE(events[0].type == ProcEventType::FORK);
+	REQUIRE(events[0].timestamp_ns == 1000);
+	REQUIRE(events[0].pid == 42);
+	REQUIRE(events[0].tgid == 42);
+	REQUIRE(events[0].parent_tgid == 1);
+	REQUIRE(events[1].type == ProcEventType::EXIT);
+	REQUIRE(events[1].pid == 43);
+	REQUIRE(events[1].tgid == 42);
+	REQUIRE(events[1].exit_code == 9);
+	REQUIRE(events[2].type == ProcEventType::OTHER);
+
+	// A message cut short is malformed.
+	events.clear();
+	auto *header = reinterpret_cast<nlmsghdr *>(buf.data());
+	header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + 4);
+	REQUIRE_FALSE(ParseProcConnectorMessage(buf.data(), buf.size(), events));
+}
+#endif
+
+TEST_CASE("ApplyProcEvent - process and thread counts", "[process_events]") {
+	ProcessEventCounts counts;
+	counts.process_count = 10;
+	counts.thread_count = 20;
+
+	// A process with one extra thread starts, exec()s, and exits.
+	ApplyProcEvent(MakeEvent(ProcEventType::FORK, 100, 100), counts);
+	ApplyProcEvent(MakeEvent(ProcEventType::FORK, 101, 100), counts);
+	ApplyProcEvent(MakeEvent(ProcEventType::EXEC, 100, 100), counts);
+	REQUIRE(counts.process_count == 11);
+	REQUIRE(counts.thread_count == 22);
+	REQUIRE(counts.forks == 1);
+	REQUIRE(counts.clones == 1);
+	REQUIRE(counts.execs == 1);
+
+	ApplyProcEvent(MakeEvent(ProcEventType::EXIT, 101, 100), counts);
+	REQUIRE(counts.process_count == 11);
+	REQUIRE(counts.exits == 0);
+	ApplyProcEvent(MakeEvent(ProcEventType::EXIT, 100, 100), counts);
+	REQUIRE(counts.process_count == 10);
+	REQUIRE(counts.thread_count == 20);
+	REQUIRE(counts.exits == 1);
+
+	// Acknowledgements and untracked events change nothing.
+	ApplyProcEvent(MakeEvent(ProcEventType::ACK, 0, 0), counts);
+	ApplyProcEvent(MakeEvent(ProcEventType::OTHER, 100, 100), counts);
+	REQUIRE(counts.process_count == 10);
+	REQUIRE(counts.thread_count == 20);
+}
+
+TEST_CASE("ReconcileSeededEvent - events queued during the walk", "[process_events]") {
+	auto make_event = [](ProcEventType type, int32_t pid, uint64_t timestamp_ns) {
+		auto event = MakeEvent(type, pid, pid);
+		event.timestamp_ns = timestamp_ns;
+		return event;
+	};
+	// The walk found pids 10, 11 and 12 and finished at 1000 ns.
+	ProcessEventSeed seed;
+	seed.tids = {10, 11, 12};
+	seed.end_ns = 1000;
+
+	// Created before the walk finished: 10 was counted by it, 20 was not.
+	REQUIRE_FALSE(ReconcileSeededEvent(make_event(ProcEventType::FORK, 10, 900), seed));
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::FORK, 20, 900), seed));
+	// Exited before the walk finished: 30 was never counted, 11 and 20 were.
+	REQUIRE_FALSE(ReconcileSeededEvent(make_event(ProcEventType::EXIT, 30, 950), seed));
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::EXIT, 11, 950), seed));
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::EXIT, 20, 950), seed));
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::EXEC, 40, 950), seed));
+
+	// After the walk, every event counts; well after it, the seed is dropped.
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::FORK, 50, 1100), seed));
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::EXIT, 60, 1100), seed));
+	REQUIRE_FALSE(seed.tids.empty());
+	REQUIRE(ReconcileSeededEvent(make_event(ProcEventType::EXIT, 12, 3000000000), seed));
+	REQUIRE(seed.tids.empty());
+	REQUIRE(seed.forked.empty());
+
+	// Skipped events still count towards the totals.
+	ProcessEventCounts counts;
+	ApplyProcEvent(make_event(ProcEventType::FORK, 10, 900), counts, false);
+	ApplyProcEvent(make_event(ProcEventType::EXIT, 30, 950), counts, false);
+	REQUIRE(counts.process_count == 0);
+	REQUIRE(counts.thread_count == 0);
+	REQUIRE(counts.forks == 1);
+	REQUIRE(counts.exits == 1);
+}
+
+TEST_CASE("ProcessExitLog - wraparound", "[process_events]") {
+	ProcessExitLog log(3);
+	log.Append(MakeExit(1));
+	log.Append(MakeExit(2));
+	auto entries = log.GetEntries();
+	REQUIRE(entries.size() == 2);
+	REQUIRE(entries[0].pid == 1);
+	REQUIRE(log.GetDropped() == 0);
+
+	for (int32_t pid = 3; pid <= 7; pid++) {
+		log.Append(MakeExit(pid));
+	}
+	entries = log.GetEntries();
+	REQUIRE(entries.size() == 3);
+	REQUIRE(entries[0].pid == 5);
+	REQUIRE(entries[1].pid == 6);
+	REQUIRE(entries[2].pid == 7);
+	REQUIRE(log.GetDropped() == 4);
+}
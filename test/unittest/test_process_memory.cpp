@@ -0,0 +1,102 @@
+#include "catch/catch.hpp"
+#include "process_memory.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+constexpr std::string_view SMAPS_CONTENT = "55d0c0a00000-55d0c0a21000 rw-p 00000000 00:00 0                  [heap]\n"
+                                           "Size:                132 kB\n"
+                                           "KernelPageSize:         4 kB\n"
+                                           "Rss:                   64 kB\n"
+                                           "Pss:                   64 kB\n"
+                                           "Private_Dirty:         64 kB\n"
+                                           "Anonymous:             64 kB\n"
+                                           "Swap:                   8 kB\n"
+                                           "VmFlags: rd wr mr mw me ac\n"
+                                           "7f0c1c000000-7f0c1c200000 r-xp 00001000 08:01 1234       /usr/lib/my lib.so\n"
+                                           "Size:               2048 kB\n"
+                                           "Rss:                 512 kB\n"
+                                           "Pss:                 256 kB\n"
+                                           "Shared_Clean:        512 kB\n"
+                                           "FilePmdMapped:      2048 kB\n"
+                                           "Private_Hugetlb:        4 kB\n"
+                                           "Shared_Hugetlb:         2 kB\n"
+                                           "VmFlags: rd ex mr mw me\n";
+
+vector<MemoryMapping> ParseInChunks(std::string_view content, size_t chunk_size) {
+	SmapsParser parser;
+	vector<MemoryMapping> mappings;
+	for (size_t pos = 0; pos < content.size(); pos += chunk_size) {
+		parser.Feed(content.substr(pos, chunk_size), mappings);
+	}
+	parser.Finish(mappings);
+	return mappings;
+}
+
+} // namespace
+
+TEST_CASE("SmapsParser - mappings", "[process_memory]") {
+	auto mappings = ParseInChunks(SMAPS_CONTENT, SMAPS_CONTENT.size());
+	REQUIRE(mappings.size() == 2);
+
+	REQUIRE(mappings[0].start_address == 0x55d0c0a00000);
+	REQUIRE(mappings[0].end_address == 0x55d0c0a21000);
+	REQUIRE(mappings[0].permissions == "rw-p");
+	REQUIRE(mappings[0].pathname == "[heap]");
+	REQUIRE(mappings[0].size == 132 * 1024);
+	REQUIRE(mappings[0].rss == 64 * 1024);
+	REQUIRE(mappings[0].private_dirty == 64 * 1024);
+	REQUIRE(mappings[0].anonymous == 64 * 1024);
+	REQUIRE(mappings[0].swap == 8 * 1024);
+
+	REQUIRE(mappings[1].offset == 0x1000);
+	REQUIRE(mappings[1].device == "08:01");
+	REQUIRE(mappings[1].inode == 1234);
+	REQUIRE(mappings[1].pathname == "/usr/lib/my lib.so");
+	REQUIRE(mappings[1].pss == 256 * 1024);
+	REQUIRE(mappings[1].shared_clean == 512 * 1024);
+	REQUIRE(mappings[1].file_pmd_mapped == 2048 * 1024);
+	REQUIRE(mappings[1].hugetlb == 6 * 1024);
+}
+
+TEST_CASE("SmapsParser - lines split across chunks", "[process_memory]") {
+	const auto expected = ParseInChunks(SMAPS_CONTENT, SMAPS_CONTENT.size());
+	for (size_t chunk_size = 1; chunk_size < 64; chunk_size++) {
+		auto mappings = ParseInChunks(SMAPS_CONTENT, chunk_size);
+		REQUIRE(mappings.size() == expected.size());
+		for (size_t idx = 0; idx < mappings.size(); idx++) {
+			REQUIRE(mappings[idx].pathname == expected[idx].pathname);
+			REQUIRE(mappings[idx].rss == expected[idx].rss);
+			REQUIRE(mappings[idx].hugetlb == expected[idx].hugetlb);
+		}
+	}
+}
+
+TEST_CASE("SmapsParser - rollup without trailing newline", "[process_memory]") {
+	constexpr std::string_view content = "00400000-7ffd1b1f5000 ---p 00000000 00:00 0      [rollup]\n"
+	                                     "Rss:                 884 kB\n"
+	                                     "Pss_Anon:            100 kB\n"
+	                                     "Pss_File:            200 kB\n"
+	                                     "Pss_Shmem:            12 kB\n"
+	                                     "Locked:                4 kB";
+	auto mappings = ParseInChunks(content, 7);
+	REQUIRE(mappings.size() == 1);
+	REQUIRE(mappings[0].pathname == "[rollup]");
+	REQUIRE(mappings[0].rss == 884 * 1024);
+	REQUIRE(mappings[0].pss_anon == 100 * 1024);
+	REQUIRE(mappings[0].pss_file == 200 * 1024);
+	REQUIRE(mappings[0].pss_shmem == 12 * 1024);
+	REQUIRE(mappings[0].locked == 4 * 1024);
+}
+
+TEST_CASE("MemoryMapping - accumulate", "[process_memory]") {
+	auto mappings = ParseInChunks(SMAPS_CONTENT, SMAPS_CONTENT.size());
+	MemoryMapping total = mappings[0];
+	total.Accumulate(mappings[1]);
+	REQUIRE(total.start_address == 0x55d0c0a00000);
+	REQUIRE(total.end_address == 0x7f0c1c200000);
+	REQUIRE(total.rss == 576 * 1024);
+	REQUIRE(total.swap == 8 * 1024);
+	REQUIRE(total.hugetlb == 6 * 1024);
+}
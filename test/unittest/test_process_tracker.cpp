@@ -0,0 +1,119 @@
+#include "catch/catch.hpp"
+#include "process_tracker.hpp"
+
+#include <cstdint>
+
+using namespace duckdb;
+
+namespace {
+
+constexpr double TICKS_PER_SECOND = 100.0;
+constexpr uint64_t NS_PER_SECOND = 1000000000;
+
+ProcessStat MakeStat(const string &name, uint64_t start_time_ticks, uint64_t cpu_ticks) {
+	ProcessStat stat;
+	stat.name = name;
+	stat.state = 'R';
+	stat.start_time_ticks = start_time_ticks;
+	stat.utime_ticks = cpu_ticks;
+	return stat;
+}
+
+vector<int32_t> GetPids(const vector<TrackedProcess *> &processes) {
+	vector<int32_t> pids;
+	for (const auto *process : processes) {
+		pids.push_back(process->pid);
+	}
+	return pids;
+}
+
+} // namespace
+
+TEST_CASE("ParseProcessStat - fields", "[process_tracker]") {
+	ProcessStat stat;
+	REQUIRE(ParseProcessStat("1234 (my (weird) name) S 1 1234 1234 0 -1 4194560 1000 0 0 0 250 50 0 0 20 0 7 0 "
+	                         "98765 10485760 2048 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 3 0 0\n",
+	                         stat));
+	REQUIRE(stat.name == "my (weird) name");
+	REQUIRE(stat.state == 'S');
+	REQUIRE(stat.ppid == 1);
+	REQUIRE(stat.minor_faults == 1000);
+	REQUIRE(stat.major_faults == 0);
+	REQUIRE(stat.utime_ticks == 250);
+	REQUIRE(stat.stime_ticks == 50);
+	REQUIRE(stat.num_threads == 7);
+	REQUIRE(stat.start_time_ticks == 98765);
+	REQUIRE(stat.rss_pages == 2048);
+
+	REQUIRE_FALSE(ParseProcessStat("", stat));
+	REQUIRE_FALSE(ParseProcessStat("1234 (bash) S 1 1234", stat));
+}
+
+TEST_CASE("ProcessTracker - CPU percentage between samples", "[process_tracker]") {
+	ProcessTracker tracker(TICKS_PER_SECOND);
+	tracker.BeginSample(NS_PER_SECOND);
+	REQUIRE_FALSE(tracker.Update(10, MakeStat("worker", 500, 100)).has_rates);
+	tracker.Update(11, MakeStat("idle", 501, 0));
+	tracker.EndSample();
+
+	// 2 seconds later, 150 ticks of 100 per second.
+	tracker.BeginSample(3 * NS_PER_SECOND);
+	auto &worker = tracker.Update(10, MakeStat("worker", 500, 250));
+	REQUIRE(worker.has_rates);
+	REQUIRE(worker.cpu_pct == 75.0);
+	REQUIRE(tracker.Update(11, MakeStat("idle", 501, 0)).cpu_pct == 0.0);
+	tracker.EndSample();
+	REQUIRE(tracker.Size() == 2);
+}
+
+TEST_CASE("ProcessTracker - pid reuse and exited processes", "[process_tracker]") {
+	ProcessTracker tracker(TICKS_PER_SECOND);
+	tracker.BeginSample(NS_PER_SECOND);
+	auto &first = tracker.Update(10, MakeStat("old", 500, 1000));
+	first.details_loaded = true;
+	first.cmdline = "old --flag";
+	tracker.Update(11, MakeStat("exits", 501, 0));
+	tracker.EndSample();
+
+	// pid 10 now belongs to a new process with another start time; pid 11 exited.
+	tracker.BeginSample(2 * NS_PER_SECOND);
+	auto &second = tracker.Update(10, MakeStat("new", 900, 10));
+	REQUIRE_FALSE(second.has_rates);
+	REQUIRE_FALSE(second.details_loaded);
+	REQUIRE(second.cmdline.empty());
+	tracker.EndSample();
+	REQUIRE(tracker.Size() == 1);
+
+	// exec() keeps pid and start time but changes the name, so details are read again.
+	tracker.BeginSample(3 * NS_PER_SECOND);
+	second.details_loaded = true;
+	auto &execed = tracker.Update(10, MakeStat("exec", 900, 20));
+	REQUIRE(execed.has_rates);
+	REQUIRE_FALSE(execed.details_loaded);
+	tracker.EndSample();
+}
+
+TEST_CASE("ProcessTracker - bounded top N", "[process_tracker]") {
+	ProcessTracker tracker(TICKS_PER_SECOND);
+	tracker.BeginSample(NS_PER_SECOND);
+	for (int32_t pid = 1; pid <= 100; pid++) {
+		tracker.Update(pid, MakeStat("p", static_cast<uint64_t>(pid), 0));
+	}
+	tracker.EndSample();
+
+	// CPU usage peaks at pid 50 and falls off on both sides; pid 101 is new and has no rates.
+	tracker.BeginSample(2 * NS_PER_SECOND);
+	for (int32_t pid = 1; pid <= 100; pid++) {
+		const auto distance = static_cast<uint64_t>(pid > 50 ? pid - 50 : 50 - pid);
+		tracker.Update(pid, MakeStat("p", static_cast<uint64_t>(pid), 100 - distance));
+	}
+	tracker.Update(101, MakeStat("new", 101, 1000));
+	tracker.EndSample();
+
+	REQUIRE(GetPids(tracker.SelectTop(5)) == vector<int32_t> {50, 49, 51, 48, 52});
+	REQUIRE(tracker.SelectTop(0).empty());
+	// Processes without rates rank last, by CPU time.
+	const auto all = tracker.SelectTop(1000);
+	REQUIRE(all.size() == 101);
+	REQUIRE(all.back()->pid == 101);
+}
@@ -0,0 +1,166 @@
+#include "catch/catch.hpp"
+#include "shared_metrics.hpp"
+
+#include <cstdint>
+
+using namespace duckdb;
+
+namespace {
+
+// Zeroed memory standing in for a freshly created shared memory segment.
+struct TestSegment {
+	TestSegment() : memory((GetSharedMetricsSegmentSize() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0) {
+	}
+	SharedMetricsSegment &Get() {
+		return *reinterpret_cast<SharedMetricsSegment *>(memory.data());
+	}
+	vector<uint64_t> memory;
+};
+
+NetworkInfo MakeNetwork(const string &name, vector<NetworkAddress> addresses) {
+	NetworkInfo info;
+	info.interface_name = name;
+	info.rx_bytes = 100;
+	info.tx_bytes = 200;
+	for (const auto &address : addresses) {
+		if (info.ipv4_address.empty() && address.family == "ipv4") {
+			info.ipv4_address = address.address;
+		}
+	}
+	info.addresses = std::move(addresses);
+	return info;
+}
+
+NetworkAddress MakeAddress(const string &family, const string &address, int32_t prefix_len) {
+	NetworkAddress result;
+	result.family = family;
+	result.address = address;
+	result.prefix_len = prefix_len;
+	return result;
+}
+
+SharedMetricsSnapshot MakeSnapshot() {
+	SharedMetricsSnapshot snapshot;
+	snapshot.publish_time_ns = 5000000000ULL;
+	snapshot.interval_ns = 1000000000ULL;
+	snapshot.publisher_pid = 42;
+	snapshot.memory.total_memory = 16ULL << 30;
+	snapshot.memory.free_memory = 4ULL << 30;
+	snapshot.handle_count = 1000;
+	snapshot.process_count = 300;
+	snapshot.thread_count = 900;
+	snapshot.has_networks = true;
+	snapshot.networks.emplace_back(MakeNetwork("lo", {MakeAddress("ipv4", "127.0.0.1", 8),
+	                                                  MakeAddress("ipv6", "::1", 128)}));
+	snapshot.networks.emplace_back(MakeNetwork("eth0", {MakeAddress("ipv6", "fe80::1%eth0", 64)}));
+	return snapshot;
+}
+
+} // namespace
+
+TEST_CASE("Shared metrics - write and read", "[shared_metrics]") {
+	TestSegment segment;
+	SharedMetricsSnapshot snapshot;
+	// Nothing was published to a zeroed segment.
+	REQUIRE_FALSE(ReadSharedMetrics(segment.Get(), true, snapshot));
+
+	InitializeSharedMetricsSegment(segment.Get());
+	REQUIRE(ReadSharedMetrics(segment.Get(), true, snapshot));
+	REQUIRE(snapshot.publish_time_ns == 0);
+
+	WriteSharedMetrics(segment.Get(), MakeSnapshot());
+	REQUIRE(ReadSharedMetrics(segment.Get(), true, snapshot));
+	REQUIRE(snapshot.publisher_pid == 42);
+	REQUIRE(snapshot.memory.total_memory == 16ULL << 30);
+	REQUIRE(snapshot.memory.free_memory == 4ULL << 30);
+	REQUIRE(snapshot.process_count == 300);
+	REQUIRE(snapshot.thread_count == 900);
+	REQUIRE(snapshot.has_networks);
+	REQUIRE(snapshot.networks.size() == 2);
+	REQUIRE(snapshot.networks[0].interface_name == "lo");
+	REQUIRE(snapshot.networks[0].ipv4_address == "127.0.0.1");
+	REQUIRE(snapshot.networks[0].addresses.size() == 2);
+	REQUIRE(snapshot.networks[0].addresses[1].family == "ipv6");
+	REQUIRE(snapshot.networks[0].addresses[1].prefix_len == 128);
+	REQUIRE(snapshot.networks[1].addresses[0].address == "fe80::1%eth0");
+	REQUIRE(snapshot.networks[1].rx_bytes == 100);
+
+	// Networks are only decoded on request.
+	REQUIRE(ReadSharedMetrics(segment.Get(), false, snapshot));
+	REQUIRE(snapshot.networks.empty());
+
+	// A publisher taking over keeps the published snapshot.
+	InitializeSharedMetricsSegment(segment.Get());
+	REQUIRE(ReadSharedMetrics(segment.Get(), false, snapshot));
+	REQUIRE(snapshot.publisher_pid == 42);
+}
+
+TEST_CASE("Shared metrics - publisher died while writing", "[shared_metrics]") {
+	TestSegment segment;
+	InitializeSharedMetricsSegment(segment.Get());
+	WriteSharedMetrics(segment.Get(), MakeSnapshot());
+	// Leave the sequence odd, as a publisher killed in the middle of a write does. It follows the magic, layout version
+	// and payload size.
+	segment.memory[2]++;
+	SharedMetricsSnapshot snapshot;
+	REQUIRE_FALSE(ReadSharedMetrics(segment.Get(), false, snapshot));
+
+	// The next publisher discards the torn payload, so readers do not take it for fresh.
+	InitializeSharedMetricsSegment(segment.Get());
+	REQUIRE(ReadSharedMetrics(segment.Get(), true, snapshot));
+	REQUIRE(snapshot.publish_time_ns == 0);
+	REQUIRE(snapshot.publisher_pid == 0);
+	REQUIRE(snapshot.networks.empty());
+
+	WriteSharedMetrics(segment.Get(), MakeSnapshot());
+	REQUIRE(ReadSharedMetrics(segment.Get(), false, snapshot));
+	REQUIRE(snapshot.publisher_pid == 42);
+}
+
+TEST_CASE("Shared metrics - networks which do not fit", "[shared_metrics]") {
+	TestSegment segment;
+	InitializeSharedMetricsSegment(segment.Get());
+	auto published = MakeSnapshot();
+	published.networks[1].addresses[0].address = string(100, 'a');
+	WriteSharedMetrics(segment.Get(), published);
+
+	// Other metrics are still shared, readers collect network info themselves.
+	SharedMetricsSnapshot snapshot;
+	REQUIRE(ReadSharedMetrics(segment.Get(), true, snapshot));
+	REQUIRE(snapshot.process_count == 300);
+	REQUIRE_FALSE(snapshot.has_networks);
+	REQUIRE(snapshot.networks.empty());
+}
+
+TEST_CASE("Shared metrics - staleness", "[shared_metrics]") {
+	auto snapshot = MakeSnapshot();
+	REQUIRE(IsSharedMetricsFresh(snapshot, snapshot.publish_time_ns));
+	REQUIRE(IsSharedMetricsFresh(snapshot, snapshot.publish_time_ns + 3 * snapshot.interval_ns));
+	REQUIRE_FALSE(IsSharedMetricsFresh(snapshot, snapshot.publish_time_ns + 3 * snapshot.interval_ns + 1));
+	// Clock of another time namespace.
+	REQUIRE_FALSE(IsSharedMetricsFresh(snapshot, snapshot.publish_time_ns - 1));
+
+	// Short intervals stay fresh for at least one second.
+	snapshot.interval_ns = 100000000ULL;
+	REQUIRE(IsSharedMetricsFresh(snapshot, snapshot.publish_time_ns + 900000000ULL));
+
+	SharedMetricsSnapshot unpublished;
+	REQUIRE_FALSE(IsSharedMetricsFresh(unpublished, 1));
+}
+
+TEST_CASE("FilterNetworkInfo", "[shared_metrics]") {
+	const auto networks = MakeSnapshot().networks;
+	REQUIRE(FilterNetworkInfo(networks, AddressFamily::ALL).size() == 2);
+
+	auto ipv4 = FilterNetworkInfo(networks, AddressFamily::IPV4);
+	REQUIRE(ipv4.size() == 1);
+	REQUIRE(ipv4[0].interface_name == "lo");
+	REQUIRE(ipv4[0].addresses.size() == 1);
+	REQUIRE(ipv4[0].ipv4_address == "127.0.0.1");
+
+	auto ipv6 = FilterNetworkInfo(networks, AddressFamily::IPV6);
+	REQUIRE(ipv6.size() == 2);
+	REQUIRE(ipv6[0].addresses.size() == 1);
+	REQUIRE(ipv6[0].addresses[0].address == "::1");
+	REQUIRE(ipv6[0].ipv4_address.empty());
+}
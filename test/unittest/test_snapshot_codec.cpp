@@ -0,0 +1,114 @@
+#include "catch/catch.hpp"
+#include "snapshot_codec.hpp"
+
+#include <cstdint>
+
+using namespace duckdb;
+
+namespace {
+
+constexpr int64_t START_MICROS = 1792324800LL * 1000000;
+constexpr int64_t INTERVAL_MICROS = 100000;
+
+// Append one snapshot of a host with [interface_count] interfaces, whose counters grow with [tick].
+void AppendSnapshot(MetricsBatch &batch, int64_t ts_micros, uint64_t tick, idx_t interface_count) {
+	const timestamp_t ts {ts_micros};
+	batch.Append(ts, "memory", "", "total_memory", 16ULL << 30);
+	batch.Append(ts, "memory", "", "used_memory", (4ULL << 30) + tick * 4096);
+	batch.Append(ts, "disk", "/", "free_space", (100ULL << 30) - tick * 512);
+	for (idx_t idx = 0; idx < interface_count; idx++) {
+		const string name = "eth" + std::to_string(idx);
+		batch.Append(ts, "network", name, "rx_bytes", 1000000 + tick * 1500);
+		batch.Append(ts, "network", name, "rx_packets", 1000 + tick);
+		batch.Append(ts, "network", name, "rx_errors", 0);
+	}
+}
+
+MetricsBatch DecodeAll(const string &data) {
+	MetricsBatch decoded;
+	SnapshotDecoder decoder(data);
+	while (decoder.Next(decoded)) {
+	}
+	return decoded;
+}
+
+void RequireEqual(const MetricsBatch &actual, const MetricsBatch &expected) {
+	REQUIRE(actual.Size() == expected.Size());
+	for (idx_t row = 0; row < expected.Size(); row++) {
+		REQUIRE(actual.timestamps[row].value == expected.timestamps[row].value);
+		REQUIRE(actual.sources[row] == expected.sources[row]);
+		REQUIRE(actual.entities[row] == expected.entities[row]);
+		REQUIRE(actual.metrics[row] == expected.metrics[row]);
+		REQUIRE(actual.values[row] == expected.values[row]);
+	}
+}
+
+} // namespace
+
+TEST_CASE("SnapshotEncoder - round trip", "[snapshot_codec]") {
+	MetricsBatch batch;
+	AppendSnapshot(batch, START_MICROS, 0, 2);
+	AppendSnapshot(batch, START_MICROS + INTERVAL_MICROS, 1, 2);
+	// Irregular interval and an interface appearing.
+	AppendSnapshot(batch, START_MICROS + 3 * INTERVAL_MICROS + 17, 2, 3);
+	// Counter reset and values at the ends of the range.
+	const timestamp_t last_ts {START_MICROS + 4 * INTERVAL_MICROS};
+	batch.Append(last_ts, "network", "eth0", "rx_bytes", 0);
+	batch.Append(last_ts, "network", "eth0", "rx_packets", UINT64_MAX);
+
+	SnapshotEncoder encoder;
+	encoder.Append(batch);
+	REQUIRE(encoder.SampleCount() == batch.Size());
+	REQUIRE(encoder.FirstTimestamp() == START_MICROS);
+	REQUIRE(encoder.LastTimestamp() == last_ts.value);
+	RequireEqual(DecodeAll(encoder.GetData()), batch);
+}
+
+TEST_CASE("SnapshotEncoder - appends continue the stream", "[snapshot_codec]") {
+	MetricsBatch all;
+	SnapshotEncoder encoder;
+	for (uint64_t tick = 0; tick < 10; tick++) {
+		MetricsBatch batch;
+		AppendSnapshot(batch, START_MICROS + static_cast<int64_t>(tick) * INTERVAL_MICROS, tick, 2);
+		AppendSnapshot(all, START_MICROS + static_cast<int64_t>(tick) * INTERVAL_MICROS, tick, 2);
+		encoder.Append(batch);
+	}
+	RequireEqual(DecodeAll(encoder.GetData()), all);
+
+	encoder.Reset();
+	REQUIRE(encoder.SampleCount() == 0);
+	REQUIRE(DecodeAll(encoder.GetData()).Size() == 0);
+}
+
+TEST_CASE("SnapshotEncoder - compression ratio", "[snapshot_codec]") {
+	// One minute at 100 milliseconds resolution.
+	MetricsBatch batch;
+	for (uint64_t tick = 0; tick < 600; tick++) {
+		AppendSnapshot(batch, START_MICROS + static_cast<int64_t>(tick) * INTERVAL_MICROS, tick, 4);
+	}
+	SnapshotEncoder encoder;
+	encoder.Append(batch);
+
+	idx_t raw_bytes = 0;
+	for (idx_t row = 0; row < batch.Size(); row++) {
+		raw_bytes += sizeof(int64_t) + batch.sources[row].size() + batch.entities[row].size() +
+		             batch.metrics[row].size() + sizeof(uint64_t);
+	}
+	REQUIRE(raw_bytes > 10 * encoder.GetData().size());
+}
+
+TEST_CASE("SnapshotDecoder - invalid input", "[snapshot_codec]") {
+	REQUIRE_THROWS(SnapshotDecoder(""));
+	REQUIRE_THROWS(SnapshotDecoder("PAR1\x01"));
+
+	MetricsBatch batch;
+	AppendSnapshot(batch, START_MICROS, 0, 1);
+	SnapshotEncoder encoder;
+	encoder.Append(batch);
+	const string &data = encoder.GetData();
+
+	// Truncated in the middle of the snapshot.
+	SnapshotDecoder decoder(std::string_view {data}.substr(0, data.size() - 2));
+	MetricsBatch decoded;
+	REQUIRE_THROWS(decoder.Next(decoded));
+}
@@ -0,0 +1,72 @@
+#include "catch/catch.hpp"
+#include "thread_pinning.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+// Two sockets with one node each, two cores per socket and two hardware threads per core, numbered like Linux does:
+// the first threads of all cores before their siblings.
+vector<CpuTopologyInfo> GetTwoSocketTopology() {
+	vector<CpuTopologyInfo> cpus;
+	for (int32_t cpu = 0; cpu < 8; cpu++) {
+		CpuTopologyInfo info;
+		info.cpu = cpu;
+		info.package = (cpu / 2) % 2;
+		info.node = info.package;
+		info.core = cpu % 2;
+		cpus.emplace_back(info);
+	}
+	return cpus;
+}
+
+} // namespace
+
+TEST_CASE("ParseThreadPinPolicy", "[thread_pinning]") {
+	REQUIRE(ParseThreadPinPolicy("compact") == ThreadPinPolicy::COMPACT);
+	REQUIRE(ParseThreadPinPolicy("Scatter") == ThreadPinPolicy::SCATTER);
+	REQUIRE(ParseThreadPinPolicy("numa_local") == ThreadPinPolicy::NUMA_LOCAL);
+	REQUIRE(ParseThreadPinPolicy("AVOID_IRQ_CPUS") == ThreadPinPolicy::AVOID_IRQ_CPUS);
+	REQUIRE(ParseThreadPinPolicy("none") == ThreadPinPolicy::NONE);
+	REQUIRE(string(ThreadPinPolicyToString(ThreadPinPolicy::NUMA_LOCAL)) == "numa_local");
+	REQUIRE_THROWS(ParseThreadPinPolicy("spread"));
+}
+
+TEST_CASE("AssignWorkerCpus compact and scatter", "[thread_pinning]") {
+	const auto cpus = GetTwoSocketTopology();
+
+	// Siblings of a core first, then the other core of the socket, then the other socket; wraps around.
+	const auto compact = AssignWorkerCpus(ThreadPinPolicy::COMPACT, cpus, {}, 10);
+	REQUIRE(compact == vector<vector<int32_t>> {{0}, {4}, {1}, {5}, {2}, {6}, {3}, {7}, {0}, {4}});
+
+	// Alternating sockets, one worker per core before any sibling.
+	const auto scatter = AssignWorkerCpus(ThreadPinPolicy::SCATTER, cpus, {}, 8);
+	REQUIRE(scatter == vector<vector<int32_t>> {{0}, {2}, {1}, {3}, {4}, {6}, {5}, {7}});
+}
+
+TEST_CASE("AssignWorkerCpus numa_local", "[thread_pinning]") {
+	const auto cpus = GetTwoSocketTopology();
+	const vector<int32_t> node0 {0, 1, 4, 5};
+	const vector<int32_t> node1 {2, 3, 6, 7};
+
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::NUMA_LOCAL, cpus, {}, 4) ==
+	        vector<vector<int32_t>> {node0, node0, node1, node1});
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::NUMA_LOCAL, cpus, {}, 3) ==
+	        vector<vector<int32_t>> {node0, node0, node1});
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::NUMA_LOCAL, cpus, {}, 1) == vector<vector<int32_t>> {node0});
+}
+
+TEST_CASE("AssignWorkerCpus avoid_irq_cpus and none", "[thread_pinning]") {
+	const auto cpus = GetTwoSocketTopology();
+	const vector<int32_t> all_cpus {0, 1, 2, 3, 4, 5, 6, 7};
+
+	// CPUs outside of the allowed ones are ignored.
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::AVOID_IRQ_CPUS, cpus, {0, 2, 9}, 2) ==
+	        vector<vector<int32_t>>(2, vector<int32_t> {1, 3, 4, 5, 6, 7}));
+	// Interrupts on every CPU leave nothing to avoid them with.
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::AVOID_IRQ_CPUS, cpus, all_cpus, 2) ==
+	        vector<vector<int32_t>>(2, all_cpus));
+
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::NONE, cpus, {}, 3) == vector<vector<int32_t>>(3, all_cpus));
+	REQUIRE(AssignWorkerCpus(ThreadPinPolicy::COMPACT, cpus, {}, 0).empty());
+}
@@ -0,0 +1,91 @@
+#include "catch/catch.hpp"
+#include "thread_stats.hpp"
+
+using namespace duckdb;
+
+namespace {
+
+ThreadInfo MakeThreadInfo(int32_t tid, uint64_t run_time_ns, uint64_t wait_time_ns) {
+	ThreadInfo info;
+	info.tid = tid;
+	info.run_time_ns = run_time_ns;
+	info.wait_time_ns = wait_time_ns;
+	return info;
+}
+
+} // namespace
+
+TEST_CASE("ParseTaskStat - regular thread name", "[thread_stats]") {
+	const std::string_view content = "4242 (duckdb) R 1 4242 4242 0 -1 4194560 1000 0 0 0 250 75 0 0 20 0 12 0 "
+	                                 "123456 1000000 2000 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 3 0 0 0 0 0\n";
+	TaskStat stat;
+	REQUIRE(ParseTaskStat(content, stat));
+	REQUIRE(stat.name == "duckdb");
+	REQUIRE(stat.state == 'R');
+	REQUIRE(stat.utime_ticks == 250);
+	REQUIRE(stat.stime_ticks == 75);
+	REQUIRE(stat.processor == 3);
+}
+
+TEST_CASE("ParseTaskStat - thread name with spaces and parentheses", "[thread_stats]") {
+	const std::string_view content = "17 (a) b (c) S 1 17 17 0 -1 0 0 0 0 0 9 8 0 0 20 0 1 0 "
+	                                 "1 1 1 1 1 1 0 0 0 0 0 0 0 0 0 0 17 5 0 0 0 0 0\n";
+	TaskStat stat;
+	REQUIRE(ParseTaskStat(content, stat));
+	REQUIRE(stat.name == "a) b (c");
+	REQUIRE(stat.state == 'S');
+	REQUIRE(stat.utime_ticks == 9);
+	REQUIRE(stat.stime_ticks == 8);
+	REQUIRE(stat.processor == 5);
+}
+
+TEST_CASE("ParseTaskStat - malformed content", "[thread_stats]") {
+	TaskStat stat;
+	REQUIRE_FALSE(ParseTaskStat("", stat));
+	REQUIRE_FALSE(ParseTaskStat("17 (truncated", stat));
+	REQUIRE_FALSE(ParseTaskStat("17 (name)", stat));
+}
+
+TEST_CASE("ParseSchedStat", "[thread_stats]") {
+	SchedStat stat;
+	REQUIRE(ParseSchedStat("1234567 89012 34\n", stat));
+	REQUIRE(stat.run_time_ns == 1234567);
+	REQUIRE(stat.wait_time_ns == 89012);
+	REQUIRE(stat.timeslices == 34);
+
+	REQUIRE_FALSE(ParseSchedStat("", stat));
+	REQUIRE_FALSE(ParseSchedStat("1 2\n", stat));
+}
+
+TEST_CASE("ParseContextSwitches", "[thread_stats]") {
+	const std::string_view content = "Name:\tduckdb\n"
+	                                 "State:\tS (sleeping)\n"
+	                                 "voluntary_ctxt_switches:\t120\n"
+	                                 "nonvoluntary_ctxt_switches:\t7\n";
+	uint64_t voluntary = 0;
+	uint64_t nonvoluntary = 0;
+	ParseContextSwitches(content, voluntary, nonvoluntary);
+	REQUIRE(voluntary == 120);
+	REQUIRE(nonvoluntary == 7);
+}
+
+TEST_CASE("ComputeThreadRates", "[thread_stats]") {
+	vector<ThreadInfo> before;
+	before.emplace_back(MakeThreadInfo(1, 1000000, 0));
+	before.emplace_back(MakeThreadInfo(2, 5000000, 5000000));
+
+	vector<ThreadInfo> after;
+	// Ran for half of the 10ms interval, waited for a quarter.
+	after.emplace_back(MakeThreadInfo(1, 6000000, 2500000));
+	// Counters went backwards, i.e. the tid was reused.
+	after.emplace_back(MakeThreadInfo(2, 1000, 0));
+	// Created in between.
+	after.emplace_back(MakeThreadInfo(3, 1000000, 0));
+
+	ComputeThreadRates(before, after, 10000000);
+	REQUIRE(after[0].has_rates);
+	REQUIRE(after[0].cpu_pct == 50.0);
+	REQUIRE(after[0].wait_pct == 25.0);
+	REQUIRE_FALSE(after[1].has_rates);
+	REQUIRE_FALSE(after[2].has_rates);
+}